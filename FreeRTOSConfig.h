@@ -50,18 +50,37 @@
 #define configMINIMAL_STACK_SIZE                ( (unsigned short) 256 )
 #define configUSE_16_BIT_TICKS                  0
 #define configIDLE_SHOULD_YIELD                 1
+#define configUSE_EDF_SCHEDULING                1
+#define configUSE_TIME_PARTITIONING             1
+#define configMAX_PARTITIONS                    1
 
 /* Synchronization Related */
 #define configUSE_MUTEXES                       1
 #define configUSE_RECURSIVE_MUTEXES             1
+#define configUSE_TRANSITIVE_INHERITANCE        1
+#define configMAX_INHERITANCE_DEPTH             4
+#define configUSE_CEILING_MUTEXES               1
 #define configUSE_APPLICATION_TASK_TAG          0
 #define configUSE_COUNTING_SEMAPHORES           1
 #define configQUEUE_REGISTRY_SIZE               8
 #define configUSE_QUEUE_SETS                    1
+#define configUSE_QUEUE_ZERO_COPY               1
+#define configUSE_QUEUE_BATCH_TRANSFER          1
+#define configUSE_SPSC_RINGS                    1
+#define configUSE_FAST_MUTEXES                  1
+#define configUSE_RW_LOCKS                      1
+#define configUSE_STREAM_BUFFER_ZERO_COPY       1
+#define configUSE_STREAM_BUFFER_EXTERNAL_INDEX  1
+#define configUSE_STREAM_BUFFER_VECTORED_IO     1
+#define configUSE_SB_COMPLETED_CALLBACK         1
+#define configUSE_INDEXED_EVENT_GROUPS          1
+#define configUSE_DIRECT_EVENT_GROUPS           1
+#define configDIRECT_EVENT_GROUP_MAX_WAITERS    8
 #define configUSE_TIME_SLICING                  1
 #define configUSE_NEWLIB_REENTRANT              0
 #define configENABLE_BACKWARD_COMPATIBILITY     1
 #define configNUM_THREAD_LOCAL_STORAGE_POINTERS 5
+#define configTASK_NOTIFICATION_ARRAY_ENTRIES   2
 
 /* System */
 #define configSTACK_DEPTH_TYPE                  uint32_t
@@ -72,21 +91,49 @@
 #define configSUPPORT_DYNAMIC_ALLOCATION        1
 #define configTOTAL_HEAP_SIZE                   (128*1024)
 #define configAPPLICATION_ALLOCATED_HEAP        0
+#define configUSE_BLOCK_POOLS                   1
+#define configUSE_KERNEL_OBJECT_POOLS           1
+#define configKERNEL_OBJECT_POOL_COUNT          4
+#define configUSE_HEAP_INSTRUMENTATION          1
+#define configHEAP_INSTRUMENTATION_TAGS         16
+#define configHEAP_INSTRUMENTATION_BLOCKS       64
+#define configUSE_HEAP_REGION_HINTS             1
+#define configHEAP_MAX_REGIONS                  3
 
 /* Hook function related definitions. */
-#define configCHECK_FOR_STACK_OVERFLOW          0
+#define configCHECK_FOR_STACK_OVERFLOW          3
+#define configSTACK_GUARD_WORDS                 8
+#define configSTACK_CANARY_SCAN_PERIOD_TICKS    100
 #define configUSE_MALLOC_FAILED_HOOK            0
 #define configUSE_DAEMON_TASK_STARTUP_HOOK      0
 
 /* Run time and task stats gathering related definitions. */
-#define configGENERATE_RUN_TIME_STATS           0
+#define configGENERATE_RUN_TIME_STATS           1
 #define configUSE_TRACE_FACILITY                1
 #define configUSE_STATS_FORMATTING_FUNCTIONS    0
+#define configRUN_TIME_COUNTER_TYPE             uint64_t
+
+/* The run time counter is the 1 MHz, 64-bit RP2040 timer, which is already
+running when the scheduler starts and never wraps in practice. */
+#ifndef __ASSEMBLER__
+extern uint64_t time_us_64( void );
+#endif
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()
+#define portGET_RUN_TIME_COUNTER_VALUE()        time_us_64()
+
+/* Critical section profiling, timed with the run time counter above. */
+#define configUSE_CRITICAL_PROFILER             1
+#define configCRITICAL_PROFILER_SITES           16
+#define configCRITICAL_PROFILER_BUCKETS         8
 
 /* Co-routine related definitions. */
 #define configUSE_CO_ROUTINES                   0
 #define configMAX_CO_ROUTINE_PRIORITIES         1
 
+/* Stackless co-routines hosted by a task (coro.h), used by the LED and
+buzzer behaviours. */
+#define configUSE_CORO_SCHEDULER                1
+
 /* Software timer related definitions. */
 #define configUSE_TIMERS                        1
 #define configTIMER_TASK_PRIORITY               ( configMAX_PRIORITIES - 1 )
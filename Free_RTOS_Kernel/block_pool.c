@@ -0,0 +1,596 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "block_pool.h"
+
+/* The MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+ * for the header files above, but not in this file, in order to generate the
+ * correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* This entire source file will be skipped if the application is not configured
+ * to include block pools.  This #if is closed at the very bottom of this
+ * file. */
+#if ( configUSE_BLOCK_POOLS == 1 )
+
+/*
+ * A block pool divides a statically allocated array into blocks of one size.
+ * Free blocks are kept on a singly linked list threaded through the blocks
+ * themselves, so allocating a block is popping the head of the list and
+ * freeing one is pushing it back - both constant time, with no per-block
+ * header and no search.
+ */
+    typedef struct BlockPoolDef_t
+    {
+        uint8_t * pucStart;        /**< The first block, aligned to portBYTE_ALIGNMENT. */
+        uint8_t * pucEnd;          /**< One past the last block. */
+        void * pvFreeList;         /**< The first free block, or NULL if all blocks are in use.  Each free block holds a pointer to the next. */
+        size_t xBlockSize;         /**< The size of each block after rounding up by blockpoolBLOCK_SIZE(). */
+        size_t xBlockCount;        /**< The number of blocks in the pool. */
+        size_t xBlocksInUse;       /**< The number of blocks currently allocated. */
+        size_t xPeakBlocksInUse;   /**< The highest value xBlocksInUse has had since the pool was created or vBlockPoolResetPeak() was called. */
+        size_t xFailedAllocations; /**< The number of allocations that returned NULL because all blocks were in use. */
+        size_t xFallbacks;         /**< The number of kernel objects this pool fits best that came from a larger pool or the heap because all blocks were in use. */
+    } BlockPool_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Remove a block from, or return a block to, the pool's free list.  Must be
+ * called from a critical section.  prvPopBlock() returns NULL, without
+ * counting a failure, if all blocks are in use.
+ */
+    static void * prvPopBlock( BlockPool_t * const pxPool ) PRIVILEGED_FUNCTION;
+    static void prvPushBlock( BlockPool_t * const pxPool,
+                              void * pvBlock ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns pdTRUE if pvBlock points into the pool's storage.
+ */
+    static BaseType_t prvPoolContains( const BlockPool_t * const pxPool,
+                                       const void * pvBlock ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_KERNEL_OBJECT_POOLS == 1 )
+
+/* The pools registered with xBlockPoolRegisterKernelObjectPool(), in order of
+ * increasing block size. */
+        PRIVILEGED_DATA static BlockPool_t * pxKernelObjectPools[ configKERNEL_OBJECT_POOL_COUNT ];
+        PRIVILEGED_DATA static UBaseType_t uxKernelObjectPoolCount = ( UBaseType_t ) 0U;
+
+    #endif /* configUSE_KERNEL_OBJECT_POOLS */
+
+/*-----------------------------------------------------------*/
+
+    BlockPoolHandle_t xBlockPoolCreateStatic( size_t xBlockSize,
+                                              size_t xBlockCount,
+                                              uint8_t * pucPoolStorage,
+                                              StaticBlockPool_t * pxStaticPool )
+    {
+        BlockPool_t * pxPool = NULL;
+        portPOINTER_SIZE_TYPE uxStart;
+        uint8_t * pucBlock;
+        size_t x;
+
+        traceENTER_xBlockPoolCreateStatic( xBlockSize, xBlockCount, pucPoolStorage, pxStaticPool );
+
+        configASSERT( pucPoolStorage );
+        configASSERT( pxStaticPool );
+        configASSERT( xBlockSize > 0U );
+        configASSERT( xBlockCount > 0U );
+
+        #if ( configASSERT_DEFINED == 1 )
+        {
+            /* Sanity check that the size of the structure used to declare a
+             * variable of type StaticBlockPool_t equals the size of the real
+             * pool structure. */
+            volatile size_t xSize = sizeof( StaticBlockPool_t );
+            configASSERT( xSize == sizeof( BlockPool_t ) );
+        }
+        #endif /* configASSERT_DEFINED */
+
+        if( ( pucPoolStorage != NULL ) && ( pxStaticPool != NULL ) && ( xBlockSize > 0U ) && ( xBlockCount > 0U ) )
+        {
+            /* MISRA Ref 11.3.1 [Misaligned access] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-113 */
+            /* coverity[misra_c_2012_rule_11_3_violation] */
+            pxPool = ( BlockPool_t * ) pxStaticPool;
+
+            /* blockpoolSTORAGE_SIZE() leaves room to align the first block. */
+            uxStart = ( portPOINTER_SIZE_TYPE ) pucPoolStorage;
+            uxStart = ( uxStart + ( portPOINTER_SIZE_TYPE ) portBYTE_ALIGNMENT_MASK ) & ~( ( portPOINTER_SIZE_TYPE ) portBYTE_ALIGNMENT_MASK );
+
+            pxPool->xBlockSize = blockpoolBLOCK_SIZE( xBlockSize );
+            pxPool->xBlockCount = xBlockCount;
+            pxPool->pucStart = ( uint8_t * ) uxStart;
+            pxPool->pucEnd = pxPool->pucStart + ( pxPool->xBlockSize * xBlockCount );
+            pxPool->xBlocksInUse = 0U;
+            pxPool->xPeakBlocksInUse = 0U;
+            pxPool->xFailedAllocations = 0U;
+            pxPool->xFallbacks = 0U;
+
+            /* Thread every block onto the free list, lowest address first. */
+            pxPool->pvFreeList = NULL;
+            pucBlock = pxPool->pucEnd;
+
+            for( x = 0U; x < xBlockCount; x++ )
+            {
+                pucBlock -= pxPool->xBlockSize;
+                *( ( void ** ) pucBlock ) = pxPool->pvFreeList;
+                pxPool->pvFreeList = ( void * ) pucBlock;
+            }
+
+            traceBLOCK_POOL_CREATE( pxPool );
+        }
+        else
+        {
+            traceBLOCK_POOL_CREATE_FAILED();
+        }
+
+        traceRETURN_xBlockPoolCreateStatic( pxPool );
+
+        return pxPool;
+    }
+/*-----------------------------------------------------------*/
+
+    void * pvBlockPoolAlloc( BlockPoolHandle_t xPool )
+    {
+        BlockPool_t * const pxPool = xPool;
+        void * pvReturn;
+
+        traceENTER_pvBlockPoolAlloc( xPool );
+
+        configASSERT( pxPool );
+
+        taskENTER_CRITICAL();
+        {
+            pvReturn = prvPopBlock( pxPool );
+
+            if( pvReturn == NULL )
+            {
+                ( pxPool->xFailedAllocations )++;
+                traceBLOCK_POOL_ALLOC_FAILED( pxPool );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        traceRETURN_pvBlockPoolAlloc( pvReturn );
+
+        return pvReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    void * pvBlockPoolAllocFromISR( BlockPoolHandle_t xPool )
+    {
+        BlockPool_t * const pxPool = xPool;
+        void * pvReturn;
+        UBaseType_t uxSavedInterruptStatus;
+
+        traceENTER_pvBlockPoolAllocFromISR( xPool );
+
+        configASSERT( pxPool );
+
+        /* MISRA Ref 4.7.1 [Return value shall be checked] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#dir-47 */
+        /* coverity[misra_c_2012_directive_4_7_violation] */
+        uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+        {
+            pvReturn = prvPopBlock( pxPool );
+
+            if( pvReturn == NULL )
+            {
+                ( pxPool->xFailedAllocations )++;
+                traceBLOCK_POOL_ALLOC_FAILED( pxPool );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+        traceRETURN_pvBlockPoolAllocFromISR( pvReturn );
+
+        return pvReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    void vBlockPoolFree( BlockPoolHandle_t xPool,
+                         void * pvBlock )
+    {
+        BlockPool_t * const pxPool = xPool;
+
+        traceENTER_vBlockPoolFree( xPool, pvBlock );
+
+        configASSERT( pxPool );
+
+        if( pvBlock != NULL )
+        {
+            taskENTER_CRITICAL();
+            {
+                prvPushBlock( pxPool, pvBlock );
+            }
+            taskEXIT_CRITICAL();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_vBlockPoolFree();
+    }
+/*-----------------------------------------------------------*/
+
+    void vBlockPoolFreeFromISR( BlockPoolHandle_t xPool,
+                                void * pvBlock )
+    {
+        BlockPool_t * const pxPool = xPool;
+        UBaseType_t uxSavedInterruptStatus;
+
+        traceENTER_vBlockPoolFreeFromISR( xPool, pvBlock );
+
+        configASSERT( pxPool );
+
+        if( pvBlock != NULL )
+        {
+            /* MISRA Ref 4.7.1 [Return value shall be checked] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#dir-47 */
+            /* coverity[misra_c_2012_directive_4_7_violation] */
+            uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+            {
+                prvPushBlock( pxPool, pvBlock );
+            }
+            taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_vBlockPoolFreeFromISR();
+    }
+/*-----------------------------------------------------------*/
+
+    void vBlockPoolGetStats( BlockPoolHandle_t xPool,
+                             BlockPoolStats_t * pxPoolStats )
+    {
+        BlockPool_t * const pxPool = xPool;
+
+        traceENTER_vBlockPoolGetStats( xPool, pxPoolStats );
+
+        configASSERT( pxPool );
+        configASSERT( pxPoolStats );
+
+        taskENTER_CRITICAL();
+        {
+            pxPoolStats->xBlockSize = pxPool->xBlockSize;
+            pxPoolStats->xBlockCount = pxPool->xBlockCount;
+            pxPoolStats->xBlocksInUse = pxPool->xBlocksInUse;
+            pxPoolStats->xPeakBlocksInUse = pxPool->xPeakBlocksInUse;
+            pxPoolStats->xFailedAllocations = pxPool->xFailedAllocations;
+            pxPoolStats->xFallbacks = pxPool->xFallbacks;
+        }
+        taskEXIT_CRITICAL();
+
+        traceRETURN_vBlockPoolGetStats();
+    }
+/*-----------------------------------------------------------*/
+
+    void vBlockPoolResetPeak( BlockPoolHandle_t xPool )
+    {
+        BlockPool_t * const pxPool = xPool;
+
+        traceENTER_vBlockPoolResetPeak( xPool );
+
+        configASSERT( pxPool );
+
+        taskENTER_CRITICAL();
+        {
+            pxPool->xPeakBlocksInUse = pxPool->xBlocksInUse;
+        }
+        taskEXIT_CRITICAL();
+
+        traceRETURN_vBlockPoolResetPeak();
+    }
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_KERNEL_OBJECT_POOLS == 1 )
+
+        BaseType_t xBlockPoolRegisterKernelObjectPool( BlockPoolHandle_t xPool )
+        {
+            BlockPool_t * const pxPool = xPool;
+            BaseType_t xReturn = pdFAIL;
+            UBaseType_t uxIndex;
+
+            traceENTER_xBlockPoolRegisterKernelObjectPool( xPool );
+
+            configASSERT( pxPool );
+
+            taskENTER_CRITICAL();
+            {
+                if( uxKernelObjectPoolCount < ( UBaseType_t ) configKERNEL_OBJECT_POOL_COUNT )
+                {
+                    /* Keep the table sorted by block size so pvPortMallocObject()
+                     * uses the smallest pool that fits. */
+                    uxIndex = uxKernelObjectPoolCount;
+
+                    while( ( uxIndex > ( UBaseType_t ) 0U ) && ( pxKernelObjectPools[ uxIndex - 1U ]->xBlockSize > pxPool->xBlockSize ) )
+                    {
+                        pxKernelObjectPools[ uxIndex ] = pxKernelObjectPools[ uxIndex - 1U ];
+                        uxIndex--;
+                    }
+
+                    pxKernelObjectPools[ uxIndex ] = pxPool;
+                    uxKernelObjectPoolCount++;
+                    xReturn = pdPASS;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            taskEXIT_CRITICAL();
+
+            traceRETURN_xBlockPoolRegisterKernelObjectPool( xReturn );
+
+            return xReturn;
+        }
+
+    #endif /* configUSE_KERNEL_OBJECT_POOLS */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_KERNEL_OBJECT_POOLS == 1 )
+
+        void * pvPortMallocObject( size_t xSize )
+        {
+            void * pvReturn = NULL;
+            BlockPool_t * pxBestFit = NULL;
+            UBaseType_t uxIndex;
+
+            /* Try each registered pool whose blocks are large enough, smallest
+             * first, then fall back to the heap. */
+            taskENTER_CRITICAL();
+            {
+                for( uxIndex = ( UBaseType_t ) 0U; ( uxIndex < uxKernelObjectPoolCount ) && ( pvReturn == NULL ); uxIndex++ )
+                {
+                    if( pxKernelObjectPools[ uxIndex ]->xBlockSize >= xSize )
+                    {
+                        if( pxBestFit == NULL )
+                        {
+                            pxBestFit = pxKernelObjectPools[ uxIndex ];
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+
+                        pvReturn = prvPopBlock( pxKernelObjectPools[ uxIndex ] );
+
+                        /* The best fitting pool was full, but a larger one
+                         * was not. */
+                        if( ( pvReturn != NULL ) && ( pxKernelObjectPools[ uxIndex ] != pxBestFit ) )
+                        {
+                            ( pxBestFit->xFallbacks )++;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+            }
+            taskEXIT_CRITICAL();
+
+            if( pvReturn == NULL )
+            {
+                #if ( configUSE_HEAP_INSTRUMENTATION == 1 )
+                {
+                    /* Charge the block to the code that created the object,
+                     * as when pvPortMallocObject() is pvPortMalloc() itself,
+                     * rather than to this call, which every kernel object
+                     * would then share. */
+                    vTaskSuspendAll();
+                    {
+                        vHeapInstrumentationSetCallSite( portGET_CALLER_ADDRESS() );
+                        pvReturn = pvPortMalloc( xSize );
+                        vHeapInstrumentationSetCallSite( NULL );
+                    }
+                    ( void ) xTaskResumeAll();
+                }
+                #else
+                {
+                    pvReturn = pvPortMalloc( xSize );
+                }
+                #endif
+
+                /* Every pool the object fits was full, so whether it fell
+                 * back or failed is only known now. */
+                if( pxBestFit != NULL )
+                {
+                    taskENTER_CRITICAL();
+                    {
+                        if( pvReturn != NULL )
+                        {
+                            ( pxBestFit->xFallbacks )++;
+                        }
+                        else
+                        {
+                            ( pxBestFit->xFailedAllocations )++;
+                            traceBLOCK_POOL_ALLOC_FAILED( pxBestFit );
+                        }
+                    }
+                    taskEXIT_CRITICAL();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            return pvReturn;
+        }
+
+    #endif /* configUSE_KERNEL_OBJECT_POOLS */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_KERNEL_OBJECT_POOLS == 1 )
+
+        void vPortFreeObject( void * pv )
+        {
+            BlockPool_t * pxOwner = NULL;
+            UBaseType_t uxIndex;
+
+            if( pv != NULL )
+            {
+                taskENTER_CRITICAL();
+                {
+                    for( uxIndex = ( UBaseType_t ) 0U; uxIndex < uxKernelObjectPoolCount; uxIndex++ )
+                    {
+                        if( prvPoolContains( pxKernelObjectPools[ uxIndex ], pv ) != pdFALSE )
+                        {
+                            pxOwner = pxKernelObjectPools[ uxIndex ];
+                            prvPushBlock( pxOwner, pv );
+                            break;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                }
+                taskEXIT_CRITICAL();
+
+                /* Objects created before the pools were registered, or when
+                 * they were full, came from the heap. */
+                if( pxOwner == NULL )
+                {
+                    vPortFree( pv );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+    #endif /* configUSE_KERNEL_OBJECT_POOLS */
+/*-----------------------------------------------------------*/
+
+    static void * prvPopBlock( BlockPool_t * const pxPool )
+    {
+        void * pvBlock = pxPool->pvFreeList;
+
+        if( pvBlock != NULL )
+        {
+            pxPool->pvFreeList = *( ( void ** ) pvBlock );
+            ( pxPool->xBlocksInUse )++;
+
+            if( pxPool->xBlocksInUse > pxPool->xPeakBlocksInUse )
+            {
+                pxPool->xPeakBlocksInUse = pxPool->xBlocksInUse;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            traceBLOCK_POOL_ALLOC( pxPool, pvBlock );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pvBlock;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvPushBlock( BlockPool_t * const pxPool,
+                              void * pvBlock )
+    {
+        /* The block must have come from this pool, and at least one block must
+         * be in use for it to be given back. */
+        configASSERT( prvPoolContains( pxPool, pvBlock ) != pdFALSE );
+        configASSERT( ( ( size_t ) ( ( uint8_t * ) pvBlock - pxPool->pucStart ) % pxPool->xBlockSize ) == 0U );
+        configASSERT( pxPool->xBlocksInUse > 0U );
+
+        traceBLOCK_POOL_FREE( pxPool, pvBlock );
+
+        *( ( void ** ) pvBlock ) = pxPool->pvFreeList;
+        pxPool->pvFreeList = pvBlock;
+        ( pxPool->xBlocksInUse )--;
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvPoolContains( const BlockPool_t * const pxPool,
+                                       const void * pvBlock )
+    {
+        BaseType_t xReturn;
+
+        if( ( ( const uint8_t * ) pvBlock >= pxPool->pucStart ) && ( ( const uint8_t * ) pvBlock < pxPool->pucEnd ) )
+        {
+            xReturn = pdTRUE;
+        }
+        else
+        {
+            xReturn = pdFALSE;
+        }
+
+        return xReturn;
+    }
+
+/* This entire source file will be skipped if the application is not configured
+ * to include block pools.  If you want to include block pools then ensure
+ * configUSE_BLOCK_POOLS is set to 1 in FreeRTOSConfig.h. */
+#endif /* configUSE_BLOCK_POOLS == 1 */
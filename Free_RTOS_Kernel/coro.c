@@ -0,0 +1,566 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+#include "coro.h"
+
+/* The MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+ * for the header files above, but not in this file, in order to generate the
+ * correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* This entire source file will be skipped if the application is not configured
+ * to include co-routine groups.  This #if is closed at the very bottom of this
+ * file. */
+#if ( configUSE_CORO_SCHEDULER == 1 )
+
+    #if ( configUSE_QUEUE_SETS != 1 )
+        #error configUSE_QUEUE_SETS must be set to 1 to build coro.c
+    #endif
+
+    #if ( configSUPPORT_DYNAMIC_ALLOCATION != 1 )
+        #error configSUPPORT_DYNAMIC_ALLOCATION must be set to 1 to build coro.c
+    #endif
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Returns pdTRUE if a co-routine is ready to run: it yielded, the event it
+ * waits for has happened or its timeout has expired.  Updates what is left of
+ * the timeout of a co-routine that is not ready.
+ */
+    static BaseType_t prvCoroIsReady( Coro_t * const pxCoro ) PRIVILEGED_FUNCTION;
+
+/*
+ * Blocks the host task until a co-routine is notified, an item is sent to one
+ * of the group's queues or xBlockTime expires, then takes every event out of
+ * the queue set.
+ */
+    static void prvWaitForEvents( CoroScheduler_t * const pxScheduler,
+                                  TickType_t xBlockTime ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+    BaseType_t xCoroSchedulerCreate( CoroScheduler_t * const pxScheduler,
+                                     const UBaseType_t uxQueueEventLength )
+    {
+        BaseType_t xReturn = pdFAIL;
+
+        traceENTER_xCoroSchedulerCreate( pxScheduler, uxQueueEventLength );
+
+        configASSERT( pxScheduler != NULL );
+
+        pxScheduler->pxFirst = NULL;
+        pxScheduler->pxLast = NULL;
+
+        /* An item a co-routine receives leaves its event in the set until the
+         * host task next takes the events out, so the set has room for one
+         * event per item the queues can hold, one per item received since the
+         * events were last taken out, and one for the semaphore. */
+        pxScheduler->xQueueSet = xQueueCreateSet( ( uxQueueEventLength * ( UBaseType_t ) 2 ) + ( UBaseType_t ) 1 );
+        pxScheduler->xWakeSemaphore = xSemaphoreCreateBinary();
+
+        if( ( pxScheduler->xQueueSet != NULL ) && ( pxScheduler->xWakeSemaphore != NULL ) )
+        {
+            xReturn = xQueueAddToSet( pxScheduler->xWakeSemaphore, pxScheduler->xQueueSet );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( xReturn != pdPASS )
+        {
+            vCoroSchedulerDelete( pxScheduler );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_xCoroSchedulerCreate( xReturn );
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    void vCoroSchedulerDelete( CoroScheduler_t * const pxScheduler )
+    {
+        traceENTER_vCoroSchedulerDelete( pxScheduler );
+
+        configASSERT( pxScheduler != NULL );
+        configASSERT( pxScheduler->pxFirst == NULL );
+
+        if( pxScheduler->xWakeSemaphore != NULL )
+        {
+            vSemaphoreDelete( pxScheduler->xWakeSemaphore );
+            pxScheduler->xWakeSemaphore = NULL;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( pxScheduler->xQueueSet != NULL )
+        {
+            vQueueDelete( pxScheduler->xQueueSet );
+            pxScheduler->xQueueSet = NULL;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_vCoroSchedulerDelete();
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xCoroSchedulerAddQueue( CoroScheduler_t * const pxScheduler,
+                                       QueueHandle_t xQueue )
+    {
+        BaseType_t xReturn;
+
+        traceENTER_xCoroSchedulerAddQueue( pxScheduler, xQueue );
+
+        configASSERT( pxScheduler != NULL );
+        configASSERT( xQueue != NULL );
+
+        xReturn = xQueueAddToSet( xQueue, pxScheduler->xQueueSet );
+
+        traceRETURN_xCoroSchedulerAddQueue( xReturn );
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    void vCoroCreate( CoroScheduler_t * const pxScheduler,
+                      Coro_t * const pxCoro,
+                      CoroFunction_t pxCoroFunction,
+                      void * pvParameters )
+    {
+        traceENTER_vCoroCreate( pxScheduler, pxCoro, pxCoroFunction, pvParameters );
+
+        configASSERT( pxScheduler != NULL );
+        configASSERT( pxCoro != NULL );
+        configASSERT( pxCoroFunction != NULL );
+
+        pxCoro->pxCoroFunction = pxCoroFunction;
+        pxCoro->pvParameters = pvParameters;
+        pxCoro->pxScheduler = pxScheduler;
+        pxCoro->pxNext = NULL;
+        pxCoro->xQueue = NULL;
+        pxCoro->xTicksToWait = portMAX_DELAY;
+        pxCoro->ulNotifiedValue = 0U;
+        pxCoro->usResumePoint = 0U;
+        pxCoro->ucState = coroSTATE_READY;
+
+        /* Appended, so that co-routines run in the order they were created. */
+        if( pxScheduler->pxLast == NULL )
+        {
+            pxScheduler->pxFirst = pxCoro;
+        }
+        else
+        {
+            pxScheduler->pxLast->pxNext = pxCoro;
+        }
+
+        pxScheduler->pxLast = pxCoro;
+
+        traceRETURN_vCoroCreate();
+    }
+/*-----------------------------------------------------------*/
+
+    void vCoroSchedulerRun( CoroScheduler_t * const pxScheduler )
+    {
+        Coro_t * pxCoro;
+        Coro_t * pxPrevious;
+        TickType_t xBlockTime;
+
+        traceENTER_vCoroSchedulerRun( pxScheduler );
+
+        configASSERT( pxScheduler != NULL );
+
+        while( pxScheduler->pxFirst != NULL )
+        {
+            xBlockTime = portMAX_DELAY;
+            pxPrevious = NULL;
+            pxCoro = pxScheduler->pxFirst;
+
+            /* Co-routines created during this pass are appended to the list,
+             * so they also run during this pass. */
+            while( pxCoro != NULL )
+            {
+                if( prvCoroIsReady( pxCoro ) != pdFALSE )
+                {
+                    pxCoro->ucState = coroSTATE_READY;
+                    pxCoro->pxCoroFunction( pxCoro, pxCoro->pvParameters );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                if( pxCoro->ucState == coroSTATE_ENDED )
+                {
+                    /* Unlink the ended co-routine.  pxPrevious stays where it is. */
+                    if( pxPrevious == NULL )
+                    {
+                        pxScheduler->pxFirst = pxCoro->pxNext;
+                    }
+                    else
+                    {
+                        pxPrevious->pxNext = pxCoro->pxNext;
+                    }
+
+                    if( pxScheduler->pxLast == pxCoro )
+                    {
+                        pxScheduler->pxLast = pxPrevious;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    if( pxCoro->ucState == coroSTATE_READY )
+                    {
+                        /* Yielded, so run it again without blocking. */
+                        xBlockTime = 0;
+                    }
+                    else if( pxCoro->xTicksToWait < xBlockTime )
+                    {
+                        xBlockTime = pxCoro->xTicksToWait;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    pxPrevious = pxCoro;
+                }
+
+                pxCoro = pxCoro->pxNext;
+            }
+
+            if( pxScheduler->pxFirst != NULL )
+            {
+                prvWaitForEvents( pxScheduler, xBlockTime );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+        traceRETURN_vCoroSchedulerRun();
+    }
+/*-----------------------------------------------------------*/
+
+    void vCoroSchedulerTask( void * pvParameters )
+    {
+        vCoroSchedulerRun( ( CoroScheduler_t * ) pvParameters );
+        vTaskDelete( NULL );
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xCoroNotifyGive( Coro_t * const pxCoro )
+    {
+        traceENTER_xCoroNotifyGive( pxCoro );
+
+        configASSERT( pxCoro != NULL );
+
+        taskENTER_CRITICAL();
+        {
+            pxCoro->ulNotifiedValue++;
+        }
+        taskEXIT_CRITICAL();
+
+        /* Fails harmlessly if the host task has not yet taken an earlier
+         * give: it still runs its co-routines, and so sees this one too. */
+        ( void ) xSemaphoreGive( pxCoro->pxScheduler->xWakeSemaphore );
+
+        traceRETURN_xCoroNotifyGive( pdPASS );
+
+        return pdPASS;
+    }
+/*-----------------------------------------------------------*/
+
+    void vCoroNotifyGiveFromISR( Coro_t * const pxCoro,
+                                 BaseType_t * const pxHigherPriorityTaskWoken )
+    {
+        UBaseType_t uxSavedInterruptStatus;
+
+        traceENTER_vCoroNotifyGiveFromISR( pxCoro, pxHigherPriorityTaskWoken );
+
+        configASSERT( pxCoro != NULL );
+
+        /* MISRA Ref 4.7.1 [Return value shall be checked] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#dir-47 */
+        /* coverity[misra_c_2012_directive_4_7_violation] */
+        uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();
+        {
+            pxCoro->ulNotifiedValue++;
+        }
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+        ( void ) xSemaphoreGiveFromISR( pxCoro->pxScheduler->xWakeSemaphore, pxHigherPriorityTaskWoken );
+
+        traceRETURN_vCoroNotifyGiveFromISR();
+    }
+/*-----------------------------------------------------------*/
+
+    void vCoroPrepareDelay( Coro_t * const pxCoro,
+                            const TickType_t xTicksToDelay )
+    {
+        if( xTicksToDelay > ( TickType_t ) 0 )
+        {
+            vCoroSetTimeOut( pxCoro, xTicksToDelay );
+            pxCoro->ucState = coroSTATE_DELAYED;
+        }
+        else
+        {
+            /* Stays ready, so the host runs it again on its next pass. */
+            pxCoro->ucState = coroSTATE_READY;
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xCoroPrepareDelayUntil( Coro_t * const pxCoro,
+                                       TickType_t * const pxPreviousWakeTime,
+                                       const TickType_t xTimeIncrement )
+    {
+        const TickType_t xConstTickCount = xTaskGetTickCount();
+        const TickType_t xTimeToWake = *pxPreviousWakeTime + xTimeIncrement;
+        BaseType_t xShouldDelay = pdFALSE;
+
+        configASSERT( xTimeIncrement > 0U );
+
+        /* The same test as xTaskDelayUntil(), which allows for the tick count
+         * and the wake time having overflowed. */
+        if( xConstTickCount < *pxPreviousWakeTime )
+        {
+            if( ( xTimeToWake < *pxPreviousWakeTime ) && ( xTimeToWake > xConstTickCount ) )
+            {
+                xShouldDelay = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            if( ( xTimeToWake < *pxPreviousWakeTime ) || ( xTimeToWake > xConstTickCount ) )
+            {
+                xShouldDelay = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+        *pxPreviousWakeTime = xTimeToWake;
+
+        if( xShouldDelay != pdFALSE )
+        {
+            vCoroPrepareDelay( pxCoro, xTimeToWake - xConstTickCount );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xShouldDelay;
+    }
+/*-----------------------------------------------------------*/
+
+    void vCoroSetTimeOut( Coro_t * const pxCoro,
+                          const TickType_t xTicksToWait )
+    {
+        vTaskSetTimeOutState( &( pxCoro->xTimeOut ) );
+        pxCoro->xTicksToWait = xTicksToWait;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xCoroPrepareWait( Coro_t * const pxCoro,
+                                 const uint8_t ucState,
+                                 QueueHandle_t xQueue )
+    {
+        BaseType_t xReturn;
+
+        if( xTaskCheckForTimeOut( &( pxCoro->xTimeOut ), &( pxCoro->xTicksToWait ) ) != pdFALSE )
+        {
+            /* Timed out, so the macro returns without waiting again. */
+            pxCoro->ucState = coroSTATE_READY;
+            xReturn = pdFALSE;
+        }
+        else
+        {
+            pxCoro->xQueue = xQueue;
+            pxCoro->ucState = ucState;
+            xReturn = pdTRUE;
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    uint32_t ulCoroTakeNotification( Coro_t * const pxCoro,
+                                     const BaseType_t xClearCountOnExit )
+    {
+        uint32_t ulReturn;
+
+        taskENTER_CRITICAL();
+        {
+            ulReturn = pxCoro->ulNotifiedValue;
+
+            if( ulReturn != 0U )
+            {
+                if( xClearCountOnExit != pdFALSE )
+                {
+                    pxCoro->ulNotifiedValue = 0U;
+                }
+                else
+                {
+                    pxCoro->ulNotifiedValue = ulReturn - 1U;
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        return ulReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvCoroIsReady( Coro_t * const pxCoro )
+    {
+        BaseType_t xReturn = pdFALSE;
+
+        switch( pxCoro->ucState )
+        {
+            case coroSTATE_READY:
+                xReturn = pdTRUE;
+                break;
+
+            case coroSTATE_WAITING_NOTIFICATION:
+                /* A single aligned read; the macro takes the notification in
+                 * a critical section once the co-routine runs. */
+                if( pxCoro->ulNotifiedValue != 0U )
+                {
+                    xReturn = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                break;
+
+            case coroSTATE_WAITING_QUEUE:
+
+                if( uxQueueMessagesWaiting( pxCoro->xQueue ) != ( UBaseType_t ) 0 )
+                {
+                    xReturn = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                break;
+
+            default:
+                /* coroSTATE_DELAYED: only the timeout can make it ready. */
+                break;
+        }
+
+        if( xReturn == pdFALSE )
+        {
+            if( xTaskCheckForTimeOut( &( pxCoro->xTimeOut ), &( pxCoro->xTicksToWait ) ) != pdFALSE )
+            {
+                xReturn = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvWaitForEvents( CoroScheduler_t * const pxScheduler,
+                                  TickType_t xBlockTime )
+    {
+        QueueSetMemberHandle_t xMember;
+
+        xMember = xQueueSelectFromSet( pxScheduler->xQueueSet, xBlockTime );
+
+        while( xMember != NULL )
+        {
+            if( xMember == pxScheduler->xWakeSemaphore )
+            {
+                ( void ) xSemaphoreTake( pxScheduler->xWakeSemaphore, 0 );
+            }
+            else
+            {
+                /* An item arrived in one of the group's queues.  It is left
+                 * in the queue, for the co-routine waiting on it to receive,
+                 * so there is nothing to do other than to wake. */
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            xMember = xQueueSelectFromSet( pxScheduler->xQueueSet, 0 );
+        }
+    }
+/*-----------------------------------------------------------*/
+
+/* This entire source file will be skipped if the application is not configured
+ * to include co-routine groups.  If you want to include them then ensure
+ * configUSE_CORO_SCHEDULER is set to 1 in FreeRTOSConfig.h. */
+#endif /* configUSE_CORO_SCHEDULER == 1 */
@@ -0,0 +1,258 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+
+/* Standard includes. */
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "critical_profiler.h"
+
+/* The MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+ * for the header files above, but not in this file, in order to generate the
+ * correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* This entire source file will be skipped if the application is not configured
+ * to include the critical section profiler.  This #if is closed at the very
+ * bottom of this file. */
+#if ( configUSE_CRITICAL_PROFILER == 1 )
+
+/* Critical sections entered at a call site that cannot be given an entry of its
+ * own, because every entry is already in use, are all counted against this last
+ * entry of the site table. */
+    #define critprofOVERFLOW_SITE    ( ( UBaseType_t ) configCRITICAL_PROFILER_SITES )
+
+/*-----------------------------------------------------------*/
+
+/* The site table is an open addressed hash table keyed on the file and line of
+ * the call site.  An entry whose pcFile is NULL is empty.  It is only accessed
+ * with interrupts masked. */
+    PRIVILEGED_DATA static CriticalSiteStats_t xSites[ configCRITICAL_PROFILER_SITES + 1 ];
+
+/* The number of critical sections that are open, and the call site and start
+ * time of the outermost one. */
+    PRIVILEGED_DATA static UBaseType_t uxNesting = ( UBaseType_t ) 0U;
+    PRIVILEGED_DATA static const char * pcOpenFile = NULL;
+    PRIVILEGED_DATA static uint32_t ulOpenLine = 0U;
+    PRIVILEGED_DATA static uint64_t ullOpenTime = 0U;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Returns the entry of xSites[] for the call site at line ulLine of pcFile,
+ * claiming an empty entry if there is not one already.
+ */
+    static CriticalSiteStats_t * prvGetSite( const char * pcFile,
+                                             uint32_t ulLine ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the histogram bucket that a critical section lasting ullDuration
+ * is counted in.
+ */
+    static UBaseType_t prvGetBucket( uint64_t ullDuration ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+    void vCriticalProfilerEnter( const char * pcFile,
+                                 uint32_t ulLine )
+    {
+        /* Called with interrupts masked, so nothing else can open or close a
+         * critical section at the same time. */
+        if( uxNesting == ( UBaseType_t ) 0U )
+        {
+            pcOpenFile = pcFile;
+            ulOpenLine = ulLine;
+            ullOpenTime = configCRITICAL_PROFILER_TIMESTAMP();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        uxNesting++;
+    }
+/*-----------------------------------------------------------*/
+
+    UBaseType_t uxCriticalProfilerEnterFromISR( UBaseType_t uxSavedInterruptStatus,
+                                                const char * pcFile,
+                                                uint32_t ulLine )
+    {
+        /* taskENTER_CRITICAL_FROM_ISR() passes in the value returned by
+         * portSET_INTERRUPT_MASK_FROM_ISR(), so interrupts are already masked
+         * and the value is handed straight back to the caller. */
+        vCriticalProfilerEnter( pcFile, ulLine );
+
+        return uxSavedInterruptStatus;
+    }
+/*-----------------------------------------------------------*/
+
+    void vCriticalProfilerExit( void )
+    {
+        uint64_t ullDuration;
+        CriticalSiteStats_t * pxSite;
+
+        /* Called with interrupts still masked, before they are unmasked. */
+        configASSERT( uxNesting > ( UBaseType_t ) 0U );
+
+        uxNesting--;
+
+        if( uxNesting == ( UBaseType_t ) 0U )
+        {
+            ullDuration = configCRITICAL_PROFILER_TIMESTAMP() - ullOpenTime;
+            pxSite = prvGetSite( pcOpenFile, ulOpenLine );
+
+            pxSite->ulCount++;
+            pxSite->ullTotalTime += ullDuration;
+            pxSite->ulHistogram[ prvGetBucket( ullDuration ) ]++;
+
+            if( ullDuration > pxSite->ullMaxTime )
+            {
+                pxSite->ullMaxTime = ullDuration;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static CriticalSiteStats_t * prvGetSite( const char * pcFile,
+                                             uint32_t ulLine )
+    {
+        CriticalSiteStats_t * pxReturn = &( xSites[ critprofOVERFLOW_SITE ] );
+        UBaseType_t uxSlot;
+        UBaseType_t uxProbes;
+
+        /* The file name is a string literal, so the same call site always
+         * passes the same pointer and the pointer can be hashed rather than
+         * the string. */
+        uxSlot = ( UBaseType_t ) ( ( ( ( portPOINTER_SIZE_TYPE ) pcFile ) ^ ( ( portPOINTER_SIZE_TYPE ) ulLine * ( portPOINTER_SIZE_TYPE ) 2654435761U ) ) % ( portPOINTER_SIZE_TYPE ) configCRITICAL_PROFILER_SITES );
+
+        for( uxProbes = ( UBaseType_t ) 0U; uxProbes < ( UBaseType_t ) configCRITICAL_PROFILER_SITES; uxProbes++ )
+        {
+            if( xSites[ uxSlot ].pcFile == NULL )
+            {
+                /* Not seen before - claim the empty entry. */
+                xSites[ uxSlot ].pcFile = pcFile;
+                xSites[ uxSlot ].ulLine = ulLine;
+                pxReturn = &( xSites[ uxSlot ] );
+                break;
+            }
+            else if( ( xSites[ uxSlot ].pcFile == pcFile ) && ( xSites[ uxSlot ].ulLine == ulLine ) )
+            {
+                pxReturn = &( xSites[ uxSlot ] );
+                break;
+            }
+            else
+            {
+                uxSlot++;
+
+                if( uxSlot == ( UBaseType_t ) configCRITICAL_PROFILER_SITES )
+                {
+                    uxSlot = ( UBaseType_t ) 0U;
+                }
+            }
+        }
+
+        return pxReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static UBaseType_t prvGetBucket( uint64_t ullDuration )
+    {
+        UBaseType_t uxBucket = ( UBaseType_t ) 0U;
+
+        while( ( ullDuration != 0U ) && ( uxBucket < ( ( UBaseType_t ) configCRITICAL_PROFILER_BUCKETS - 1U ) ) )
+        {
+            ullDuration >>= 1;
+            uxBucket++;
+        }
+
+        return uxBucket;
+    }
+/*-----------------------------------------------------------*/
+
+    UBaseType_t uxCriticalProfilerGetSiteStats( CriticalSiteStats_t * const pxSiteStatsArray,
+                                                const UBaseType_t uxArraySize )
+    {
+        UBaseType_t uxSite;
+        UBaseType_t uxReturn = ( UBaseType_t ) 0U;
+
+        configASSERT( ( pxSiteStatsArray != NULL ) || ( uxArraySize == ( UBaseType_t ) 0U ) );
+
+        /* portENTER_CRITICAL() rather than taskENTER_CRITICAL(), so that copying
+         * the figures is not itself measured. */
+        portENTER_CRITICAL();
+        {
+            for( uxSite = ( UBaseType_t ) 0U; ( uxSite <= critprofOVERFLOW_SITE ) && ( uxReturn < uxArraySize ); uxSite++ )
+            {
+                if( xSites[ uxSite ].ulCount != 0U )
+                {
+                    pxSiteStatsArray[ uxReturn ] = xSites[ uxSite ];
+                    uxReturn++;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+        portEXIT_CRITICAL();
+
+        return uxReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    void vCriticalProfilerReset( void )
+    {
+        portENTER_CRITICAL();
+        {
+            ( void ) memset( xSites, 0x00, sizeof( xSites ) );
+        }
+        portEXIT_CRITICAL();
+    }
+/*-----------------------------------------------------------*/
+
+/* This entire source file will be skipped if the application is not configured
+ * to include the critical section profiler.  If you want to include the
+ * profiler then ensure configUSE_CRITICAL_PROFILER is set to 1 in
+ * FreeRTOSConfig.h. */
+#endif /* configUSE_CRITICAL_PROFILER == 1 */
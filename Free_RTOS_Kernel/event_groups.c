@@ -63,8 +63,62 @@
         #if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
             uint8_t ucStaticallyAllocated; /**< Set to pdTRUE if the event group is statically allocated to ensure no attempt is made to free the memory. */
         #endif
+
+        #if ( configUSE_INDEXED_EVENT_GROUPS == 1 )
+            List_t * pxBitWaitLists; /**< Array of eventINDEXED_BIT_COUNT lists, one per event bit, holding the tasks waiting on that bit alone.  NULL if the event group is not indexed. */
+        #endif
+
+        #if ( configUSE_DIRECT_EVENT_GROUPS == 1 )
+            uint8_t ucDirectFromISR; /**< Set to pdTRUE if interrupts unblock waiting tasks directly, in which case tasks access xTasksWaitingForBits from a critical section. */
+        #endif
     } EventGroup_t;
 
+    #if ( configUSE_INDEXED_EVENT_GROUPS == 1 )
+
+/* The number of event bits available to the application, and therefore the
+ * number of per-bit wait lists an indexed event group has. */
+        #define eventINDEXED_BIT_COUNT    ( ( ( UBaseType_t ) sizeof( EventBits_t ) * ( UBaseType_t ) 8U ) - ( UBaseType_t ) 8U )
+
+    #endif
+
+    #if ( configUSE_DIRECT_EVENT_GROUPS == 1 )
+
+/*
+ * Interrupts walk and modify the wait list of an event group created by
+ * xEventGroupCreateDirect(), so suspending the scheduler is not enough to
+ * protect it.  Tasks instead hold a critical section while they read the event
+ * bits and access the wait list of such an event group.  The number of waiting
+ * tasks is bounded by configDIRECT_EVENT_GROUP_MAX_WAITERS, which bounds the
+ * time spent in the critical section.
+ */
+        #define prvLockWaitList( pxEventBits )                      \
+    do {                                                            \
+        if( ( pxEventBits )->ucDirectFromISR != pdFALSE )           \
+        {                                                           \
+            taskENTER_CRITICAL();                                   \
+        }                                                           \
+    } while( 0 )
+
+        #define prvUnlockWaitList( pxEventBits )                    \
+    do {                                                            \
+        if( ( pxEventBits )->ucDirectFromISR != pdFALSE )           \
+        {                                                           \
+            taskEXIT_CRITICAL();                                    \
+        }                                                           \
+    } while( 0 )
+
+        #define prvAssertWaiterLimit( pxEventBits )                 \
+    configASSERT( ( ( pxEventBits )->ucDirectFromISR == pdFALSE ) || \
+                  ( listCURRENT_LIST_LENGTH( &( ( pxEventBits )->xTasksWaitingForBits ) ) < ( UBaseType_t ) configDIRECT_EVENT_GROUP_MAX_WAITERS ) )
+
+    #else /* configUSE_DIRECT_EVENT_GROUPS */
+
+        #define prvLockWaitList( pxEventBits )
+        #define prvUnlockWaitList( pxEventBits )
+        #define prvAssertWaiterLimit( pxEventBits )
+
+    #endif /* configUSE_DIRECT_EVENT_GROUPS */
+
 /*-----------------------------------------------------------*/
 
 /*
@@ -79,6 +133,41 @@
                                             const EventBits_t uxBitsToWaitFor,
                                             const BaseType_t xWaitForAllBits ) PRIVILEGED_FUNCTION;
 
+/*
+ * Unblock the tasks in pxList whose wait condition is met by the event group's
+ * current bits.  Returns the bits that must be cleared because a task that was
+ * unblocked asked for its bits to be cleared on exit.  Must be called with the
+ * scheduler suspended, or from a critical section within an interrupt if
+ * pxHigherPriorityTaskWoken is not NULL.
+ */
+    static EventBits_t prvUnblockMatchingWaiters( EventGroup_t * pxEventBits,
+                                                  const List_t * pxList,
+                                                  BaseType_t * pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/*
+ * Unblock every task in pxList, as when the event group is deleted.  Must be
+ * called with the scheduler suspended.
+ */
+    static void prvUnblockAllWaiters( const List_t * pxList ) PRIVILEGED_FUNCTION;
+
+    #if ( configUSE_INDEXED_EVENT_GROUPS == 1 )
+
+/*
+ * Returns the list a task waiting for uxBitsToWaitFor is placed on.  In an
+ * indexed event group a task waiting for a single bit is placed on that bit's
+ * list, so setting a bit only has to look at the tasks that care about it.
+ * Tasks waiting for more than one bit, and all tasks in an event group that is
+ * not indexed, are placed on xTasksWaitingForBits.
+ */
+        static List_t * prvGetWaitList( EventGroup_t * pxEventBits,
+                                        const EventBits_t uxBitsToWaitFor ) PRIVILEGED_FUNCTION;
+
+    #else
+
+        #define prvGetWaitList( pxEventBits, uxBitsToWaitFor )    ( &( ( pxEventBits )->xTasksWaitingForBits ) )
+
+    #endif /* configUSE_INDEXED_EVENT_GROUPS */
+
 /*-----------------------------------------------------------*/
 
     #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
@@ -113,6 +202,18 @@
                 pxEventBits->uxEventBits = 0;
                 vListInitialise( &( pxEventBits->xTasksWaitingForBits ) );
 
+                #if ( configUSE_INDEXED_EVENT_GROUPS == 1 )
+                {
+                    pxEventBits->pxBitWaitLists = NULL;
+                }
+                #endif
+
+                #if ( configUSE_DIRECT_EVENT_GROUPS == 1 )
+                {
+                    pxEventBits->ucDirectFromISR = pdFALSE;
+                }
+                #endif
+
                 #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
                 {
                     /* Both static and dynamic allocation can be used, so note that
@@ -151,13 +252,25 @@
             /* MISRA Ref 11.5.1 [Malloc memory assignment] */
             /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
             /* coverity[misra_c_2012_rule_11_5_violation] */
-            pxEventBits = ( EventGroup_t * ) pvPortMalloc( sizeof( EventGroup_t ) );
+            pxEventBits = ( EventGroup_t * ) pvPortMallocObject( sizeof( EventGroup_t ) );
 
             if( pxEventBits != NULL )
             {
                 pxEventBits->uxEventBits = 0;
                 vListInitialise( &( pxEventBits->xTasksWaitingForBits ) );
 
+                #if ( configUSE_INDEXED_EVENT_GROUPS == 1 )
+                {
+                    pxEventBits->pxBitWaitLists = NULL;
+                }
+                #endif
+
+                #if ( configUSE_DIRECT_EVENT_GROUPS == 1 )
+                {
+                    pxEventBits->ucDirectFromISR = pdFALSE;
+                }
+                #endif
+
                 #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
                 {
                     /* Both static and dynamic allocation can be used, so note this
@@ -182,6 +295,118 @@
     #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
 /*-----------------------------------------------------------*/
 
+    #if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configUSE_INDEXED_EVENT_GROUPS == 1 ) )
+
+        EventGroupHandle_t xEventGroupCreateIndexed( void )
+        {
+            EventGroup_t * pxEventBits;
+            UBaseType_t uxBit;
+
+            traceENTER_xEventGroupCreateIndexed();
+
+            /* The per-bit lists are allocated in the same block as the event
+             * group structure, immediately after it. */
+            /* MISRA Ref 11.5.1 [Malloc memory assignment] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+            /* coverity[misra_c_2012_rule_11_5_violation] */
+            pxEventBits = ( EventGroup_t * ) pvPortMallocObject( sizeof( EventGroup_t ) + ( ( size_t ) eventINDEXED_BIT_COUNT * sizeof( List_t ) ) );
+
+            if( pxEventBits != NULL )
+            {
+                pxEventBits->uxEventBits = 0;
+                vListInitialise( &( pxEventBits->xTasksWaitingForBits ) );
+
+                /* MISRA Ref 11.3.1 [Misaligned access] */
+                /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-113 */
+                /* coverity[misra_c_2012_rule_11_3_violation] */
+                pxEventBits->pxBitWaitLists = ( List_t * ) &( pxEventBits[ 1 ] );
+
+                for( uxBit = ( UBaseType_t ) 0U; uxBit < eventINDEXED_BIT_COUNT; uxBit++ )
+                {
+                    vListInitialise( &( pxEventBits->pxBitWaitLists[ uxBit ] ) );
+                }
+
+                #if ( configUSE_DIRECT_EVENT_GROUPS == 1 )
+                {
+                    pxEventBits->ucDirectFromISR = pdFALSE;
+                }
+                #endif
+
+                #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+                {
+                    pxEventBits->ucStaticallyAllocated = pdFALSE;
+                }
+                #endif /* configSUPPORT_STATIC_ALLOCATION */
+
+                traceEVENT_GROUP_CREATE( pxEventBits );
+            }
+            else
+            {
+                traceEVENT_GROUP_CREATE_FAILED();
+            }
+
+            traceRETURN_xEventGroupCreateIndexed( pxEventBits );
+
+            return pxEventBits;
+        }
+
+    #endif /* ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configUSE_INDEXED_EVENT_GROUPS == 1 ) */
+/*-----------------------------------------------------------*/
+
+    #if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configUSE_DIRECT_EVENT_GROUPS == 1 ) )
+
+        EventGroupHandle_t xEventGroupCreateDirect( void )
+        {
+            EventGroup_t * pxEventBits;
+
+            traceENTER_xEventGroupCreateDirect();
+
+            pxEventBits = xEventGroupCreate();
+
+            if( pxEventBits != NULL )
+            {
+                pxEventBits->ucDirectFromISR = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            traceRETURN_xEventGroupCreateDirect( pxEventBits );
+
+            return pxEventBits;
+        }
+
+    #endif /* ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configUSE_DIRECT_EVENT_GROUPS == 1 ) */
+/*-----------------------------------------------------------*/
+
+    #if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configUSE_DIRECT_EVENT_GROUPS == 1 ) )
+
+        EventGroupHandle_t xEventGroupCreateDirectStatic( StaticEventGroup_t * pxEventGroupBuffer )
+        {
+            EventGroup_t * pxEventBits;
+
+            traceENTER_xEventGroupCreateDirectStatic( pxEventGroupBuffer );
+
+            pxEventBits = xEventGroupCreateStatic( pxEventGroupBuffer );
+
+            if( pxEventBits != NULL )
+            {
+                pxEventBits->ucDirectFromISR = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            traceRETURN_xEventGroupCreateDirectStatic( pxEventBits );
+
+            return pxEventBits;
+        }
+
+    #endif /* ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configUSE_DIRECT_EVENT_GROUPS == 1 ) */
+/*-----------------------------------------------------------*/
+
     EventBits_t xEventGroupSync( EventGroupHandle_t xEventGroup,
                                  const EventBits_t uxBitsToSet,
                                  const EventBits_t uxBitsToWaitFor,
@@ -208,6 +433,23 @@
 
             ( void ) xEventGroupSetBits( xEventGroup, uxBitsToSet );
 
+            prvLockWaitList( pxEventBits );
+
+            #if ( configUSE_DIRECT_EVENT_GROUPS == 1 )
+            {
+                /* An interrupt may have set more bits since xEventGroupSetBits()
+                 * returned, and will not set them again for this task. */
+                if( pxEventBits->ucDirectFromISR != pdFALSE )
+                {
+                    uxOriginalBitValue |= pxEventBits->uxEventBits;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif /* configUSE_DIRECT_EVENT_GROUPS */
+
             if( ( ( uxOriginalBitValue | uxBitsToSet ) & uxBitsToWaitFor ) == uxBitsToWaitFor )
             {
                 /* All the rendezvous bits are now set - no need to block. */
@@ -225,10 +467,12 @@
                 {
                     traceEVENT_GROUP_SYNC_BLOCK( xEventGroup, uxBitsToSet, uxBitsToWaitFor );
 
+                    prvAssertWaiterLimit( pxEventBits );
+
                     /* Store the bits that the calling task is waiting for in the
                      * task's event list item so the kernel knows when a match is
                      * found.  Then enter the blocked state. */
-                    vTaskPlaceOnUnorderedEventList( &( pxEventBits->xTasksWaitingForBits ), ( uxBitsToWaitFor | eventCLEAR_EVENTS_ON_EXIT_BIT | eventWAIT_FOR_ALL_BITS ), xTicksToWait );
+                    vTaskPlaceOnUnorderedEventList( prvGetWaitList( pxEventBits, uxBitsToWaitFor ), ( uxBitsToWaitFor | eventCLEAR_EVENTS_ON_EXIT_BIT | eventWAIT_FOR_ALL_BITS ), xTicksToWait );
 
                     /* This assignment is obsolete as uxReturn will get set after
                      * the task unblocks, but some compilers mistakenly generate a
@@ -244,6 +488,8 @@
                     xTimeoutOccurred = pdTRUE;
                 }
             }
+
+            prvUnlockWaitList( pxEventBits );
         }
         xAlreadyYielded = xTaskResumeAll();
 
@@ -334,6 +580,7 @@
         #endif
 
         vTaskSuspendAll();
+        prvLockWaitList( pxEventBits );
         {
             const EventBits_t uxCurrentEventBits = pxEventBits->uxEventBits;
 
@@ -388,10 +635,12 @@
                     mtCOVERAGE_TEST_MARKER();
                 }
 
+                prvAssertWaiterLimit( pxEventBits );
+
                 /* Store the bits that the calling task is waiting for in the
                  * task's event list item so the kernel knows when a match is
                  * found.  Then enter the blocked state. */
-                vTaskPlaceOnUnorderedEventList( &( pxEventBits->xTasksWaitingForBits ), ( uxBitsToWaitFor | uxControlBits ), xTicksToWait );
+                vTaskPlaceOnUnorderedEventList( prvGetWaitList( pxEventBits, uxBitsToWaitFor ), ( uxBitsToWaitFor | uxControlBits ), xTicksToWait );
 
                 /* This is obsolete as it will get set after the task unblocks, but
                  * some compilers mistakenly generate a warning about the variable
@@ -401,6 +650,7 @@
                 traceEVENT_GROUP_WAIT_BITS_BLOCK( xEventGroup, uxBitsToWaitFor );
             }
         }
+        prvUnlockWaitList( pxEventBits );
         xAlreadyYielded = xTaskResumeAll();
 
         if( xTicksToWait != ( TickType_t ) 0 )
@@ -547,13 +797,8 @@
     EventBits_t xEventGroupSetBits( EventGroupHandle_t xEventGroup,
                                     const EventBits_t uxBitsToSet )
     {
-        ListItem_t * pxListItem;
-        ListItem_t * pxNext;
-        ListItem_t const * pxListEnd;
-        List_t const * pxList;
-        EventBits_t uxBitsToClear = 0, uxBitsWaitedFor, uxControlBits, uxReturnBits;
+        EventBits_t uxBitsToClear, uxReturnBits;
         EventGroup_t * pxEventBits = xEventGroup;
-        BaseType_t xMatchFound = pdFALSE;
 
         traceENTER_xEventGroupSetBits( xEventGroup, uxBitsToSet );
 
@@ -562,75 +807,51 @@
         configASSERT( xEventGroup );
         configASSERT( ( uxBitsToSet & eventEVENT_BITS_CONTROL_BYTES ) == 0 );
 
-        pxList = &( pxEventBits->xTasksWaitingForBits );
-        pxListEnd = listGET_END_MARKER( pxList );
         vTaskSuspendAll();
+        prvLockWaitList( pxEventBits );
         {
             traceEVENT_GROUP_SET_BITS( xEventGroup, uxBitsToSet );
 
-            pxListItem = listGET_HEAD_ENTRY( pxList );
-
             /* Set the bits. */
             pxEventBits->uxEventBits |= uxBitsToSet;
 
             /* See if the new bit value should unblock any tasks. */
-            while( pxListItem != pxListEnd )
-            {
-                pxNext = listGET_NEXT( pxListItem );
-                uxBitsWaitedFor = listGET_LIST_ITEM_VALUE( pxListItem );
-                xMatchFound = pdFALSE;
+            uxBitsToClear = prvUnblockMatchingWaiters( pxEventBits, &( pxEventBits->xTasksWaitingForBits ), NULL );
 
-                /* Split the bits waited for from the control bits. */
-                uxControlBits = uxBitsWaitedFor & eventEVENT_BITS_CONTROL_BYTES;
-                uxBitsWaitedFor &= ~eventEVENT_BITS_CONTROL_BYTES;
+            #if ( configUSE_INDEXED_EVENT_GROUPS == 1 )
+            {
+                EventBits_t uxBits;
+                UBaseType_t uxBit;
 
-                if( ( uxControlBits & eventWAIT_FOR_ALL_BITS ) == ( EventBits_t ) 0 )
+                if( pxEventBits->pxBitWaitLists != NULL )
                 {
-                    /* Just looking for single bit being set. */
-                    if( ( uxBitsWaitedFor & pxEventBits->uxEventBits ) != ( EventBits_t ) 0 )
-                    {
-                        xMatchFound = pdTRUE;
-                    }
-                    else
+                    /* Only the lists of the bits being set can hold tasks whose
+                     * wait condition is now met.  A task on a per-bit list only
+                     * blocked while its bit was clear, so the lists of bits that
+                     * were already set are empty. */
+                    uxBits = uxBitsToSet;
+
+                    for( uxBit = ( UBaseType_t ) 0U; uxBits != ( EventBits_t ) 0; uxBit++ )
                     {
-                        mtCOVERAGE_TEST_MARKER();
+                        if( ( ( uxBits & ( EventBits_t ) 1U ) != ( EventBits_t ) 0 ) &&
+                            ( listLIST_IS_EMPTY( &( pxEventBits->pxBitWaitLists[ uxBit ] ) ) == pdFALSE ) )
+                        {
+                            uxBitsToClear |= prvUnblockMatchingWaiters( pxEventBits, &( pxEventBits->pxBitWaitLists[ uxBit ] ), NULL );
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+
+                        uxBits >>= 1;
                     }
                 }
-                else if( ( uxBitsWaitedFor & pxEventBits->uxEventBits ) == uxBitsWaitedFor )
-                {
-                    /* All bits are set. */
-                    xMatchFound = pdTRUE;
-                }
                 else
                 {
-                    /* Need all bits to be set, but not all the bits were set. */
-                }
-
-                if( xMatchFound != pdFALSE )
-                {
-                    /* The bits match.  Should the bits be cleared on exit? */
-                    if( ( uxControlBits & eventCLEAR_EVENTS_ON_EXIT_BIT ) != ( EventBits_t ) 0 )
-                    {
-                        uxBitsToClear |= uxBitsWaitedFor;
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
-
-                    /* Store the actual event flag value in the task's event list
-                     * item before removing the task from the event list.  The
-                     * eventUNBLOCKED_DUE_TO_BIT_SET bit is set so the task knows
-                     * that is was unblocked due to its required bits matching, rather
-                     * than because it timed out. */
-                    vTaskRemoveFromUnorderedEventList( pxListItem, pxEventBits->uxEventBits | eventUNBLOCKED_DUE_TO_BIT_SET );
+                    mtCOVERAGE_TEST_MARKER();
                 }
-
-                /* Move onto the next list item.  Note pxListItem->pxNext is not
-                 * used here as the list item may have been removed from the event list
-                 * and inserted into the ready/pending reading list. */
-                pxListItem = pxNext;
             }
+            #endif /* configUSE_INDEXED_EVENT_GROUPS */
 
             /* Clear any bits that matched when the eventCLEAR_EVENTS_ON_EXIT_BIT
              * bit was set in the control word. */
@@ -639,6 +860,7 @@
             /* Snapshot resulting bits. */
             uxReturnBits = pxEventBits->uxEventBits;
         }
+        prvUnlockWaitList( pxEventBits );
         ( void ) xTaskResumeAll();
 
         traceRETURN_xEventGroupSetBits( uxReturnBits );
@@ -662,13 +884,27 @@
         {
             traceEVENT_GROUP_DELETE( xEventGroup );
 
-            while( listCURRENT_LIST_LENGTH( pxTasksWaitingForBits ) > ( UBaseType_t ) 0 )
+            prvLockWaitList( pxEventBits );
+            prvUnblockAllWaiters( pxTasksWaitingForBits );
+            prvUnlockWaitList( pxEventBits );
+
+            #if ( configUSE_INDEXED_EVENT_GROUPS == 1 )
             {
-                /* Unblock the task, returning 0 as the event list is being deleted
-                 * and cannot therefore have any bits set. */
-                configASSERT( pxTasksWaitingForBits->xListEnd.pxNext != ( const ListItem_t * ) &( pxTasksWaitingForBits->xListEnd ) );
-                vTaskRemoveFromUnorderedEventList( pxTasksWaitingForBits->xListEnd.pxNext, eventUNBLOCKED_DUE_TO_BIT_SET );
+                UBaseType_t uxBit;
+
+                if( pxEventBits->pxBitWaitLists != NULL )
+                {
+                    for( uxBit = ( UBaseType_t ) 0U; uxBit < eventINDEXED_BIT_COUNT; uxBit++ )
+                    {
+                        prvUnblockAllWaiters( &( pxEventBits->pxBitWaitLists[ uxBit ] ) );
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
             }
+            #endif /* configUSE_INDEXED_EVENT_GROUPS */
         }
         ( void ) xTaskResumeAll();
 
@@ -676,7 +912,7 @@
         {
             /* The event group can only have been allocated dynamically - free
              * it again. */
-            vPortFree( pxEventBits );
+            vPortFreeObject( pxEventBits );
         }
         #elif ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
         {
@@ -684,7 +920,7 @@
              * dynamically, so check before attempting to free the memory. */
             if( pxEventBits->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
             {
-                vPortFree( pxEventBits );
+                vPortFreeObject( pxEventBits );
             }
             else
             {
@@ -775,6 +1011,149 @@
     }
 /*-----------------------------------------------------------*/
 
+    static EventBits_t prvUnblockMatchingWaiters( EventGroup_t * pxEventBits,
+                                                  const List_t * pxList,
+                                                  BaseType_t * pxHigherPriorityTaskWoken )
+    {
+        ListItem_t * pxListItem;
+        ListItem_t * pxNext;
+        ListItem_t const * pxListEnd;
+        EventBits_t uxBitsToClear = 0, uxBitsWaitedFor, uxControlBits;
+        BaseType_t xMatchFound;
+
+        pxListEnd = listGET_END_MARKER( pxList );
+        pxListItem = listGET_HEAD_ENTRY( pxList );
+
+        while( pxListItem != pxListEnd )
+        {
+            pxNext = listGET_NEXT( pxListItem );
+            uxBitsWaitedFor = listGET_LIST_ITEM_VALUE( pxListItem );
+            xMatchFound = pdFALSE;
+
+            /* Split the bits waited for from the control bits. */
+            uxControlBits = uxBitsWaitedFor & eventEVENT_BITS_CONTROL_BYTES;
+            uxBitsWaitedFor &= ~eventEVENT_BITS_CONTROL_BYTES;
+
+            if( ( uxControlBits & eventWAIT_FOR_ALL_BITS ) == ( EventBits_t ) 0 )
+            {
+                /* Just looking for single bit being set. */
+                if( ( uxBitsWaitedFor & pxEventBits->uxEventBits ) != ( EventBits_t ) 0 )
+                {
+                    xMatchFound = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else if( ( uxBitsWaitedFor & pxEventBits->uxEventBits ) == uxBitsWaitedFor )
+            {
+                /* All bits are set. */
+                xMatchFound = pdTRUE;
+            }
+            else
+            {
+                /* Need all bits to be set, but not all the bits were set. */
+            }
+
+            if( xMatchFound != pdFALSE )
+            {
+                /* The bits match.  Should the bits be cleared on exit? */
+                if( ( uxControlBits & eventCLEAR_EVENTS_ON_EXIT_BIT ) != ( EventBits_t ) 0 )
+                {
+                    uxBitsToClear |= uxBitsWaitedFor;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                /* Store the actual event flag value in the task's event list
+                 * item before removing the task from the event list.  The
+                 * eventUNBLOCKED_DUE_TO_BIT_SET bit is set so the task knows
+                 * that is was unblocked due to its required bits matching, rather
+                 * than because it timed out. */
+                #if ( configUSE_DIRECT_EVENT_GROUPS == 1 )
+                {
+                    if( pxHigherPriorityTaskWoken != NULL )
+                    {
+                        if( xTaskRemoveFromUnorderedEventListFromISR( pxListItem, pxEventBits->uxEventBits | eventUNBLOCKED_DUE_TO_BIT_SET ) != pdFALSE )
+                        {
+                            *pxHigherPriorityTaskWoken = pdTRUE;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else
+                    {
+                        vTaskRemoveFromUnorderedEventList( pxListItem, pxEventBits->uxEventBits | eventUNBLOCKED_DUE_TO_BIT_SET );
+                    }
+                }
+                #else /* configUSE_DIRECT_EVENT_GROUPS */
+                {
+                    ( void ) pxHigherPriorityTaskWoken;
+                    vTaskRemoveFromUnorderedEventList( pxListItem, pxEventBits->uxEventBits | eventUNBLOCKED_DUE_TO_BIT_SET );
+                }
+                #endif /* configUSE_DIRECT_EVENT_GROUPS */
+            }
+
+            /* Move onto the next list item.  Note pxListItem->pxNext is not
+             * used here as the list item may have been removed from the event list
+             * and inserted into the ready/pending reading list. */
+            pxListItem = pxNext;
+        }
+
+        return uxBitsToClear;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvUnblockAllWaiters( const List_t * pxList )
+    {
+        while( listCURRENT_LIST_LENGTH( pxList ) > ( UBaseType_t ) 0 )
+        {
+            /* Unblock the task, returning 0 as the event list is being deleted
+             * and cannot therefore have any bits set. */
+            configASSERT( pxList->xListEnd.pxNext != ( const ListItem_t * ) &( pxList->xListEnd ) );
+            vTaskRemoveFromUnorderedEventList( pxList->xListEnd.pxNext, eventUNBLOCKED_DUE_TO_BIT_SET );
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_INDEXED_EVENT_GROUPS == 1 )
+
+        static List_t * prvGetWaitList( EventGroup_t * pxEventBits,
+                                        const EventBits_t uxBitsToWaitFor )
+        {
+            List_t * pxReturn = &( pxEventBits->xTasksWaitingForBits );
+            EventBits_t uxBits = uxBitsToWaitFor;
+            UBaseType_t uxBit = 0;
+
+            /* Only a wait for exactly one bit, for which "any" and "all" are the
+             * same condition, can use a per-bit list. */
+            if( ( pxEventBits->pxBitWaitLists != NULL ) &&
+                ( ( uxBitsToWaitFor & ( uxBitsToWaitFor - ( EventBits_t ) 1U ) ) == ( EventBits_t ) 0 ) )
+            {
+                while( uxBits > ( EventBits_t ) 1U )
+                {
+                    uxBits >>= 1;
+                    uxBit++;
+                }
+
+                pxReturn = &( pxEventBits->pxBitWaitLists[ uxBit ] );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            return pxReturn;
+        }
+
+    #endif /* configUSE_INDEXED_EVENT_GROUPS */
+/*-----------------------------------------------------------*/
+
     static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits,
                                             const EventBits_t uxBitsToWaitFor,
                                             const BaseType_t xWaitForAllBits )
@@ -833,6 +1212,76 @@
     #endif /* if ( ( configUSE_TRACE_FACILITY == 1 ) && ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) ) */
 /*-----------------------------------------------------------*/
 
+    #if ( configUSE_DIRECT_EVENT_GROUPS == 1 )
+
+        EventBits_t xEventGroupSetBitsDirectFromISR( EventGroupHandle_t xEventGroup,
+                                                     const EventBits_t uxBitsToSet,
+                                                     BaseType_t * pxHigherPriorityTaskWoken )
+        {
+            EventGroup_t * pxEventBits = xEventGroup;
+            EventBits_t uxBitsToClear, uxReturnBits;
+            BaseType_t xYieldRequired = pdFALSE;
+            UBaseType_t uxSavedInterruptStatus;
+
+            traceENTER_xEventGroupSetBitsDirectFromISR( xEventGroup, uxBitsToSet, pxHigherPriorityTaskWoken );
+
+            configASSERT( xEventGroup );
+            configASSERT( ( uxBitsToSet & eventEVENT_BITS_CONTROL_BYTES ) == 0 );
+
+            /* Only event groups created with xEventGroupCreateDirect() or
+             * xEventGroupCreateDirectStatic() protect their wait list from
+             * interrupts. */
+            configASSERT( pxEventBits->ucDirectFromISR != pdFALSE );
+
+            /* RTOS ports that support interrupt nesting have the concept of a
+             * maximum system call (or maximum API call) interrupt priority.
+             * Interrupts that are above the maximum system call priority are keep
+             * permanently enabled, even when the RTOS kernel is in a critical section,
+             * but cannot make any calls to FreeRTOS API functions.  If configASSERT()
+             * is defined in FreeRTOSConfig.h then
+             * portASSERT_IF_INTERRUPT_PRIORITY_INVALID() will result in an assertion
+             * failure if a FreeRTOS API function is called from an interrupt that has
+             * been assigned a priority above the configured maximum system call
+             * priority. */
+            portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+            /* MISRA Ref 4.7.1 [Return value shall be checked] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#dir-47 */
+            /* coverity[misra_c_2012_directive_4_7_violation] */
+            uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+            {
+                traceEVENT_GROUP_SET_BITS_FROM_ISR( xEventGroup, uxBitsToSet );
+
+                /* Set the bits and unblock the waiting tasks here, rather than
+                 * deferring the work to the timer service task, so a task waiting
+                 * on the bits runs as soon as the interrupt exits. */
+                pxEventBits->uxEventBits |= uxBitsToSet;
+
+                uxBitsToClear = prvUnblockMatchingWaiters( pxEventBits, &( pxEventBits->xTasksWaitingForBits ), &xYieldRequired );
+
+                pxEventBits->uxEventBits &= ~uxBitsToClear;
+
+                uxReturnBits = pxEventBits->uxEventBits;
+            }
+            taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+            if( ( xYieldRequired != pdFALSE ) && ( pxHigherPriorityTaskWoken != NULL ) )
+            {
+                *pxHigherPriorityTaskWoken = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            traceRETURN_xEventGroupSetBitsDirectFromISR( uxReturnBits );
+
+            return uxReturnBits;
+        }
+
+    #endif /* configUSE_DIRECT_EVENT_GROUPS */
+/*-----------------------------------------------------------*/
+
     #if ( configUSE_TRACE_FACILITY == 1 )
 
         UBaseType_t uxEventGroupGetNumber( void * xEventGroup )
@@ -0,0 +1,541 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "atomic.h"
+#include "fast_mutex.h"
+
+/* The MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+ * for the header files above, but not in this file, in order to generate the
+ * correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* This entire source file will be skipped if the application is not configured
+ * to include fast mutexes.  This #if is closed at the very bottom of this
+ * file. */
+#if ( configUSE_FAST_MUTEXES == 1 )
+
+    #if ( configUSE_MUTEXES != 1 )
+        #error configUSE_MUTEXES must be set to 1 to build fast_mutex.c
+    #endif
+
+/* Bits stored in the ucFlags member of the mutex structure. */
+    #define fastmutexFLAGS_IS_STATICALLY_ALLOCATED    ( ( uint8_t ) 1 )
+
+/* Set in the lock word while tasks are, or may be, blocked on the mutex.  Task
+ * handles point to word aligned task control blocks, so bit 0 of a handle is
+ * always clear and is free to use as a flag. */
+    #define fastmutexCONTENDED_BIT                    ( ( portPOINTER_SIZE_TYPE ) 1 )
+
+/* Extract the holder's handle from a lock word. */
+    #define fastmutexGET_HOLDER( pvLockWord )         ( ( TaskHandle_t ) ( ( portPOINTER_SIZE_TYPE ) ( pvLockWord ) & ~fastmutexCONTENDED_BIT ) )
+
+/*
+ * The lock word holds the handle of the task that holds the mutex, or NULL if
+ * the mutex is free.  Taking a free, uncontended mutex is a single compare and
+ * swap from NULL to the taking task's handle, and giving it back is a single
+ * compare and swap from the task's handle back to NULL.
+ *
+ * A task that finds the mutex held sets fastmutexCONTENDED_BIT, which makes
+ * the holder's compare and swap fail when it gives the mutex back, so the
+ * holder falls back to the slow path that unblocks the highest priority
+ * waiting task.  The bit is only set or cleared with the scheduler suspended,
+ * and the uncontended fast paths never succeed while it is set, so the waiting
+ * task list needs no other protection.  The lock word can be fastmutexCONTENDED_BIT
+ * alone, meaning a waiting task has been unblocked but has not yet taken the
+ * mutex.
+ */
+    typedef struct FastMutexDef_t
+    {
+        void * volatile pvLockWord;  /**< Handle of the holding task, plus fastmutexCONTENDED_BIT while tasks are blocked on the mutex.  NULL if the mutex is free and uncontended. */
+        List_t xTasksWaitingToTake;  /**< List of tasks blocked waiting for the mutex.  Stored in priority order.  Only accessed with the scheduler suspended. */
+        uint8_t ucFlags;
+    } FastMutex_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * The part of xFastMutexTake() that is executed when the mutex could not be
+ * taken with a single compare and swap.  Blocks the calling task, with
+ * priority inheritance, until the mutex is taken or xTicksToWait expires.
+ */
+    static BaseType_t prvTakeContended( FastMutex_t * const pxMutex,
+                                        void * const pvCallingTask,
+                                        TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/*
+ * The part of xFastMutexGive() that is executed when tasks are blocked on the
+ * mutex.  Disinherits any priority inherited by the calling task and unblocks
+ * the highest priority waiting task.
+ */
+    static BaseType_t prvGiveContended( FastMutex_t * const pxMutex ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the priority of the highest priority task blocked on the mutex, or
+ * tskIDLE_PRIORITY if no tasks are blocked.  Must be called with the scheduler
+ * suspended.
+ */
+    static UBaseType_t prvGetHighestWaitingPriority( const FastMutex_t * const pxMutex ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called by both the static and dynamic create functions to initialise the
+ * mutex structure.
+ */
+    static void prvInitialiseNewFastMutex( FastMutex_t * const pxMutex,
+                                           uint8_t ucFlags ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+    #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+        FastMutexHandle_t xFastMutexCreate( void )
+        {
+            FastMutex_t * pxMutex;
+
+            traceENTER_xFastMutexCreate();
+
+            /* MISRA Ref 11.5.1 [Malloc memory assignment] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+            /* coverity[misra_c_2012_rule_11_5_violation] */
+            pxMutex = ( FastMutex_t * ) pvPortMallocObject( sizeof( FastMutex_t ) );
+
+            if( pxMutex != NULL )
+            {
+                prvInitialiseNewFastMutex( pxMutex, 0 );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            traceRETURN_xFastMutexCreate( pxMutex );
+
+            return pxMutex;
+        }
+
+    #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+    #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+        FastMutexHandle_t xFastMutexCreateStatic( StaticFastMutex_t * pxStaticMutex )
+        {
+            FastMutex_t * pxMutex = NULL;
+
+            traceENTER_xFastMutexCreateStatic( pxStaticMutex );
+
+            configASSERT( pxStaticMutex );
+
+            #if ( configASSERT_DEFINED == 1 )
+            {
+                /* Sanity check that the size of the structure used to declare a
+                 * variable of type StaticFastMutex_t equals the size of the real
+                 * mutex structure. */
+                volatile size_t xSize = sizeof( StaticFastMutex_t );
+                configASSERT( xSize == sizeof( FastMutex_t ) );
+            }
+            #endif /* configASSERT_DEFINED */
+
+            if( pxStaticMutex != NULL )
+            {
+                /* MISRA Ref 11.3.1 [Misaligned access] */
+                /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-113 */
+                /* coverity[misra_c_2012_rule_11_3_violation] */
+                pxMutex = ( FastMutex_t * ) pxStaticMutex;
+                prvInitialiseNewFastMutex( pxMutex, fastmutexFLAGS_IS_STATICALLY_ALLOCATED );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            traceRETURN_xFastMutexCreateStatic( pxMutex );
+
+            return pxMutex;
+        }
+
+    #endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+    void vFastMutexDelete( FastMutexHandle_t xMutex )
+    {
+        FastMutex_t * pxMutex = xMutex;
+
+        traceENTER_vFastMutexDelete( xMutex );
+
+        configASSERT( pxMutex );
+
+        /* A mutex must not be deleted while it is held or tasks are blocked on
+         * it. */
+        configASSERT( pxMutex->pvLockWord == NULL );
+        configASSERT( listLIST_IS_EMPTY( &( pxMutex->xTasksWaitingToTake ) ) != pdFALSE );
+
+        if( ( pxMutex->ucFlags & fastmutexFLAGS_IS_STATICALLY_ALLOCATED ) == ( uint8_t ) 0 )
+        {
+            #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+            {
+                vPortFreeObject( ( void * ) pxMutex );
+            }
+            #endif
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_vFastMutexDelete();
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xFastMutexTake( FastMutexHandle_t xMutex,
+                               TickType_t xTicksToWait )
+    {
+        FastMutex_t * const pxMutex = xMutex;
+        void * const pvCallingTask = ( void * ) xTaskGetCurrentTaskHandle();
+        BaseType_t xReturn;
+
+        traceENTER_xFastMutexTake( xMutex, xTicksToWait );
+
+        configASSERT( pxMutex );
+
+        /* Fast mutexes are not recursive. */
+        configASSERT( fastmutexGET_HOLDER( pxMutex->pvLockWord ) != ( TaskHandle_t ) pvCallingTask );
+
+        /* Cannot block if the scheduler is suspended. */
+        #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+        {
+            configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+        }
+        #endif
+
+        if( Atomic_CompareAndSwapPointers_p32( &( pxMutex->pvLockWord ), pvCallingTask, NULL ) == ATOMIC_COMPARE_AND_SWAP_SUCCESS )
+        {
+            /* The mutex was free and uncontended. */
+            ( void ) pvTaskIncrementMutexHeldCount();
+            traceFAST_MUTEX_TAKE( xMutex );
+            xReturn = pdPASS;
+        }
+        else
+        {
+            xReturn = prvTakeContended( pxMutex, pvCallingTask, xTicksToWait );
+        }
+
+        traceRETURN_xFastMutexTake( xReturn );
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xFastMutexGive( FastMutexHandle_t xMutex )
+    {
+        FastMutex_t * const pxMutex = xMutex;
+        void * const pvCallingTask = ( void * ) xTaskGetCurrentTaskHandle();
+        BaseType_t xReturn = pdPASS;
+
+        traceENTER_xFastMutexGive( xMutex );
+
+        configASSERT( pxMutex );
+
+        /* Only the holder can give the mutex back. */
+        if( fastmutexGET_HOLDER( pxMutex->pvLockWord ) == ( TaskHandle_t ) pvCallingTask )
+        {
+            traceFAST_MUTEX_GIVE( xMutex );
+
+            if( Atomic_CompareAndSwapPointers_p32( &( pxMutex->pvLockWord ), NULL, pvCallingTask ) == ATOMIC_COMPARE_AND_SWAP_SUCCESS )
+            {
+                /* No tasks were waiting for the mutex. */
+                if( xTaskDecrementMutexHeldCount() != pdFALSE )
+                {
+                    taskYIELD_WITHIN_API();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                /* fastmutexCONTENDED_BIT is set. */
+                ( void ) prvGiveContended( pxMutex );
+            }
+        }
+        else
+        {
+            xReturn = pdFAIL;
+        }
+
+        traceRETURN_xFastMutexGive( xReturn );
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    TaskHandle_t xFastMutexGetHolder( FastMutexHandle_t xMutex )
+    {
+        const FastMutex_t * const pxMutex = xMutex;
+        TaskHandle_t xReturn;
+
+        traceENTER_xFastMutexGetHolder( xMutex );
+
+        configASSERT( pxMutex );
+
+        xReturn = fastmutexGET_HOLDER( pxMutex->pvLockWord );
+
+        traceRETURN_xFastMutexGetHolder( xReturn );
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvTakeContended( FastMutex_t * const pxMutex,
+                                        void * const pvCallingTask,
+                                        TickType_t xTicksToWait )
+    {
+        TimeOut_t xTimeOut;
+        void * pvLockWord;
+        void * pvNewLockWord;
+        BaseType_t xReturn = errQUEUE_EMPTY;
+        BaseType_t xInheritanceOccurred = pdFALSE;
+        BaseType_t xTimedOut = pdFALSE;
+        BaseType_t xBlocked;
+
+        vTaskSetTimeOutState( &xTimeOut );
+
+        for( ; ; )
+        {
+            xBlocked = pdFALSE;
+
+            vTaskSuspendAll();
+            {
+                pvLockWord = pxMutex->pvLockWord;
+
+                if( fastmutexGET_HOLDER( pvLockWord ) == NULL )
+                {
+                    /* The mutex is free, either because the holder gave it back
+                     * or because it gave it back and unblocked this task.  Keep
+                     * fastmutexCONTENDED_BIT set if other tasks are still
+                     * blocked on the mutex. */
+                    if( listLIST_IS_EMPTY( &( pxMutex->xTasksWaitingToTake ) ) == pdFALSE )
+                    {
+                        pvNewLockWord = ( void * ) ( ( portPOINTER_SIZE_TYPE ) pvCallingTask | fastmutexCONTENDED_BIT );
+                    }
+                    else
+                    {
+                        pvNewLockWord = pvCallingTask;
+                    }
+
+                    if( Atomic_CompareAndSwapPointers_p32( &( pxMutex->pvLockWord ), pvNewLockWord, pvLockWord ) == ATOMIC_COMPARE_AND_SWAP_SUCCESS )
+                    {
+                        ( void ) pvTaskIncrementMutexHeldCount();
+                        traceFAST_MUTEX_TAKE( pxMutex );
+                        xReturn = pdPASS;
+                    }
+                    else
+                    {
+                        /* Another core took the mutex first - try again. */
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+                {
+                    /* Set fastmutexCONTENDED_BIT so the holder takes the slow
+                     * path when it gives the mutex back.  The compare and swap
+                     * fails if the holder gave the mutex back first, in which
+                     * case the loop tries to take it again. */
+                    pvNewLockWord = ( void * ) ( ( portPOINTER_SIZE_TYPE ) pvLockWord | fastmutexCONTENDED_BIT );
+
+                    if( Atomic_CompareAndSwapPointers_p32( &( pxMutex->pvLockWord ), pvNewLockWord, pvLockWord ) == ATOMIC_COMPARE_AND_SWAP_SUCCESS )
+                    {
+                        taskENTER_CRITICAL();
+                        {
+                            xInheritanceOccurred |= xTaskPriorityInherit( fastmutexGET_HOLDER( pvLockWord ) );
+                        }
+                        taskEXIT_CRITICAL();
+
+                        traceBLOCKING_ON_FAST_MUTEX_TAKE( pxMutex );
+                        vTaskPlaceOnEventList( &( pxMutex->xTasksWaitingToTake ), xTicksToWait );
+                        xBlocked = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    /* Timed out.  This task may have raised the holder's
+                     * priority, in which case the holder's priority must drop
+                     * back to the highest priority of the tasks still waiting,
+                     * or its base priority. */
+                    if( xInheritanceOccurred != pdFALSE )
+                    {
+                        taskENTER_CRITICAL();
+                        {
+                            vTaskPriorityDisinheritAfterTimeout( fastmutexGET_HOLDER( pvLockWord ), prvGetHighestWaitingPriority( pxMutex ) );
+                        }
+                        taskEXIT_CRITICAL();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    /* If this was the last waiting task the holder can use
+                     * the fast path again. */
+                    if( listLIST_IS_EMPTY( &( pxMutex->xTasksWaitingToTake ) ) != pdFALSE )
+                    {
+                        ( void ) Atomic_CompareAndSwapPointers_p32( &( pxMutex->pvLockWord ), fastmutexGET_HOLDER( pvLockWord ), pvLockWord );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    traceFAST_MUTEX_TAKE_FAILED( pxMutex );
+                    xTimedOut = pdTRUE;
+                }
+            }
+
+            if( xTaskResumeAll() == pdFALSE )
+            {
+                if( xBlocked != pdFALSE )
+                {
+                    taskYIELD_WITHIN_API();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            if( ( xReturn == pdPASS ) || ( xTimedOut != pdFALSE ) )
+            {
+                break;
+            }
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvGiveContended( FastMutex_t * const pxMutex )
+    {
+        BaseType_t xYieldRequired;
+
+        vTaskSuspendAll();
+        {
+            taskENTER_CRITICAL();
+            {
+                /* Drop any priority the calling task inherited from the tasks
+                 * blocked on the mutex. */
+                xYieldRequired = xTaskPriorityDisinherit( xTaskGetCurrentTaskHandle() );
+
+                if( listLIST_IS_EMPTY( &( pxMutex->xTasksWaitingToTake ) ) == pdFALSE )
+                {
+                    /* Leave the mutex free but contended.  The unblocked task
+                     * takes it when it runs, unless a higher priority task takes
+                     * it first, in which case the unblocked task blocks again. */
+                    pxMutex->pvLockWord = ( void * ) fastmutexCONTENDED_BIT;
+
+                    if( xTaskRemoveFromEventList( &( pxMutex->xTasksWaitingToTake ) ) != pdFALSE )
+                    {
+                        xYieldRequired = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    /* The waiting tasks timed out before the mutex was given
+                     * back. */
+                    pxMutex->pvLockWord = NULL;
+                }
+            }
+            taskEXIT_CRITICAL();
+        }
+
+        if( ( xTaskResumeAll() == pdFALSE ) && ( xYieldRequired != pdFALSE ) )
+        {
+            taskYIELD_WITHIN_API();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xYieldRequired;
+    }
+/*-----------------------------------------------------------*/
+
+    static UBaseType_t prvGetHighestWaitingPriority( const FastMutex_t * const pxMutex )
+    {
+        UBaseType_t uxHighestPriorityOfWaitingTasks;
+
+        /* The waiting tasks are held in priority order, and the item value of
+         * each task's event list item is configMAX_PRIORITIES minus the task's
+         * priority. */
+        if( listCURRENT_LIST_LENGTH( &( pxMutex->xTasksWaitingToTake ) ) > 0U )
+        {
+            uxHighestPriorityOfWaitingTasks = ( UBaseType_t ) ( ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) listGET_ITEM_VALUE_OF_HEAD_ENTRY( &( pxMutex->xTasksWaitingToTake ) ) );
+        }
+        else
+        {
+            uxHighestPriorityOfWaitingTasks = tskIDLE_PRIORITY;
+        }
+
+        return uxHighestPriorityOfWaitingTasks;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvInitialiseNewFastMutex( FastMutex_t * const pxMutex,
+                                           uint8_t ucFlags )
+    {
+        pxMutex->pvLockWord = NULL;
+        vListInitialise( &( pxMutex->xTasksWaitingToTake ) );
+        pxMutex->ucFlags = ucFlags;
+
+        traceFAST_MUTEX_CREATE( pxMutex );
+    }
+
+/* This entire source file will be skipped if the application is not configured
+ * to include fast mutexes.  If you want to include fast mutexes then ensure
+ * configUSE_FAST_MUTEXES is set to 1 in FreeRTOSConfig.h. */
+#endif /* configUSE_FAST_MUTEXES == 1 */
@@ -0,0 +1,479 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "heap_instrumentation.h"
+
+/* The MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+ * for the header files above, but not in this file, in order to generate the
+ * correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* This entire source file will be skipped if the application is not configured
+ * to include heap instrumentation.  This #if is closed at the very bottom of
+ * this file. */
+#if ( configUSE_HEAP_INSTRUMENTATION == 1 )
+
+    #if ( ( INCLUDE_xTaskGetCurrentTaskHandle != 1 ) && ( configUSE_MUTEXES != 1 ) )
+        #error configUSE_HEAP_INSTRUMENTATION requires INCLUDE_xTaskGetCurrentTaskHandle or configUSE_MUTEXES to be set to 1
+    #endif
+
+    #if ( ( INCLUDE_xTaskGetSchedulerState != 1 ) && ( configUSE_TIMERS != 1 ) )
+        #error configUSE_HEAP_INSTRUMENTATION requires INCLUDE_xTaskGetSchedulerState or configUSE_TIMERS to be set to 1
+    #endif
+
+/* Allocations that cannot be given a tag of their own, because every tag is
+ * held by a call site that still has live blocks, are all counted against this
+ * last entry of the tag table. */
+    #define heapinstOVERFLOW_TAG    ( ( UBaseType_t ) configHEAP_INSTRUMENTATION_TAGS )
+
+/*
+ * One entry of the table of live blocks.  The table is an open addressed hash
+ * table keyed on the block's address, so the tag and size of a block can be
+ * found again when it is freed without adding anything to the heap's own
+ * block headers.
+ */
+    typedef struct HeapInstrumentationBlock
+    {
+        void * pvAddress;  /**< The address pvPortMalloc() returned, or NULL if the entry is empty. */
+        size_t xSize;      /**< The size passed to traceMALLOC() for the block. */
+        UBaseType_t uxTag; /**< Index into xTags[] of the block's tag. */
+    } HeapInstrumentationBlock_t;
+
+/*-----------------------------------------------------------*/
+
+    PRIVILEGED_DATA static HeapTagStats_t xTags[ configHEAP_INSTRUMENTATION_TAGS + 1 ];
+    PRIVILEGED_DATA static HeapInstrumentationBlock_t xBlocks[ configHEAP_INSTRUMENTATION_BLOCKS ];
+
+    PRIVILEGED_DATA static size_t xLiveBytes = ( size_t ) 0U;
+    PRIVILEGED_DATA static size_t xPeakLiveBytes = ( size_t ) 0U;
+    PRIVILEGED_DATA static size_t xFailedAllocations = ( size_t ) 0U;
+    PRIVILEGED_DATA static size_t xUntrackedAllocations = ( size_t ) 0U;
+    PRIVILEGED_DATA static size_t xLastFailedSize = ( size_t ) 0U;
+    PRIVILEGED_DATA static void * pvLastFailedCallSite = NULL;
+
+/* Set by vHeapInstrumentationSetCallSite() while a wrapper around
+ * pvPortMalloc() allocates on behalf of its own caller. */
+    PRIVILEGED_DATA static void * pvCallSiteOverride = NULL;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Returns the index of the tag for allocations made from pvCallSite by
+ * xOwner, claiming a free tag if there is not one already.
+ */
+    static UBaseType_t prvGetTag( void * pvCallSite,
+                                  TaskHandle_t xOwner ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the slot of xBlocks[] at which a search for pvAddress starts.
+ */
+    static UBaseType_t prvHashAddress( const void * pvAddress ) PRIVILEGED_FUNCTION;
+
+/*
+ * Empties slot uxSlot of xBlocks[], moving back any later entries of the same
+ * probe sequence so that searches do not stop early at the gap.
+ */
+    static void prvRemoveBlock( UBaseType_t uxSlot ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+    void vHeapInstrumentationRecordMalloc( void * pvAddress,
+                                           size_t xSize,
+                                           void * pvCallSite )
+    {
+        TaskHandle_t xOwner = NULL;
+        UBaseType_t uxTag;
+        UBaseType_t uxSlot;
+        UBaseType_t uxProbes;
+
+        /* Called from within pvPortMalloc() with the scheduler suspended, so
+         * the tables cannot be accessed by another task at the same time. */
+        if( pvCallSiteOverride != NULL )
+        {
+            pvCallSite = pvCallSiteOverride;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( pvAddress == NULL )
+        {
+            xFailedAllocations++;
+            xLastFailedSize = xSize;
+            pvLastFailedCallSite = pvCallSite;
+        }
+        else
+        {
+            /* pxCurrentTCB is not meaningful until the scheduler has started,
+             * so allocations made before then have no owner. */
+            if( xTaskGetSchedulerState() != taskSCHEDULER_NOT_STARTED )
+            {
+                xOwner = xTaskGetCurrentTaskHandle();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            uxSlot = prvHashAddress( pvAddress );
+
+            for( uxProbes = ( UBaseType_t ) 0U; uxProbes < ( UBaseType_t ) configHEAP_INSTRUMENTATION_BLOCKS; uxProbes++ )
+            {
+                if( xBlocks[ uxSlot ].pvAddress == NULL )
+                {
+                    break;
+                }
+                else
+                {
+                    uxSlot = ( uxSlot + 1U ) % ( UBaseType_t ) configHEAP_INSTRUMENTATION_BLOCKS;
+                }
+            }
+
+            if( uxProbes < ( UBaseType_t ) configHEAP_INSTRUMENTATION_BLOCKS )
+            {
+                uxTag = prvGetTag( pvCallSite, xOwner );
+
+                xBlocks[ uxSlot ].pvAddress = pvAddress;
+                xBlocks[ uxSlot ].xSize = xSize;
+                xBlocks[ uxSlot ].uxTag = uxTag;
+
+                xTags[ uxTag ].xLiveBytes += xSize;
+                ( xTags[ uxTag ].uxLiveBlocks )++;
+                ( xTags[ uxTag ].uxAllocations )++;
+
+                if( xTags[ uxTag ].xLiveBytes > xTags[ uxTag ].xPeakLiveBytes )
+                {
+                    xTags[ uxTag ].xPeakLiveBytes = xTags[ uxTag ].xLiveBytes;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                xLiveBytes += xSize;
+
+                if( xLiveBytes > xPeakLiveBytes )
+                {
+                    xPeakLiveBytes = xLiveBytes;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                /* There are more live blocks than configHEAP_INSTRUMENTATION_BLOCKS.
+                 * The block is not counted anywhere, so it is not subtracted
+                 * when it is freed either. */
+                xUntrackedAllocations++;
+            }
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    void vHeapInstrumentationRecordFree( void * pvAddress )
+    {
+        HeapTagStats_t * pxTag;
+        UBaseType_t uxSlot;
+        UBaseType_t uxProbes;
+
+        if( pvAddress != NULL )
+        {
+            uxSlot = prvHashAddress( pvAddress );
+
+            for( uxProbes = ( UBaseType_t ) 0U; uxProbes < ( UBaseType_t ) configHEAP_INSTRUMENTATION_BLOCKS; uxProbes++ )
+            {
+                if( xBlocks[ uxSlot ].pvAddress == pvAddress )
+                {
+                    pxTag = &( xTags[ xBlocks[ uxSlot ].uxTag ] );
+                    pxTag->xLiveBytes -= xBlocks[ uxSlot ].xSize;
+                    ( pxTag->uxLiveBlocks )--;
+                    xLiveBytes -= xBlocks[ uxSlot ].xSize;
+
+                    prvRemoveBlock( uxSlot );
+                    break;
+                }
+                else if( xBlocks[ uxSlot ].pvAddress == NULL )
+                {
+                    /* Not tracked - see vHeapInstrumentationRecordMalloc(). */
+                    break;
+                }
+                else
+                {
+                    uxSlot = ( uxSlot + 1U ) % ( UBaseType_t ) configHEAP_INSTRUMENTATION_BLOCKS;
+                }
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    void vHeapInstrumentationSetCallSite( void * pvCallSite )
+    {
+        /* Called with the scheduler suspended, so no other task can allocate
+         * while the override is in place. */
+        pvCallSiteOverride = pvCallSite;
+    }
+/*-----------------------------------------------------------*/
+
+    UBaseType_t uxHeapGetTagStats( HeapTagStats_t * const pxTagStatsArray,
+                                   const UBaseType_t uxArraySize )
+    {
+        UBaseType_t uxIndex;
+        UBaseType_t uxCount = ( UBaseType_t ) 0U;
+
+        traceENTER_uxHeapGetTagStats( pxTagStatsArray, uxArraySize );
+
+        configASSERT( pxTagStatsArray );
+
+        vTaskSuspendAll();
+        {
+            for( uxIndex = ( UBaseType_t ) 0U; ( uxIndex <= heapinstOVERFLOW_TAG ) && ( uxCount < uxArraySize ); uxIndex++ )
+            {
+                if( xTags[ uxIndex ].uxAllocations != ( UBaseType_t ) 0U )
+                {
+                    pxTagStatsArray[ uxCount ] = xTags[ uxIndex ];
+                    uxCount++;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+        ( void ) xTaskResumeAll();
+
+        traceRETURN_uxHeapGetTagStats( uxCount );
+
+        return uxCount;
+    }
+/*-----------------------------------------------------------*/
+
+    void vHeapGetSnapshot( HeapSnapshot_t * pxSnapshot )
+    {
+        HeapStats_t xHeapStats;
+        UBaseType_t uxIndex;
+
+        traceENTER_vHeapGetSnapshot( pxSnapshot );
+
+        configASSERT( pxSnapshot );
+
+        /* vPortGetHeapStats() suspends the scheduler itself, so is called
+         * before the instrumentation's own figures are read. */
+        vPortGetHeapStats( &xHeapStats );
+
+        pxSnapshot->xFreeBytes = xHeapStats.xAvailableHeapSpaceInBytes;
+        pxSnapshot->xMinimumEverFreeBytes = xHeapStats.xMinimumEverFreeBytesRemaining;
+        pxSnapshot->xLargestFreeBlock = xHeapStats.xSizeOfLargestFreeBlockInBytes;
+        pxSnapshot->xFreeBlocks = xHeapStats.xNumberOfFreeBlocks;
+
+        /* 0 when all the free space is in one block, approaching 1000 as the
+         * free space is split into more, smaller blocks. */
+        if( xHeapStats.xAvailableHeapSpaceInBytes > ( size_t ) 0U )
+        {
+            pxSnapshot->uxFragmentationIndex = ( UBaseType_t ) ( ( ( uint64_t ) ( xHeapStats.xAvailableHeapSpaceInBytes - xHeapStats.xSizeOfLargestFreeBlockInBytes ) * 1000U ) /
+                                                                 xHeapStats.xAvailableHeapSpaceInBytes );
+        }
+        else
+        {
+            pxSnapshot->uxFragmentationIndex = ( UBaseType_t ) 0U;
+        }
+
+        vTaskSuspendAll();
+        {
+            pxSnapshot->xLiveBytes = xLiveBytes;
+            pxSnapshot->xPeakLiveBytes = xPeakLiveBytes;
+            pxSnapshot->xFailedAllocations = xFailedAllocations;
+            pxSnapshot->xLastFailedSize = xLastFailedSize;
+            pxSnapshot->pvLastFailedCallSite = pvLastFailedCallSite;
+            pxSnapshot->xUntrackedAllocations = xUntrackedAllocations;
+            pxSnapshot->uxTagsInUse = ( UBaseType_t ) 0U;
+
+            for( uxIndex = ( UBaseType_t ) 0U; uxIndex <= heapinstOVERFLOW_TAG; uxIndex++ )
+            {
+                if( xTags[ uxIndex ].uxLiveBlocks != ( UBaseType_t ) 0U )
+                {
+                    ( pxSnapshot->uxTagsInUse )++;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+        ( void ) xTaskResumeAll();
+
+        traceRETURN_vHeapGetSnapshot();
+    }
+/*-----------------------------------------------------------*/
+
+    static UBaseType_t prvGetTag( void * pvCallSite,
+                                  TaskHandle_t xOwner )
+    {
+        UBaseType_t uxIndex;
+        UBaseType_t uxUnused = heapinstOVERFLOW_TAG;
+        UBaseType_t uxIdle = heapinstOVERFLOW_TAG;
+        UBaseType_t uxReturn = heapinstOVERFLOW_TAG;
+
+        for( uxIndex = ( UBaseType_t ) 0U; uxIndex < heapinstOVERFLOW_TAG; uxIndex++ )
+        {
+            if( xTags[ uxIndex ].uxAllocations == ( UBaseType_t ) 0U )
+            {
+                /* Tags are claimed in order, so the rest are unused too. */
+                uxUnused = uxIndex;
+                break;
+            }
+            else if( ( xTags[ uxIndex ].pvCallSite == pvCallSite ) && ( xTags[ uxIndex ].xOwner == xOwner ) )
+            {
+                uxReturn = uxIndex;
+                break;
+            }
+            else if( ( xTags[ uxIndex ].uxLiveBlocks == ( UBaseType_t ) 0U ) && ( uxIdle == heapinstOVERFLOW_TAG ) )
+            {
+                uxIdle = uxIndex;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+        if( uxReturn == heapinstOVERFLOW_TAG )
+        {
+            /* Prefer a tag that has never been used.  Failing that, recycle
+             * one whose blocks have all been freed, losing its history. */
+            if( uxUnused != heapinstOVERFLOW_TAG )
+            {
+                uxReturn = uxUnused;
+            }
+            else
+            {
+                uxReturn = uxIdle;
+            }
+
+            if( uxReturn != heapinstOVERFLOW_TAG )
+            {
+                xTags[ uxReturn ].pvCallSite = pvCallSite;
+                xTags[ uxReturn ].xOwner = xOwner;
+                xTags[ uxReturn ].xLiveBytes = ( size_t ) 0U;
+                xTags[ uxReturn ].xPeakLiveBytes = ( size_t ) 0U;
+                xTags[ uxReturn ].uxLiveBlocks = ( UBaseType_t ) 0U;
+                xTags[ uxReturn ].uxAllocations = ( UBaseType_t ) 0U;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return uxReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static UBaseType_t prvHashAddress( const void * pvAddress )
+    {
+        /* Blocks are aligned to portBYTE_ALIGNMENT, so the low bits carry no
+         * information. */
+        return ( UBaseType_t ) ( ( ( ( portPOINTER_SIZE_TYPE ) pvAddress ) / ( portPOINTER_SIZE_TYPE ) portBYTE_ALIGNMENT ) %
+                                 ( portPOINTER_SIZE_TYPE ) configHEAP_INSTRUMENTATION_BLOCKS );
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvRemoveBlock( UBaseType_t uxSlot )
+    {
+        UBaseType_t uxGap = uxSlot;
+        UBaseType_t uxNext = uxSlot;
+        UBaseType_t uxHome;
+        UBaseType_t uxProbes;
+        BaseType_t xMove;
+
+        /* The walk ends at the first empty slot, or after visiting every
+         * other slot if the table was full. */
+        for( uxProbes = ( UBaseType_t ) 1U; uxProbes < ( UBaseType_t ) configHEAP_INSTRUMENTATION_BLOCKS; uxProbes++ )
+        {
+            uxNext = ( uxNext + 1U ) % ( UBaseType_t ) configHEAP_INSTRUMENTATION_BLOCKS;
+
+            if( xBlocks[ uxNext ].pvAddress == NULL )
+            {
+                break;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            /* An entry can fill the gap if the gap lies on the path from the
+             * entry's home slot to where the entry is now. */
+            uxHome = prvHashAddress( xBlocks[ uxNext ].pvAddress );
+
+            if( uxGap <= uxNext )
+            {
+                xMove = ( ( uxHome <= uxGap ) || ( uxHome > uxNext ) ) ? pdTRUE : pdFALSE;
+            }
+            else
+            {
+                xMove = ( ( uxHome <= uxGap ) && ( uxHome > uxNext ) ) ? pdTRUE : pdFALSE;
+            }
+
+            if( xMove != pdFALSE )
+            {
+                xBlocks[ uxGap ] = xBlocks[ uxNext ];
+                uxGap = uxNext;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+        xBlocks[ uxGap ].pvAddress = NULL;
+    }
+
+/* This entire source file will be skipped if the application is not configured
+ * to include heap instrumentation.  If you want to include heap
+ * instrumentation then ensure configUSE_HEAP_INSTRUMENTATION is set to 1 in
+ * FreeRTOSConfig.h. */
+#endif /* configUSE_HEAP_INSTRUMENTATION == 1 */
@@ -329,6 +329,18 @@
     #define configUSE_EVENT_GROUPS    1
 #endif
 
+#ifndef configUSE_INDEXED_EVENT_GROUPS
+    #define configUSE_INDEXED_EVENT_GROUPS    0
+#endif
+
+#ifndef configUSE_DIRECT_EVENT_GROUPS
+    #define configUSE_DIRECT_EVENT_GROUPS    0
+#endif
+
+#ifndef configDIRECT_EVENT_GROUP_MAX_WAITERS
+    #define configDIRECT_EVENT_GROUP_MAX_WAITERS    8
+#endif
+
 #ifndef configUSE_STREAM_BUFFERS
     #define configUSE_STREAM_BUFFERS    1
 #endif
@@ -599,6 +611,16 @@
     #define portPOINTER_SIZE_TYPE    uint32_t
 #endif
 
+/* The address a function was called from.  Only used by the heap
+ * instrumentation, to attribute allocations to the code that made them. */
+#ifndef portGET_CALLER_ADDRESS
+    #if defined( __GNUC__ )
+        #define portGET_CALLER_ADDRESS()    __builtin_return_address( 0 )
+    #else
+        #define portGET_CALLER_ADDRESS()    NULL
+    #endif
+#endif
+
 /* Remove any unused trace macros. */
 #ifndef traceSTART
 
@@ -702,6 +724,18 @@
     #define configCHECK_FOR_STACK_OVERFLOW    0
 #endif
 
+#ifndef configSTACK_GUARD_WORDS
+    #define configSTACK_GUARD_WORDS    8
+#endif
+
+#ifndef configSTACK_CANARY_SCAN_PERIOD_TICKS
+    #define configSTACK_CANARY_SCAN_PERIOD_TICKS    pdMS_TO_TICKS( 100 )
+#endif
+
+#if ( ( configCHECK_FOR_STACK_OVERFLOW == 3 ) && ( configSTACK_GUARD_WORDS < 1 ) )
+    #error configSTACK_GUARD_WORDS must be at least 1 when configCHECK_FOR_STACK_OVERFLOW is set to 3
+#endif
+
 #ifndef configRECORD_STACK_HIGH_ADDRESS
     #define configRECORD_STACK_HIGH_ADDRESS    0
 #endif
@@ -884,6 +918,20 @@
     #define traceTIMER_COMMAND_RECEIVED( pxTimer, xMessageID, xMessageValue )
 #endif
 
+#if ( configUSE_HEAP_INSTRUMENTATION == 1 )
+
+/* heap_instrumentation.c sees every allocation and free through these two
+ * hooks.  They are called from within pvPortMalloc() and vPortFree() with the
+ * scheduler suspended, so portGET_CALLER_ADDRESS() is the address of the code
+ * that called the heap. */
+    #if defined( traceMALLOC ) || defined( traceFREE )
+        #error configUSE_HEAP_INSTRUMENTATION uses traceMALLOC() and traceFREE(), so they must not also be defined in FreeRTOSConfig.h
+    #endif
+
+    #define traceMALLOC( pvAddress, uiSize )    vHeapInstrumentationRecordMalloc( ( pvAddress ), ( size_t ) ( uiSize ), portGET_CALLER_ADDRESS() )
+    #define traceFREE( pvAddress, uiSize )      vHeapInstrumentationRecordFree( pvAddress )
+#endif
+
 #ifndef traceMALLOC
     #define traceMALLOC( pvAddress, uiSize )
 #endif
@@ -1060,6 +1108,30 @@
     #define traceRETURN_xEventGroupCreate( pxEventBits )
 #endif
 
+#ifndef traceENTER_xEventGroupCreateIndexed
+    #define traceENTER_xEventGroupCreateIndexed()
+#endif
+
+#ifndef traceRETURN_xEventGroupCreateIndexed
+    #define traceRETURN_xEventGroupCreateIndexed( pxEventBits )
+#endif
+
+#ifndef traceENTER_xEventGroupCreateDirect
+    #define traceENTER_xEventGroupCreateDirect()
+#endif
+
+#ifndef traceRETURN_xEventGroupCreateDirect
+    #define traceRETURN_xEventGroupCreateDirect( pxEventBits )
+#endif
+
+#ifndef traceENTER_xEventGroupCreateDirectStatic
+    #define traceENTER_xEventGroupCreateDirectStatic( pxEventGroupBuffer )
+#endif
+
+#ifndef traceRETURN_xEventGroupCreateDirectStatic
+    #define traceRETURN_xEventGroupCreateDirectStatic( pxEventBits )
+#endif
+
 #ifndef traceENTER_xEventGroupSync
     #define traceENTER_xEventGroupSync( xEventGroup, uxBitsToSet, uxBitsToWaitFor, xTicksToWait )
 #endif
@@ -1148,6 +1220,14 @@
     #define traceRETURN_xEventGroupSetBitsFromISR( xReturn )
 #endif
 
+#ifndef traceENTER_xEventGroupSetBitsDirectFromISR
+    #define traceENTER_xEventGroupSetBitsDirectFromISR( xEventGroup, uxBitsToSet, pxHigherPriorityTaskWoken )
+#endif
+
+#ifndef traceRETURN_xEventGroupSetBitsDirectFromISR
+    #define traceRETURN_xEventGroupSetBitsDirectFromISR( uxReturnBits )
+#endif
+
 #ifndef traceENTER_uxEventGroupGetNumber
     #define traceENTER_uxEventGroupGetNumber( xEventGroup )
 #endif
@@ -1212,6 +1292,22 @@
     #define traceRETURN_xQueueCreateMutexStatic( xNewQueue )
 #endif
 
+#ifndef traceENTER_xQueueCreateCeilingMutex
+    #define traceENTER_xQueueCreateCeilingMutex( uxCeilingPriority )
+#endif
+
+#ifndef traceRETURN_xQueueCreateCeilingMutex
+    #define traceRETURN_xQueueCreateCeilingMutex( xNewQueue )
+#endif
+
+#ifndef traceENTER_xQueueCreateCeilingMutexStatic
+    #define traceENTER_xQueueCreateCeilingMutexStatic( uxCeilingPriority, pxStaticQueue )
+#endif
+
+#ifndef traceRETURN_xQueueCreateCeilingMutexStatic
+    #define traceRETURN_xQueueCreateCeilingMutexStatic( xNewQueue )
+#endif
+
 #ifndef traceENTER_xQueueGetMutexHolder
     #define traceENTER_xQueueGetMutexHolder( xSemaphore )
 #endif
@@ -1292,6 +1388,70 @@
     #define traceRETURN_xQueueReceive( xReturn )
 #endif
 
+#ifndef traceENTER_xQueueReserve
+    #define traceENTER_xQueueReserve( xQueue, ppvItem, xTicksToWait )
+#endif
+
+#ifndef traceRETURN_xQueueReserve
+    #define traceRETURN_xQueueReserve( xReturn )
+#endif
+
+#ifndef traceENTER_xQueueCommit
+    #define traceENTER_xQueueCommit( xQueue )
+#endif
+
+#ifndef traceRETURN_xQueueCommit
+    #define traceRETURN_xQueueCommit( xReturn )
+#endif
+
+#ifndef traceENTER_xQueueAcquire
+    #define traceENTER_xQueueAcquire( xQueue, ppvItem, xTicksToWait )
+#endif
+
+#ifndef traceRETURN_xQueueAcquire
+    #define traceRETURN_xQueueAcquire( xReturn )
+#endif
+
+#ifndef traceENTER_xQueueRelease
+    #define traceENTER_xQueueRelease( xQueue )
+#endif
+
+#ifndef traceRETURN_xQueueRelease
+    #define traceRETURN_xQueueRelease( xReturn )
+#endif
+
+#ifndef traceENTER_xQueueSendMultiple
+    #define traceENTER_xQueueSendMultiple( xQueue, pvItems, xItemCount, xTicksToWait )
+#endif
+
+#ifndef traceRETURN_xQueueSendMultiple
+    #define traceRETURN_xQueueSendMultiple( xReturn )
+#endif
+
+#ifndef traceENTER_xQueueSendMultipleFromISR
+    #define traceENTER_xQueueSendMultipleFromISR( xQueue, pvItems, xItemCount, pxHigherPriorityTaskWoken )
+#endif
+
+#ifndef traceRETURN_xQueueSendMultipleFromISR
+    #define traceRETURN_xQueueSendMultipleFromISR( xReturn )
+#endif
+
+#ifndef traceENTER_xQueueReceiveMultiple
+    #define traceENTER_xQueueReceiveMultiple( xQueue, pvBuffer, xMaxItemCount, xTicksToWait )
+#endif
+
+#ifndef traceRETURN_xQueueReceiveMultiple
+    #define traceRETURN_xQueueReceiveMultiple( xReturn )
+#endif
+
+#ifndef traceENTER_xQueueReceiveMultipleFromISR
+    #define traceENTER_xQueueReceiveMultipleFromISR( xQueue, pvBuffer, xMaxItemCount, pxHigherPriorityTaskWoken )
+#endif
+
+#ifndef traceRETURN_xQueueReceiveMultipleFromISR
+    #define traceRETURN_xQueueReceiveMultipleFromISR( xReturn )
+#endif
+
 #ifndef traceENTER_xQueueSemaphoreTake
     #define traceENTER_xQueueSemaphoreTake( xQueue, xTicksToWait )
 #endif
@@ -1748,6 +1908,14 @@
     #define traceRETURN_xTaskCreateAffinitySet( xReturn )
 #endif
 
+#ifndef traceENTER_xTaskCreateInRegion
+    #define traceENTER_xTaskCreateInRegion( pxTaskCode, pcName, uxStackDepth, pvParameters, uxPriority, pxCreatedTask, xStackRegion )
+#endif
+
+#ifndef traceRETURN_xTaskCreateInRegion
+    #define traceRETURN_xTaskCreateInRegion( xReturn )
+#endif
+
 #ifndef traceENTER_vTaskDelete
     #define traceENTER_vTaskDelete( xTaskToDelete )
 #endif
@@ -2000,6 +2168,62 @@
     #define traceRETURN_xTaskCatchUpTicks( xYieldOccurred )
 #endif
 
+#ifndef traceENTER_vTaskSetDeadline
+    #define traceENTER_vTaskSetDeadline( xTask, xDeadline )
+#endif
+
+#ifndef traceRETURN_vTaskSetDeadline
+    #define traceRETURN_vTaskSetDeadline()
+#endif
+
+#ifndef traceENTER_xTaskGetDeadline
+    #define traceENTER_xTaskGetDeadline( xTask )
+#endif
+
+#ifndef traceRETURN_xTaskGetDeadline
+    #define traceRETURN_xTaskGetDeadline( xReturn )
+#endif
+
+#ifndef traceENTER_xTaskDelayUntilWithDeadline
+    #define traceENTER_xTaskDelayUntilWithDeadline( pxPreviousWakeTime, xTimeIncrement, xRelativeDeadline )
+#endif
+
+#ifndef traceRETURN_xTaskDelayUntilWithDeadline
+    #define traceRETURN_xTaskDelayUntilWithDeadline( xReturn )
+#endif
+
+#ifndef traceENTER_xTaskSetPartitionSchedule
+    #define traceENTER_xTaskSetPartitionSchedule( pxWindows, uxWindowCount )
+#endif
+
+#ifndef traceRETURN_xTaskSetPartitionSchedule
+    #define traceRETURN_xTaskSetPartitionSchedule( xReturn )
+#endif
+
+#ifndef traceENTER_vTaskSetPartition
+    #define traceENTER_vTaskSetPartition( xTask, uxPartition )
+#endif
+
+#ifndef traceRETURN_vTaskSetPartition
+    #define traceRETURN_vTaskSetPartition()
+#endif
+
+#ifndef traceENTER_uxTaskGetPartition
+    #define traceENTER_uxTaskGetPartition( xTask )
+#endif
+
+#ifndef traceRETURN_uxTaskGetPartition
+    #define traceRETURN_uxTaskGetPartition( uxReturn )
+#endif
+
+#ifndef traceENTER_xTaskGetPartitionStatus
+    #define traceENTER_xTaskGetPartitionStatus( uxPartition, pxPartitionStatus )
+#endif
+
+#ifndef traceRETURN_xTaskGetPartitionStatus
+    #define traceRETURN_xTaskGetPartitionStatus( xReturn )
+#endif
+
 #ifndef traceENTER_xTaskAbortDelay
     #define traceENTER_xTaskAbortDelay( xTask )
 #endif
@@ -2096,6 +2320,14 @@
     #define traceRETURN_vTaskRemoveFromUnorderedEventList()
 #endif
 
+#ifndef traceENTER_xTaskRemoveFromUnorderedEventListFromISR
+    #define traceENTER_xTaskRemoveFromUnorderedEventListFromISR( pxEventListItem, xItemValue )
+#endif
+
+#ifndef traceRETURN_xTaskRemoveFromUnorderedEventListFromISR
+    #define traceRETURN_xTaskRemoveFromUnorderedEventListFromISR( xReturn )
+#endif
+
 #ifndef traceENTER_vTaskSetTimeOutState
     #define traceENTER_vTaskSetTimeOutState( pxTimeOut )
 #endif
@@ -2184,6 +2416,14 @@
     #define traceRETURN_vTaskGetInfo()
 #endif
 
+#ifndef traceENTER_uxTaskGetStackOverflowDepth
+    #define traceENTER_uxTaskGetStackOverflowDepth( xTask )
+#endif
+
+#ifndef traceRETURN_uxTaskGetStackOverflowDepth
+    #define traceRETURN_uxTaskGetStackOverflowDepth( uxReturn )
+#endif
+
 #ifndef traceENTER_uxTaskGetStackHighWaterMark2
     #define traceENTER_uxTaskGetStackHighWaterMark2( xTask )
 #endif
@@ -2320,6 +2560,38 @@
     #define traceRETURN_pvTaskIncrementMutexHeldCount( pxTCB )
 #endif
 
+#ifndef traceENTER_xTaskDecrementMutexHeldCount
+    #define traceENTER_xTaskDecrementMutexHeldCount()
+#endif
+
+#ifndef traceRETURN_xTaskDecrementMutexHeldCount
+    #define traceRETURN_xTaskDecrementMutexHeldCount( xReturn )
+#endif
+
+#ifndef traceENTER_vTaskSetBlockedOnMutex
+    #define traceENTER_vTaskSetBlockedOnMutex( pvMutex )
+#endif
+
+#ifndef traceRETURN_vTaskSetBlockedOnMutex
+    #define traceRETURN_vTaskSetBlockedOnMutex()
+#endif
+
+#ifndef traceENTER_uxTaskPriorityRaiseToCeiling
+    #define traceENTER_uxTaskPriorityRaiseToCeiling( uxCeilingPriority )
+#endif
+
+#ifndef traceRETURN_uxTaskPriorityRaiseToCeiling
+    #define traceRETURN_uxTaskPriorityRaiseToCeiling( uxPriorityBeforeCeiling )
+#endif
+
+#ifndef traceENTER_xTaskPriorityRestoreFromCeiling
+    #define traceENTER_xTaskPriorityRestoreFromCeiling( uxCeilingPriority, uxPriorityBeforeCeiling )
+#endif
+
+#ifndef traceRETURN_xTaskPriorityRestoreFromCeiling
+    #define traceRETURN_xTaskPriorityRestoreFromCeiling( xReturn )
+#endif
+
 #ifndef traceENTER_ulTaskGenericNotifyTake
     #define traceENTER_ulTaskGenericNotifyTake( uxIndexToWaitOn, xClearCountOnExit, xTicksToWait )
 #endif
@@ -2600,6 +2872,530 @@
     #define traceRETURN_ucStreamBufferGetStreamBufferType( ucStreamBufferType )
 #endif
 
+#ifndef traceENTER_xStreamBufferReserve
+    #define traceENTER_xStreamBufferReserve( xStreamBuffer, ppvData, xTicksToWait )
+#endif
+
+#ifndef traceRETURN_xStreamBufferReserve
+    #define traceRETURN_xStreamBufferReserve( xReturn )
+#endif
+
+#ifndef traceENTER_xStreamBufferReserveFromISR
+    #define traceENTER_xStreamBufferReserveFromISR( xStreamBuffer, ppvData )
+#endif
+
+#ifndef traceRETURN_xStreamBufferReserveFromISR
+    #define traceRETURN_xStreamBufferReserveFromISR( xReturn )
+#endif
+
+#ifndef traceENTER_vStreamBufferCommit
+    #define traceENTER_vStreamBufferCommit( xStreamBuffer, xBytesWritten )
+#endif
+
+#ifndef traceRETURN_vStreamBufferCommit
+    #define traceRETURN_vStreamBufferCommit()
+#endif
+
+#ifndef traceENTER_vStreamBufferCommitFromISR
+    #define traceENTER_vStreamBufferCommitFromISR( xStreamBuffer, xBytesWritten, pxHigherPriorityTaskWoken )
+#endif
+
+#ifndef traceRETURN_vStreamBufferCommitFromISR
+    #define traceRETURN_vStreamBufferCommitFromISR()
+#endif
+
+#ifndef traceENTER_xStreamBufferPeek
+    #define traceENTER_xStreamBufferPeek( xStreamBuffer, ppvData, xTicksToWait )
+#endif
+
+#ifndef traceRETURN_xStreamBufferPeek
+    #define traceRETURN_xStreamBufferPeek( xReturn )
+#endif
+
+#ifndef traceENTER_xStreamBufferPeekFromISR
+    #define traceENTER_xStreamBufferPeekFromISR( xStreamBuffer, ppvData )
+#endif
+
+#ifndef traceRETURN_xStreamBufferPeekFromISR
+    #define traceRETURN_xStreamBufferPeekFromISR( xReturn )
+#endif
+
+#ifndef traceENTER_vStreamBufferConsume
+    #define traceENTER_vStreamBufferConsume( xStreamBuffer, xBytesRead )
+#endif
+
+#ifndef traceRETURN_vStreamBufferConsume
+    #define traceRETURN_vStreamBufferConsume()
+#endif
+
+#ifndef traceENTER_vStreamBufferConsumeFromISR
+    #define traceENTER_vStreamBufferConsumeFromISR( xStreamBuffer, xBytesRead, pxHigherPriorityTaskWoken )
+#endif
+
+#ifndef traceRETURN_vStreamBufferConsumeFromISR
+    #define traceRETURN_vStreamBufferConsumeFromISR()
+#endif
+
+#ifndef traceENTER_xStreamBufferCreateExternallyIndexed
+    #define traceENTER_xStreamBufferCreateExternallyIndexed( xBufferSizeBytes, xTriggerLevelBytes, pucStreamBufferStorageArea, pxSendCompletedCallback, pxReceiveCompletedCallback )
+#endif
+
+#ifndef traceRETURN_xStreamBufferCreateExternallyIndexed
+    #define traceRETURN_xStreamBufferCreateExternallyIndexed( pxStreamBuffer )
+#endif
+
+#ifndef traceENTER_xStreamBufferSetHead
+    #define traceENTER_xStreamBufferSetHead( xStreamBuffer, xNewHead )
+#endif
+
+#ifndef traceRETURN_xStreamBufferSetHead
+    #define traceRETURN_xStreamBufferSetHead( xReturn )
+#endif
+
+#ifndef traceENTER_xStreamBufferSetHeadFromISR
+    #define traceENTER_xStreamBufferSetHeadFromISR( xStreamBuffer, xNewHead, pxHigherPriorityTaskWoken )
+#endif
+
+#ifndef traceRETURN_xStreamBufferSetHeadFromISR
+    #define traceRETURN_xStreamBufferSetHeadFromISR( xReturn )
+#endif
+
+#ifndef traceENTER_xStreamBufferSetTail
+    #define traceENTER_xStreamBufferSetTail( xStreamBuffer, xNewTail )
+#endif
+
+#ifndef traceRETURN_xStreamBufferSetTail
+    #define traceRETURN_xStreamBufferSetTail( xReturn )
+#endif
+
+#ifndef traceENTER_xStreamBufferSetTailFromISR
+    #define traceENTER_xStreamBufferSetTailFromISR( xStreamBuffer, xNewTail, pxHigherPriorityTaskWoken )
+#endif
+
+#ifndef traceRETURN_xStreamBufferSetTailFromISR
+    #define traceRETURN_xStreamBufferSetTailFromISR( xReturn )
+#endif
+
+#ifndef traceENTER_xStreamBufferSendVectored
+    #define traceENTER_xStreamBufferSendVectored( xStreamBuffer, pxVectors, xVectorCount, xTicksToWait )
+#endif
+
+#ifndef traceRETURN_xStreamBufferSendVectored
+    #define traceRETURN_xStreamBufferSendVectored( xReturn )
+#endif
+
+#ifndef traceENTER_xStreamBufferSendVectoredFromISR
+    #define traceENTER_xStreamBufferSendVectoredFromISR( xStreamBuffer, pxVectors, xVectorCount, pxHigherPriorityTaskWoken )
+#endif
+
+#ifndef traceRETURN_xStreamBufferSendVectoredFromISR
+    #define traceRETURN_xStreamBufferSendVectoredFromISR( xReturn )
+#endif
+
+#ifndef traceENTER_xStreamBufferReceiveVectored
+    #define traceENTER_xStreamBufferReceiveVectored( xStreamBuffer, pxVectors, xVectorCount, xTicksToWait )
+#endif
+
+#ifndef traceRETURN_xStreamBufferReceiveVectored
+    #define traceRETURN_xStreamBufferReceiveVectored( xReceivedLength )
+#endif
+
+#ifndef traceENTER_xStreamBufferReceiveVectoredFromISR
+    #define traceENTER_xStreamBufferReceiveVectoredFromISR( xStreamBuffer, pxVectors, xVectorCount, pxHigherPriorityTaskWoken )
+#endif
+
+#ifndef traceRETURN_xStreamBufferReceiveVectoredFromISR
+    #define traceRETURN_xStreamBufferReceiveVectoredFromISR( xReceivedLength )
+#endif
+
+#ifndef traceSPSC_RING_CREATE
+    #define traceSPSC_RING_CREATE( pxRing )
+#endif
+
+#ifndef traceSPSC_RING_SEND
+    #define traceSPSC_RING_SEND( pxRing )
+#endif
+
+#ifndef traceSPSC_RING_SEND_FAILED
+    #define traceSPSC_RING_SEND_FAILED( pxRing )
+#endif
+
+#ifndef traceBLOCKING_ON_SPSC_RING_RECEIVE
+    #define traceBLOCKING_ON_SPSC_RING_RECEIVE( xRing )
+#endif
+
+#ifndef traceENTER_xSpscRingCreate
+    #define traceENTER_xSpscRingCreate( xItemCount, xItemSize )
+#endif
+
+#ifndef traceRETURN_xSpscRingCreate
+    #define traceRETURN_xSpscRingCreate( pxRing )
+#endif
+
+#ifndef traceENTER_xSpscRingCreateStatic
+    #define traceENTER_xSpscRingCreateStatic( xItemCount, xItemSize, pucRingStorageArea, pxStaticRing )
+#endif
+
+#ifndef traceRETURN_xSpscRingCreateStatic
+    #define traceRETURN_xSpscRingCreateStatic( pxRing )
+#endif
+
+#ifndef traceENTER_vSpscRingDelete
+    #define traceENTER_vSpscRingDelete( xRing )
+#endif
+
+#ifndef traceRETURN_vSpscRingDelete
+    #define traceRETURN_vSpscRingDelete()
+#endif
+
+#ifndef traceENTER_xSpscRingSendFromISR
+    #define traceENTER_xSpscRingSendFromISR( xRing, pvItem, pxHigherPriorityTaskWoken )
+#endif
+
+#ifndef traceRETURN_xSpscRingSendFromISR
+    #define traceRETURN_xSpscRingSendFromISR( xReturn )
+#endif
+
+#ifndef traceENTER_xSpscRingSend
+    #define traceENTER_xSpscRingSend( xRing, pvItem )
+#endif
+
+#ifndef traceRETURN_xSpscRingSend
+    #define traceRETURN_xSpscRingSend( xReturn )
+#endif
+
+#ifndef traceENTER_xSpscRingReceive
+    #define traceENTER_xSpscRingReceive( xRing, pvBuffer, xTicksToWait )
+#endif
+
+#ifndef traceRETURN_xSpscRingReceive
+    #define traceRETURN_xSpscRingReceive( xReturn )
+#endif
+
+#ifndef traceENTER_xSpscRingItemsWaiting
+    #define traceENTER_xSpscRingItemsWaiting( xRing )
+#endif
+
+#ifndef traceRETURN_xSpscRingItemsWaiting
+    #define traceRETURN_xSpscRingItemsWaiting( xReturn )
+#endif
+
+#ifndef traceFAST_MUTEX_CREATE
+    #define traceFAST_MUTEX_CREATE( pxMutex )
+#endif
+
+#ifndef traceFAST_MUTEX_TAKE
+    #define traceFAST_MUTEX_TAKE( xMutex )
+#endif
+
+#ifndef traceFAST_MUTEX_TAKE_FAILED
+    #define traceFAST_MUTEX_TAKE_FAILED( xMutex )
+#endif
+
+#ifndef traceBLOCKING_ON_FAST_MUTEX_TAKE
+    #define traceBLOCKING_ON_FAST_MUTEX_TAKE( xMutex )
+#endif
+
+#ifndef traceFAST_MUTEX_GIVE
+    #define traceFAST_MUTEX_GIVE( xMutex )
+#endif
+
+#ifndef traceENTER_xFastMutexCreate
+    #define traceENTER_xFastMutexCreate()
+#endif
+
+#ifndef traceRETURN_xFastMutexCreate
+    #define traceRETURN_xFastMutexCreate( pxMutex )
+#endif
+
+#ifndef traceENTER_xFastMutexCreateStatic
+    #define traceENTER_xFastMutexCreateStatic( pxStaticMutex )
+#endif
+
+#ifndef traceRETURN_xFastMutexCreateStatic
+    #define traceRETURN_xFastMutexCreateStatic( pxMutex )
+#endif
+
+#ifndef traceENTER_vFastMutexDelete
+    #define traceENTER_vFastMutexDelete( xMutex )
+#endif
+
+#ifndef traceRETURN_vFastMutexDelete
+    #define traceRETURN_vFastMutexDelete()
+#endif
+
+#ifndef traceENTER_xFastMutexTake
+    #define traceENTER_xFastMutexTake( xMutex, xTicksToWait )
+#endif
+
+#ifndef traceRETURN_xFastMutexTake
+    #define traceRETURN_xFastMutexTake( xReturn )
+#endif
+
+#ifndef traceENTER_xFastMutexGive
+    #define traceENTER_xFastMutexGive( xMutex )
+#endif
+
+#ifndef traceRETURN_xFastMutexGive
+    #define traceRETURN_xFastMutexGive( xReturn )
+#endif
+
+#ifndef traceENTER_xFastMutexGetHolder
+    #define traceENTER_xFastMutexGetHolder( xMutex )
+#endif
+
+#ifndef traceRETURN_xFastMutexGetHolder
+    #define traceRETURN_xFastMutexGetHolder( xReturn )
+#endif
+
+#ifndef traceRW_LOCK_CREATE
+    #define traceRW_LOCK_CREATE( pxLock )
+#endif
+
+#ifndef traceRW_LOCK_TAKE_READ
+    #define traceRW_LOCK_TAKE_READ( xLock )
+#endif
+
+#ifndef traceRW_LOCK_TAKE_READ_FAILED
+    #define traceRW_LOCK_TAKE_READ_FAILED( xLock )
+#endif
+
+#ifndef traceBLOCKING_ON_RW_LOCK_TAKE_READ
+    #define traceBLOCKING_ON_RW_LOCK_TAKE_READ( xLock )
+#endif
+
+#ifndef traceRW_LOCK_GIVE_READ
+    #define traceRW_LOCK_GIVE_READ( xLock )
+#endif
+
+#ifndef traceRW_LOCK_TAKE_WRITE
+    #define traceRW_LOCK_TAKE_WRITE( xLock )
+#endif
+
+#ifndef traceRW_LOCK_TAKE_WRITE_FAILED
+    #define traceRW_LOCK_TAKE_WRITE_FAILED( xLock )
+#endif
+
+#ifndef traceBLOCKING_ON_RW_LOCK_TAKE_WRITE
+    #define traceBLOCKING_ON_RW_LOCK_TAKE_WRITE( xLock )
+#endif
+
+#ifndef traceRW_LOCK_GIVE_WRITE
+    #define traceRW_LOCK_GIVE_WRITE( xLock )
+#endif
+
+#ifndef traceENTER_xRWLockCreate
+    #define traceENTER_xRWLockCreate()
+#endif
+
+#ifndef traceRETURN_xRWLockCreate
+    #define traceRETURN_xRWLockCreate( pxLock )
+#endif
+
+#ifndef traceENTER_xRWLockCreateStatic
+    #define traceENTER_xRWLockCreateStatic( pxStaticLock )
+#endif
+
+#ifndef traceRETURN_xRWLockCreateStatic
+    #define traceRETURN_xRWLockCreateStatic( pxLock )
+#endif
+
+#ifndef traceENTER_vRWLockDelete
+    #define traceENTER_vRWLockDelete( xLock )
+#endif
+
+#ifndef traceRETURN_vRWLockDelete
+    #define traceRETURN_vRWLockDelete()
+#endif
+
+#ifndef traceENTER_xRWLockTakeRead
+    #define traceENTER_xRWLockTakeRead( xLock, xTicksToWait )
+#endif
+
+#ifndef traceRETURN_xRWLockTakeRead
+    #define traceRETURN_xRWLockTakeRead( xReturn )
+#endif
+
+#ifndef traceENTER_xRWLockGiveRead
+    #define traceENTER_xRWLockGiveRead( xLock )
+#endif
+
+#ifndef traceRETURN_xRWLockGiveRead
+    #define traceRETURN_xRWLockGiveRead( xReturn )
+#endif
+
+#ifndef traceENTER_xRWLockTakeWrite
+    #define traceENTER_xRWLockTakeWrite( xLock, xTicksToWait )
+#endif
+
+#ifndef traceRETURN_xRWLockTakeWrite
+    #define traceRETURN_xRWLockTakeWrite( xReturn )
+#endif
+
+#ifndef traceENTER_xRWLockGiveWrite
+    #define traceENTER_xRWLockGiveWrite( xLock )
+#endif
+
+#ifndef traceRETURN_xRWLockGiveWrite
+    #define traceRETURN_xRWLockGiveWrite( xReturn )
+#endif
+
+#ifndef traceBLOCK_POOL_CREATE
+    #define traceBLOCK_POOL_CREATE( pxPool )
+#endif
+
+#ifndef traceBLOCK_POOL_CREATE_FAILED
+    #define traceBLOCK_POOL_CREATE_FAILED()
+#endif
+
+#ifndef traceBLOCK_POOL_ALLOC
+    #define traceBLOCK_POOL_ALLOC( pxPool, pvBlock )
+#endif
+
+#ifndef traceBLOCK_POOL_ALLOC_FAILED
+    #define traceBLOCK_POOL_ALLOC_FAILED( pxPool )
+#endif
+
+#ifndef traceBLOCK_POOL_FREE
+    #define traceBLOCK_POOL_FREE( pxPool, pvBlock )
+#endif
+
+#ifndef traceENTER_xBlockPoolCreateStatic
+    #define traceENTER_xBlockPoolCreateStatic( xBlockSize, xBlockCount, pucPoolStorage, pxStaticPool )
+#endif
+
+#ifndef traceRETURN_xBlockPoolCreateStatic
+    #define traceRETURN_xBlockPoolCreateStatic( pxPool )
+#endif
+
+#ifndef traceENTER_pvBlockPoolAlloc
+    #define traceENTER_pvBlockPoolAlloc( xPool )
+#endif
+
+#ifndef traceRETURN_pvBlockPoolAlloc
+    #define traceRETURN_pvBlockPoolAlloc( pvReturn )
+#endif
+
+#ifndef traceENTER_pvBlockPoolAllocFromISR
+    #define traceENTER_pvBlockPoolAllocFromISR( xPool )
+#endif
+
+#ifndef traceRETURN_pvBlockPoolAllocFromISR
+    #define traceRETURN_pvBlockPoolAllocFromISR( pvReturn )
+#endif
+
+#ifndef traceENTER_vBlockPoolFree
+    #define traceENTER_vBlockPoolFree( xPool, pvBlock )
+#endif
+
+#ifndef traceRETURN_vBlockPoolFree
+    #define traceRETURN_vBlockPoolFree()
+#endif
+
+#ifndef traceENTER_vBlockPoolFreeFromISR
+    #define traceENTER_vBlockPoolFreeFromISR( xPool, pvBlock )
+#endif
+
+#ifndef traceRETURN_vBlockPoolFreeFromISR
+    #define traceRETURN_vBlockPoolFreeFromISR()
+#endif
+
+#ifndef traceENTER_vBlockPoolGetStats
+    #define traceENTER_vBlockPoolGetStats( xPool, pxPoolStats )
+#endif
+
+#ifndef traceRETURN_vBlockPoolGetStats
+    #define traceRETURN_vBlockPoolGetStats()
+#endif
+
+#ifndef traceENTER_vBlockPoolResetPeak
+    #define traceENTER_vBlockPoolResetPeak( xPool )
+#endif
+
+#ifndef traceRETURN_vBlockPoolResetPeak
+    #define traceRETURN_vBlockPoolResetPeak()
+#endif
+
+#ifndef traceENTER_xBlockPoolRegisterKernelObjectPool
+    #define traceENTER_xBlockPoolRegisterKernelObjectPool( xPool )
+#endif
+
+#ifndef traceRETURN_xBlockPoolRegisterKernelObjectPool
+    #define traceRETURN_xBlockPoolRegisterKernelObjectPool( xReturn )
+#endif
+
+#ifndef traceENTER_uxHeapGetTagStats
+    #define traceENTER_uxHeapGetTagStats( pxTagStatsArray, uxArraySize )
+#endif
+
+#ifndef traceRETURN_uxHeapGetTagStats
+    #define traceRETURN_uxHeapGetTagStats( uxCount )
+#endif
+
+#ifndef traceENTER_vHeapGetSnapshot
+    #define traceENTER_vHeapGetSnapshot( pxSnapshot )
+#endif
+
+#ifndef traceRETURN_vHeapGetSnapshot
+    #define traceRETURN_vHeapGetSnapshot()
+#endif
+
+#ifndef traceENTER_xCoroSchedulerCreate
+    #define traceENTER_xCoroSchedulerCreate( pxScheduler, uxQueueEventLength )
+#endif
+
+#ifndef traceRETURN_xCoroSchedulerCreate
+    #define traceRETURN_xCoroSchedulerCreate( xReturn )
+#endif
+
+#ifndef traceENTER_vCoroSchedulerDelete
+    #define traceENTER_vCoroSchedulerDelete( pxScheduler )
+#endif
+
+#ifndef traceRETURN_vCoroSchedulerDelete
+    #define traceRETURN_vCoroSchedulerDelete()
+#endif
+
+#ifndef traceENTER_xCoroSchedulerAddQueue
+    #define traceENTER_xCoroSchedulerAddQueue( pxScheduler, xQueue )
+#endif
+
+#ifndef traceRETURN_xCoroSchedulerAddQueue
+    #define traceRETURN_xCoroSchedulerAddQueue( xReturn )
+#endif
+
+#ifndef traceENTER_vCoroCreate
+    #define traceENTER_vCoroCreate( pxScheduler, pxCoro, pxCoroFunction, pvParameters )
+#endif
+
+#ifndef traceRETURN_vCoroCreate
+    #define traceRETURN_vCoroCreate()
+#endif
+
+#ifndef traceENTER_vCoroSchedulerRun
+    #define traceENTER_vCoroSchedulerRun( pxScheduler )
+#endif
+
+#ifndef traceRETURN_vCoroSchedulerRun
+    #define traceRETURN_vCoroSchedulerRun()
+#endif
+
+#ifndef traceENTER_xCoroNotifyGive
+    #define traceENTER_xCoroNotifyGive( pxCoro )
+#endif
+
+#ifndef traceRETURN_xCoroNotifyGive
+    #define traceRETURN_xCoroNotifyGive( xReturn )
+#endif
+
+#ifndef traceENTER_vCoroNotifyGiveFromISR
+    #define traceENTER_vCoroNotifyGiveFromISR( pxCoro, pxHigherPriorityTaskWoken )
+#endif
+
+#ifndef traceRETURN_vCoroNotifyGiveFromISR
+    #define traceRETURN_vCoroNotifyGiveFromISR()
+#endif
+
 #ifndef traceENTER_vListInitialise
     #define traceENTER_vListInitialise( pxList )
 #endif
@@ -2734,6 +3530,135 @@
     #define configUSE_QUEUE_SETS    0
 #endif
 
+#ifndef configUSE_QUEUE_ZERO_COPY
+    #define configUSE_QUEUE_ZERO_COPY    0
+#endif
+
+#ifndef configUSE_QUEUE_BATCH_TRANSFER
+    #define configUSE_QUEUE_BATCH_TRANSFER    0
+#endif
+
+#ifndef configUSE_SPSC_RINGS
+    #define configUSE_SPSC_RINGS    0
+#endif
+
+#ifndef configUSE_FAST_MUTEXES
+    #define configUSE_FAST_MUTEXES    0
+#endif
+
+#ifndef configUSE_RW_LOCKS
+    #define configUSE_RW_LOCKS    0
+#endif
+
+#ifndef configUSE_TRANSITIVE_INHERITANCE
+    #define configUSE_TRANSITIVE_INHERITANCE    0
+#endif
+
+#ifndef configMAX_INHERITANCE_DEPTH
+    #define configMAX_INHERITANCE_DEPTH    4
+#endif
+
+#ifndef configUSE_CEILING_MUTEXES
+    #define configUSE_CEILING_MUTEXES    0
+#endif
+
+#ifndef configUSE_BLOCK_POOLS
+    #define configUSE_BLOCK_POOLS    0
+#endif
+
+#ifndef configUSE_KERNEL_OBJECT_POOLS
+    #define configUSE_KERNEL_OBJECT_POOLS    0
+#endif
+
+#ifndef configKERNEL_OBJECT_POOL_COUNT
+    #define configKERNEL_OBJECT_POOL_COUNT    4
+#endif
+
+#if ( ( configUSE_KERNEL_OBJECT_POOLS == 1 ) && ( configUSE_BLOCK_POOLS != 1 ) )
+    #error configUSE_KERNEL_OBJECT_POOLS requires configUSE_BLOCK_POOLS to be set to 1
+#endif
+
+#ifndef configUSE_HEAP_INSTRUMENTATION
+    #define configUSE_HEAP_INSTRUMENTATION    0
+#endif
+
+#ifndef configHEAP_INSTRUMENTATION_TAGS
+    #define configHEAP_INSTRUMENTATION_TAGS    16
+#endif
+
+#ifndef configHEAP_INSTRUMENTATION_BLOCKS
+    #define configHEAP_INSTRUMENTATION_BLOCKS    64
+#endif
+
+#ifndef configUSE_HEAP_REGION_HINTS
+    #define configUSE_HEAP_REGION_HINTS    0
+#endif
+
+#if ( ( configUSE_HEAP_REGION_HINTS == 1 ) && ( configSTACK_ALLOCATION_FROM_SEPARATE_HEAP == 1 ) )
+    #error configUSE_HEAP_REGION_HINTS places stacks with pvPortMallocInRegion(), so cannot be used with configSTACK_ALLOCATION_FROM_SEPARATE_HEAP
+#endif
+
+#ifndef configUSE_EDF_SCHEDULING
+    #define configUSE_EDF_SCHEDULING    0
+#endif
+
+#if ( ( configUSE_EDF_SCHEDULING == 1 ) && ( configNUMBER_OF_CORES > 1 ) )
+    #error configUSE_EDF_SCHEDULING is only supported by the single core scheduler
+#endif
+
+#ifndef configUSE_TIME_PARTITIONING
+    #define configUSE_TIME_PARTITIONING    0
+#endif
+
+#ifndef configMAX_PARTITIONS
+    #define configMAX_PARTITIONS    4
+#endif
+
+#ifndef configUSE_PARTITION_OVERRUN_HOOK
+    #define configUSE_PARTITION_OVERRUN_HOOK    0
+#endif
+
+#if ( ( configUSE_TIME_PARTITIONING == 1 ) && ( configNUMBER_OF_CORES > 1 ) )
+    #error configUSE_TIME_PARTITIONING is only supported by the single core scheduler
+#endif
+
+#if ( ( configUSE_TIME_PARTITIONING == 1 ) && ( configUSE_TICKLESS_IDLE != 0 ) )
+    #error configUSE_TIME_PARTITIONING switches partition windows from the tick interrupt, so cannot be used with configUSE_TICKLESS_IDLE
+#endif
+
+#ifndef configUSE_CRITICAL_PROFILER
+    #define configUSE_CRITICAL_PROFILER    0
+#endif
+
+#ifndef configCRITICAL_PROFILER_SITES
+    #define configCRITICAL_PROFILER_SITES    32
+#endif
+
+#ifndef configCRITICAL_PROFILER_BUCKETS
+    #define configCRITICAL_PROFILER_BUCKETS    8
+#endif
+
+#if ( ( configUSE_CRITICAL_PROFILER == 1 ) && ( configNUMBER_OF_CORES > 1 ) )
+    #error configUSE_CRITICAL_PROFILER is only supported by the single core scheduler
+#endif
+
+#if ( ( configUSE_CRITICAL_PROFILER == 1 ) && ( configCRITICAL_PROFILER_BUCKETS < 2 ) )
+    #error configCRITICAL_PROFILER_BUCKETS must be at least 2
+#endif
+
+/* The 64-bit timestamp the critical section profiler measures durations with.
+ * The run time stats counter is used unless another is given. */
+#ifndef configCRITICAL_PROFILER_TIMESTAMP
+    #if ( ( configUSE_CRITICAL_PROFILER == 1 ) && !defined( portGET_RUN_TIME_COUNTER_VALUE ) )
+        #error configUSE_CRITICAL_PROFILER requires configCRITICAL_PROFILER_TIMESTAMP() or portGET_RUN_TIME_COUNTER_VALUE() to be defined
+    #endif
+    #define configCRITICAL_PROFILER_TIMESTAMP()    ( ( uint64_t ) portGET_RUN_TIME_COUNTER_VALUE() )
+#endif
+
+#ifndef configUSE_CORO_SCHEDULER
+    #define configUSE_CORO_SCHEDULER    0
+#endif
+
 #ifndef portTASK_USES_FLOATING_POINT
     #define portTASK_USES_FLOATING_POINT()
 #endif
@@ -2802,6 +3727,10 @@
     #error configTASK_NOTIFICATION_ARRAY_ENTRIES must be at least 1
 #endif
 
+#ifndef configSPSC_RING_NOTIFICATION_INDEX
+    #define configSPSC_RING_NOTIFICATION_INDEX    0
+#endif
+
 #ifndef configUSE_POSIX_ERRNO
     #define configUSE_POSIX_ERRNO    0
 #endif
@@ -2812,6 +3741,18 @@
     #define configUSE_SB_COMPLETED_CALLBACK    0
 #endif
 
+#ifndef configUSE_STREAM_BUFFER_ZERO_COPY
+    #define configUSE_STREAM_BUFFER_ZERO_COPY    0
+#endif
+
+#ifndef configUSE_STREAM_BUFFER_EXTERNAL_INDEX
+    #define configUSE_STREAM_BUFFER_EXTERNAL_INDEX    0
+#endif
+
+#ifndef configUSE_STREAM_BUFFER_VECTORED_IO
+    #define configUSE_STREAM_BUFFER_VECTORED_IO    0
+#endif
+
 #ifndef portTICK_TYPE_IS_ATOMIC
     #define portTICK_TYPE_IS_ATOMIC    0
 #endif
@@ -3193,6 +4134,15 @@ typedef struct xSTATIC_TCB
     #if ( configUSE_MUTEXES == 1 )
         UBaseType_t uxDummy12[ 2 ];
     #endif
+    #if ( configUSE_TRANSITIVE_INHERITANCE == 1 )
+        void * pvDummy27;
+    #endif
+    #if ( configUSE_EDF_SCHEDULING == 1 )
+        TickType_t xDummy28;
+    #endif
+    #if ( configUSE_TIME_PARTITIONING == 1 )
+        UBaseType_t uxDummy29;
+    #endif
     #if ( configUSE_APPLICATION_TASK_TAG == 1 )
         void * pxDummy14;
     #endif
@@ -3261,6 +4211,14 @@ typedef struct xSTATIC_QUEUE
         UBaseType_t uxDummy8;
         uint8_t ucDummy9;
     #endif
+
+    #if ( configUSE_QUEUE_ZERO_COPY == 1 )
+        uint8_t ucDummy10;
+    #endif
+
+    #if ( configUSE_CEILING_MUTEXES == 1 )
+        UBaseType_t uxDummy11[ 2 ];
+    #endif
 } StaticQueue_t;
 typedef StaticQueue_t StaticSemaphore_t;
 
@@ -3290,6 +4248,14 @@ typedef struct xSTATIC_EVENT_GROUP
     #if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
         uint8_t ucDummy4;
     #endif
+
+    #if ( configUSE_INDEXED_EVENT_GROUPS == 1 )
+        void * pvDummy5;
+    #endif
+
+    #if ( configUSE_DIRECT_EVENT_GROUPS == 1 )
+        uint8_t ucDummy6;
+    #endif
 } StaticEventGroup_t;
 
 /*
@@ -3350,6 +4316,61 @@ typedef struct xSTATIC_STREAM_BUFFER
 /* Message buffers are built on stream buffers. */
 typedef StaticStreamBuffer_t StaticMessageBuffer_t;
 
+/*
+ * In line with the other kernel objects, the structure used internally by
+ * spsc_ring.c is not accessible to application code.  StaticSpscRing_t is
+ * provided so SPSC rings can be statically allocated.  Its size and alignment
+ * requirements are guaranteed to match those of the genuine structure.
+ */
+typedef struct xSTATIC_SPSC_RING
+{
+    uint32_t ulDummy1[ 3 ];
+    size_t uxDummy2;
+    void * pvDummy3[ 2 ];
+    uint8_t ucDummy4;
+} StaticSpscRing_t;
+
+/*
+ * In line with the other kernel objects, the structure used internally by
+ * fast_mutex.c is not accessible to application code.  StaticFastMutex_t is
+ * provided so fast mutexes can be statically allocated.  Its size and
+ * alignment requirements are guaranteed to match those of the genuine
+ * structure.
+ */
+typedef struct xSTATIC_FAST_MUTEX
+{
+    void * pvDummy1;
+    StaticList_t xDummy2;
+    uint8_t ucDummy3;
+} StaticFastMutex_t;
+
+/*
+ * In line with the other kernel objects, the structure used internally by
+ * rw_lock.c is not accessible to application code.  StaticRWLock_t is
+ * provided so reader-writer locks can be statically allocated.  Its size and
+ * alignment requirements are guaranteed to match those of the genuine
+ * structure.
+ */
+typedef struct xSTATIC_RW_LOCK
+{
+    uint32_t ulDummy1;
+    void * pvDummy2;
+    StaticList_t xDummy3[ 2 ];
+    uint8_t ucDummy4;
+} StaticRWLock_t;
+
+/*
+ * In line with the other kernel objects, the structure used internally by
+ * block_pool.c is not accessible to application code.  StaticBlockPool_t is
+ * provided so block pools can be created.  Its size and alignment
+ * requirements are guaranteed to match those of the genuine structure.
+ */
+typedef struct xSTATIC_BLOCK_POOL
+{
+    void * pvDummy1[ 3 ];
+    size_t xDummy2[ 6 ];
+} StaticBlockPool_t;
+
 /* *INDENT-OFF* */
 #ifdef __cplusplus
     }
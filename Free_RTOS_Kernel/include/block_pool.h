@@ -0,0 +1,315 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+
+
+/*
+ * Block pools hand out fixed-size blocks carved from an array the application
+ * provides.  Allocating and freeing a block take constant time, never
+ * fragment, and never touch the heap, so a pool sized for the worst case can
+ * be used where heap allocation is not allowed or its timing is not bounded -
+ * for example, for message buffers allocated from an interrupt.
+ *
+ * Pools can also back the kernel's own objects.  When
+ * configUSE_KERNEL_OBJECT_POOLS is 1 the create functions that allocate
+ * dynamically (xTaskCreate(), xQueueCreate(), xTimerCreate(),
+ * xEventGroupCreate(), etc.) take task control blocks and object structures
+ * from the smallest pool registered with xBlockPoolRegisterKernelObjectPool()
+ * that has a large enough free block, and fall back to pvPortMalloc() if there
+ * is none.  Task stacks are still allocated from the heap.
+ */
+
+#ifndef BLOCK_POOL_H
+#define BLOCK_POOL_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h must appear in source files before include block_pool.h"
+#endif
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/**
+ * Type by which block pools are referenced.  For example, a call to
+ * xBlockPoolCreateStatic() returns a BlockPoolHandle_t variable that can then
+ * be used as a parameter to pvBlockPoolAlloc(), vBlockPoolFree(), etc.
+ */
+struct BlockPoolDef_t;
+typedef struct BlockPoolDef_t * BlockPoolHandle_t;
+
+/**
+ * Used with vBlockPoolGetStats() to read how much of a pool is in use.
+ */
+typedef struct xBLOCK_POOL_STATS
+{
+    size_t xBlockSize;         /* The size of each block, after rounding up. */
+    size_t xBlockCount;        /* The number of blocks in the pool. */
+    size_t xBlocksInUse;       /* The number of blocks currently allocated. */
+    size_t xPeakBlocksInUse;   /* The most blocks that have been allocated at once since the pool was created or vBlockPoolResetPeak() was called. */
+    size_t xFailedAllocations; /* The number of allocations that returned NULL because every block was in use. */
+    size_t xFallbacks;         /* The number of kernel objects that fitted this pool best but, because every block was in use, came from a larger pool or the heap instead. */
+} BlockPoolStats_t;
+
+/**
+ * The size each block of a pool occupies: the requested size rounded up to a
+ * multiple of portBYTE_ALIGNMENT, and to at least the size of a pointer, which
+ * free blocks use to link to each other.
+ */
+#define blockpoolBLOCK_SIZE( xBlockSize )                                                                              \
+    ( ( ( ( ( xBlockSize ) < sizeof( void * ) ) ? sizeof( void * ) : ( xBlockSize ) ) + portBYTE_ALIGNMENT_MASK ) & \
+      ~( ( size_t ) portBYTE_ALIGNMENT_MASK ) )
+
+/**
+ * The number of bytes of storage a pool of xBlockCount blocks of xBlockSize
+ * bytes needs.  Includes space to align the first block, so the storage array
+ * itself can have any alignment.
+ */
+#define blockpoolSTORAGE_SIZE( xBlockSize, xBlockCount ) \
+    ( ( blockpoolBLOCK_SIZE( xBlockSize ) * ( xBlockCount ) ) + portBYTE_ALIGNMENT_MASK )
+
+/**
+ * block_pool.h
+ *
+ * @code{c}
+ * BlockPoolHandle_t xBlockPoolCreateStatic( size_t xBlockSize,
+ *                                           size_t xBlockCount,
+ *                                           uint8_t *pucPoolStorage,
+ *                                           StaticBlockPool_t *pxStaticPool );
+ * @endcode
+ *
+ * Creates a pool of xBlockCount blocks of xBlockSize bytes in the array
+ * pointed to by pucPoolStorage.  All the blocks start free.
+ *
+ * configUSE_BLOCK_POOLS must be set to 1 in FreeRTOSConfig.h for block pools
+ * to be available.
+ *
+ * @param xBlockSize The size of each block in bytes.  Rounded up as described
+ * for blockpoolBLOCK_SIZE().
+ *
+ * @param xBlockCount The number of blocks in the pool.
+ *
+ * @param pucPoolStorage Must point to an array of at least
+ * blockpoolSTORAGE_SIZE( xBlockSize, xBlockCount ) bytes.
+ *
+ * @param pxStaticPool Must point to a variable of type StaticBlockPool_t,
+ * which will be used to hold the pool's data structure.
+ *
+ * @return A handle to the created pool, or NULL if any parameter was NULL or
+ * zero.
+ *
+ * Example usage:
+ * @code{c}
+ * #define MESSAGE_SIZE     32
+ * #define MESSAGE_COUNT    8
+ *
+ * static uint8_t ucMessageStorage[ blockpoolSTORAGE_SIZE( MESSAGE_SIZE, MESSAGE_COUNT ) ];
+ * static StaticBlockPool_t xMessagePoolBuffer;
+ *
+ * void vAFunction( void )
+ * {
+ * BlockPoolHandle_t xMessagePool;
+ * uint8_t *pucMessage;
+ *
+ *  xMessagePool = xBlockPoolCreateStatic( MESSAGE_SIZE, MESSAGE_COUNT,
+ *                                         ucMessageStorage, &xMessagePoolBuffer );
+ *
+ *  pucMessage = pvBlockPoolAlloc( xMessagePool );
+ *
+ *  if( pucMessage != NULL )
+ *  {
+ *      // Fill in and use the message, then give the block back.
+ *      vBlockPoolFree( xMessagePool, pucMessage );
+ *  }
+ * }
+ * @endcode
+ * \defgroup xBlockPoolCreateStatic xBlockPoolCreateStatic
+ * \ingroup BlockPoolManagement
+ */
+BlockPoolHandle_t xBlockPoolCreateStatic( size_t xBlockSize,
+                                          size_t xBlockCount,
+                                          uint8_t * pucPoolStorage,
+                                          StaticBlockPool_t * pxStaticPool ) PRIVILEGED_FUNCTION;
+
+/**
+ * block_pool.h
+ *
+ * @code{c}
+ * void *pvBlockPoolAlloc( BlockPoolHandle_t xPool );
+ * @endcode
+ *
+ * Takes a free block from a pool.  Never blocks.
+ *
+ * @param xPool The pool to allocate from.
+ *
+ * @return A pointer to the block, aligned to portBYTE_ALIGNMENT, or NULL if
+ * every block in the pool is in use.
+ *
+ * \defgroup pvBlockPoolAlloc pvBlockPoolAlloc
+ * \ingroup BlockPoolManagement
+ */
+void * pvBlockPoolAlloc( BlockPoolHandle_t xPool ) PRIVILEGED_FUNCTION;
+
+/**
+ * block_pool.h
+ *
+ * @code{c}
+ * void *pvBlockPoolAllocFromISR( BlockPoolHandle_t xPool );
+ * @endcode
+ *
+ * A version of pvBlockPoolAlloc() that can be called from an interrupt
+ * service routine.
+ *
+ * \defgroup pvBlockPoolAllocFromISR pvBlockPoolAllocFromISR
+ * \ingroup BlockPoolManagement
+ */
+void * pvBlockPoolAllocFromISR( BlockPoolHandle_t xPool ) PRIVILEGED_FUNCTION;
+
+/**
+ * block_pool.h
+ *
+ * @code{c}
+ * void vBlockPoolFree( BlockPoolHandle_t xPool, void *pvBlock );
+ * @endcode
+ *
+ * Returns a block obtained from pvBlockPoolAlloc() or
+ * pvBlockPoolAllocFromISR() to the pool it came from.  Passing NULL does
+ * nothing.
+ *
+ * @param xPool The pool the block was allocated from.
+ *
+ * @param pvBlock The block being freed.
+ *
+ * \defgroup vBlockPoolFree vBlockPoolFree
+ * \ingroup BlockPoolManagement
+ */
+void vBlockPoolFree( BlockPoolHandle_t xPool,
+                     void * pvBlock ) PRIVILEGED_FUNCTION;
+
+/**
+ * block_pool.h
+ *
+ * @code{c}
+ * void vBlockPoolFreeFromISR( BlockPoolHandle_t xPool, void *pvBlock );
+ * @endcode
+ *
+ * A version of vBlockPoolFree() that can be called from an interrupt service
+ * routine.
+ *
+ * \defgroup vBlockPoolFreeFromISR vBlockPoolFreeFromISR
+ * \ingroup BlockPoolManagement
+ */
+void vBlockPoolFreeFromISR( BlockPoolHandle_t xPool,
+                            void * pvBlock ) PRIVILEGED_FUNCTION;
+
+/**
+ * block_pool.h
+ *
+ * @code{c}
+ * void vBlockPoolGetStats( BlockPoolHandle_t xPool, BlockPoolStats_t *pxPoolStats );
+ * @endcode
+ *
+ * Reads the pool's block size, block count, current and peak utilisation, the
+ * number of failed allocations and, for a registered kernel object pool, the
+ * number of objects that fell back to a larger pool or the heap, into the
+ * structure pointed to by pxPoolStats.  A kernel object that could not be
+ * allocated anywhere counts as a failed allocation of the pool that fits it
+ * best.  The counters are read together, in a critical section, so are
+ * consistent with each other.
+ *
+ * \defgroup vBlockPoolGetStats vBlockPoolGetStats
+ * \ingroup BlockPoolManagement
+ */
+void vBlockPoolGetStats( BlockPoolHandle_t xPool,
+                         BlockPoolStats_t * pxPoolStats ) PRIVILEGED_FUNCTION;
+
+/**
+ * block_pool.h
+ *
+ * @code{c}
+ * void vBlockPoolResetPeak( BlockPoolHandle_t xPool );
+ * @endcode
+ *
+ * Sets the pool's peak utilisation to the number of blocks currently in use,
+ * so the peak over a new interval can be measured.
+ *
+ * \defgroup vBlockPoolResetPeak vBlockPoolResetPeak
+ * \ingroup BlockPoolManagement
+ */
+void vBlockPoolResetPeak( BlockPoolHandle_t xPool ) PRIVILEGED_FUNCTION;
+
+/**
+ * block_pool.h
+ *
+ * @code{c}
+ * BaseType_t xBlockPoolRegisterKernelObjectPool( BlockPoolHandle_t xPool );
+ * @endcode
+ *
+ * Makes a pool available to the kernel object create functions.  Objects
+ * created before the pool is registered, or while it is full, come from the
+ * heap and are returned to it when deleted.  A registered pool must not be
+ * used for anything else.
+ *
+ * configUSE_KERNEL_OBJECT_POOLS must be set to 1 in FreeRTOSConfig.h for this
+ * function to be available.  At most configKERNEL_OBJECT_POOL_COUNT pools can
+ * be registered.
+ *
+ * Example usage:
+ * @code{c}
+ * static uint8_t ucTCBPoolStorage[ blockpoolSTORAGE_SIZE( sizeof( StaticTask_t ), 4 ) ];
+ * static StaticBlockPool_t xTCBPoolBuffer;
+ *
+ * int main( void )
+ * {
+ *  xBlockPoolRegisterKernelObjectPool( xBlockPoolCreateStatic( sizeof( StaticTask_t ), 4,
+ *                                                              ucTCBPoolStorage, &xTCBPoolBuffer ) );
+ *
+ *  // The control blocks of up to four tasks now come from the pool.
+ *  xTaskCreate( ... );
+ * }
+ * @endcode
+ *
+ * @return pdPASS if the pool was registered, or pdFAIL if
+ * configKERNEL_OBJECT_POOL_COUNT pools are already registered.
+ *
+ * \defgroup xBlockPoolRegisterKernelObjectPool xBlockPoolRegisterKernelObjectPool
+ * \ingroup BlockPoolManagement
+ */
+#if ( configUSE_KERNEL_OBJECT_POOLS == 1 )
+    BaseType_t xBlockPoolRegisterKernelObjectPool( BlockPoolHandle_t xPool ) PRIVILEGED_FUNCTION;
+#endif
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* !defined( BLOCK_POOL_H ) */
@@ -0,0 +1,536 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Stackless co-routines that share the stack of one host task.
+ *
+ * A co-routine is a function that is called again each time it resumes and
+ * jumps back to the point where it last waited, as the co-routines of
+ * croutine.h do.  Unlike those, these co-routines are not scheduled from the
+ * idle task: any number of groups of co-routines can each be hosted by an
+ * ordinary task, at that task's priority, by calling vCoroSchedulerRun() from
+ * it or creating it with vCoroSchedulerTask().  The co-routines of a group
+ * run in turn, in the order they were created, each until it reaches its next
+ * wait.  When none is ready the host task blocks, so an idle group costs no
+ * processor time.
+ *
+ * A co-routine can wait for a number of ticks or for a periodic wake time,
+ * for a notification given to it by a task, an interrupt or another
+ * co-routine, and for an item to arrive in a queue that a task or an
+ * interrupt writes to.  The host task blocks on a queue set holding every
+ * queue its co-routines wait on, plus a binary semaphore that notifications
+ * are signalled through, with a block time that ends at the earliest
+ * co-routine timeout.  Sending to a queue therefore also costs a write to the
+ * queue set, and giving a notification a semaphore give.
+ *
+ * Each co-routine needs only its Coro_t, which the application provides,
+ * instead of a task control block and a stack of its own.  In exchange:
+ *
+ * - Local variables do not keep their value across a macro that can wait
+ *   (coroYIELD(), coroDELAY(), coroDELAY_UNTIL(), coroNOTIFY_TAKE() and
+ *   coroQUEUE_RECEIVE()).  Keep state in static variables or in the structure
+ *   passed as the co-routine's parameter.
+ * - Those macros can only be used in the co-routine function itself, not in a
+ *   function it calls, and at most one of them on any one source line.  The
+ *   co-routine function must not contain a switch statement of its own that
+ *   spans one of them.
+ * - The co-routines of a group share the host task's priority, and a
+ *   co-routine that does not reach a wait keeps the others from running.
+ * - Blocking FreeRTOS API calls block the whole group; call them with a block
+ *   time of zero and use the co-routine macros to wait instead.
+ */
+
+#ifndef CORO_H
+#define CORO_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h must appear in source files before include coro.h"
+#endif
+
+#include "queue.h"
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/* Values of the ucState member of Coro_t. */
+#define coroSTATE_READY                   ( ( uint8_t ) 0 )
+#define coroSTATE_DELAYED                 ( ( uint8_t ) 1 )
+#define coroSTATE_WAITING_NOTIFICATION    ( ( uint8_t ) 2 )
+#define coroSTATE_WAITING_QUEUE           ( ( uint8_t ) 3 )
+#define coroSTATE_ENDED                   ( ( uint8_t ) 4 )
+
+struct xCORO;
+struct xCORO_SCHEDULER;
+
+/* Defines the prototype to which co-routine functions must conform. */
+typedef void (* CoroFunction_t)( struct xCORO * pxCoro,
+                                 void * pvParameters );
+
+/*
+ * The co-routine control block.  The structure has to be visible because the
+ * co-routine macros access it, but its members should only be used through
+ * the functions and macros below.
+ */
+typedef struct xCORO
+{
+    CoroFunction_t pxCoroFunction;
+    void * pvParameters;
+    struct xCORO_SCHEDULER * pxScheduler; /**< The group the co-routine belongs to. */
+    struct xCORO * pxNext;                /**< The next co-routine of the group, in creation order. */
+    QueueHandle_t xQueue;                 /**< The queue waited on in coroSTATE_WAITING_QUEUE. */
+    TimeOut_t xTimeOut;                   /**< When the current wait started. */
+    TickType_t xTicksToWait;              /**< What is left of the current wait, or portMAX_DELAY. */
+    volatile uint32_t ulNotifiedValue;    /**< Notifications given and not yet taken. */
+    uint16_t usResumePoint;               /**< Where the co-routine function resumes; 0 to start from the top. */
+    uint8_t ucState;
+} Coro_t;
+
+/*
+ * A group of co-routines and the host task state they share.  Declare one for
+ * each group and pass it to xCoroSchedulerCreate() before use.
+ */
+typedef struct xCORO_SCHEDULER
+{
+    Coro_t * pxFirst;
+    Coro_t * pxLast;
+    QueueSetHandle_t xQueueSet;  /**< The set the host task blocks on. */
+    QueueHandle_t xWakeSemaphore; /**< Given whenever a co-routine of the group is notified. */
+} CoroScheduler_t;
+
+/**
+ * coro.h
+ *
+ * @code{c}
+ * BaseType_t xCoroSchedulerCreate( CoroScheduler_t * const pxScheduler, const UBaseType_t uxQueueEventLength );
+ * @endcode
+ *
+ * Initialises a group of co-routines, creating the queue set and the
+ * semaphore its host task blocks on.
+ *
+ * configUSE_CORO_SCHEDULER, configUSE_QUEUE_SETS and
+ * configSUPPORT_DYNAMIC_ALLOCATION must all be set to 1 in FreeRTOSConfig.h
+ * for co-routines to be available.
+ *
+ * @param pxScheduler The group to initialise.
+ *
+ * @param uxQueueEventLength The sum of the lengths of all the queues that
+ * will be added with xCoroSchedulerAddQueue(), or 0 if the co-routines will
+ * not wait on queues.  The event of an item stays in the queue set after a
+ * co-routine has received the item, until the host task takes every event
+ * out of the set once the co-routines have run, so the set is created with
+ * room for twice this many events plus one for the semaphore.  That is enough
+ * as long as the co-routines of the group receive no more than
+ * uxQueueEventLength items from their queues between two waits.
+ *
+ * @return pdPASS if the group was initialised, or pdFAIL if there was not
+ * enough heap memory available.
+ *
+ * \defgroup xCoroSchedulerCreate xCoroSchedulerCreate
+ * \ingroup CoRoutines
+ */
+BaseType_t xCoroSchedulerCreate( CoroScheduler_t * const pxScheduler,
+                                 const UBaseType_t uxQueueEventLength ) PRIVILEGED_FUNCTION;
+
+/**
+ * coro.h
+ *
+ * @code{c}
+ * void vCoroSchedulerDelete( CoroScheduler_t * const pxScheduler );
+ * @endcode
+ *
+ * Frees the queue set and the semaphore of a group whose co-routines have
+ * all ended.  Queues added with xCoroSchedulerAddQueue() must have been
+ * deleted first, or be removed from the set with xQueueRemoveFromSet().
+ *
+ * @param pxScheduler The group to delete.
+ *
+ * \defgroup vCoroSchedulerDelete vCoroSchedulerDelete
+ * \ingroup CoRoutines
+ */
+void vCoroSchedulerDelete( CoroScheduler_t * const pxScheduler ) PRIVILEGED_FUNCTION;
+
+/**
+ * coro.h
+ *
+ * @code{c}
+ * BaseType_t xCoroSchedulerAddQueue( CoroScheduler_t * const pxScheduler, QueueHandle_t xQueue );
+ * @endcode
+ *
+ * Adds a queue to the group's queue set, so that co-routines of the group can
+ * wait on it with coroQUEUE_RECEIVE().  The queue must be empty, as it must
+ * be for xQueueAddToSet(), and cannot also be a member of another queue set.
+ * Tasks and interrupts send to it as usual.
+ *
+ * @param pxScheduler The group.
+ *
+ * @param xQueue The queue to add.
+ *
+ * @return pdPASS if the queue was added, otherwise pdFAIL.
+ *
+ * \defgroup xCoroSchedulerAddQueue xCoroSchedulerAddQueue
+ * \ingroup CoRoutines
+ */
+BaseType_t xCoroSchedulerAddQueue( CoroScheduler_t * const pxScheduler,
+                                   QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+
+/**
+ * coro.h
+ *
+ * @code{c}
+ * void vCoroCreate( CoroScheduler_t * const pxScheduler, Coro_t * const pxCoro, CoroFunction_t pxCoroFunction, void * pvParameters );
+ * @endcode
+ *
+ * Adds a co-routine to a group.  It first runs, from the top of
+ * pxCoroFunction, the next time the group's co-routines run.  Must be called
+ * either before the host task starts running the group or by a co-routine of
+ * the same group.  pxCoro can be reused once the co-routine has ended.
+ *
+ * @param pxScheduler The group the co-routine belongs to.
+ *
+ * @param pxCoro The co-routine's control block.  Must stay valid until the
+ * co-routine ends.
+ *
+ * @param pxCoroFunction The co-routine function, which must start with
+ * coroSTART() and end with coroEND().
+ *
+ * @param pvParameters Passed to every call of pxCoroFunction.
+ *
+ * Example usage:
+ * @code{c}
+ * static CoroScheduler_t xGroup;
+ * static Coro_t xBlinker;
+ *
+ * static void vBlink( Coro_t * pxCoro, void * pvParameters )
+ * {
+ * static TickType_t xLastWake;
+ * BaseType_t xWasDelayed;
+ *
+ *   coroSTART( pxCoro );
+ *
+ *   xLastWake = xTaskGetTickCount();
+ *
+ *   for( ;; )
+ *   {
+ *       vToggleLED();
+ *       coroDELAY_UNTIL( pxCoro, &xLastWake, pdMS_TO_TICKS( 500 ), &xWasDelayed );
+ *   }
+ *
+ *   coroEND( pxCoro );
+ * }
+ *
+ * void vStartBlinker( void )
+ * {
+ *   xCoroSchedulerCreate( &xGroup, 0 );
+ *   vCoroCreate( &xGroup, &xBlinker, vBlink, NULL );
+ *   xTaskCreate( vCoroSchedulerTask, "Coro", configMINIMAL_STACK_SIZE, &xGroup, 1, NULL );
+ * }
+ * @endcode
+ *
+ * \defgroup vCoroCreate vCoroCreate
+ * \ingroup CoRoutines
+ */
+void vCoroCreate( CoroScheduler_t * const pxScheduler,
+                  Coro_t * const pxCoro,
+                  CoroFunction_t pxCoroFunction,
+                  void * pvParameters ) PRIVILEGED_FUNCTION;
+
+/**
+ * coro.h
+ *
+ * @code{c}
+ * void vCoroSchedulerRun( CoroScheduler_t * const pxScheduler );
+ * @endcode
+ *
+ * Runs the co-routines of a group from the calling task, which becomes the
+ * group's host task, blocking whenever none of them is ready.  Returns once
+ * every co-routine of the group has ended.  The stack of the calling task
+ * must be large enough for the deepest co-routine of the group.
+ *
+ * @param pxScheduler The group to run.
+ *
+ * \defgroup vCoroSchedulerRun vCoroSchedulerRun
+ * \ingroup CoRoutines
+ */
+void vCoroSchedulerRun( CoroScheduler_t * const pxScheduler ) PRIVILEGED_FUNCTION;
+
+/**
+ * coro.h
+ *
+ * @code{c}
+ * void vCoroSchedulerTask( void * pvParameters );
+ * @endcode
+ *
+ * A task function that runs the group of co-routines passed as its parameter
+ * with vCoroSchedulerRun(), then deletes itself.
+ *
+ * @param pvParameters A pointer to the CoroScheduler_t to run.
+ *
+ * \defgroup vCoroSchedulerTask vCoroSchedulerTask
+ * \ingroup CoRoutines
+ */
+void vCoroSchedulerTask( void * pvParameters ) PRIVILEGED_FUNCTION;
+
+/**
+ * coro.h
+ *
+ * @code{c}
+ * BaseType_t xCoroNotifyGive( Coro_t * const pxCoro );
+ * @endcode
+ *
+ * Gives a notification to a co-routine, the equivalent of xTaskNotifyGive()
+ * for co-routines: increments its notification count and wakes its host task
+ * if necessary.  Can be called from any task, including from a co-routine.
+ *
+ * @param pxCoro The co-routine to notify.
+ *
+ * @return Always pdPASS.
+ *
+ * \defgroup xCoroNotifyGive xCoroNotifyGive
+ * \ingroup CoRoutines
+ */
+BaseType_t xCoroNotifyGive( Coro_t * const pxCoro ) PRIVILEGED_FUNCTION;
+
+/**
+ * coro.h
+ *
+ * @code{c}
+ * void vCoroNotifyGiveFromISR( Coro_t * const pxCoro, BaseType_t * const pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * A version of xCoroNotifyGive() that can be called from an interrupt
+ * service routine.
+ *
+ * @param pxCoro The co-routine to notify.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if waking the host task
+ * means a context switch should be requested before the interrupt exits.
+ *
+ * \defgroup vCoroNotifyGiveFromISR vCoroNotifyGiveFromISR
+ * \ingroup CoRoutines
+ */
+void vCoroNotifyGiveFromISR( Coro_t * const pxCoro,
+                             BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * coro.h
+ *
+ * @code{c}
+ * coroSTART( Coro_t * pxCoro );
+ * @endcode
+ *
+ * Must be the first statement of every co-routine function, after the
+ * declarations.
+ *
+ * \defgroup coroSTART coroSTART
+ * \ingroup CoRoutines
+ */
+
+/* *INDENT-OFF* */
+#define coroSTART( pxCoro )                     \
+    switch( ( pxCoro )->usResumePoint ) {       \
+        case 0:
+
+/**
+ * coro.h
+ *
+ * @code{c}
+ * coroEND( Coro_t * pxCoro );
+ * @endcode
+ *
+ * Must be the last statement of every co-routine function.  Reaching it ends
+ * the co-routine.  A co-routine function must not return other than by
+ * reaching coroEND() or one of the macros that wait.
+ *
+ * \defgroup coroEND coroEND
+ * \ingroup CoRoutines
+ */
+#define coroEND( pxCoro )    } ( pxCoro )->ucState = coroSTATE_ENDED
+/* *INDENT-ON* */
+
+/*
+ * This macro is intended for internal use by the co-routine implementation
+ * only.  It should not be used directly by application writers.
+ */
+#define coroSET_RESUME_POINT( pxCoro )                                 \
+    ( pxCoro )->usResumePoint = ( uint16_t ) __LINE__; return; \
+    case __LINE__:
+
+/**
+ * coro.h
+ *
+ * @code{c}
+ * coroYIELD( Coro_t * pxCoro );
+ * @endcode
+ *
+ * Lets the other ready co-routines of the group run before this one
+ * continues.
+ *
+ * \defgroup coroYIELD coroYIELD
+ * \ingroup CoRoutines
+ */
+#define coroYIELD( pxCoro )    coroDELAY( ( pxCoro ), 0 )
+
+/**
+ * coro.h
+ *
+ * @code{c}
+ * coroDELAY( Coro_t * pxCoro, TickType_t xTicksToDelay );
+ * @endcode
+ *
+ * Waits for a number of ticks, the equivalent of vTaskDelay().  A delay of
+ * zero is the same as coroYIELD().
+ *
+ * \defgroup coroDELAY coroDELAY
+ * \ingroup CoRoutines
+ */
+#define coroDELAY( pxCoro, xTicksToDelay )                   \
+    do {                                                     \
+        vCoroPrepareDelay( ( pxCoro ), ( xTicksToDelay ) ); \
+        coroSET_RESUME_POINT( ( pxCoro ) );                  \
+    } while( 0 )
+
+/**
+ * coro.h
+ *
+ * @code{c}
+ * coroDELAY_UNTIL( Coro_t * pxCoro, TickType_t * pxPreviousWakeTime, TickType_t xTimeIncrement, BaseType_t * pxWasDelayed );
+ * @endcode
+ *
+ * Waits until a periodic wake time, the equivalent of xTaskDelayUntil().
+ * *pxPreviousWakeTime must keep its value while the co-routine waits, so it
+ * cannot be a local variable.
+ *
+ * @param pxWasDelayed Set to pdTRUE if the co-routine waited, or to pdFALSE
+ * if the wake time had already passed.
+ *
+ * \defgroup coroDELAY_UNTIL coroDELAY_UNTIL
+ * \ingroup CoRoutines
+ */
+#define coroDELAY_UNTIL( pxCoro, pxPreviousWakeTime, xTimeIncrement, pxWasDelayed )                      \
+    do {                                                                                                \
+        if( xCoroPrepareDelayUntil( ( pxCoro ), ( pxPreviousWakeTime ), ( xTimeIncrement ) ) != pdFALSE ) \
+        {                                                                                               \
+            coroSET_RESUME_POINT( ( pxCoro ) );                                                         \
+            *( pxWasDelayed ) = pdTRUE;                                                                 \
+        }                                                                                               \
+        else                                                                                            \
+        {                                                                                               \
+            *( pxWasDelayed ) = pdFALSE;                                                                \
+        }                                                                                               \
+    } while( 0 )
+
+/**
+ * coro.h
+ *
+ * @code{c}
+ * coroNOTIFY_TAKE( Coro_t * pxCoro, BaseType_t xClearCountOnExit, TickType_t xTicksToWait, uint32_t * pulResult );
+ * @endcode
+ *
+ * Waits for a notification given by xCoroNotifyGive() or
+ * vCoroNotifyGiveFromISR(), the equivalent of ulTaskNotifyTake().
+ *
+ * @param xClearCountOnExit pdTRUE to clear the notification count, pdFALSE to
+ * decrement it.
+ *
+ * @param xTicksToWait The longest time to wait, or portMAX_DELAY to wait
+ * indefinitely.
+ *
+ * @param pulResult Set to the notification count before it was cleared or
+ * decremented, or to 0 if the wait timed out.
+ *
+ * \defgroup coroNOTIFY_TAKE coroNOTIFY_TAKE
+ * \ingroup CoRoutines
+ */
+#define coroNOTIFY_TAKE( pxCoro, xClearCountOnExit, xTicksToWait, pulResult )                                      \
+    do {                                                                                                           \
+        vCoroSetTimeOut( ( pxCoro ), ( xTicksToWait ) );                                                           \
+        while( ( ( *( pulResult ) = ulCoroTakeNotification( ( pxCoro ), ( xClearCountOnExit ) ) ) == 0U ) &&     \
+               ( xCoroPrepareWait( ( pxCoro ), coroSTATE_WAITING_NOTIFICATION, NULL ) != pdFALSE ) )            \
+        {                                                                                                          \
+            coroSET_RESUME_POINT( ( pxCoro ) );                                                                    \
+        }                                                                                                          \
+    } while( 0 )
+
+/**
+ * coro.h
+ *
+ * @code{c}
+ * coroQUEUE_RECEIVE( Coro_t * pxCoro, QueueHandle_t xQueue, void * pvBuffer, TickType_t xTicksToWait, BaseType_t * pxResult );
+ * @endcode
+ *
+ * Waits for an item and receives it from a queue that was added to the group
+ * with xCoroSchedulerAddQueue(), the equivalent of xQueueReceive().
+ *
+ * @param xTicksToWait The longest time to wait, or portMAX_DELAY to wait
+ * indefinitely.
+ *
+ * @param pxResult Set to pdPASS if an item was received, otherwise to
+ * errQUEUE_EMPTY.
+ *
+ * \defgroup coroQUEUE_RECEIVE coroQUEUE_RECEIVE
+ * \ingroup CoRoutines
+ */
+#define coroQUEUE_RECEIVE( pxCoro, xQueue, pvBuffer, xTicksToWait, pxResult )                           \
+    do {                                                                                                \
+        vCoroSetTimeOut( ( pxCoro ), ( xTicksToWait ) );                                                \
+        while( ( ( *( pxResult ) = xQueueReceive( ( xQueue ), ( pvBuffer ), 0 ) ) != pdPASS ) &&        \
+               ( xCoroPrepareWait( ( pxCoro ), coroSTATE_WAITING_QUEUE, ( xQueue ) ) != pdFALSE ) ) \
+        {                                                                                               \
+            coroSET_RESUME_POINT( ( pxCoro ) );                                                         \
+        }                                                                                               \
+    } while( 0 )
+
+/*
+ * These functions are intended for internal use by the co-routine macros
+ * only.  The macro nature of the co-routine implementation requires that the
+ * prototypes appear here.  The functions should not be used by application
+ * writers.
+ */
+void vCoroPrepareDelay( Coro_t * const pxCoro,
+                        const TickType_t xTicksToDelay ) PRIVILEGED_FUNCTION;
+BaseType_t xCoroPrepareDelayUntil( Coro_t * const pxCoro,
+                                   TickType_t * const pxPreviousWakeTime,
+                                   const TickType_t xTimeIncrement ) PRIVILEGED_FUNCTION;
+void vCoroSetTimeOut( Coro_t * const pxCoro,
+                      const TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+BaseType_t xCoroPrepareWait( Coro_t * const pxCoro,
+                             const uint8_t ucState,
+                             QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+uint32_t ulCoroTakeNotification( Coro_t * const pxCoro,
+                                 const BaseType_t xClearCountOnExit ) PRIVILEGED_FUNCTION;
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* !defined( CORO_H ) */
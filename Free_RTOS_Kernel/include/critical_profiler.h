@@ -0,0 +1,147 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+
+
+/*
+ * The critical section profiler measures how long interrupts stay masked.
+ * When configUSE_CRITICAL_PROFILER is 1, taskENTER_CRITICAL(),
+ * taskEXIT_CRITICAL(), taskENTER_CRITICAL_FROM_ISR() and
+ * taskEXIT_CRITICAL_FROM_ISR() time each outermost critical section with
+ * configCRITICAL_PROFILER_TIMESTAMP() and attribute it to the call site - the
+ * file and line - of the taskENTER_CRITICAL() or taskENTER_CRITICAL_FROM_ISR()
+ * that opened it.  Nested critical sections are counted as part of the one
+ * that encloses them.  The bodies of xTaskIncrementTick() and
+ * vTaskSwitchContext(), which the port calls with interrupts already masked,
+ * are measured as sites of their own.
+ *
+ * For each call site the number of critical sections, their total and longest
+ * duration and a histogram of durations are kept.  Histogram bucket 0 counts
+ * critical sections shorter than one timestamp unit and bucket n counts those
+ * of at least 2^(n-1) and less than 2^n units, except that the last bucket
+ * also counts everything longer.
+ *
+ * configCRITICAL_PROFILER_TIMESTAMP() defaults to
+ * portGET_RUN_TIME_COUNTER_VALUE(), so the durations are in the units of the
+ * run time stats counter.  It is read twice for every outermost critical
+ * section, and the time taken to read it and to update the statistics is
+ * included in the durations, so it should be a free running counter that is
+ * cheap to read.  Critical sections that are shorter than one unit are only
+ * counted, not timed, so a counter with a finer resolution gives more useful
+ * figures for the short ones.
+ *
+ * Set configUSE_CRITICAL_PROFILER to 0 in FreeRTOSConfig.h to remove the
+ * profiler completely: the critical section macros are then exactly the port
+ * macros, as they are without the profiler.  It is only supported by the single
+ * core scheduler.
+ *
+ * At most configCRITICAL_PROFILER_SITES call sites are recorded.  Critical
+ * sections opened at any further call site are counted against a shared site
+ * whose file is NULL.
+ */
+
+#ifndef CRITICAL_PROFILER_H
+#define CRITICAL_PROFILER_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h must appear in source files before include critical_profiler.h"
+#endif
+
+#include "task.h"
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/**
+ * Used with uxCriticalProfilerGetSiteStats() to read the critical sections
+ * attributed to one call site.
+ */
+typedef struct xCRITICAL_SITE_STATS
+{
+    const char * pcFile;                                      /* __FILE__ where the critical sections were entered, or NULL for the shared site. */
+    uint32_t ulLine;                                          /* __LINE__ where the critical sections were entered. */
+    uint32_t ulCount;                                         /* The number of critical sections measured. */
+    uint64_t ullTotalTime;                                    /* The sum of their durations. */
+    uint64_t ullMaxTime;                                      /* The longest of their durations. */
+    uint32_t ulHistogram[ configCRITICAL_PROFILER_BUCKETS ]; /* The number of critical sections in each duration bucket. */
+} CriticalSiteStats_t;
+
+/**
+ * critical_profiler.h
+ *
+ * @code{c}
+ * UBaseType_t uxCriticalProfilerGetSiteStats( CriticalSiteStats_t * const pxSiteStatsArray, const UBaseType_t uxArraySize );
+ * @endcode
+ *
+ * Copies the figures for every call site that has entered a critical section
+ * into an array, so the sites that keep interrupts masked longest can be
+ * found.  The array is not sorted.
+ *
+ * The figures are copied with interrupts masked, but that critical section is
+ * not itself measured, so reading the figures does not add to them.
+ *
+ * @param pxSiteStatsArray The array the figures are copied into.
+ *
+ * @param uxArraySize The number of elements in pxSiteStatsArray.  An array of
+ * configCRITICAL_PROFILER_SITES + 1 elements is always large enough.
+ *
+ * @return The number of elements of pxSiteStatsArray that were filled in.
+ *
+ * \defgroup uxCriticalProfilerGetSiteStats uxCriticalProfilerGetSiteStats
+ * \ingroup CriticalProfiler
+ */
+UBaseType_t uxCriticalProfilerGetSiteStats( CriticalSiteStats_t * const pxSiteStatsArray,
+                                            const UBaseType_t uxArraySize ) PRIVILEGED_FUNCTION;
+
+/**
+ * critical_profiler.h
+ *
+ * @code{c}
+ * void vCriticalProfilerReset( void );
+ * @endcode
+ *
+ * Forgets every call site and its figures - for example, to measure only the
+ * critical sections of a steady state once start up is over.  A critical
+ * section that is open when vCriticalProfilerReset() is called is still
+ * measured when it exits.
+ *
+ * \defgroup vCriticalProfilerReset vCriticalProfilerReset
+ * \ingroup CriticalProfiler
+ */
+void vCriticalProfilerReset( void ) PRIVILEGED_FUNCTION;
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* !defined( CRITICAL_PROFILER_H ) */
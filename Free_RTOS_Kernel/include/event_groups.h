@@ -229,6 +229,100 @@ typedef TickType_t               EventBits_t;
     EventGroupHandle_t xEventGroupCreateStatic( StaticEventGroup_t * pxEventGroupBuffer ) PRIVILEGED_FUNCTION;
 #endif
 
+/**
+ * event_groups.h
+ * @code{c}
+ * EventGroupHandle_t xEventGroupCreateIndexed( void );
+ * @endcode
+ *
+ * Create a new event group that keeps a separate list of waiting tasks for
+ * each event bit.
+ *
+ * A task that waits for exactly one bit in an indexed event group is held on
+ * that bit's list, so xEventGroupSetBits() only examines the tasks waiting for
+ * the bits being set rather than every task blocked on the event group.  Tasks
+ * that wait for more than one bit are held on a shared list that is examined on
+ * every call to xEventGroupSetBits(), as with an event group created by
+ * xEventGroupCreate().  Indexing therefore pays off when many tasks each wait
+ * on their own bit of the same event group.
+ *
+ * The per-bit lists are allocated with the event group, so an indexed event
+ * group uses one List_t of extra heap per usable event bit (see
+ * xEventGroupCreate() for the number of usable bits).
+ *
+ * The configUSE_EVENT_GROUPS and configUSE_INDEXED_EVENT_GROUPS
+ * configuration constants must be set to 1, and configSUPPORT_DYNAMIC_ALLOCATION
+ * must be set to 1, for xEventGroupCreateIndexed() to be available.
+ *
+ * @return If the event group was created then a handle to the event group is
+ * returned.  If there was insufficient FreeRTOS heap available to create the
+ * event group then NULL is returned.
+ *
+ * Example usage:
+ * @code{c}
+ *  #define BIT_FROM_UART   ( 1 << 0 )
+ *  #define BIT_FROM_ADC    ( 1 << 1 )
+ *
+ *  EventGroupHandle_t xEventGroup = xEventGroupCreateIndexed();
+ *
+ *  // In the UART task - only setting BIT_FROM_UART looks at this task.
+ *  xEventGroupWaitBits( xEventGroup, BIT_FROM_UART, pdTRUE, pdFALSE, portMAX_DELAY );
+ *
+ *  // In the ADC task - only setting BIT_FROM_ADC looks at this task.
+ *  xEventGroupWaitBits( xEventGroup, BIT_FROM_ADC, pdTRUE, pdFALSE, portMAX_DELAY );
+ * @endcode
+ * \defgroup xEventGroupCreateIndexed xEventGroupCreateIndexed
+ * \ingroup EventGroup
+ */
+#if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configUSE_INDEXED_EVENT_GROUPS == 1 ) )
+    EventGroupHandle_t xEventGroupCreateIndexed( void ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * event_groups.h
+ * @code{c}
+ * EventGroupHandle_t xEventGroupCreateDirect( void );
+ * EventGroupHandle_t xEventGroupCreateDirectStatic( StaticEventGroup_t * pxEventGroupBuffer );
+ * @endcode
+ *
+ * Create a new event group whose bits can be set from an interrupt with
+ * xEventGroupSetBitsDirectFromISR().
+ *
+ * xEventGroupSetBitsFromISR() cannot access the list of tasks waiting on an
+ * event group, so it defers setting the bits to the RTOS daemon (timer service)
+ * task, and a waiting task is only unblocked after the daemon task has run.
+ * xEventGroupSetBitsDirectFromISR() instead sets the bits and unblocks the
+ * waiting tasks from within the interrupt.  To make that possible, tasks access
+ * the wait list of a direct event group from a critical section rather than
+ * with the scheduler suspended, and the number of tasks that can wait on the
+ * event group at any one time is limited to
+ * configDIRECT_EVENT_GROUP_MAX_WAITERS so the time spent in the interrupt and
+ * in those critical sections is bounded.  configASSERT() fails if a task
+ * attempts to exceed that limit.
+ *
+ * In all other respects a direct event group behaves as, and is used with the
+ * same API functions as, an event group created with xEventGroupCreate() or
+ * xEventGroupCreateStatic().
+ *
+ * The configUSE_EVENT_GROUPS and configUSE_DIRECT_EVENT_GROUPS configuration
+ * constants must be set to 1 for these functions to be available.
+ *
+ * @param pxEventGroupBuffer As for xEventGroupCreateStatic().
+ *
+ * @return If the event group was created then a handle to the event group is
+ * returned, otherwise NULL is returned.
+ *
+ * \defgroup xEventGroupCreateDirect xEventGroupCreateDirect
+ * \ingroup EventGroup
+ */
+#if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configUSE_DIRECT_EVENT_GROUPS == 1 ) )
+    EventGroupHandle_t xEventGroupCreateDirect( void ) PRIVILEGED_FUNCTION;
+#endif
+
+#if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configUSE_DIRECT_EVENT_GROUPS == 1 ) )
+    EventGroupHandle_t xEventGroupCreateDirectStatic( StaticEventGroup_t * pxEventGroupBuffer ) PRIVILEGED_FUNCTION;
+#endif
+
 /**
  * event_groups.h
  * @code{c}
@@ -616,6 +710,63 @@ EventBits_t xEventGroupSetBits( EventGroupHandle_t xEventGroup,
     xTimerPendFunctionCallFromISR( vEventGroupSetBitsCallback, ( void * ) ( xEventGroup ), ( uint32_t ) ( uxBitsToSet ), ( pxHigherPriorityTaskWoken ) )
 #endif
 
+/**
+ * event_groups.h
+ * @code{c}
+ *  EventBits_t xEventGroupSetBitsDirectFromISR( EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToSet, BaseType_t *pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * A version of xEventGroupSetBits() that can be called from an interrupt, for
+ * use with event groups created by xEventGroupCreateDirect() or
+ * xEventGroupCreateDirectStatic().
+ *
+ * Unlike xEventGroupSetBitsFromISR(), the bits are set and any tasks whose
+ * wait condition is met are unblocked before the function returns, without
+ * involving the RTOS daemon task, so the latency from the interrupt to the
+ * waiting task does not depend on configTIMER_TASK_PRIORITY or on the timer
+ * command queue having space.  The time spent in the function grows with the
+ * number of tasks waiting on the event group, which is limited to
+ * configDIRECT_EVENT_GROUP_MAX_WAITERS.
+ *
+ * @param xEventGroup The direct event group in which the bits are to be set.
+ *
+ * @param uxBitsToSet A bitwise value that indicates the bit or bits to set.
+ *
+ * @param pxHigherPriorityTaskWoken *pxHigherPriorityTaskWoken is set to pdTRUE
+ * if setting the bits unblocked a task that has a priority above that of the
+ * interrupted task, in which case a context switch should be requested before
+ * the interrupt exits.  It can be NULL.
+ *
+ * @return The value of the event group after the bits were set and the bits of
+ * any tasks that were unblocked with xClearOnExit set were cleared.
+ *
+ * Example usage:
+ * @code{c}
+ * #define BIT_0    ( 1 << 0 )
+ *
+ * // An event group which it is assumed has already been created by a call to
+ * // xEventGroupCreateDirect().
+ * EventGroupHandle_t xEventGroup;
+ *
+ * void anInterruptHandler( void )
+ * {
+ * BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+ *
+ *  xEventGroupSetBitsDirectFromISR( xEventGroup, BIT_0, &xHigherPriorityTaskWoken );
+ *
+ *  // The task waiting for BIT_0, if any, is already in the Ready state.
+ *  portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+ * }
+ * @endcode
+ * \defgroup xEventGroupSetBitsDirectFromISR xEventGroupSetBitsDirectFromISR
+ * \ingroup EventGroup
+ */
+#if ( configUSE_DIRECT_EVENT_GROUPS == 1 )
+    EventBits_t xEventGroupSetBitsDirectFromISR( EventGroupHandle_t xEventGroup,
+                                                 const EventBits_t uxBitsToSet,
+                                                 BaseType_t * pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+#endif
+
 /**
  * event_groups.h
  * @code{c}
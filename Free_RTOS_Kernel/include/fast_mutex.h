@@ -0,0 +1,213 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Fast mutexes are an alternative to the mutex type semaphores created by
+ * xSemaphoreCreateMutex() for the common case where the mutex is rarely
+ * contended.  Taking a free mutex, and giving back a mutex no other task is
+ * waiting for, is a single atomic compare and swap on a lock word (see
+ * atomic.h) rather than a call into the queue implementation with its critical
+ * sections.  Only when a task finds the mutex held do the take and give
+ * functions fall back to suspending the scheduler, blocking the task and
+ * applying priority inheritance, in the same way as a mutex type semaphore.
+ *
+ * Fast mutexes cannot be used from interrupts, are not recursive, and cannot
+ * be added to queue sets.
+ */
+
+#ifndef FAST_MUTEX_H
+#define FAST_MUTEX_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h must appear in source files before include fast_mutex.h"
+#endif
+
+#include "task.h"
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/**
+ * Type by which fast mutexes are referenced.  For example, a call to
+ * xFastMutexCreate() returns a FastMutexHandle_t variable that can then be
+ * used as a parameter to xFastMutexTake(), xFastMutexGive(), etc.
+ */
+struct FastMutexDef_t;
+typedef struct FastMutexDef_t * FastMutexHandle_t;
+
+/**
+ * fast_mutex.h
+ *
+ * @code{c}
+ * FastMutexHandle_t xFastMutexCreate( void );
+ * @endcode
+ *
+ * Creates a new fast mutex using dynamically allocated memory.  The mutex is
+ * created in the free state.
+ *
+ * configUSE_FAST_MUTEXES, configUSE_MUTEXES and
+ * configSUPPORT_DYNAMIC_ALLOCATION must all be set to 1 in FreeRTOSConfig.h
+ * for xFastMutexCreate() to be available.
+ *
+ * @return If the mutex is created successfully then a handle to the created
+ * mutex is returned.  If there was not enough heap memory available to create
+ * the mutex then NULL is returned.
+ *
+ * \defgroup xFastMutexCreate xFastMutexCreate
+ * \ingroup FastMutexManagement
+ */
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+    FastMutexHandle_t xFastMutexCreate( void ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * fast_mutex.h
+ *
+ * @code{c}
+ * FastMutexHandle_t xFastMutexCreateStatic( StaticFastMutex_t *pxStaticMutex );
+ * @endcode
+ *
+ * Creates a new fast mutex using statically allocated memory.
+ *
+ * @param pxStaticMutex Must point to a variable of type StaticFastMutex_t,
+ * which will be used to hold the mutex's data structure.
+ *
+ * @return A handle to the created mutex, or NULL if pxStaticMutex was NULL.
+ *
+ * \defgroup xFastMutexCreateStatic xFastMutexCreateStatic
+ * \ingroup FastMutexManagement
+ */
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+    FastMutexHandle_t xFastMutexCreateStatic( StaticFastMutex_t * pxStaticMutex ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * fast_mutex.h
+ *
+ * @code{c}
+ * BaseType_t xFastMutexTake( FastMutexHandle_t xMutex, TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Takes a fast mutex.  Must not be called from an interrupt, and must not be
+ * called by the task that already holds the mutex.
+ *
+ * If the mutex is held by another task, the calling task blocks for at most
+ * xTicksToWait ticks waiting for it, and the holder inherits the calling task's
+ * priority while the calling task is blocked, exactly as with
+ * xSemaphoreTake() on a mutex type semaphore.
+ *
+ * @param xMutex The mutex being taken.
+ *
+ * @param xTicksToWait The maximum amount of time the task should remain in the
+ * Blocked state to wait for the mutex if it is not free.
+ *
+ * @return pdPASS if the mutex was taken, otherwise errQUEUE_EMPTY.
+ *
+ * Example usage:
+ * @code{c}
+ * FastMutexHandle_t xMutex = xFastMutexCreate();
+ *
+ * void vATask( void * pvParameters )
+ * {
+ *  if( xFastMutexTake( xMutex, portMAX_DELAY ) == pdPASS )
+ *  {
+ *      // Access the shared resource.
+ *
+ *      xFastMutexGive( xMutex );
+ *  }
+ * }
+ * @endcode
+ * \defgroup xFastMutexTake xFastMutexTake
+ * \ingroup FastMutexManagement
+ */
+BaseType_t xFastMutexTake( FastMutexHandle_t xMutex,
+                           TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * fast_mutex.h
+ *
+ * @code{c}
+ * BaseType_t xFastMutexGive( FastMutexHandle_t xMutex );
+ * @endcode
+ *
+ * Gives back a fast mutex held by the calling task.  If tasks are blocked on
+ * the mutex the highest priority one is unblocked, and any priority the
+ * calling task inherited is disinherited.
+ *
+ * @param xMutex The mutex being given back.
+ *
+ * @return pdPASS if the mutex was given back, or pdFAIL if the calling task
+ * was not the holder.
+ *
+ * \defgroup xFastMutexGive xFastMutexGive
+ * \ingroup FastMutexManagement
+ */
+BaseType_t xFastMutexGive( FastMutexHandle_t xMutex ) PRIVILEGED_FUNCTION;
+
+/**
+ * fast_mutex.h
+ *
+ * @code{c}
+ * TaskHandle_t xFastMutexGetHolder( FastMutexHandle_t xMutex );
+ * @endcode
+ *
+ * Returns the handle of the task that holds the mutex, or NULL if the mutex
+ * is free.  The result can be out of date by the time it is used, so this is
+ * only reliable when called by the holder to check it holds the mutex.
+ *
+ * \defgroup xFastMutexGetHolder xFastMutexGetHolder
+ * \ingroup FastMutexManagement
+ */
+TaskHandle_t xFastMutexGetHolder( FastMutexHandle_t xMutex ) PRIVILEGED_FUNCTION;
+
+/**
+ * fast_mutex.h
+ *
+ * @code{c}
+ * void vFastMutexDelete( FastMutexHandle_t xMutex );
+ * @endcode
+ *
+ * Deletes a mutex that was created with xFastMutexCreate() or
+ * xFastMutexCreateStatic().  The mutex must be free and no tasks may be
+ * blocked on it.
+ *
+ * \defgroup vFastMutexDelete vFastMutexDelete
+ * \ingroup FastMutexManagement
+ */
+void vFastMutexDelete( FastMutexHandle_t xMutex ) PRIVILEGED_FUNCTION;
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* !defined( FAST_MUTEX_H ) */
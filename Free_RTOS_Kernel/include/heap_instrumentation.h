@@ -0,0 +1,156 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+
+
+/*
+ * Heap instrumentation records every pvPortMalloc() and vPortFree() through the
+ * traceMALLOC() and traceFREE() hooks the heap implementations already call,
+ * so it works with any of them and needs no change to the heap itself.  Each
+ * allocation is attributed to a tag - the pair of the address pvPortMalloc()
+ * was called from and the task that called it - and the live bytes, live
+ * blocks and peak live bytes of each tag are kept up to date.
+ * vHeapGetSnapshot() combines those figures with vPortGetHeapStats() to give
+ * the largest free block and a fragmentation index.
+ *
+ * Sizes are those the heap passes to traceMALLOC(): the number of bytes
+ * requested plus the heap's block header and alignment padding.  They can be
+ * slightly less than the heap's own figures, because the heap hands out a
+ * whole free block when the remainder would be too small to split off.
+ *
+ * Set configUSE_HEAP_INSTRUMENTATION to 0 in FreeRTOSConfig.h to remove the
+ * instrumentation completely: the hooks then expand to nothing.  When it is 1,
+ * traceMALLOC() and traceFREE() must not also be defined in FreeRTOSConfig.h,
+ * and the heap implementation must provide vPortGetHeapStats() (heap_4.c,
+ * heap_5.c and heap_tlsf.c do).
+ *
+ * At most configHEAP_INSTRUMENTATION_TAGS tags exist at once.  When they are
+ * all in use, a new call site reuses a tag whose blocks have all been freed, or
+ * if there is none its allocations are counted against a shared tag whose call
+ * site and owner are NULL.  At most configHEAP_INSTRUMENTATION_BLOCKS blocks
+ * are tracked at once; further blocks are only counted in
+ * xUntrackedAllocations.
+ */
+
+#ifndef HEAP_INSTRUMENTATION_H
+#define HEAP_INSTRUMENTATION_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h must appear in source files before include heap_instrumentation.h"
+#endif
+
+#include "task.h"
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/**
+ * Used with uxHeapGetTagStats() to read the allocations attributed to one tag.
+ */
+typedef struct xHEAP_TAG_STATS
+{
+    void * pvCallSite;         /* The address pvPortMalloc() was called from. */
+    TaskHandle_t xOwner;       /* The task that called pvPortMalloc(), or NULL if the scheduler had not started.  The task may since have been deleted. */
+    size_t xLiveBytes;         /* The bytes currently allocated. */
+    size_t xPeakLiveBytes;     /* The most bytes that have been allocated at once. */
+    UBaseType_t uxLiveBlocks;  /* The blocks currently allocated. */
+    UBaseType_t uxAllocations; /* The total number of successful allocations. */
+} HeapTagStats_t;
+
+/**
+ * Used with vHeapGetSnapshot() to read the state of the whole heap.
+ */
+typedef struct xHEAP_SNAPSHOT
+{
+    size_t xFreeBytes;                /* The sum of all the free blocks. */
+    size_t xMinimumEverFreeBytes;     /* The lowest xFreeBytes has been since the system booted. */
+    size_t xLargestFreeBlock;         /* The size of the largest free block, which bounds the largest allocation that can succeed. */
+    size_t xFreeBlocks;               /* The number of free blocks. */
+    UBaseType_t uxFragmentationIndex; /* 1000 * ( xFreeBytes - xLargestFreeBlock ) / xFreeBytes: 0 when the free space is contiguous, approaching 1000 as it is split up. */
+    size_t xLiveBytes;                /* The bytes currently allocated, over all tags. */
+    size_t xPeakLiveBytes;            /* The most bytes that have been allocated at once. */
+    size_t xFailedAllocations;        /* The number of calls to pvPortMalloc() that returned NULL. */
+    size_t xLastFailedSize;           /* The size, as adjusted by the heap, of the most recent failed allocation. */
+    void * pvLastFailedCallSite;      /* The address the most recent failed allocation was requested from. */
+    size_t xUntrackedAllocations;     /* Allocations not attributed to any tag because configHEAP_INSTRUMENTATION_BLOCKS blocks were already tracked. */
+    UBaseType_t uxTagsInUse;          /* The number of tags with live blocks. */
+} HeapSnapshot_t;
+
+/**
+ * heap_instrumentation.h
+ *
+ * @code{c}
+ * UBaseType_t uxHeapGetTagStats( HeapTagStats_t * const pxTagStatsArray, const UBaseType_t uxArraySize );
+ * @endcode
+ *
+ * Copies the figures for every tag that has been used into an array, so the
+ * owner of every allocation can be found - for example, to find which call
+ * site is leaking.
+ *
+ * @param pxTagStatsArray The array the figures are copied into.
+ *
+ * @param uxArraySize The number of elements in pxTagStatsArray.  An array of
+ * configHEAP_INSTRUMENTATION_TAGS + 1 elements is always large enough.
+ *
+ * @return The number of elements of pxTagStatsArray that were filled in.
+ *
+ * \defgroup uxHeapGetTagStats uxHeapGetTagStats
+ * \ingroup HeapInstrumentation
+ */
+UBaseType_t uxHeapGetTagStats( HeapTagStats_t * const pxTagStatsArray,
+                               const UBaseType_t uxArraySize ) PRIVILEGED_FUNCTION;
+
+/**
+ * heap_instrumentation.h
+ *
+ * @code{c}
+ * void vHeapGetSnapshot( HeapSnapshot_t *pxSnapshot );
+ * @endcode
+ *
+ * Fills in a HeapSnapshot_t with the current state of the heap.  The structure
+ * is small and holds no pointers into the heap, so it can be copied out as it
+ * is - for example, sent over a serial link at a regular interval to watch how
+ * fragmentation develops over a long run.
+ *
+ * @param pxSnapshot The structure to fill in.
+ *
+ * \defgroup vHeapGetSnapshot vHeapGetSnapshot
+ * \ingroup HeapInstrumentation
+ */
+void vHeapGetSnapshot( HeapSnapshot_t * pxSnapshot ) PRIVILEGED_FUNCTION;
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* !defined( HEAP_INSTRUMENTATION_H ) */
@@ -958,6 +958,86 @@ typedef StreamBufferHandle_t MessageBufferHandle_t;
 #define xMessageBufferReceiveCompletedFromISR( xMessageBuffer, pxHigherPriorityTaskWoken ) \
     xStreamBufferReceiveCompletedFromISR( ( xMessageBuffer ), ( pxHigherPriorityTaskWoken ) )
 
+#if ( configUSE_STREAM_BUFFER_VECTORED_IO == 1 )
+
+/**
+ * message_buffer.h
+ *
+ * @code{c}
+ * size_t xMessageBufferSendVectored( MessageBufferHandle_t xMessageBuffer,
+ *                                    const StreamBufferVector_t * pxVectors,
+ *                                    size_t xVectorCount,
+ *                                    TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Sends one message made up of several segments, such as a header and a
+ * payload, without assembling it in a temporary buffer first.  See
+ * xStreamBufferSendVectored().
+ *
+ * \defgroup xMessageBufferSendVectored xMessageBufferSendVectored
+ * \ingroup MessageBufferManagement
+ */
+    #define xMessageBufferSendVectored( xMessageBuffer, pxVectors, xVectorCount, xTicksToWait ) \
+    xStreamBufferSendVectored( ( xMessageBuffer ), ( pxVectors ), ( xVectorCount ), ( xTicksToWait ) )
+
+/**
+ * message_buffer.h
+ *
+ * @code{c}
+ * size_t xMessageBufferSendVectoredFromISR( MessageBufferHandle_t xMessageBuffer,
+ *                                           const StreamBufferVector_t * pxVectors,
+ *                                           size_t xVectorCount,
+ *                                           BaseType_t * const pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * Interrupt safe version of xMessageBufferSendVectored().
+ *
+ * \defgroup xMessageBufferSendVectoredFromISR xMessageBufferSendVectoredFromISR
+ * \ingroup MessageBufferManagement
+ */
+    #define xMessageBufferSendVectoredFromISR( xMessageBuffer, pxVectors, xVectorCount, pxHigherPriorityTaskWoken ) \
+    xStreamBufferSendVectoredFromISR( ( xMessageBuffer ), ( pxVectors ), ( xVectorCount ), ( pxHigherPriorityTaskWoken ) )
+
+/**
+ * message_buffer.h
+ *
+ * @code{c}
+ * size_t xMessageBufferReceiveVectored( MessageBufferHandle_t xMessageBuffer,
+ *                                       const StreamBufferVector_t * pxVectors,
+ *                                       size_t xVectorCount,
+ *                                       TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Receives the next message, scattering it across several segments.  The
+ * segments together must be large enough for the whole message.  See
+ * xStreamBufferReceiveVectored().
+ *
+ * \defgroup xMessageBufferReceiveVectored xMessageBufferReceiveVectored
+ * \ingroup MessageBufferManagement
+ */
+    #define xMessageBufferReceiveVectored( xMessageBuffer, pxVectors, xVectorCount, xTicksToWait ) \
+    xStreamBufferReceiveVectored( ( xMessageBuffer ), ( pxVectors ), ( xVectorCount ), ( xTicksToWait ) )
+
+/**
+ * message_buffer.h
+ *
+ * @code{c}
+ * size_t xMessageBufferReceiveVectoredFromISR( MessageBufferHandle_t xMessageBuffer,
+ *                                              const StreamBufferVector_t * pxVectors,
+ *                                              size_t xVectorCount,
+ *                                              BaseType_t * const pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * Interrupt safe version of xMessageBufferReceiveVectored().
+ *
+ * \defgroup xMessageBufferReceiveVectoredFromISR xMessageBufferReceiveVectoredFromISR
+ * \ingroup MessageBufferManagement
+ */
+    #define xMessageBufferReceiveVectoredFromISR( xMessageBuffer, pxVectors, xVectorCount, pxHigherPriorityTaskWoken ) \
+    xStreamBufferReceiveVectoredFromISR( ( xMessageBuffer ), ( pxVectors ), ( xVectorCount ), ( pxHigherPriorityTaskWoken ) )
+
+#endif /* configUSE_STREAM_BUFFER_VECTORED_IO */
+
 /* *INDENT-OFF* */
 #if defined( __cplusplus )
     } /* extern "C" */
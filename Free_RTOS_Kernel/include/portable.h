@@ -183,6 +183,45 @@ void vPortDefineHeapRegions( const HeapRegion_t * const pxHeapRegions ) PRIVILEG
  */
 void vPortGetHeapStats( HeapStats_t * pxHeapStats );
 
+/*
+ * Called by the heap, through traceMALLOC() and traceFREE(), when
+ * configUSE_HEAP_INSTRUMENTATION is 1.  Implemented in heap_instrumentation.c.
+ * vHeapInstrumentationSetCallSite() is called, with the scheduler suspended,
+ * by code that wraps pvPortMalloc() so the allocations it makes are attributed
+ * to pvCallSite rather than to the wrapper, until it is called again with
+ * NULL.
+ */
+#if ( configUSE_HEAP_INSTRUMENTATION == 1 )
+    void vHeapInstrumentationRecordMalloc( void * pvAddress,
+                                           size_t xSize,
+                                           void * pvCallSite ) PRIVILEGED_FUNCTION;
+    void vHeapInstrumentationRecordFree( void * pvAddress ) PRIVILEGED_FUNCTION;
+    void vHeapInstrumentationSetCallSite( void * pvCallSite ) PRIVILEGED_FUNCTION;
+#endif
+
+/*
+ * Passed to pvPortMallocInRegion() and xTaskCreateInRegion() when the block
+ * can come from any heap region.
+ */
+#define portHEAP_REGION_ANY    ( ( BaseType_t ) -1 )
+
+/*
+ * Heaps that keep each region passed to vPortDefineHeapRegions() separate
+ * (heap_banked.c) can place a block in a chosen region - the index of the
+ * region in the array passed - and report statistics for each region.  If the
+ * region chosen cannot satisfy the request, the block comes from another
+ * region.
+ */
+#if ( configUSE_HEAP_REGION_HINTS == 1 )
+    void * pvPortMallocInRegion( size_t xWantedSize,
+                                 BaseType_t xRegion ) PRIVILEGED_FUNCTION;
+    void vPortGetHeapRegionStats( BaseType_t xRegion,
+                                  HeapStats_t * pxHeapStats ) PRIVILEGED_FUNCTION;
+    #define pvPortMallocStackInRegion    pvPortMallocInRegion
+#else
+    #define pvPortMallocStackInRegion( xSize, xRegion )    pvPortMallocStack( xSize )
+#endif
+
 /*
  * Map to the memory management routines required for the port.
  */
@@ -203,6 +242,20 @@ void xPortResetHeapMinimumEverFreeHeapSize( void ) PRIVILEGED_FUNCTION;
     #define vPortFreeStack       vPortFree
 #endif
 
+/*
+ * Allocate and free kernel object structures.  When
+ * configUSE_KERNEL_OBJECT_POOLS is 1 these are implemented in block_pool.c and
+ * use the pools registered with xBlockPoolRegisterKernelObjectPool() before
+ * falling back to the heap.
+ */
+#if ( configUSE_KERNEL_OBJECT_POOLS == 1 )
+    void * pvPortMallocObject( size_t xSize ) PRIVILEGED_FUNCTION;
+    void vPortFreeObject( void * pv ) PRIVILEGED_FUNCTION;
+#else
+    #define pvPortMallocObject    pvPortMalloc
+    #define vPortFreeObject       vPortFree
+#endif
+
 /*
  * This function resets the internal state of the heap module. It must be called
  * by the application before restarting the scheduler.
@@ -914,6 +914,288 @@ BaseType_t xQueueReceive( QueueHandle_t xQueue,
                           void * const pvBuffer,
                           TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
 
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+
+/**
+ * queue. h
+ * @code{c}
+ * BaseType_t xQueueReserve(
+ *                            QueueHandle_t xQueue,
+ *                            void **ppvItem,
+ *                            TickType_t xTicksToWait
+ *                         );
+ * @endcode
+ *
+ * Obtain a pointer to the next free slot in the queue storage area so an item
+ * can be written in place instead of being built in a separate buffer and then
+ * copied into the queue by xQueueSend().  The item does not become visible to
+ * receivers until xQueueCommit() is called.
+ *
+ * configUSE_QUEUE_ZERO_COPY must be set to 1 in FreeRTOSConfig.h for
+ * xQueueReserve() to be available.
+ *
+ * The zero copy API assumes a single producer: only one slot can be reserved
+ * at a time, and the queue must not be written to the back with xQueueSend()
+ * or xQueueSendToBack(), or overwritten with xQueueOverwrite(), while a slot
+ * is reserved.  The reserved slot counts as used space, so
+ * uxQueueSpacesAvailable() is one lower and a send to the front of the queue
+ * finds it full if the reserved slot is the only one left.
+ *
+ * @param xQueue The handle to the queue on which the item is to be posted.
+ *
+ * @param ppvItem Set to point to the reserved slot, which is uxItemSize bytes
+ * long, or to NULL if no slot could be reserved.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for space to become available on the queue, should it already
+ * be full.
+ *
+ * @return pdPASS if a slot was reserved, otherwise errQUEUE_FULL.
+ *
+ * Example usage:
+ * @code{c}
+ * void vAFunction( QueueHandle_t xQueue )
+ * {
+ * struct AFrame *pxFrame;
+ *
+ *  if( xQueueReserve( xQueue, ( void ** ) &pxFrame, portMAX_DELAY ) == pdPASS )
+ *  {
+ *      // Fill the frame directly in the queue storage area.
+ *      vFillFrame( pxFrame );
+ *
+ *      // Make the frame available to the receiving task.
+ *      xQueueCommit( xQueue );
+ *  }
+ * }
+ * @endcode
+ * \defgroup xQueueReserve xQueueReserve
+ * \ingroup QueueManagement
+ */
+    BaseType_t xQueueReserve( QueueHandle_t xQueue,
+                              void ** const ppvItem,
+                              TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * @code{c}
+ * BaseType_t xQueueCommit( QueueHandle_t xQueue );
+ * @endcode
+ *
+ * Post the item previously written into the slot returned by xQueueReserve()
+ * to the back of the queue.  A task blocked waiting to receive from the queue
+ * is unblocked exactly as if the item had been sent with xQueueSend().
+ *
+ * @param xQueue The handle to the queue on which a slot was reserved.
+ *
+ * @return pdPASS.
+ *
+ * \defgroup xQueueCommit xQueueCommit
+ * \ingroup QueueManagement
+ */
+    BaseType_t xQueueCommit( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * @code{c}
+ * BaseType_t xQueueAcquire(
+ *                            QueueHandle_t xQueue,
+ *                            void **ppvItem,
+ *                            TickType_t xTicksToWait
+ *                         );
+ * @endcode
+ *
+ * Obtain a pointer to the item at the front of the queue so it can be
+ * processed in place instead of being copied out by xQueueReceive().  The item
+ * remains in the queue, and its slot cannot be reused by senders, until
+ * xQueueRelease() is called.
+ *
+ * configUSE_QUEUE_ZERO_COPY must be set to 1 in FreeRTOSConfig.h for
+ * xQueueAcquire() to be available.
+ *
+ * The zero copy API assumes a single consumer: only one item can be acquired
+ * at a time, and the queue must not be read, peeked, or written to the front
+ * while an item is acquired.
+ *
+ * @param xQueue The handle to the queue from which the item is to be
+ * received.
+ *
+ * @param ppvItem Set to point to the item, or to NULL if no item was
+ * available.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for an item to receive should the queue be empty at the time
+ * of the call.
+ *
+ * @return pdPASS if an item was acquired, otherwise errQUEUE_EMPTY.
+ *
+ * \defgroup xQueueAcquire xQueueAcquire
+ * \ingroup QueueManagement
+ */
+    BaseType_t xQueueAcquire( QueueHandle_t xQueue,
+                              void ** const ppvItem,
+                              TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * @code{c}
+ * BaseType_t xQueueRelease( QueueHandle_t xQueue );
+ * @endcode
+ *
+ * Remove the item previously obtained with xQueueAcquire() from the queue,
+ * freeing its slot.  A task blocked waiting to send to the queue is unblocked
+ * exactly as if the item had been read with xQueueReceive().
+ *
+ * @param xQueue The handle to the queue from which an item was acquired.
+ *
+ * @return pdPASS.
+ *
+ * \defgroup xQueueRelease xQueueRelease
+ * \ingroup QueueManagement
+ */
+    BaseType_t xQueueRelease( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_QUEUE_ZERO_COPY */
+
+#if ( configUSE_QUEUE_BATCH_TRANSFER == 1 )
+
+/**
+ * queue. h
+ * @code{c}
+ * size_t xQueueSendMultiple(
+ *                             QueueHandle_t xQueue,
+ *                             const void *pvItems,
+ *                             size_t xItemCount,
+ *                             TickType_t xTicksToWait
+ *                          );
+ * @endcode
+ *
+ * Post up to xItemCount items to the back of a queue.  All the items that fit
+ * are copied, and any tasks waiting to receive are unblocked, within a single
+ * critical section, and the decision to yield is made once for the whole
+ * batch rather than once per item.
+ *
+ * configUSE_QUEUE_BATCH_TRANSFER must be set to 1 in FreeRTOSConfig.h for
+ * xQueueSendMultiple() to be available.
+ *
+ * @param xQueue The handle to the queue on which the items are to be posted.
+ *
+ * @param pvItems A pointer to an array of items that are to be placed on the
+ * queue.  Each item is the size defined when the queue was created.
+ *
+ * @param xItemCount The number of items in the pvItems array.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for space to become available on the queue, should it already be
+ * full.  The call returns as soon as at least one item has been sent.
+ *
+ * @return The number of items sent, which is less than xItemCount if the queue
+ * did not have space for all of them, or 0 if the call timed out.
+ *
+ * \defgroup xQueueSendMultiple xQueueSendMultiple
+ * \ingroup QueueManagement
+ */
+    size_t xQueueSendMultiple( QueueHandle_t xQueue,
+                               const void * const pvItems,
+                               size_t xItemCount,
+                               TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * @code{c}
+ * size_t xQueueSendMultipleFromISR(
+ *                                    QueueHandle_t xQueue,
+ *                                    const void *pvItems,
+ *                                    size_t xItemCount,
+ *                                    BaseType_t *pxHigherPriorityTaskWoken
+ *                                 );
+ * @endcode
+ *
+ * A version of xQueueSendMultiple() that can be called from an interrupt
+ * service routine.  It never blocks.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if sending the items caused a
+ * task with a priority higher than the interrupted task to unblock, in which
+ * case a context switch should be requested before the interrupt is exited.
+ *
+ * @return The number of items sent.
+ *
+ * \defgroup xQueueSendMultipleFromISR xQueueSendMultipleFromISR
+ * \ingroup QueueManagement
+ */
+    size_t xQueueSendMultipleFromISR( QueueHandle_t xQueue,
+                                      const void * const pvItems,
+                                      size_t xItemCount,
+                                      BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * @code{c}
+ * size_t xQueueReceiveMultiple(
+ *                                QueueHandle_t xQueue,
+ *                                void *pvBuffer,
+ *                                size_t xMaxItemCount,
+ *                                TickType_t xTicksToWait
+ *                             );
+ * @endcode
+ *
+ * Receive up to xMaxItemCount items from a queue in a single critical section,
+ * unblocking at most one waiting sender per item removed.
+ *
+ * configUSE_QUEUE_BATCH_TRANSFER must be set to 1 in FreeRTOSConfig.h for
+ * xQueueReceiveMultiple() to be available.
+ *
+ * @param xQueue The handle to the queue from which the items are to be
+ * received.
+ *
+ * @param pvBuffer Pointer to the buffer into which the received items will be
+ * copied.  It must be large enough to hold xMaxItemCount items.
+ *
+ * @param xMaxItemCount The maximum number of items to receive.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for an item to receive should the queue be empty at the time of the
+ * call.  The call returns as soon as at least one item has been received.
+ *
+ * @return The number of items received, or 0 if the call timed out.
+ *
+ * \defgroup xQueueReceiveMultiple xQueueReceiveMultiple
+ * \ingroup QueueManagement
+ */
+    size_t xQueueReceiveMultiple( QueueHandle_t xQueue,
+                                  void * const pvBuffer,
+                                  size_t xMaxItemCount,
+                                  TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * @code{c}
+ * size_t xQueueReceiveMultipleFromISR(
+ *                                       QueueHandle_t xQueue,
+ *                                       void *pvBuffer,
+ *                                       size_t xMaxItemCount,
+ *                                       BaseType_t *pxHigherPriorityTaskWoken
+ *                                    );
+ * @endcode
+ *
+ * A version of xQueueReceiveMultiple() that can be called from an interrupt
+ * service routine.  It never blocks.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if receiving the items caused
+ * a task with a priority higher than the interrupted task to unblock, in which
+ * case a context switch should be requested before the interrupt is exited.
+ *
+ * @return The number of items received.
+ *
+ * \defgroup xQueueReceiveMultipleFromISR xQueueReceiveMultipleFromISR
+ * \ingroup QueueManagement
+ */
+    size_t xQueueReceiveMultipleFromISR( QueueHandle_t xQueue,
+                                         void * const pvBuffer,
+                                         size_t xMaxItemCount,
+                                         BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_QUEUE_BATCH_TRANSFER */
+
 /**
  * queue. h
  * @code{c}
@@ -1502,6 +1784,15 @@ QueueHandle_t xQueueCreateMutex( const uint8_t ucQueueType ) PRIVILEGED_FUNCTION
                                            StaticQueue_t * pxStaticQueue ) PRIVILEGED_FUNCTION;
 #endif
 
+#if ( ( configUSE_CEILING_MUTEXES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+    QueueHandle_t xQueueCreateCeilingMutex( const UBaseType_t uxCeilingPriority ) PRIVILEGED_FUNCTION;
+#endif
+
+#if ( ( configUSE_CEILING_MUTEXES == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+    QueueHandle_t xQueueCreateCeilingMutexStatic( const UBaseType_t uxCeilingPriority,
+                                                  StaticQueue_t * pxStaticQueue ) PRIVILEGED_FUNCTION;
+#endif
+
 #if ( configUSE_COUNTING_SEMAPHORES == 1 )
     QueueHandle_t xQueueCreateCountingSemaphore( const UBaseType_t uxMaxCount,
                                                  const UBaseType_t uxInitialCount ) PRIVILEGED_FUNCTION;
@@ -0,0 +1,247 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+
+/*
+ * Reader-writer locks protect state that is read far more often than it is
+ * written.  Any number of tasks can hold the lock for reading at the same
+ * time, or one task can hold it for writing.  Taking and giving back the lock
+ * for reading while no task holds or is waiting for it for writing is a single
+ * atomic compare and swap (see atomic.h), so tasks that only read do not
+ * serialise on each other, even on different cores.
+ *
+ * Writers are preferred over readers: once a task is waiting to write, tasks
+ * that want to read wait too, so a steady stream of readers cannot keep a
+ * writer out.  A task holding the lock for writing inherits the priority of
+ * any higher priority task blocked on the lock, in the same way as the holder
+ * of a mutex type semaphore.  Tasks holding the lock for reading do not.
+ *
+ * Reader-writer locks cannot be used from interrupts and are not recursive.
+ * A task must not take the lock for reading while it holds it for writing, or
+ * for writing while it holds it for reading.
+ */
+
+#ifndef RW_LOCK_H
+#define RW_LOCK_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h must appear in source files before include rw_lock.h"
+#endif
+
+#include "task.h"
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/**
+ * Type by which reader-writer locks are referenced.  For example, a call to
+ * xRWLockCreate() returns a RWLockHandle_t variable that can then be used as a
+ * parameter to xRWLockTakeRead(), xRWLockGiveWrite(), etc.
+ */
+struct RWLockDef_t;
+typedef struct RWLockDef_t * RWLockHandle_t;
+
+/**
+ * rw_lock.h
+ *
+ * @code{c}
+ * RWLockHandle_t xRWLockCreate( void );
+ * @endcode
+ *
+ * Creates a new reader-writer lock using dynamically allocated memory.  The
+ * lock is created in the free state.
+ *
+ * configUSE_RW_LOCKS, configUSE_MUTEXES and configSUPPORT_DYNAMIC_ALLOCATION
+ * must all be set to 1 in FreeRTOSConfig.h for xRWLockCreate() to be
+ * available.
+ *
+ * @return If the lock is created successfully then a handle to the created
+ * lock is returned.  If there was not enough heap memory available to create
+ * the lock then NULL is returned.
+ *
+ * \defgroup xRWLockCreate xRWLockCreate
+ * \ingroup RWLockManagement
+ */
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+    RWLockHandle_t xRWLockCreate( void ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * rw_lock.h
+ *
+ * @code{c}
+ * RWLockHandle_t xRWLockCreateStatic( StaticRWLock_t *pxStaticLock );
+ * @endcode
+ *
+ * Creates a new reader-writer lock using statically allocated memory.
+ *
+ * @param pxStaticLock Must point to a variable of type StaticRWLock_t, which
+ * will be used to hold the lock's data structure.
+ *
+ * @return A handle to the created lock, or NULL if pxStaticLock was NULL.
+ *
+ * \defgroup xRWLockCreateStatic xRWLockCreateStatic
+ * \ingroup RWLockManagement
+ */
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+    RWLockHandle_t xRWLockCreateStatic( StaticRWLock_t * pxStaticLock ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * rw_lock.h
+ *
+ * @code{c}
+ * BaseType_t xRWLockTakeRead( RWLockHandle_t xLock, TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Takes a reader-writer lock for reading.  If a task holds the lock for
+ * writing, or is waiting to take it for writing, the calling task blocks for
+ * at most xTicksToWait ticks.  A task holding the lock for writing inherits
+ * the calling task's priority while the calling task is blocked.
+ *
+ * @param xLock The lock being taken.
+ *
+ * @param xTicksToWait The maximum amount of time the task should remain in the
+ * Blocked state to wait for the lock.
+ *
+ * @return pdPASS if the lock was taken, otherwise errQUEUE_EMPTY.
+ *
+ * Example usage:
+ * @code{c}
+ * RWLockHandle_t xConfigLock = xRWLockCreate();
+ *
+ * void vReaderTask( void * pvParameters )
+ * {
+ *  if( xRWLockTakeRead( xConfigLock, portMAX_DELAY ) == pdPASS )
+ *  {
+ *      // Read the shared configuration.
+ *
+ *      xRWLockGiveRead( xConfigLock );
+ *  }
+ * }
+ * @endcode
+ * \defgroup xRWLockTakeRead xRWLockTakeRead
+ * \ingroup RWLockManagement
+ */
+BaseType_t xRWLockTakeRead( RWLockHandle_t xLock,
+                            TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * rw_lock.h
+ *
+ * @code{c}
+ * BaseType_t xRWLockGiveRead( RWLockHandle_t xLock );
+ * @endcode
+ *
+ * Gives back a reader-writer lock the calling task holds for reading.  When
+ * the last reader gives the lock back, the highest priority task waiting to
+ * write, if any, takes the lock.
+ *
+ * @param xLock The lock being given back.
+ *
+ * @return pdPASS if the lock was given back, or pdFAIL if no task held the
+ * lock for reading.
+ *
+ * \defgroup xRWLockGiveRead xRWLockGiveRead
+ * \ingroup RWLockManagement
+ */
+BaseType_t xRWLockGiveRead( RWLockHandle_t xLock ) PRIVILEGED_FUNCTION;
+
+/**
+ * rw_lock.h
+ *
+ * @code{c}
+ * BaseType_t xRWLockTakeWrite( RWLockHandle_t xLock, TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Takes a reader-writer lock for writing.  If any task holds the lock the
+ * calling task blocks for at most xTicksToWait ticks.  If the lock is held for
+ * writing the holder inherits the calling task's priority while the calling
+ * task is blocked.
+ *
+ * @param xLock The lock being taken.
+ *
+ * @param xTicksToWait The maximum amount of time the task should remain in the
+ * Blocked state to wait for the lock.
+ *
+ * @return pdPASS if the lock was taken, otherwise errQUEUE_EMPTY.
+ *
+ * \defgroup xRWLockTakeWrite xRWLockTakeWrite
+ * \ingroup RWLockManagement
+ */
+BaseType_t xRWLockTakeWrite( RWLockHandle_t xLock,
+                             TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * rw_lock.h
+ *
+ * @code{c}
+ * BaseType_t xRWLockGiveWrite( RWLockHandle_t xLock );
+ * @endcode
+ *
+ * Gives back a reader-writer lock the calling task holds for writing, and
+ * disinherits any priority the calling task inherited.  The lock passes to the
+ * highest priority task waiting to write if there is one, otherwise every task
+ * waiting to read is unblocked.
+ *
+ * @param xLock The lock being given back.
+ *
+ * @return pdPASS if the lock was given back, or pdFAIL if the calling task did
+ * not hold the lock for writing.
+ *
+ * \defgroup xRWLockGiveWrite xRWLockGiveWrite
+ * \ingroup RWLockManagement
+ */
+BaseType_t xRWLockGiveWrite( RWLockHandle_t xLock ) PRIVILEGED_FUNCTION;
+
+/**
+ * rw_lock.h
+ *
+ * @code{c}
+ * void vRWLockDelete( RWLockHandle_t xLock );
+ * @endcode
+ *
+ * Deletes a lock that was created with xRWLockCreate() or
+ * xRWLockCreateStatic().  The lock must be free and no tasks may be blocked on
+ * it.
+ *
+ * \defgroup vRWLockDelete vRWLockDelete
+ * \ingroup RWLockManagement
+ */
+void vRWLockDelete( RWLockHandle_t xLock ) PRIVILEGED_FUNCTION;
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* !defined( RW_LOCK_H ) */
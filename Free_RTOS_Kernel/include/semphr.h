@@ -798,6 +798,85 @@ typedef QueueHandle_t SemaphoreHandle_t;
     #define xSemaphoreCreateMutexStatic( pxMutexBuffer )    xQueueCreateMutexStatic( queueQUEUE_TYPE_MUTEX, ( pxMutexBuffer ) )
 #endif
 
+/**
+ * semphr. h
+ * @code{c}
+ * SemaphoreHandle_t xSemaphoreCreateCeilingMutex( UBaseType_t uxCeilingPriority );
+ * @endcode
+ *
+ * Creates a new priority ceiling mutex and returns a handle by which the new
+ * mutex can be referenced.  configUSE_CEILING_MUTEXES must be set to 1 in
+ * FreeRTOSConfig.h for this function to be available.
+ *
+ * A task that takes a priority ceiling mutex is raised to uxCeilingPriority
+ * immediately, rather than only when a higher priority task blocks on the
+ * mutex as happens with xSemaphoreCreateMutex().  Provided uxCeilingPriority
+ * is at least the priority of every task that takes the mutex, no task that
+ * uses the mutex can preempt the holder, so on a single core a task is blocked
+ * by a lower priority task at most once and mutexes that share a ceiling
+ * cannot deadlock.  Taking the mutex never needs to move the holder between
+ * lists on behalf of another task, so contended takes cost the same as
+ * uncontended ones.
+ *
+ * The holder returns to its previous priority when it gives the mutex back.
+ * Tasks with a priority between the holder's own priority and the ceiling are
+ * held off while the mutex is held, even if they never use it.
+ *
+ * Mutexes created using this function are accessed using the xSemaphoreTake()
+ * and xSemaphoreGive() macros, and cannot be used from interrupt service
+ * routines or taken recursively.
+ *
+ * @param uxCeilingPriority The priority the holder runs at while it holds the
+ * mutex.  Must be above tskIDLE_PRIORITY and below configMAX_PRIORITIES.
+ *
+ * @return If the mutex was successfully created then a handle to the created
+ * mutex is returned.  If there was not enough heap to allocate the mutex data
+ * structures then NULL is returned.
+ *
+ * Example usage:
+ * @code{c}
+ * SemaphoreHandle_t xI2CMutex;
+ *
+ * void vSetup( void )
+ * {
+ *  // The sensor and display tasks both use the I2C bus, and the display
+ *  // task has the higher priority of the two.
+ *  xI2CMutex = xSemaphoreCreateCeilingMutex( DISPLAY_TASK_PRIORITY );
+ * }
+ * @endcode
+ * \defgroup xSemaphoreCreateCeilingMutex xSemaphoreCreateCeilingMutex
+ * \ingroup Semaphores
+ */
+#if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configUSE_CEILING_MUTEXES == 1 ) )
+    #define xSemaphoreCreateCeilingMutex( uxCeilingPriority )    xQueueCreateCeilingMutex( ( uxCeilingPriority ) )
+#endif
+
+/**
+ * semphr. h
+ * @code{c}
+ * SemaphoreHandle_t xSemaphoreCreateCeilingMutexStatic( UBaseType_t uxCeilingPriority,
+ *                                                       StaticSemaphore_t *pxMutexBuffer );
+ * @endcode
+ *
+ * As xSemaphoreCreateCeilingMutex(), but the mutex's data structure is held in
+ * the StaticSemaphore_t variable pointed to by pxMutexBuffer, removing the need
+ * for the memory to be allocated dynamically.
+ *
+ * @param uxCeilingPriority The priority the holder runs at while it holds the
+ * mutex.
+ *
+ * @param pxMutexBuffer Must point to a variable of type StaticSemaphore_t.
+ *
+ * @return If the mutex was successfully created then a handle to the created
+ * mutex is returned.  If pxMutexBuffer was NULL then NULL is returned.
+ *
+ * \defgroup xSemaphoreCreateCeilingMutexStatic xSemaphoreCreateCeilingMutexStatic
+ * \ingroup Semaphores
+ */
+#if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configUSE_CEILING_MUTEXES == 1 ) )
+    #define xSemaphoreCreateCeilingMutexStatic( uxCeilingPriority, pxMutexBuffer )    xQueueCreateCeilingMutexStatic( ( uxCeilingPriority ), ( pxMutexBuffer ) )
+#endif
+
 
 /**
  * semphr. h
@@ -0,0 +1,247 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Single producer, single consumer rings are a light weight alternative to
+ * queues for the common case of exactly one writer (typically an interrupt
+ * service routine) and exactly one reader (a task).  The data path needs no
+ * critical section: the producer only ever writes the head index and the
+ * consumer only ever writes the tail index, so each side publishes its
+ * progress with a single aligned store.  The consumer only enters the Blocked
+ * state, waiting on a direct to task notification, when it finds the ring
+ * empty.
+ *
+ * ***NOTE***:  Uniquely among FreeRTOS objects, the SPSC ring implementation
+ * assumes there is only one task or interrupt that will write to the ring (the
+ * producer), and only one task that will read from the ring (the consumer).
+ * It is safe for the producer and consumer to be different tasks or
+ * interrupts, but, unlike other FreeRTOS objects, it is not safe to have
+ * multiple different producers or multiple different consumers.
+ */
+
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h must appear in source files before include spsc_ring.h"
+#endif
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/**
+ * Type by which SPSC rings are referenced.  For example, a call to
+ * xSpscRingCreate() returns an SpscRingHandle_t variable that can then be used
+ * as a parameter to xSpscRingSendFromISR(), xSpscRingReceive(), etc.
+ */
+struct SpscRingDef_t;
+typedef struct SpscRingDef_t * SpscRingHandle_t;
+
+/**
+ * spsc_ring.h
+ *
+ * @code{c}
+ * SpscRingHandle_t xSpscRingCreate( size_t xItemCount, size_t xItemSize );
+ * @endcode
+ *
+ * Creates a new SPSC ring using dynamically allocated memory.
+ *
+ * configUSE_SPSC_RINGS and configSUPPORT_DYNAMIC_ALLOCATION must both be set
+ * to 1 in FreeRTOSConfig.h for xSpscRingCreate() to be available.
+ *
+ * @param xItemCount The number of items the ring can hold.  This must be a
+ * power of two so ring indexes can be wrapped with a mask.
+ *
+ * @param xItemSize The size, in bytes, of each item.
+ *
+ * @return If the ring is created successfully then a handle to the created
+ * ring is returned.  If there was not enough heap memory available to create
+ * the ring then NULL is returned.
+ *
+ * \defgroup xSpscRingCreate xSpscRingCreate
+ * \ingroup SpscRingManagement
+ */
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+    SpscRingHandle_t xSpscRingCreate( size_t xItemCount,
+                                      size_t xItemSize ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * spsc_ring.h
+ *
+ * @code{c}
+ * SpscRingHandle_t xSpscRingCreateStatic( size_t xItemCount,
+ *                                         size_t xItemSize,
+ *                                         uint8_t *pucRingStorageArea,
+ *                                         StaticSpscRing_t *pxStaticRing );
+ * @endcode
+ *
+ * Creates a new SPSC ring using statically allocated memory.
+ *
+ * @param xItemCount The number of items the ring can hold.  This must be a
+ * power of two.
+ *
+ * @param xItemSize The size, in bytes, of each item.
+ *
+ * @param pucRingStorageArea Must point to a uint8_t array that is at least
+ * ( xItemCount * xItemSize ) bytes big.
+ *
+ * @param pxStaticRing Must point to a variable of type StaticSpscRing_t, which
+ * will be used to hold the ring's data structure.
+ *
+ * @return A handle to the created ring, or NULL if either pucRingStorageArea
+ * or pxStaticRing are NULL.
+ *
+ * \defgroup xSpscRingCreateStatic xSpscRingCreateStatic
+ * \ingroup SpscRingManagement
+ */
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+    SpscRingHandle_t xSpscRingCreateStatic( size_t xItemCount,
+                                            size_t xItemSize,
+                                            uint8_t * const pucRingStorageArea,
+                                            StaticSpscRing_t * const pxStaticRing ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * spsc_ring.h
+ *
+ * @code{c}
+ * BaseType_t xSpscRingSendFromISR( SpscRingHandle_t xRing,
+ *                                  const void *pvItem,
+ *                                  BaseType_t *pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * Copies one item into the ring from an interrupt service routine.  Never
+ * blocks.  Interrupts are only masked, and only for the duration of a task
+ * notification, when the consumer task is blocked waiting for data.
+ *
+ * @param xRing The handle of the ring being written to.
+ *
+ * @param pvItem A pointer to the item to copy into the ring.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if writing the item unblocked
+ * a consumer task that has a priority above the interrupted task, in which
+ * case a context switch should be requested before the interrupt is exited.
+ *
+ * @return pdPASS if the item was written, or errQUEUE_FULL if the ring was
+ * full.
+ *
+ * \defgroup xSpscRingSendFromISR xSpscRingSendFromISR
+ * \ingroup SpscRingManagement
+ */
+BaseType_t xSpscRingSendFromISR( SpscRingHandle_t xRing,
+                                 const void * pvItem,
+                                 BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * spsc_ring.h
+ *
+ * @code{c}
+ * BaseType_t xSpscRingSend( SpscRingHandle_t xRing, const void *pvItem );
+ * @endcode
+ *
+ * Task level version of xSpscRingSendFromISR().  Never blocks.
+ *
+ * @return pdPASS if the item was written, or errQUEUE_FULL if the ring was
+ * full.
+ *
+ * \defgroup xSpscRingSend xSpscRingSend
+ * \ingroup SpscRingManagement
+ */
+BaseType_t xSpscRingSend( SpscRingHandle_t xRing,
+                          const void * pvItem ) PRIVILEGED_FUNCTION;
+
+/**
+ * spsc_ring.h
+ *
+ * @code{c}
+ * BaseType_t xSpscRingReceive( SpscRingHandle_t xRing,
+ *                              void *pvBuffer,
+ *                              TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Copies one item out of the ring.  If the ring is empty the calling task
+ * blocks on its configSPSC_RING_NOTIFICATION_INDEX task notification until the
+ * producer writes an item or xTicksToWait expires.  Must only be called from
+ * the single consumer task.
+ *
+ * @param xRing The handle of the ring being read from.
+ *
+ * @param pvBuffer A pointer to the buffer into which the item is copied.
+ *
+ * @param xTicksToWait The maximum amount of time the task should remain in the
+ * Blocked state waiting for an item should the ring be empty.
+ *
+ * @return pdPASS if an item was read, or errQUEUE_EMPTY if the call timed out.
+ *
+ * \defgroup xSpscRingReceive xSpscRingReceive
+ * \ingroup SpscRingManagement
+ */
+BaseType_t xSpscRingReceive( SpscRingHandle_t xRing,
+                             void * pvBuffer,
+                             TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * spsc_ring.h
+ *
+ * @code{c}
+ * size_t xSpscRingItemsWaiting( SpscRingHandle_t xRing );
+ * @endcode
+ *
+ * Queries the number of items in the ring.  Safe to call from either side.
+ *
+ * \defgroup xSpscRingItemsWaiting xSpscRingItemsWaiting
+ * \ingroup SpscRingManagement
+ */
+size_t xSpscRingItemsWaiting( SpscRingHandle_t xRing ) PRIVILEGED_FUNCTION;
+
+/**
+ * spsc_ring.h
+ *
+ * @code{c}
+ * void vSpscRingDelete( SpscRingHandle_t xRing );
+ * @endcode
+ *
+ * Deletes a ring that was created with xSpscRingCreate() or
+ * xSpscRingCreateStatic().  The consumer must not be blocked on the ring.
+ *
+ * \defgroup vSpscRingDelete vSpscRingDelete
+ * \ingroup SpscRingManagement
+ */
+void vSpscRingDelete( SpscRingHandle_t xRing ) PRIVILEGED_FUNCTION;
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* !defined( SPSC_RING_H ) */
@@ -41,6 +41,15 @@
  * to which the bytes were set when the task was created have not been
  * overwritten.  Note this second test does not guarantee that an overflowed
  * stack will always be recognised.
+ *
+ * Setting configCHECK_FOR_STACK_OVERFLOW to 3 reserves the last
+ * configSTACK_GUARD_WORDS words of each stack as a guard zone.  The context
+ * switch then only compares the saved stack pointer against the guard zone
+ * boundary, which costs the same as method 1, while the comparison of the
+ * guard zone contents against the fill pattern is moved out of the context
+ * switch and into the idle task, which scans the guard zone of every task once
+ * every configSTACK_CANARY_SCAN_PERIOD_TICKS ticks.  The hook can query how far
+ * the task reached into its guard zone with uxTaskGetStackOverflowDepth().
  */
 
 /*-----------------------------------------------------------*/
@@ -98,7 +107,7 @@
 #endif /* configCHECK_FOR_STACK_OVERFLOW == 1 */
 /*-----------------------------------------------------------*/
 
-#if ( ( configCHECK_FOR_STACK_OVERFLOW > 1 ) && ( portSTACK_GROWTH < 0 ) && ( portUSING_MPU_WRAPPERS != 1 ) )
+#if ( ( configCHECK_FOR_STACK_OVERFLOW == 2 ) && ( portSTACK_GROWTH < 0 ) && ( portUSING_MPU_WRAPPERS != 1 ) )
 
     #define taskCHECK_FOR_STACK_OVERFLOW()                                                       \
     do                                                                                           \
@@ -120,7 +129,7 @@
 #endif /* #if( configCHECK_FOR_STACK_OVERFLOW > 1 ) */
 /*-----------------------------------------------------------*/
 
-#if ( ( configCHECK_FOR_STACK_OVERFLOW > 1 ) && ( portSTACK_GROWTH > 0 ) && ( portUSING_MPU_WRAPPERS != 1 ) )
+#if ( ( configCHECK_FOR_STACK_OVERFLOW == 2 ) && ( portSTACK_GROWTH > 0 ) && ( portUSING_MPU_WRAPPERS != 1 ) )
 
     #define taskCHECK_FOR_STACK_OVERFLOW()                                                                                                \
     do                                                                                                                                    \
@@ -142,7 +151,43 @@
         }                                                                                                                                 \
     } while( 0 )
 
-#endif /* #if( configCHECK_FOR_STACK_OVERFLOW > 1 ) */
+#endif /* #if( configCHECK_FOR_STACK_OVERFLOW == 2 ) */
+/*-----------------------------------------------------------*/
+
+#if ( ( configCHECK_FOR_STACK_OVERFLOW == 3 ) && ( portSTACK_GROWTH < 0 ) && ( portUSING_MPU_WRAPPERS != 1 ) )
+
+/* Only the saved stack pointer is checked here, against the guard zone
+ * boundary.  The guard zone contents are checked by the idle task. */
+    #define taskCHECK_FOR_STACK_OVERFLOW()                                                                                     \
+    do                                                                                                                         \
+    {                                                                                                                          \
+        /* Has the saved context reached into the guard zone? */                                                               \
+        if( pxCurrentTCB->pxTopOfStack < pxCurrentTCB->pxStack + ( configSTACK_GUARD_WORDS + portSTACK_LIMIT_PADDING ) )       \
+        {                                                                                                                      \
+            char * pcOverflowTaskName = pxCurrentTCB->pcTaskName;                                                              \
+            vApplicationStackOverflowHook( ( TaskHandle_t ) pxCurrentTCB, pcOverflowTaskName );                                \
+        }                                                                                                                      \
+    } while( 0 )
+
+#endif /* configCHECK_FOR_STACK_OVERFLOW == 3 */
+/*-----------------------------------------------------------*/
+
+#if ( ( configCHECK_FOR_STACK_OVERFLOW == 3 ) && ( portSTACK_GROWTH > 0 ) && ( portUSING_MPU_WRAPPERS != 1 ) )
+
+/* Only the saved stack pointer is checked here, against the guard zone
+ * boundary.  The guard zone contents are checked by the idle task. */
+    #define taskCHECK_FOR_STACK_OVERFLOW()                                                                                     \
+    do                                                                                                                         \
+    {                                                                                                                          \
+        /* Has the saved context reached into the guard zone? */                                                               \
+        if( pxCurrentTCB->pxTopOfStack > pxCurrentTCB->pxEndOfStack - ( configSTACK_GUARD_WORDS + portSTACK_LIMIT_PADDING ) )  \
+        {                                                                                                                      \
+            char * pcOverflowTaskName = pxCurrentTCB->pcTaskName;                                                              \
+            vApplicationStackOverflowHook( ( TaskHandle_t ) pxCurrentTCB, pcOverflowTaskName );                                \
+        }                                                                                                                      \
+    } while( 0 )
+
+#endif /* configCHECK_FOR_STACK_OVERFLOW == 3 */
 /*-----------------------------------------------------------*/
 
 /* Remove stack overflow macro if not being used. */
@@ -85,6 +85,21 @@ typedef void (* StreamBufferCallbackFunction_t)( StreamBufferHandle_t xStreamBuf
                                                  BaseType_t xIsInsideISR,
                                                  BaseType_t * const pxHigherPriorityTaskWoken );
 
+#if ( configUSE_STREAM_BUFFER_VECTORED_IO == 1 )
+
+/**
+ * Type used to describe one segment of the data passed to
+ * xStreamBufferSendVectored() and xStreamBufferReceiveVectored().  When
+ * sending, pvData is only read.
+ */
+    typedef struct xSTREAM_BUFFER_VECTOR
+    {
+        void * pvData;       /**< Start of the segment. */
+        size_t xLengthBytes; /**< Length of the segment in bytes.  May be zero. */
+    } StreamBufferVector_t;
+
+#endif /* configUSE_STREAM_BUFFER_VECTORED_IO */
+
 /**
  * stream_buffer.h
  *
@@ -1245,6 +1260,572 @@ UBaseType_t uxStreamBufferGetStreamBufferNotificationIndex( StreamBufferHandle_t
 void vStreamBufferSetStreamBufferNotificationIndex( StreamBufferHandle_t xStreamBuffer,
                                                     UBaseType_t uxNotificationIndex ) PRIVILEGED_FUNCTION;
 
+#if ( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferReserve( StreamBufferHandle_t xStreamBuffer,
+ *                              void ** ppvData,
+ *                              TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Obtain a pointer to free space inside a stream buffer's storage area so the
+ * data can be written in place, for example by a DMA engine or a peripheral
+ * driver, instead of being copied in by xStreamBufferSend().  Once the data has
+ * been written, vStreamBufferCommit() makes it visible to the reader.
+ *
+ * The returned region is always contiguous.  When the free space wraps around
+ * the end of the storage area only the part up to the end is returned - the
+ * remainder is returned by the next call, once the first part has been
+ * committed.
+ *
+ * Only stream buffers can be used - message buffers store a length in front of
+ * each message so cannot be written in place.  As with xStreamBufferSend()
+ * there must only be one writer.
+ *
+ * configUSE_STREAM_BUFFER_ZERO_COPY must be set to 1 in FreeRTOSConfig.h for
+ * xStreamBufferReserve() to be available.
+ *
+ * @param xStreamBuffer The handle of the stream buffer to write to.
+ *
+ * @param ppvData Set to the start of the free region.
+ *
+ * @param xTicksToWait The maximum amount of time the calling task should remain
+ * in the Blocked state waiting for the stream buffer to have any free space.
+ *
+ * @return The number of bytes that can be written starting at *ppvData.  Zero
+ * if the stream buffer remained full for the whole block time.
+ *
+ * Example use:
+ * @code{c}
+ * void vAFunction( StreamBufferHandle_t xStreamBuffer )
+ * {
+ * void *pvData;
+ * size_t xSpace;
+ *
+ *  // Write directly into the stream buffer's storage.
+ *  xSpace = xStreamBufferReserve( xStreamBuffer, &pvData, pdMS_TO_TICKS( 100 ) );
+ *
+ *  if( xSpace > 0 )
+ *  {
+ *      size_t xWritten = xReadFromPeripheral( pvData, xSpace );
+ *      vStreamBufferCommit( xStreamBuffer, xWritten );
+ *  }
+ * }
+ * @endcode
+ * \defgroup xStreamBufferReserve xStreamBufferReserve
+ * \ingroup StreamBufferManagement
+ */
+    size_t xStreamBufferReserve( StreamBufferHandle_t xStreamBuffer,
+                                 void ** ppvData,
+                                 TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferReserveFromISR( StreamBufferHandle_t xStreamBuffer,
+ *                                     void ** ppvData );
+ * @endcode
+ *
+ * A version of xStreamBufferReserve() that can be called from an interrupt
+ * service routine.  It never blocks.
+ *
+ * @param xStreamBuffer The handle of the stream buffer to write to.
+ *
+ * @param ppvData Set to the start of the free region.
+ *
+ * @return The number of bytes that can be written starting at *ppvData.
+ *
+ * \defgroup xStreamBufferReserveFromISR xStreamBufferReserveFromISR
+ * \ingroup StreamBufferManagement
+ */
+    size_t xStreamBufferReserveFromISR( StreamBufferHandle_t xStreamBuffer,
+                                        void ** ppvData ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * void vStreamBufferCommit( StreamBufferHandle_t xStreamBuffer,
+ *                          size_t xBytesWritten );
+ * @endcode
+ *
+ * Make the first xBytesWritten bytes of the region obtained from
+ * xStreamBufferReserve() available to the reader.  If that takes the number of
+ * bytes in the stream buffer to or above the trigger level, a task blocked on
+ * the stream buffer is unblocked exactly as it would be by xStreamBufferSend().
+ *
+ * @param xStreamBuffer The handle of the stream buffer that was written to.
+ *
+ * @param xBytesWritten The number of bytes written.  Must not exceed the value
+ * returned by xStreamBufferReserve().  Zero abandons the reservation.
+ *
+ * \defgroup vStreamBufferCommit vStreamBufferCommit
+ * \ingroup StreamBufferManagement
+ */
+    void vStreamBufferCommit( StreamBufferHandle_t xStreamBuffer,
+                              size_t xBytesWritten ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * void vStreamBufferCommitFromISR( StreamBufferHandle_t xStreamBuffer,
+ *                                 size_t xBytesWritten,
+ *                                 BaseType_t * const pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * A version of vStreamBufferCommit() that can be called from an interrupt
+ * service routine, such as a DMA completion handler.
+ *
+ * @param xStreamBuffer The handle of the stream buffer that was written to.
+ *
+ * @param xBytesWritten The number of bytes written.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if committing the data
+ * unblocked a task that has a priority above the currently running task, in
+ * which case a context switch should be requested before the interrupt exits.
+ *
+ * \defgroup vStreamBufferCommitFromISR vStreamBufferCommitFromISR
+ * \ingroup StreamBufferManagement
+ */
+    void vStreamBufferCommitFromISR( StreamBufferHandle_t xStreamBuffer,
+                                     size_t xBytesWritten,
+                                     BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferPeek( StreamBufferHandle_t xStreamBuffer,
+ *                           void ** ppvData,
+ *                           TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Obtain a pointer to the data at the front of a stream buffer so it can be
+ * parsed or transmitted in place instead of being copied out by
+ * xStreamBufferReceive().  The data stays in the stream buffer until
+ * vStreamBufferConsume() is called.
+ *
+ * The returned region is always contiguous.  When the data wraps around the end
+ * of the storage area only the part up to the end is returned.  A batching
+ * buffer only reports data once it holds more than its trigger level, as with
+ * xStreamBufferReceive().
+ *
+ * Only stream buffers can be used.  There must only be one reader.
+ *
+ * configUSE_STREAM_BUFFER_ZERO_COPY must be set to 1 in FreeRTOSConfig.h for
+ * xStreamBufferPeek() to be available.
+ *
+ * @param xStreamBuffer The handle of the stream buffer to read from.
+ *
+ * @param ppvData Set to the start of the data, or NULL if there is none.
+ *
+ * @param xTicksToWait The maximum amount of time the calling task should remain
+ * in the Blocked state waiting for data.
+ *
+ * @return The number of bytes that can be read starting at *ppvData.  Zero if
+ * no data arrived within the block time.
+ *
+ * \defgroup xStreamBufferPeek xStreamBufferPeek
+ * \ingroup StreamBufferManagement
+ */
+    size_t xStreamBufferPeek( StreamBufferHandle_t xStreamBuffer,
+                              void ** ppvData,
+                              TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferPeekFromISR( StreamBufferHandle_t xStreamBuffer,
+ *                                  void ** ppvData );
+ * @endcode
+ *
+ * A version of xStreamBufferPeek() that can be called from an interrupt service
+ * routine.  It never blocks.
+ *
+ * @param xStreamBuffer The handle of the stream buffer to read from.
+ *
+ * @param ppvData Set to the start of the data, or NULL if there is none.
+ *
+ * @return The number of bytes that can be read starting at *ppvData.
+ *
+ * \defgroup xStreamBufferPeekFromISR xStreamBufferPeekFromISR
+ * \ingroup StreamBufferManagement
+ */
+    size_t xStreamBufferPeekFromISR( StreamBufferHandle_t xStreamBuffer,
+                                     void ** ppvData ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * void vStreamBufferConsume( StreamBufferHandle_t xStreamBuffer,
+ *                           size_t xBytesRead );
+ * @endcode
+ *
+ * Remove the first xBytesRead bytes of the region obtained from
+ * xStreamBufferPeek() from the stream buffer.  A task blocked waiting for space
+ * is unblocked exactly as it would be by xStreamBufferReceive().
+ *
+ * @param xStreamBuffer The handle of the stream buffer that was read from.
+ *
+ * @param xBytesRead The number of bytes to remove.  Must not exceed the value
+ * returned by xStreamBufferPeek().
+ *
+ * \defgroup vStreamBufferConsume vStreamBufferConsume
+ * \ingroup StreamBufferManagement
+ */
+    void vStreamBufferConsume( StreamBufferHandle_t xStreamBuffer,
+                               size_t xBytesRead ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * void vStreamBufferConsumeFromISR( StreamBufferHandle_t xStreamBuffer,
+ *                                  size_t xBytesRead,
+ *                                  BaseType_t * const pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * A version of vStreamBufferConsume() that can be called from an interrupt
+ * service routine.
+ *
+ * @param xStreamBuffer The handle of the stream buffer that was read from.
+ *
+ * @param xBytesRead The number of bytes to remove.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if freeing the space unblocked
+ * a task that has a priority above the currently running task.
+ *
+ * \defgroup vStreamBufferConsumeFromISR vStreamBufferConsumeFromISR
+ * \ingroup StreamBufferManagement
+ */
+    void vStreamBufferConsumeFromISR( StreamBufferHandle_t xStreamBuffer,
+                                      size_t xBytesRead,
+                                      BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_STREAM_BUFFER_ZERO_COPY */
+
+#if ( configUSE_STREAM_BUFFER_EXTERNAL_INDEX == 1 )
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * StreamBufferHandle_t xStreamBufferCreateExternallyIndexed( size_t xBufferSizeBytes,
+ *                                                            size_t xTriggerLevelBytes,
+ *                                                            uint8_t * const pucStreamBufferStorageArea,
+ *                                                            StreamBufferCallbackFunction_t pxSendCompletedCallback,
+ *                                                            StreamBufferCallbackFunction_t pxReceiveCompletedCallback );
+ * @endcode
+ *
+ * Creates a stream buffer whose storage area is written or read directly by
+ * hardware, typically a DMA channel running in ring mode.  The hardware moves
+ * the data, and the application reports how far it got by calling
+ * xStreamBufferSetHead() (the hardware is the writer) or xStreamBufferSetTail()
+ * (the hardware is the reader).  The other side uses the normal stream buffer
+ * API, including the zero-copy functions when
+ * configUSE_STREAM_BUFFER_ZERO_COPY is set to 1.
+ *
+ * Unlike xStreamBufferCreate() the storage area is supplied by the application
+ * and used exactly as given, so it can satisfy the alignment and size the
+ * hardware requires (the RP2040 DMA ring must be a power of two in size and
+ * aligned to its size).  As with any stream buffer one byte of the storage
+ * area is never reported as free, so the buffer holds at most
+ * xBufferSizeBytes - 1 bytes.
+ *
+ * The kernel cannot stop the hardware.  If the hardware is the writer and gets
+ * a whole ring ahead of the reader, the overwritten data is lost and the
+ * buffer appears to hold fewer bytes than were written.  The reader must
+ * therefore keep up with the hardware.
+ *
+ * configUSE_STREAM_BUFFER_EXTERNAL_INDEX must be set to 1 in FreeRTOSConfig.h
+ * for xStreamBufferCreateExternallyIndexed() to be available.  The callbacks are
+ * only used if configUSE_SB_COMPLETED_CALLBACK is also set to 1.
+ *
+ * @param xBufferSizeBytes The size, in bytes, of the storage area.
+ *
+ * @param xTriggerLevelBytes The number of bytes that must be in the buffer
+ * before a task blocked waiting for data is unblocked.
+ *
+ * @param pucStreamBufferStorageArea The storage area the hardware reads or
+ * writes.  It must remain valid until the stream buffer is deleted, and is not
+ * freed by vStreamBufferDelete().
+ *
+ * @param pxSendCompletedCallback Callback invoked when data is written to the
+ * buffer, for example to start a transmit DMA transfer.  If NULL the waiting
+ * reader is notified as normal.
+ *
+ * @param pxReceiveCompletedCallback Callback invoked when data is read from the
+ * buffer.  If NULL the waiting writer is notified as normal.
+ *
+ * @return The handle of the created stream buffer, or NULL if there was not
+ * enough heap for the stream buffer structure.
+ *
+ * \defgroup xStreamBufferCreateExternallyIndexed xStreamBufferCreateExternallyIndexed
+ * \ingroup StreamBufferManagement
+ */
+    StreamBufferHandle_t xStreamBufferCreateExternallyIndexed( size_t xBufferSizeBytes,
+                                                               size_t xTriggerLevelBytes,
+                                                               uint8_t * const pucStreamBufferStorageArea,
+                                                               StreamBufferCallbackFunction_t pxSendCompletedCallback,
+                                                               StreamBufferCallbackFunction_t pxReceiveCompletedCallback ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferSetHead( StreamBufferHandle_t xStreamBuffer,
+ *                              size_t xNewHead );
+ * @endcode
+ *
+ * Tell an externally indexed stream buffer that the hardware has written up to,
+ * but not including, offset xNewHead of the storage area.  For a DMA channel
+ * that is the channel's write address minus the start of the storage area.
+ * If the number of bytes in the buffer reaches the trigger level, a task
+ * blocked waiting for data is unblocked exactly as by xStreamBufferSend().
+ *
+ * @param xStreamBuffer The handle of an externally indexed stream buffer.
+ *
+ * @param xNewHead The new write offset, less than the storage area's size.
+ *
+ * @return The number of bytes the hardware wrote since the previous call.
+ *
+ * \defgroup xStreamBufferSetHead xStreamBufferSetHead
+ * \ingroup StreamBufferManagement
+ */
+    size_t xStreamBufferSetHead( StreamBufferHandle_t xStreamBuffer,
+                                 size_t xNewHead ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferSetHeadFromISR( StreamBufferHandle_t xStreamBuffer,
+ *                                     size_t xNewHead,
+ *                                     BaseType_t * const pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * A version of xStreamBufferSetHead() that can be called from an interrupt
+ * service routine, typically the DMA transfer complete interrupt.
+ *
+ * @param xStreamBuffer The handle of an externally indexed stream buffer.
+ *
+ * @param xNewHead The new write offset, less than the storage area's size.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if a task with a priority
+ * above the currently running task was unblocked, in which case a context
+ * switch should be requested before the interrupt exits.
+ *
+ * @return The number of bytes the hardware wrote since the previous call.
+ *
+ * \defgroup xStreamBufferSetHeadFromISR xStreamBufferSetHeadFromISR
+ * \ingroup StreamBufferManagement
+ */
+    size_t xStreamBufferSetHeadFromISR( StreamBufferHandle_t xStreamBuffer,
+                                        size_t xNewHead,
+                                        BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferSetTail( StreamBufferHandle_t xStreamBuffer,
+ *                              size_t xNewTail );
+ * @endcode
+ *
+ * Tell an externally indexed stream buffer that the hardware has read up to,
+ * but not including, offset xNewTail of the storage area.  A task blocked
+ * waiting for space is unblocked exactly as by xStreamBufferReceive().
+ *
+ * @param xStreamBuffer The handle of an externally indexed stream buffer.
+ *
+ * @param xNewTail The new read offset, less than the storage area's size.
+ *
+ * @return The number of bytes the hardware read since the previous call.
+ *
+ * \defgroup xStreamBufferSetTail xStreamBufferSetTail
+ * \ingroup StreamBufferManagement
+ */
+    size_t xStreamBufferSetTail( StreamBufferHandle_t xStreamBuffer,
+                                 size_t xNewTail ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferSetTailFromISR( StreamBufferHandle_t xStreamBuffer,
+ *                                     size_t xNewTail,
+ *                                     BaseType_t * const pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * A version of xStreamBufferSetTail() that can be called from an interrupt
+ * service routine.
+ *
+ * @param xStreamBuffer The handle of an externally indexed stream buffer.
+ *
+ * @param xNewTail The new read offset, less than the storage area's size.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if a task with a priority
+ * above the currently running task was unblocked.
+ *
+ * @return The number of bytes the hardware read since the previous call.
+ *
+ * \defgroup xStreamBufferSetTailFromISR xStreamBufferSetTailFromISR
+ * \ingroup StreamBufferManagement
+ */
+    size_t xStreamBufferSetTailFromISR( StreamBufferHandle_t xStreamBuffer,
+                                        size_t xNewTail,
+                                        BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_STREAM_BUFFER_EXTERNAL_INDEX */
+
+#if ( configUSE_STREAM_BUFFER_VECTORED_IO == 1 )
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferSendVectored( StreamBufferHandle_t xStreamBuffer,
+ *                                   const StreamBufferVector_t * pxVectors,
+ *                                   size_t xVectorCount,
+ *                                   TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Sends the concatenation of several segments, for example a header followed
+ * by a payload, without first assembling them in a temporary buffer.  The
+ * segments are copied straight into the buffer one after another.
+ *
+ * Apart from taking its data as segments it behaves exactly as
+ * xStreamBufferSend().  In particular, when used with a message buffer the
+ * segments are written as one message, and a reader never sees part of it.
+ *
+ * configUSE_STREAM_BUFFER_VECTORED_IO must be set to 1 in FreeRTOSConfig.h for
+ * xStreamBufferSendVectored() to be available.
+ *
+ * @param xStreamBuffer The handle of the stream or message buffer to send to.
+ *
+ * @param pxVectors An array of segments, written in array order.
+ *
+ * @param xVectorCount The number of entries in pxVectors.
+ *
+ * @param xTicksToWait As for xStreamBufferSend().
+ *
+ * @return The number of bytes written.  For a message buffer that is either the
+ * total length of all the segments or 0.
+ *
+ * Example use:
+ * @code{c}
+ * void vAFunction( MessageBufferHandle_t xMessageBuffer, Header_t * pxHeader, void * pvPayload, size_t xPayloadLength )
+ * {
+ * StreamBufferVector_t xVectors[ 2 ];
+ *
+ *  xVectors[ 0 ].pvData = pxHeader;
+ *  xVectors[ 0 ].xLengthBytes = sizeof( Header_t );
+ *  xVectors[ 1 ].pvData = pvPayload;
+ *  xVectors[ 1 ].xLengthBytes = xPayloadLength;
+ *
+ *  xMessageBufferSendVectored( xMessageBuffer, xVectors, 2, portMAX_DELAY );
+ * }
+ * @endcode
+ * \defgroup xStreamBufferSendVectored xStreamBufferSendVectored
+ * \ingroup StreamBufferManagement
+ */
+    size_t xStreamBufferSendVectored( StreamBufferHandle_t xStreamBuffer,
+                                      const StreamBufferVector_t * pxVectors,
+                                      size_t xVectorCount,
+                                      TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferSendVectoredFromISR( StreamBufferHandle_t xStreamBuffer,
+ *                                          const StreamBufferVector_t * pxVectors,
+ *                                          size_t xVectorCount,
+ *                                          BaseType_t * const pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * Interrupt safe version of xStreamBufferSendVectored().  Otherwise behaves as
+ * xStreamBufferSendFromISR().
+ *
+ * \defgroup xStreamBufferSendVectoredFromISR xStreamBufferSendVectoredFromISR
+ * \ingroup StreamBufferManagement
+ */
+    size_t xStreamBufferSendVectoredFromISR( StreamBufferHandle_t xStreamBuffer,
+                                             const StreamBufferVector_t * pxVectors,
+                                             size_t xVectorCount,
+                                             BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferReceiveVectored( StreamBufferHandle_t xStreamBuffer,
+ *                                      const StreamBufferVector_t * pxVectors,
+ *                                      size_t xVectorCount,
+ *                                      TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Receives into several segments, filling each in array order before moving
+ * to the next.  For example, a fixed size header can be received into one
+ * structure and the payload into another buffer.
+ *
+ * Apart from taking its destination as segments it behaves exactly as
+ * xStreamBufferReceive().  When used with a message buffer the segments
+ * together must be large enough to hold the whole next message, otherwise the
+ * message is left in the buffer and 0 is returned.
+ *
+ * configUSE_STREAM_BUFFER_VECTORED_IO must be set to 1 in FreeRTOSConfig.h for
+ * xStreamBufferReceiveVectored() to be available.
+ *
+ * @param xStreamBuffer The handle of the stream or message buffer to receive
+ * from.
+ *
+ * @param pxVectors An array of segments, filled in array order.
+ *
+ * @param xVectorCount The number of entries in pxVectors.
+ *
+ * @param xTicksToWait As for xStreamBufferReceive().
+ *
+ * @return The number of bytes received.
+ *
+ * \defgroup xStreamBufferReceiveVectored xStreamBufferReceiveVectored
+ * \ingroup StreamBufferManagement
+ */
+    size_t xStreamBufferReceiveVectored( StreamBufferHandle_t xStreamBuffer,
+                                         const StreamBufferVector_t * pxVectors,
+                                         size_t xVectorCount,
+                                         TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferReceiveVectoredFromISR( StreamBufferHandle_t xStreamBuffer,
+ *                                             const StreamBufferVector_t * pxVectors,
+ *                                             size_t xVectorCount,
+ *                                             BaseType_t * const pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * Interrupt safe version of xStreamBufferReceiveVectored().  Otherwise behaves
+ * as xStreamBufferReceiveFromISR().
+ *
+ * \defgroup xStreamBufferReceiveVectoredFromISR xStreamBufferReceiveVectoredFromISR
+ * \ingroup StreamBufferManagement
+ */
+    size_t xStreamBufferReceiveVectoredFromISR( StreamBufferHandle_t xStreamBuffer,
+                                                const StreamBufferVector_t * pxVectors,
+                                                size_t xVectorCount,
+                                                BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_STREAM_BUFFER_VECTORED_IO */
+
 /* Functions below here are not part of the public API. */
 StreamBufferHandle_t xStreamBufferGenericCreate( size_t xBufferSizeBytes,
                                                  size_t xTriggerLevelBytes,
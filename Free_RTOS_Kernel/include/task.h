@@ -180,6 +180,25 @@ typedef struct xTASK_STATUS
     #endif
 } TaskStatus_t;
 
+/* One window of the major frame passed to xTaskSetPartitionSchedule(). */
+typedef struct xTASK_PARTITION_WINDOW
+{
+    UBaseType_t uxPartition; /* The partition whose tasks run during the window, or tskNO_PARTITION. */
+    TickType_t xDuration;    /* The length of the window in ticks.  Must not be zero. */
+} TaskPartitionWindow_t;
+
+/* Used with the xTaskGetPartitionStatus() function to return the budget and
+ * usage counters of a partition. */
+typedef struct xTASK_PARTITION_STATUS
+{
+    TickType_t xBudget;                               /* The ticks given to the partition in each major frame. */
+    uint32_t ulWindows;                               /* The number of windows of the partition started so far. */
+    uint32_t ulOverruns;                              /* The number of windows that ended with a task of the partition still ready to run, so with more work than the budget allowed. */
+    uint32_t ulUsedTicks;                             /* The number of ticks in which a task of the partition was running when the tick interrupt occurred. */
+    configRUN_TIME_COUNTER_TYPE ulLastSwitchOverhead; /* The time from the tick that started the last window of the partition to the context switch that followed it, in run time stats counter units.  Zero if configGENERATE_RUN_TIME_STATS is 0. */
+    configRUN_TIME_COUNTER_TYPE ulMaxSwitchOverhead;  /* The largest value of ulLastSwitchOverhead so far. */
+} TaskPartitionStatus_t;
+
 /* Possible return values for eTaskConfirmSleepModeStatus(). */
 typedef enum
 {
@@ -205,6 +224,15 @@ typedef enum
  */
 #define tskNO_AFFINITY      ( ( UBaseType_t ) -1 )
 
+/**
+ * The partition of a task that is not bound to a partition with
+ * vTaskSetPartition().  Such a task can run in every window.  Also used as the
+ * partition of a window in which only such tasks run.
+ *
+ * \ingroup TaskUtils
+ */
+#define tskNO_PARTITION     ( ( UBaseType_t ) -1 )
+
 /**
  * task. h
  *
@@ -224,14 +252,27 @@ typedef enum
  * NOTE: This may alter the stack (depending on the portable implementation)
  * so must be used with care!
  *
+ * When configUSE_CRITICAL_PROFILER is 1 the time the critical region keeps
+ * interrupts masked is also recorded against the file and line it was entered
+ * from - see critical_profiler.h.
+ *
  * \defgroup taskENTER_CRITICAL taskENTER_CRITICAL
  * \ingroup SchedulerControl
  */
-#define taskENTER_CRITICAL()                 portENTER_CRITICAL()
-#if ( configNUMBER_OF_CORES == 1 )
-    #define taskENTER_CRITICAL_FROM_ISR()    portSET_INTERRUPT_MASK_FROM_ISR()
+#if ( configUSE_CRITICAL_PROFILER == 1 )
+    #define taskENTER_CRITICAL()                                   \
+    do {                                                           \
+        portENTER_CRITICAL();                                      \
+        vCriticalProfilerEnter( __FILE__, ( uint32_t ) __LINE__ ); \
+    } while( 0 )
+    #define taskENTER_CRITICAL_FROM_ISR()    uxCriticalProfilerEnterFromISR( ( UBaseType_t ) portSET_INTERRUPT_MASK_FROM_ISR(), __FILE__, ( uint32_t ) __LINE__ )
 #else
-    #define taskENTER_CRITICAL_FROM_ISR()    portENTER_CRITICAL_FROM_ISR()
+    #define taskENTER_CRITICAL()                 portENTER_CRITICAL()
+    #if ( configNUMBER_OF_CORES == 1 )
+        #define taskENTER_CRITICAL_FROM_ISR()    portSET_INTERRUPT_MASK_FROM_ISR()
+    #else
+        #define taskENTER_CRITICAL_FROM_ISR()    portENTER_CRITICAL_FROM_ISR()
+    #endif
 #endif
 
 /**
@@ -246,11 +287,24 @@ typedef enum
  * \defgroup taskEXIT_CRITICAL taskEXIT_CRITICAL
  * \ingroup SchedulerControl
  */
-#define taskEXIT_CRITICAL()                    portEXIT_CRITICAL()
-#if ( configNUMBER_OF_CORES == 1 )
-    #define taskEXIT_CRITICAL_FROM_ISR( x )    portCLEAR_INTERRUPT_MASK_FROM_ISR( x )
+#if ( configUSE_CRITICAL_PROFILER == 1 )
+    #define taskEXIT_CRITICAL()     \
+    do {                            \
+        vCriticalProfilerExit();    \
+        portEXIT_CRITICAL();        \
+    } while( 0 )
+    #define taskEXIT_CRITICAL_FROM_ISR( x )     \
+    do {                                        \
+        vCriticalProfilerExit();                \
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( x ); \
+    } while( 0 )
 #else
-    #define taskEXIT_CRITICAL_FROM_ISR( x )    portEXIT_CRITICAL_FROM_ISR( x )
+    #define taskEXIT_CRITICAL()                    portEXIT_CRITICAL()
+    #if ( configNUMBER_OF_CORES == 1 )
+        #define taskEXIT_CRITICAL_FROM_ISR( x )    portCLEAR_INTERRUPT_MASK_FROM_ISR( x )
+    #else
+        #define taskEXIT_CRITICAL_FROM_ISR( x )    portEXIT_CRITICAL_FROM_ISR( x )
+    #endif
 #endif
 
 /**
@@ -400,6 +454,63 @@ typedef enum
                                        TaskHandle_t * const pxCreatedTask ) PRIVILEGED_FUNCTION;
 #endif
 
+/**
+ * task. h
+ * @code{c}
+ * BaseType_t xTaskCreateInRegion(
+ *                            TaskFunction_t pxTaskCode,
+ *                            const char * const pcName,
+ *                            const configSTACK_DEPTH_TYPE uxStackDepth,
+ *                            void *pvParameters,
+ *                            UBaseType_t uxPriority,
+ *                            TaskHandle_t *pxCreatedTask,
+ *                            BaseType_t xStackRegion
+ *                        );
+ * @endcode
+ *
+ * Create a new task as xTaskCreate() does, but allocate the task's stack with
+ * pvPortMallocInRegion() so it is placed in heap region xStackRegion - the
+ * index of the region in the array passed to vPortDefineHeapRegions().  The
+ * region is a hint: if it does not have room for the stack, the stack is
+ * allocated from the other regions.  The task control block is allocated as
+ * for xTaskCreate().
+ *
+ * Placing the stacks of busy tasks in a memory bank that DMA does not use
+ * stops the processor's stack accesses and the DMA's transfers from stalling
+ * each other.
+ *
+ * configUSE_HEAP_REGION_HINTS must be set to 1 in FreeRTOSConfig.h, and a heap
+ * implementation that provides pvPortMallocInRegion() (heap_banked.c) must be
+ * used, for xTaskCreateInRegion() to be available.
+ *
+ * @param xStackRegion The heap region to allocate the stack from, or
+ * portHEAP_REGION_ANY to behave as xTaskCreate().
+ *
+ * The other parameters and the return value are as for xTaskCreate().
+ *
+ * Example usage:
+ * @code{c}
+ * // Region 1 is a memory bank that DMA does not access.
+ * #define STACK_REGION    1
+ *
+ * void vOtherFunction( void )
+ * {
+ *   xTaskCreateInRegion( vTaskCode, "NAME", STACK_SIZE, NULL, tskIDLE_PRIORITY, NULL, STACK_REGION );
+ * }
+ * @endcode
+ * \defgroup xTaskCreateInRegion xTaskCreateInRegion
+ * \ingroup Tasks
+ */
+#if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configUSE_HEAP_REGION_HINTS == 1 ) )
+    BaseType_t xTaskCreateInRegion( TaskFunction_t pxTaskCode,
+                                    const char * const pcName,
+                                    const configSTACK_DEPTH_TYPE uxStackDepth,
+                                    void * const pvParameters,
+                                    UBaseType_t uxPriority,
+                                    TaskHandle_t * const pxCreatedTask,
+                                    BaseType_t xStackRegion ) PRIVILEGED_FUNCTION;
+#endif
+
 /**
  * task. h
  * @code{c}
@@ -935,6 +1046,265 @@ BaseType_t xTaskDelayUntil( TickType_t * const pxPreviousWakeTime,
         ( void ) xTaskDelayUntil( ( pxPreviousWakeTime ), ( xTimeIncrement ) ); \
     } while( 0 )
 
+/**
+ * task. h
+ * @code{c}
+ * void vTaskSetDeadline( TaskHandle_t xTask, TickType_t xDeadline );
+ * @endcode
+ *
+ * configUSE_EDF_SCHEDULING must be defined as 1 in FreeRTOSConfig.h for this
+ * function to be available.
+ *
+ * With configUSE_EDF_SCHEDULING set to 1 the scheduler still always runs the
+ * highest priority ready task, but ready tasks of equal priority are ordered by
+ * absolute deadline instead of taking turns, so the task with the earliest
+ * deadline runs first (Earliest Deadline First).  A task that becomes ready
+ * with an earlier deadline than the running task of the same priority preempts
+ * it.  Placing all the deadline driven tasks at the same priority gives EDF
+ * scheduling between them, while tasks at higher priorities still preempt them
+ * as before.
+ *
+ * A task has no deadline, which is represented as portMAX_DELAY, until one is
+ * set.  Tasks with equal deadlines, including those without one, take turns
+ * as they would without configUSE_EDF_SCHEDULING.
+ *
+ * Deadlines are compared as plain tick values, so a deadline that lies beyond
+ * the next tick count overflow sorts ahead of deadlines that do not for as
+ * long as both are pending.  With a 32-bit TickType_t at 1 kHz that can only
+ * happen in the relative deadline window before the tick count wraps, once
+ * every 49.7 days.
+ *
+ * @param xTask Handle of the task whose deadline is being set.  Passing a
+ * NULL handle results in the deadline of the calling task being set.
+ *
+ * @param xDeadline The absolute deadline, in ticks.
+ *
+ * \defgroup vTaskSetDeadline vTaskSetDeadline
+ * \ingroup TaskCtrl
+ */
+#if ( configUSE_EDF_SCHEDULING == 1 )
+    void vTaskSetDeadline( TaskHandle_t xTask,
+                           TickType_t xDeadline ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * TickType_t xTaskGetDeadline( TaskHandle_t xTask );
+ * @endcode
+ *
+ * configUSE_EDF_SCHEDULING must be defined as 1 in FreeRTOSConfig.h for this
+ * function to be available.
+ *
+ * @param xTask Handle of the task being queried.  Passing a NULL handle
+ * results in the deadline of the calling task being returned.
+ *
+ * @return The absolute deadline of the task in ticks, or portMAX_DELAY if the
+ * task has no deadline.
+ *
+ * \defgroup xTaskGetDeadline xTaskGetDeadline
+ * \ingroup TaskCtrl
+ */
+#if ( configUSE_EDF_SCHEDULING == 1 )
+    TickType_t xTaskGetDeadline( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * BaseType_t xTaskDelayUntilWithDeadline( TickType_t *pxPreviousWakeTime, const TickType_t xTimeIncrement, const TickType_t xRelativeDeadline );
+ * @endcode
+ *
+ * configUSE_EDF_SCHEDULING and INCLUDE_xTaskDelayUntil must be defined as 1
+ * in FreeRTOSConfig.h for this function to be available.
+ *
+ * Behaves as xTaskDelayUntil(), and also sets the deadline of the calling
+ * task to xRelativeDeadline ticks after the time at which it will be woken, so
+ * a periodic task is placed in deadline order as soon as its next period
+ * starts.  The deadline is set before the task blocks.
+ *
+ * @param pxPreviousWakeTime As for xTaskDelayUntil().
+ *
+ * @param xTimeIncrement The period of the task, as for xTaskDelayUntil().
+ *
+ * @param xRelativeDeadline The deadline of the next period, relative to its
+ * start.  Usually equal to xTimeIncrement.
+ *
+ * @return As for xTaskDelayUntil().  pdFALSE means the previous period
+ * overran, in which case the deadline set is already in the past.
+ *
+ * Example usage:
+ * @code{c}
+ * // Perform an action every 10 ticks, finishing each one within 8 ticks.
+ * void vTaskFunction( void * pvParameters )
+ * {
+ * TickType_t xLastWakeTime = xTaskGetTickCount();
+ *
+ *     for( ;; )
+ *     {
+ *         xTaskDelayUntilWithDeadline( &xLastWakeTime, 10, 8 );
+ *
+ *         // Perform action here.
+ *     }
+ * }
+ * @endcode
+ * \defgroup xTaskDelayUntilWithDeadline xTaskDelayUntilWithDeadline
+ * \ingroup TaskCtrl
+ */
+#if ( ( configUSE_EDF_SCHEDULING == 1 ) && ( INCLUDE_xTaskDelayUntil == 1 ) )
+    BaseType_t xTaskDelayUntilWithDeadline( TickType_t * const pxPreviousWakeTime,
+                                            const TickType_t xTimeIncrement,
+                                            const TickType_t xRelativeDeadline ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * BaseType_t xTaskSetPartitionSchedule( const TaskPartitionWindow_t * const pxWindows, UBaseType_t uxWindowCount );
+ * @endcode
+ *
+ * configUSE_TIME_PARTITIONING must be defined as 1 in FreeRTOSConfig.h for
+ * this function to be available.
+ *
+ * Divides the processor time into a major frame of fixed windows that repeats
+ * for as long as the scheduler runs.  Each window belongs to a partition, and
+ * during a window only the tasks bound to that partition with
+ * vTaskSetPartition(), and the tasks not bound to any partition, can run.  The
+ * usual priority rules apply between the tasks that can run.  A task of
+ * another partition that becomes ready waits until a window of its partition
+ * starts, so each partition is given the processor time of its windows however
+ * much work the other partitions have.
+ *
+ * The idle task, the timer service task, and any task never passed to
+ * vTaskSetPartition() are not bound to a partition, so they can take time
+ * from every window.  A mutex shared between partitions can block a task until
+ * the window of the holder's partition, so should be avoided.
+ *
+ * A window ends with a tick interrupt.  If a task of the partition is still
+ * ready at that point, the partition needed more than its budget: the overrun
+ * is counted and, if configUSE_PARTITION_OVERRUN_HOOK is 1,
+ * vApplicationPartitionOverrunHook() is called from the tick interrupt.  A
+ * task that unblocks in that same tick is not counted, as the next window has
+ * already started when it is made ready.  Two consecutive windows of the same
+ * partition act as one.
+ *
+ * Must be called before the scheduler is started.  The first window starts
+ * with the first tick.
+ *
+ * @param pxWindows The windows of the major frame, in order.  The array is
+ * not copied, so must remain valid while the scheduler runs.
+ *
+ * @param uxWindowCount The number of windows in pxWindows.
+ *
+ * @return pdPASS if the schedule was set.  pdFAIL if a window has a zero
+ * duration or a partition number not less than configMAX_PARTITIONS and not
+ * tskNO_PARTITION.
+ *
+ * Example usage:
+ * @code{c}
+ * // Input handling gets 1 ms of every 10 ms, the control loop 6 ms, and the
+ * // remaining 3 ms are left to the tasks not bound to a partition.
+ * static const TaskPartitionWindow_t xMajorFrame[] =
+ * {
+ *     { 0, pdMS_TO_TICKS( 1 ) },
+ *     { 1, pdMS_TO_TICKS( 6 ) },
+ *     { tskNO_PARTITION, pdMS_TO_TICKS( 3 ) }
+ * };
+ *
+ * xTaskSetPartitionSchedule( xMajorFrame, 3 );
+ * vTaskSetPartition( xInputTask, 0 );
+ * vTaskSetPartition( xControlTask, 1 );
+ * vTaskStartScheduler();
+ * @endcode
+ * \defgroup xTaskSetPartitionSchedule xTaskSetPartitionSchedule
+ * \ingroup TaskCtrl
+ */
+#if ( configUSE_TIME_PARTITIONING == 1 )
+    BaseType_t xTaskSetPartitionSchedule( const TaskPartitionWindow_t * const pxWindows,
+                                          UBaseType_t uxWindowCount ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * void vTaskSetPartition( TaskHandle_t xTask, UBaseType_t uxPartition );
+ * @endcode
+ *
+ * configUSE_TIME_PARTITIONING must be defined as 1 in FreeRTOSConfig.h for
+ * this function to be available.
+ *
+ * Binds a task to a partition of the schedule set by
+ * xTaskSetPartitionSchedule(), so it only runs in the windows of that
+ * partition.  Tasks start without a partition.
+ *
+ * @param xTask Handle of the task being bound.  Passing a NULL handle results
+ * in the calling task being bound.
+ *
+ * @param uxPartition The partition, less than configMAX_PARTITIONS, or
+ * tskNO_PARTITION to let the task run in every window again.
+ *
+ * \defgroup vTaskSetPartition vTaskSetPartition
+ * \ingroup TaskCtrl
+ */
+#if ( configUSE_TIME_PARTITIONING == 1 )
+    void vTaskSetPartition( TaskHandle_t xTask,
+                            UBaseType_t uxPartition ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * UBaseType_t uxTaskGetPartition( TaskHandle_t xTask );
+ * @endcode
+ *
+ * configUSE_TIME_PARTITIONING must be defined as 1 in FreeRTOSConfig.h for
+ * this function to be available.
+ *
+ * @param xTask Handle of the task being queried.  Passing a NULL handle
+ * results in the partition of the calling task being returned.
+ *
+ * @return The partition the task is bound to, or tskNO_PARTITION.
+ *
+ * \defgroup uxTaskGetPartition uxTaskGetPartition
+ * \ingroup TaskCtrl
+ */
+#if ( configUSE_TIME_PARTITIONING == 1 )
+    UBaseType_t uxTaskGetPartition( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * BaseType_t xTaskGetPartitionStatus( UBaseType_t uxPartition, TaskPartitionStatus_t * pxPartitionStatus );
+ * @endcode
+ *
+ * configUSE_TIME_PARTITIONING must be defined as 1 in FreeRTOSConfig.h for
+ * this function to be available.
+ *
+ * Returns the budget of a partition with its usage, overrun and window switch
+ * overhead counters.  The counters are reset by xTaskSetPartitionSchedule().
+ *
+ * The switch overhead is measured from the tick interrupt that starts a
+ * window of the partition, after the tick count has been incremented, to the
+ * selection of the task that runs first in it, so it covers moving the tasks
+ * of both partitions between the ready lists and the context switch, but not
+ * the saving and restoring of registers.
+ *
+ * @param uxPartition The partition being queried.
+ *
+ * @param pxPartitionStatus The structure the status is copied to.
+ *
+ * @return pdPASS, or pdFAIL if uxPartition is not less than
+ * configMAX_PARTITIONS.
+ *
+ * \defgroup xTaskGetPartitionStatus xTaskGetPartitionStatus
+ * \ingroup TaskCtrl
+ */
+#if ( configUSE_TIME_PARTITIONING == 1 )
+    BaseType_t xTaskGetPartitionStatus( UBaseType_t uxPartition,
+                                        TaskPartitionStatus_t * pxPartitionStatus ) PRIVILEGED_FUNCTION;
+#endif
+
 
 /**
  * task. h
@@ -1948,6 +2318,42 @@ char * pcTaskGetName( TaskHandle_t xTaskToQuery ) PRIVILEGED_FUNCTION;
 
 #endif
 
+#if ( ( configCHECK_FOR_STACK_OVERFLOW == 3 ) && ( portUSING_MPU_WRAPPERS != 1 ) )
+
+/**
+ * task.h
+ * @code{c}
+ * configSTACK_DEPTH_TYPE uxTaskGetStackOverflowDepth( TaskHandle_t xTask );
+ * @endcode
+ *
+ * configCHECK_FOR_STACK_OVERFLOW must be set to 3 in FreeRTOSConfig.h for this
+ * function to be available.
+ *
+ * With configCHECK_FOR_STACK_OVERFLOW set to 3 the last configSTACK_GUARD_WORDS
+ * words of each task stack form a guard zone.  vApplicationStackOverflowHook()
+ * is called from the context switch when the saved stack pointer of a task lies
+ * inside its guard zone, and from the idle task when a periodic scan finds that
+ * the fill pattern of a guard zone has been overwritten.  This function returns
+ * how far, in words, the task has reached into its guard zone, so it can be
+ * called from the hook to report the overflow depth.
+ *
+ * The depth is the larger of the number of guard words no longer holding the
+ * fill pattern and the number of guard words below the saved stack pointer.
+ * A value up to configSTACK_GUARD_WORDS means the task used stack it was not
+ * meant to use, but did not leave its stack buffer.  A value greater than
+ * configSTACK_GUARD_WORDS means the saved stack pointer was outside the stack
+ * buffer, by the difference, and neighbouring memory has been corrupted.
+ *
+ * @param xTask Handle of the task being queried.  Passing a NULL
+ * handle results in the depth of the calling task being returned.
+ *
+ * @return The depth, in words, reached into the guard zone.  Zero if the guard
+ * zone has not been touched.
+ */
+    configSTACK_DEPTH_TYPE uxTaskGetStackOverflowDepth( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+
+#endif
+
 #if ( configUSE_IDLE_HOOK == 1 )
 
 /**
@@ -1986,6 +2392,27 @@ char * pcTaskGetName( TaskHandle_t xTaskToQuery ) PRIVILEGED_FUNCTION;
 
 #endif
 
+#if ( ( configUSE_TIME_PARTITIONING == 1 ) && ( configUSE_PARTITION_OVERRUN_HOOK == 1 ) )
+
+/**
+ * task.h
+ * @code{c}
+ * void vApplicationPartitionOverrunHook( UBaseType_t uxPartition );
+ * @endcode
+ *
+ * Called from the tick interrupt when a window of uxPartition ends with a task
+ * of the partition still ready to run.  Must not call any API function that
+ * is not safe to call from an interrupt.
+ *
+ * @param uxPartition The partition whose window overran.
+ */
+    /* MISRA Ref 8.6.1 [External linkage] */
+    /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-86 */
+    /* coverity[misra_c_2012_rule_8_6_violation] */
+    void vApplicationPartitionOverrunHook( UBaseType_t uxPartition );
+
+#endif
+
 #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
 
 /**
@@ -3500,6 +3927,27 @@ void vTaskResetState( void ) PRIVILEGED_FUNCTION;
  */
 BaseType_t xTaskIncrementTick( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * THESE FUNCTIONS MUST NOT BE USED FROM APPLICATION CODE.  THEY ARE ONLY
+ * CALLED BY THE CRITICAL SECTION MACROS WHEN configUSE_CRITICAL_PROFILER IS 1.
+ *
+ * THESE FUNCTIONS MUST BE CALLED WITH INTERRUPTS DISABLED.
+ *
+ * vCriticalProfilerEnter() is called as a critical section is entered at line
+ * ulLine of pcFile, and vCriticalProfilerExit() as it is exited.
+ * uxCriticalProfilerEnterFromISR() does the same as vCriticalProfilerEnter()
+ * and returns uxSavedInterruptStatus, so it can wrap
+ * portSET_INTERRUPT_MASK_FROM_ISR().  Implemented in critical_profiler.c.
+ */
+#if ( configUSE_CRITICAL_PROFILER == 1 )
+    void vCriticalProfilerEnter( const char * pcFile,
+                                 uint32_t ulLine ) PRIVILEGED_FUNCTION;
+    UBaseType_t uxCriticalProfilerEnterFromISR( UBaseType_t uxSavedInterruptStatus,
+                                                const char * pcFile,
+                                                uint32_t ulLine ) PRIVILEGED_FUNCTION;
+    void vCriticalProfilerExit( void ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS AN
  * INTERFACE WHICH IS FOR THE EXCLUSIVE USE OF THE SCHEDULER.
@@ -3580,6 +4028,25 @@ BaseType_t xTaskRemoveFromEventList( const List_t * const pxEventList ) PRIVILEG
 void vTaskRemoveFromUnorderedEventList( ListItem_t * pxEventListItem,
                                         const TickType_t xItemValue ) PRIVILEGED_FUNCTION;
 
+/*
+ * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS AN
+ * INTERFACE WHICH IS FOR THE EXCLUSIVE USE OF THE SCHEDULER.
+ *
+ * THIS FUNCTION MUST BE CALLED FROM A CRITICAL SECTION.
+ *
+ * As vTaskRemoveFromUnorderedEventList(), but can also be called from an
+ * interrupt or while the scheduler is running, in which case the task is held
+ * on the pending ready list until the scheduler can move it to a ready list.
+ * Used by event groups created with xEventGroupCreateDirect().
+ *
+ * @return pdTRUE if the task being removed has a higher priority than the task
+ * that was running, otherwise pdFALSE.
+ */
+#if ( configUSE_DIRECT_EVENT_GROUPS == 1 )
+    BaseType_t xTaskRemoveFromUnorderedEventListFromISR( ListItem_t * pxEventListItem,
+                                                         const TickType_t xItemValue ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS ONLY
  * INTENDED FOR USE WHEN IMPLEMENTING A PORT OF THE SCHEDULER AND IS
@@ -3697,6 +4164,36 @@ void vTaskPriorityDisinheritAfterTimeout( TaskHandle_t const pxMutexHolder,
  */
 TaskHandle_t pvTaskIncrementMutexHeldCount( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * For internal use only.  Decrement the mutex held count when a mutex that
+ * was taken with pvTaskIncrementMutexHeldCount() is given back, disinheriting
+ * any inherited priority if it was the last mutex held.  Returns pdTRUE if the
+ * calling task's priority was lowered, in which case it should yield.
+ */
+#if ( configUSE_FAST_MUTEXES == 1 )
+    BaseType_t xTaskDecrementMutexHeldCount( void ) PRIVILEGED_FUNCTION;
+#endif
+
+/*
+ * For internal use only.  Record the mutex the calling task is about to block
+ * on, or NULL once it is no longer blocked, so priority inheritance can follow
+ * the chain from a mutex holder that is itself blocked on another mutex.
+ */
+#if ( configUSE_TRANSITIVE_INHERITANCE == 1 )
+    void vTaskSetBlockedOnMutex( void * pvMutex ) PRIVILEGED_FUNCTION;
+#endif
+
+/*
+ * For internal use only.  Raise the calling task to the ceiling priority of a
+ * priority ceiling mutex it has just taken, returning the priority it had
+ * before.  Restore the priority when the mutex is given back.
+ */
+#if ( configUSE_CEILING_MUTEXES == 1 )
+    UBaseType_t uxTaskPriorityRaiseToCeiling( UBaseType_t uxCeilingPriority ) PRIVILEGED_FUNCTION;
+    BaseType_t xTaskPriorityRestoreFromCeiling( UBaseType_t uxCeilingPriority,
+                                                UBaseType_t uxPriorityBeforeCeiling ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * For internal use only.  Same as vTaskSetTimeOutState(), but without a critical
  * section.
@@ -0,0 +1,847 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+
+
+/*
+ * A heap_5.c style allocator that spans several separate memory regions, but
+ * keeps each region as a heap of its own - with its own free list, free byte
+ * count and statistics - so the caller can choose which region a block comes
+ * from.  This matters on parts where memory is split into banks that the bus
+ * fabric arbitrates separately, for example the RP2040's striped main SRAM and
+ * its two 4 KB scratch banks: placing the stacks of busy tasks in one bank and
+ * DMA buffers in another stops the processor and the DMA from stalling each
+ * other.
+ *
+ * The regions are passed to vPortDefineHeapRegions(), which must be called
+ * before the first allocation.  A region is identified by its index in the
+ * array passed.  pvPortMallocInRegion() takes a block from the region given,
+ * falling back to the other regions in index order if that region cannot
+ * satisfy the request; pvPortMalloc() does the same starting from region 0.
+ * vPortFree() finds the region from the address being freed.  Within a
+ * region, blocks are allocated first fit and adjacent free blocks are
+ * combined, as in heap_4.c.
+ *
+ * When configUSE_HEAP_REGION_HINTS is 1 the kernel uses
+ * pvPortMallocInRegion() to place the stacks of tasks created with
+ * xTaskCreateInRegion().
+ *
+ * See heap_1.c, heap_2.c, heap_3.c, heap_4.c, heap_5.c and heap_tlsf.c for
+ * alternative implementations, and the memory management pages of
+ * https://www.FreeRTOS.org for more information.
+ */
+#include <stdlib.h>
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 0 )
+    #error This file must not be used if configSUPPORT_DYNAMIC_ALLOCATION is 0
+#endif
+
+#ifndef configHEAP_CLEAR_MEMORY_ON_FREE
+    #define configHEAP_CLEAR_MEMORY_ON_FREE    0
+#endif
+
+/* The maximum number of regions vPortDefineHeapRegions() accepts. */
+#ifndef configHEAP_MAX_REGIONS
+    #define configHEAP_MAX_REGIONS    4
+#endif
+
+/* Block sizes must not get too small. */
+#define heapMINIMUM_BLOCK_SIZE    ( ( size_t ) ( xHeapStructSize << 1 ) )
+
+/* Assumes 8bit bytes! */
+#define heapBITS_PER_BYTE         ( ( size_t ) 8 )
+
+/* Max value that fits in a size_t type. */
+#define heapSIZE_MAX              ( ~( ( size_t ) 0 ) )
+
+/* Check if multiplying a and b will result in overflow. */
+#define heapMULTIPLY_WILL_OVERFLOW( a, b )     ( ( ( a ) > 0 ) && ( ( b ) > ( heapSIZE_MAX / ( a ) ) ) )
+
+/* Check if adding a and b will result in overflow. */
+#define heapADD_WILL_OVERFLOW( a, b )          ( ( a ) > ( heapSIZE_MAX - ( b ) ) )
+
+/* Check if the subtraction operation ( a - b ) will result in underflow. */
+#define heapSUBTRACT_WILL_UNDERFLOW( a, b )    ( ( a ) < ( b ) )
+
+/* MSB of the xBlockSize member of an BlockLink_t structure is used to track
+ * the allocation status of a block.  When MSB of the xBlockSize member of
+ * an BlockLink_t structure is set then the block belongs to the application.
+ * When the bit is free the block is still part of the free heap space. */
+#define heapBLOCK_ALLOCATED_BITMASK    ( ( ( size_t ) 1 ) << ( ( sizeof( size_t ) * heapBITS_PER_BYTE ) - 1 ) )
+#define heapBLOCK_SIZE_IS_VALID( xBlockSize )    ( ( ( xBlockSize ) & heapBLOCK_ALLOCATED_BITMASK ) == 0 )
+#define heapBLOCK_IS_ALLOCATED( pxBlock )        ( ( ( pxBlock->xBlockSize ) & heapBLOCK_ALLOCATED_BITMASK ) != 0 )
+#define heapALLOCATE_BLOCK( pxBlock )            ( ( pxBlock->xBlockSize ) |= heapBLOCK_ALLOCATED_BITMASK )
+#define heapFREE_BLOCK( pxBlock )                ( ( pxBlock->xBlockSize ) &= ~heapBLOCK_ALLOCATED_BITMASK )
+
+/*-----------------------------------------------------------*/
+
+/* Define the linked list structure.  This is used to link free blocks in order
+ * of their memory address. */
+typedef struct A_BLOCK_LINK
+{
+    struct A_BLOCK_LINK * pxNextFreeBlock; /**< The next free block in the list. */
+    size_t xBlockSize;                     /**< The size of the free block. */
+} BlockLink_t;
+
+/* The state of one region.  Each region is a heap_4.c heap in its own right. */
+typedef struct HEAP_REGION_STATE
+{
+    BlockLink_t xStart;                    /**< Marks the start of the region's free list. */
+    BlockLink_t * pxEnd;                   /**< Marks the end of the region's free list, and of the region itself. */
+    uint8_t * pucFirstBlock;               /**< The lowest address of the region that can hold a block. */
+    size_t xFreeBytesRemaining;            /**< The sum of the sizes of the region's free blocks. */
+    size_t xMinimumEverFreeBytesRemaining; /**< The lowest xFreeBytesRemaining has been. */
+    size_t xNumberOfSuccessfulAllocations; /**< Blocks allocated from the region. */
+    size_t xNumberOfSuccessfulFrees;       /**< Blocks returned to the region. */
+} HeapRegionState_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Rounds a requested size up to include the block header and alignment
+ * padding.  Returns 0 if the result would not fit in a size_t.
+ */
+static size_t prvAdjustWantedSize( size_t xWantedSize ) PRIVILEGED_FUNCTION;
+
+/*
+ * Allocates a block of xWantedSize bytes, already adjusted by
+ * prvAdjustWantedSize(), from region xRegion, or if xRegion cannot satisfy the
+ * request from the first region that can.  Must be called with the scheduler
+ * suspended.
+ */
+static void * prvAllocate( size_t xWantedSize,
+                           BaseType_t xRegion ) PRIVILEGED_FUNCTION;
+
+/*
+ * Allocates a block from one region only.  Must be called with the scheduler
+ * suspended.
+ */
+static void * prvAllocateFromRegion( HeapRegionState_t * pxRegion,
+                                     size_t xWantedSize ) PRIVILEGED_FUNCTION;
+
+/*
+ * Inserts a block of memory that is being freed into the correct position in
+ * its region's list of free memory blocks.  The block being freed will be
+ * merged with the block in front it and/or the block behind it if the memory
+ * blocks are adjacent to each other.
+ */
+static void prvInsertBlockIntoFreeList( HeapRegionState_t * pxRegion,
+                                        BlockLink_t * pxBlockToInsert ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the region that contains pv, or NULL if no region does.
+ */
+static HeapRegionState_t * prvFindRegion( const void * pv ) PRIVILEGED_FUNCTION;
+
+/*
+ * Walks the free list of a region to find the number, largest and smallest
+ * of its free blocks.
+ */
+static void prvScanFreeBlocks( const HeapRegionState_t * pxRegion,
+                               size_t * pxBlocks,
+                               size_t * pxMaxSize,
+                               size_t * pxMinSize ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+/* The size of the structure placed at the beginning of each allocated memory
+ * block must by correctly byte aligned. */
+static const size_t xHeapStructSize = ( sizeof( BlockLink_t ) + ( ( size_t ) ( portBYTE_ALIGNMENT - 1 ) ) ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+/* The regions passed to vPortDefineHeapRegions(), in the order passed. */
+PRIVILEGED_DATA static HeapRegionState_t xRegions[ configHEAP_MAX_REGIONS ];
+PRIVILEGED_DATA static BaseType_t xRegionCount = 0;
+
+/* Totals over all the regions. */
+PRIVILEGED_DATA static size_t xFreeBytesRemaining = ( size_t ) 0U;
+PRIVILEGED_DATA static size_t xMinimumEverFreeBytesRemaining = ( size_t ) 0U;
+
+/*-----------------------------------------------------------*/
+
+void * pvPortMalloc( size_t xWantedSize )
+{
+    void * pvReturn;
+
+    /* The heap must be initialised before the first call to pvPortMalloc(). */
+    configASSERT( xRegionCount > 0 );
+
+    xWantedSize = prvAdjustWantedSize( xWantedSize );
+
+    vTaskSuspendAll();
+    {
+        pvReturn = prvAllocate( xWantedSize, portHEAP_REGION_ANY );
+        traceMALLOC( pvReturn, xWantedSize );
+    }
+    ( void ) xTaskResumeAll();
+
+    #if ( configUSE_MALLOC_FAILED_HOOK == 1 )
+    {
+        if( pvReturn == NULL )
+        {
+            vApplicationMallocFailedHook();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif /* if ( configUSE_MALLOC_FAILED_HOOK == 1 ) */
+
+    configASSERT( ( ( ( size_t ) pvReturn ) & ( size_t ) portBYTE_ALIGNMENT_MASK ) == 0 );
+    return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void * pvPortMallocInRegion( size_t xWantedSize,
+                             BaseType_t xRegion )
+{
+    void * pvReturn;
+
+    /* The heap must be initialised before the first call to pvPortMalloc(). */
+    configASSERT( xRegionCount > 0 );
+    configASSERT( ( xRegion == portHEAP_REGION_ANY ) || ( ( xRegion >= 0 ) && ( xRegion < xRegionCount ) ) );
+
+    xWantedSize = prvAdjustWantedSize( xWantedSize );
+
+    /* Kept separate from pvPortMalloc(), rather than called by it, so that
+     * traceMALLOC() sees the caller of whichever function was used. */
+    vTaskSuspendAll();
+    {
+        pvReturn = prvAllocate( xWantedSize, xRegion );
+        traceMALLOC( pvReturn, xWantedSize );
+    }
+    ( void ) xTaskResumeAll();
+
+    #if ( configUSE_MALLOC_FAILED_HOOK == 1 )
+    {
+        if( pvReturn == NULL )
+        {
+            vApplicationMallocFailedHook();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif /* if ( configUSE_MALLOC_FAILED_HOOK == 1 ) */
+
+    configASSERT( ( ( ( size_t ) pvReturn ) & ( size_t ) portBYTE_ALIGNMENT_MASK ) == 0 );
+    return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vPortFree( void * pv )
+{
+    uint8_t * puc = ( uint8_t * ) pv;
+    BlockLink_t * pxLink;
+    HeapRegionState_t * pxRegion;
+
+    if( pv != NULL )
+    {
+        /* The memory being freed will have an BlockLink_t structure immediately
+         * before it. */
+        puc -= xHeapStructSize;
+
+        /* This casting is to keep the compiler from issuing warnings. */
+        pxLink = ( void * ) puc;
+
+        pxRegion = prvFindRegion( pv );
+
+        configASSERT( pxRegion != NULL );
+        configASSERT( heapBLOCK_IS_ALLOCATED( pxLink ) != 0 );
+        configASSERT( pxLink->pxNextFreeBlock == NULL );
+
+        if( ( pxRegion != NULL ) && ( heapBLOCK_IS_ALLOCATED( pxLink ) != 0 ) )
+        {
+            if( pxLink->pxNextFreeBlock == NULL )
+            {
+                /* The block is being returned to the heap - it is no longer
+                 * allocated. */
+                heapFREE_BLOCK( pxLink );
+                #if ( configHEAP_CLEAR_MEMORY_ON_FREE == 1 )
+                {
+                    /* Check for underflow as this can occur if xBlockSize is
+                     * overwritten in a heap block. */
+                    if( heapSUBTRACT_WILL_UNDERFLOW( pxLink->xBlockSize, xHeapStructSize ) == 0 )
+                    {
+                        ( void ) memset( puc + xHeapStructSize, 0, pxLink->xBlockSize - xHeapStructSize );
+                    }
+                }
+                #endif
+
+                vTaskSuspendAll();
+                {
+                    /* Add this block to the list of free blocks. */
+                    pxRegion->xFreeBytesRemaining += pxLink->xBlockSize;
+                    xFreeBytesRemaining += pxLink->xBlockSize;
+                    traceFREE( pv, pxLink->xBlockSize );
+                    prvInsertBlockIntoFreeList( pxRegion, ( ( BlockLink_t * ) pxLink ) );
+                    pxRegion->xNumberOfSuccessfulFrees++;
+                }
+                ( void ) xTaskResumeAll();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetFreeHeapSize( void )
+{
+    return xFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetMinimumEverFreeHeapSize( void )
+{
+    return xMinimumEverFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+void xPortResetHeapMinimumEverFreeHeapSize( void )
+{
+    BaseType_t xRegion;
+
+    vTaskSuspendAll();
+    {
+        for( xRegion = 0; xRegion < xRegionCount; xRegion++ )
+        {
+            xRegions[ xRegion ].xMinimumEverFreeBytesRemaining = xRegions[ xRegion ].xFreeBytesRemaining;
+        }
+
+        xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+    }
+    ( void ) xTaskResumeAll();
+}
+/*-----------------------------------------------------------*/
+
+void vPortInitialiseBlocks( void )
+{
+    /* This just exists to keep the linker quiet. */
+}
+/*-----------------------------------------------------------*/
+
+void * pvPortCalloc( size_t xNum,
+                     size_t xSize )
+{
+    void * pv = NULL;
+
+    if( heapMULTIPLY_WILL_OVERFLOW( xNum, xSize ) == 0 )
+    {
+        pv = pvPortMalloc( xNum * xSize );
+
+        if( pv != NULL )
+        {
+            ( void ) memset( pv, 0, xNum * xSize );
+        }
+    }
+
+    return pv;
+}
+/*-----------------------------------------------------------*/
+
+void vPortDefineHeapRegions( const HeapRegion_t * const pxHeapRegions ) /* PRIVILEGED_FUNCTION */
+{
+    HeapRegionState_t * pxRegion;
+    BlockLink_t * pxFirstFreeBlock;
+    portPOINTER_SIZE_TYPE uxAddress;
+    portPOINTER_SIZE_TYPE uxEndAddress;
+    const HeapRegion_t * pxHeapRegion;
+
+    /* Can only call once! */
+    configASSERT( xRegionCount == 0 );
+
+    for( pxHeapRegion = pxHeapRegions; pxHeapRegion->xSizeInBytes > 0; pxHeapRegion++ )
+    {
+        configASSERT( xRegionCount < ( BaseType_t ) configHEAP_MAX_REGIONS );
+
+        if( xRegionCount >= ( BaseType_t ) configHEAP_MAX_REGIONS )
+        {
+            break;
+        }
+
+        pxRegion = &( xRegions[ xRegionCount ] );
+
+        /* Ensure the heap region starts on a correctly aligned boundary. */
+        uxAddress = ( portPOINTER_SIZE_TYPE ) pxHeapRegion->pucStartAddress;
+        uxEndAddress = uxAddress + ( portPOINTER_SIZE_TYPE ) pxHeapRegion->xSizeInBytes;
+
+        if( ( uxAddress & portBYTE_ALIGNMENT_MASK ) != 0 )
+        {
+            uxAddress += ( portBYTE_ALIGNMENT - 1 );
+            uxAddress &= ~( ( portPOINTER_SIZE_TYPE ) portBYTE_ALIGNMENT_MASK );
+        }
+
+        /* pxEnd is used to mark the end of the list of free blocks and is
+         * inserted at the end of the region space. */
+        uxEndAddress -= ( portPOINTER_SIZE_TYPE ) xHeapStructSize;
+        uxEndAddress &= ~( ( portPOINTER_SIZE_TYPE ) portBYTE_ALIGNMENT_MASK );
+
+        /* A region too small to hold a block once aligned is ignored, but still
+         * takes its index so the indexes the application uses stay valid. */
+        pxRegion->pxEnd = ( BlockLink_t * ) uxEndAddress;
+        pxRegion->pxEnd->xBlockSize = 0;
+        pxRegion->pxEnd->pxNextFreeBlock = NULL;
+        pxRegion->pucFirstBlock = ( uint8_t * ) uxAddress;
+
+        if( uxEndAddress > ( uxAddress + ( portPOINTER_SIZE_TYPE ) heapMINIMUM_BLOCK_SIZE ) )
+        {
+            /* To start with there is a single free block that is sized to take
+             * up the entire region minus the space taken by pxEnd. */
+            pxFirstFreeBlock = ( BlockLink_t * ) uxAddress;
+            pxFirstFreeBlock->xBlockSize = ( size_t ) ( uxEndAddress - uxAddress );
+            pxFirstFreeBlock->pxNextFreeBlock = pxRegion->pxEnd;
+            pxRegion->xStart.pxNextFreeBlock = pxFirstFreeBlock;
+            pxRegion->xFreeBytesRemaining = pxFirstFreeBlock->xBlockSize;
+        }
+        else
+        {
+            pxRegion->xStart.pxNextFreeBlock = pxRegion->pxEnd;
+            pxRegion->xFreeBytesRemaining = ( size_t ) 0U;
+        }
+
+        pxRegion->xStart.xBlockSize = ( size_t ) 0U;
+        pxRegion->xMinimumEverFreeBytesRemaining = pxRegion->xFreeBytesRemaining;
+        pxRegion->xNumberOfSuccessfulAllocations = ( size_t ) 0U;
+        pxRegion->xNumberOfSuccessfulFrees = ( size_t ) 0U;
+
+        xFreeBytesRemaining += pxRegion->xFreeBytesRemaining;
+        xRegionCount++;
+    }
+
+    xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+
+    /* Check something was actually defined before it is accessed. */
+    configASSERT( xRegionCount > 0 );
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvAdjustWantedSize( size_t xWantedSize )
+{
+    size_t xAdditionalRequiredSize;
+
+    if( xWantedSize > 0 )
+    {
+        /* The wanted size must be increased so it can contain a BlockLink_t
+         * structure in addition to the requested amount of bytes. */
+        if( heapADD_WILL_OVERFLOW( xWantedSize, xHeapStructSize ) == 0 )
+        {
+            xWantedSize += xHeapStructSize;
+
+            /* Ensure that blocks are always aligned to the required number
+             * of bytes. */
+            if( ( xWantedSize & portBYTE_ALIGNMENT_MASK ) != 0x00 )
+            {
+                /* Byte alignment required. */
+                xAdditionalRequiredSize = portBYTE_ALIGNMENT - ( xWantedSize & portBYTE_ALIGNMENT_MASK );
+
+                if( heapADD_WILL_OVERFLOW( xWantedSize, xAdditionalRequiredSize ) == 0 )
+                {
+                    xWantedSize += xAdditionalRequiredSize;
+                }
+                else
+                {
+                    xWantedSize = 0;
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            xWantedSize = 0;
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    /* Check the block size we are trying to allocate is not so large that the
+     * top bit is set.  The top bit of the block size member of the
+     * BlockLink_t structure is used to determine who owns the block - the
+     * application or the kernel, so it must be free. */
+    if( heapBLOCK_SIZE_IS_VALID( xWantedSize ) == 0 )
+    {
+        xWantedSize = 0;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return xWantedSize;
+}
+/*-----------------------------------------------------------*/
+
+static void * prvAllocate( size_t xWantedSize,
+                           BaseType_t xRegion )
+{
+    void * pvReturn = NULL;
+    BaseType_t x;
+
+    if( xWantedSize > 0 )
+    {
+        /* Try the region asked for first. */
+        if( ( xRegion >= 0 ) && ( xRegion < xRegionCount ) )
+        {
+            pvReturn = prvAllocateFromRegion( &( xRegions[ xRegion ] ), xWantedSize );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* The region is a hint, so fall back to the others in order. */
+        for( x = 0; ( x < xRegionCount ) && ( pvReturn == NULL ); x++ )
+        {
+            if( x != xRegion )
+            {
+                pvReturn = prvAllocateFromRegion( &( xRegions[ x ] ), xWantedSize );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+        if( pvReturn != NULL )
+        {
+            xFreeBytesRemaining -= ( ( BlockLink_t * ) ( ( ( uint8_t * ) pvReturn ) - xHeapStructSize ) )->xBlockSize & ~heapBLOCK_ALLOCATED_BITMASK;
+
+            if( xFreeBytesRemaining < xMinimumEverFreeBytesRemaining )
+            {
+                xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void * prvAllocateFromRegion( HeapRegionState_t * pxRegion,
+                                     size_t xWantedSize )
+{
+    BlockLink_t * pxBlock;
+    BlockLink_t * pxPreviousBlock;
+    BlockLink_t * pxNewBlockLink;
+    void * pvReturn = NULL;
+
+    if( xWantedSize <= pxRegion->xFreeBytesRemaining )
+    {
+        /* Traverse the list from the start (lowest address) block until
+         * one of adequate size is found. */
+        pxPreviousBlock = &( pxRegion->xStart );
+        pxBlock = pxRegion->xStart.pxNextFreeBlock;
+
+        while( ( pxBlock->xBlockSize < xWantedSize ) && ( pxBlock->pxNextFreeBlock != NULL ) )
+        {
+            pxPreviousBlock = pxBlock;
+            pxBlock = pxBlock->pxNextFreeBlock;
+        }
+
+        /* If the end marker was reached then a block of adequate size
+         * was not found. */
+        if( pxBlock != pxRegion->pxEnd )
+        {
+            /* Return the memory space pointed to - jumping over the
+             * BlockLink_t structure at its start. */
+            pvReturn = ( void * ) ( ( ( uint8_t * ) pxPreviousBlock->pxNextFreeBlock ) + xHeapStructSize );
+
+            /* This block is being returned for use so must be taken out
+             * of the list of free blocks. */
+            pxPreviousBlock->pxNextFreeBlock = pxBlock->pxNextFreeBlock;
+
+            /* If the block is larger than required it can be split into
+             * two. */
+            if( ( pxBlock->xBlockSize - xWantedSize ) > heapMINIMUM_BLOCK_SIZE )
+            {
+                /* This block is to be split into two.  Create a new
+                 * block following the number of bytes requested. */
+                pxNewBlockLink = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xWantedSize );
+                configASSERT( ( ( ( size_t ) pxNewBlockLink ) & portBYTE_ALIGNMENT_MASK ) == 0 );
+
+                /* Calculate the sizes of two blocks split from the
+                 * single block. */
+                pxNewBlockLink->xBlockSize = pxBlock->xBlockSize - xWantedSize;
+                pxBlock->xBlockSize = xWantedSize;
+
+                /* Insert the new block into the list of free blocks. */
+                pxNewBlockLink->pxNextFreeBlock = pxPreviousBlock->pxNextFreeBlock;
+                pxPreviousBlock->pxNextFreeBlock = pxNewBlockLink;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            pxRegion->xFreeBytesRemaining -= pxBlock->xBlockSize;
+
+            if( pxRegion->xFreeBytesRemaining < pxRegion->xMinimumEverFreeBytesRemaining )
+            {
+                pxRegion->xMinimumEverFreeBytesRemaining = pxRegion->xFreeBytesRemaining;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            /* The block is being returned - it is allocated and owned
+             * by the application and has no "next" block. */
+            heapALLOCATE_BLOCK( pxBlock );
+            pxBlock->pxNextFreeBlock = NULL;
+            pxRegion->xNumberOfSuccessfulAllocations++;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvInsertBlockIntoFreeList( HeapRegionState_t * pxRegion,
+                                        BlockLink_t * pxBlockToInsert ) /* PRIVILEGED_FUNCTION */
+{
+    BlockLink_t * pxIterator;
+    uint8_t * puc;
+
+    /* Iterate through the list until a block is found that has a higher address
+     * than the block being inserted. */
+    for( pxIterator = &( pxRegion->xStart ); pxIterator->pxNextFreeBlock < pxBlockToInsert; pxIterator = pxIterator->pxNextFreeBlock )
+    {
+        /* Nothing to do here, just iterate to the right position. */
+    }
+
+    /* Do the block being inserted, and the block it is being inserted after
+     * make a contiguous block of memory? */
+    puc = ( uint8_t * ) pxIterator;
+
+    if( ( puc + pxIterator->xBlockSize ) == ( uint8_t * ) pxBlockToInsert )
+    {
+        pxIterator->xBlockSize += pxBlockToInsert->xBlockSize;
+        pxBlockToInsert = pxIterator;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    /* Do the block being inserted, and the block it is being inserted before
+     * make a contiguous block of memory? */
+    puc = ( uint8_t * ) pxBlockToInsert;
+
+    if( ( puc + pxBlockToInsert->xBlockSize ) == ( uint8_t * ) pxIterator->pxNextFreeBlock )
+    {
+        if( pxIterator->pxNextFreeBlock != pxRegion->pxEnd )
+        {
+            /* Form one big block from the two blocks. */
+            pxBlockToInsert->xBlockSize += pxIterator->pxNextFreeBlock->xBlockSize;
+            pxBlockToInsert->pxNextFreeBlock = pxIterator->pxNextFreeBlock->pxNextFreeBlock;
+        }
+        else
+        {
+            pxBlockToInsert->pxNextFreeBlock = pxRegion->pxEnd;
+        }
+    }
+    else
+    {
+        pxBlockToInsert->pxNextFreeBlock = pxIterator->pxNextFreeBlock;
+    }
+
+    /* If the block being inserted plugged a gap, so was merged with the block
+     * before and the block after, then it's pxNextFreeBlock pointer will have
+     * already been set, and should not be set here as that would make it point
+     * to itself. */
+    if( pxIterator != pxBlockToInsert )
+    {
+        pxIterator->pxNextFreeBlock = pxBlockToInsert;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+}
+/*-----------------------------------------------------------*/
+
+static HeapRegionState_t * prvFindRegion( const void * pv )
+{
+    HeapRegionState_t * pxReturn = NULL;
+    BaseType_t x;
+
+    for( x = 0; x < xRegionCount; x++ )
+    {
+        if( ( ( const uint8_t * ) pv > xRegions[ x ].pucFirstBlock ) && ( ( const uint8_t * ) pv < ( const uint8_t * ) xRegions[ x ].pxEnd ) )
+        {
+            pxReturn = &( xRegions[ x ] );
+            break;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+    return pxReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvScanFreeBlocks( const HeapRegionState_t * pxRegion,
+                               size_t * pxBlocks,
+                               size_t * pxMaxSize,
+                               size_t * pxMinSize )
+{
+    const BlockLink_t * pxBlock = pxRegion->xStart.pxNextFreeBlock;
+
+    while( pxBlock != pxRegion->pxEnd )
+    {
+        /* Increment the number of blocks and record the largest block seen
+         * so far. */
+        ( *pxBlocks )++;
+
+        if( pxBlock->xBlockSize > *pxMaxSize )
+        {
+            *pxMaxSize = pxBlock->xBlockSize;
+        }
+
+        if( pxBlock->xBlockSize < *pxMinSize )
+        {
+            *pxMinSize = pxBlock->xBlockSize;
+        }
+
+        /* Move to the next block in the chain until the last block is
+         * reached. */
+        pxBlock = pxBlock->pxNextFreeBlock;
+    }
+}
+/*-----------------------------------------------------------*/
+
+void vPortGetHeapStats( HeapStats_t * pxHeapStats )
+{
+    size_t xBlocks = 0, xMaxSize = 0, xMinSize = portMAX_DELAY; /* portMAX_DELAY used as a portable way of getting the maximum value. */
+    size_t xAllocations = 0, xFrees = 0;
+    BaseType_t x;
+
+    vTaskSuspendAll();
+    {
+        for( x = 0; x < xRegionCount; x++ )
+        {
+            prvScanFreeBlocks( &( xRegions[ x ] ), &xBlocks, &xMaxSize, &xMinSize );
+            xAllocations += xRegions[ x ].xNumberOfSuccessfulAllocations;
+            xFrees += xRegions[ x ].xNumberOfSuccessfulFrees;
+        }
+
+        pxHeapStats->xAvailableHeapSpaceInBytes = xFreeBytesRemaining;
+        pxHeapStats->xMinimumEverFreeBytesRemaining = xMinimumEverFreeBytesRemaining;
+    }
+    ( void ) xTaskResumeAll();
+
+    pxHeapStats->xSizeOfLargestFreeBlockInBytes = xMaxSize;
+    pxHeapStats->xSizeOfSmallestFreeBlockInBytes = xMinSize;
+    pxHeapStats->xNumberOfFreeBlocks = xBlocks;
+    pxHeapStats->xNumberOfSuccessfulAllocations = xAllocations;
+    pxHeapStats->xNumberOfSuccessfulFrees = xFrees;
+}
+/*-----------------------------------------------------------*/
+
+void vPortGetHeapRegionStats( BaseType_t xRegion,
+                              HeapStats_t * pxHeapStats )
+{
+    size_t xBlocks = 0, xMaxSize = 0, xMinSize = portMAX_DELAY; /* portMAX_DELAY used as a portable way of getting the maximum value. */
+
+    configASSERT( ( xRegion >= 0 ) && ( xRegion < xRegionCount ) );
+
+    vTaskSuspendAll();
+    {
+        prvScanFreeBlocks( &( xRegions[ xRegion ] ), &xBlocks, &xMaxSize, &xMinSize );
+
+        pxHeapStats->xAvailableHeapSpaceInBytes = xRegions[ xRegion ].xFreeBytesRemaining;
+        pxHeapStats->xMinimumEverFreeBytesRemaining = xRegions[ xRegion ].xMinimumEverFreeBytesRemaining;
+        pxHeapStats->xNumberOfSuccessfulAllocations = xRegions[ xRegion ].xNumberOfSuccessfulAllocations;
+        pxHeapStats->xNumberOfSuccessfulFrees = xRegions[ xRegion ].xNumberOfSuccessfulFrees;
+    }
+    ( void ) xTaskResumeAll();
+
+    pxHeapStats->xSizeOfLargestFreeBlockInBytes = xMaxSize;
+    pxHeapStats->xSizeOfSmallestFreeBlockInBytes = xMinSize;
+    pxHeapStats->xNumberOfFreeBlocks = xBlocks;
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * Reset the state in this file. This state is normally initialized at start up.
+ * This function must be called by the application before restarting the
+ * scheduler.
+ */
+void vPortHeapResetState( void )
+{
+    xRegionCount = 0;
+
+    xFreeBytesRemaining = ( size_t ) 0U;
+    xMinimumEverFreeBytesRemaining = ( size_t ) 0U;
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,815 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+
+/*
+ * A Two-Level Segregated Fit (TLSF) implementation of pvPortMalloc() and
+ * vPortFree().  Like heap_4.c it combines adjacent free blocks to limit
+ * fragmentation, but rather than walking a single free list it keeps a
+ * separate free list for each of a fixed set of size classes, and a pair of
+ * bitmaps recording which of those lists are non-empty.  Finding a free block
+ * large enough for a request is then a couple of bit scans, so pvPortMalloc()
+ * and vPortFree() both execute in a bounded time that does not depend on the
+ * number of free blocks.
+ *
+ * The first level divides block sizes into powers of two, and the second level
+ * divides each power of two range into tlsfSL_INDEX_COUNT equal parts.  A
+ * request is rounded up to the start of the next second level range before the
+ * search, so any block found is large enough without walking its list.  The
+ * cost is that a request may be satisfied from a larger size class than
+ * strictly necessary, which wastes at most 1 / tlsfSL_INDEX_COUNT of the block
+ * until the excess is split off.
+ *
+ * See heap_1.c, heap_2.c, heap_3.c, heap_4.c and heap_5.c for alternative
+ * implementations, and the memory management pages of https://www.FreeRTOS.org
+ * for more information.
+ */
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 0 )
+    #error This file must not be used if configSUPPORT_DYNAMIC_ALLOCATION is 0
+#endif
+
+#ifndef configHEAP_CLEAR_MEMORY_ON_FREE
+    #define configHEAP_CLEAR_MEMORY_ON_FREE    0
+#endif
+
+/* Max value that fits in a size_t type. */
+#define heapSIZE_MAX                          ( ~( ( size_t ) 0 ) )
+
+/* Check if multiplying a and b will result in overflow. */
+#define heapMULTIPLY_WILL_OVERFLOW( a, b )    ( ( ( a ) > 0 ) && ( ( b ) > ( heapSIZE_MAX / ( a ) ) ) )
+
+/* Check if adding a and b will result in overflow. */
+#define heapADD_WILL_OVERFLOW( a, b )         ( ( a ) > ( heapSIZE_MAX - ( b ) ) )
+
+/* log2 of portBYTE_ALIGNMENT.  All block sizes are multiples of
+ * portBYTE_ALIGNMENT. */
+#if ( portBYTE_ALIGNMENT == 4 )
+    #define tlsfALIGN_SIZE_LOG2    ( 2U )
+#elif ( portBYTE_ALIGNMENT == 8 )
+    #define tlsfALIGN_SIZE_LOG2    ( 3U )
+#elif ( portBYTE_ALIGNMENT == 16 )
+    #define tlsfALIGN_SIZE_LOG2    ( 4U )
+#elif ( portBYTE_ALIGNMENT == 32 )
+    #define tlsfALIGN_SIZE_LOG2    ( 5U )
+#else
+    #error heap_tlsf.c requires portBYTE_ALIGNMENT to be 4, 8, 16 or 32
+#endif
+
+/* Each power of two size range is divided into 2^tlsfSL_INDEX_COUNT_LOG2
+ * second level size classes. */
+#define tlsfSL_INDEX_COUNT_LOG2    ( 4U )
+#define tlsfSL_INDEX_COUNT         ( 1U << tlsfSL_INDEX_COUNT_LOG2 )
+
+/* Blocks smaller than tlsfSMALL_BLOCK_SIZE all share the first first level
+ * list, split into second level classes that are exactly portBYTE_ALIGNMENT
+ * bytes apart. */
+#define tlsfFL_INDEX_SHIFT         ( tlsfSL_INDEX_COUNT_LOG2 + tlsfALIGN_SIZE_LOG2 )
+#define tlsfSMALL_BLOCK_SIZE       ( ( size_t ) 1 << tlsfFL_INDEX_SHIFT )
+
+/* Every block is smaller than 2^tlsfFL_INDEX_MAX bytes.  Only as many first
+ * level lists as the heap can use are allocated. */
+#if ( configTOTAL_HEAP_SIZE < ( 1UL << 16 ) )
+    #define tlsfFL_INDEX_MAX    ( 16U )
+#elif ( configTOTAL_HEAP_SIZE < ( 1UL << 20 ) )
+    #define tlsfFL_INDEX_MAX    ( 20U )
+#elif ( configTOTAL_HEAP_SIZE < ( 1UL << 24 ) )
+    #define tlsfFL_INDEX_MAX    ( 24U )
+#else
+    #define tlsfFL_INDEX_MAX    ( 31U )
+#endif
+
+#define tlsfFL_INDEX_COUNT       ( tlsfFL_INDEX_MAX - tlsfFL_INDEX_SHIFT + 1U )
+#define tlsfMAX_BLOCK_SIZE       ( ( size_t ) 1 << tlsfFL_INDEX_MAX )
+
+/* Bit 0 of the xBlockSize member of a BlockLink_t structure is set while the
+ * block is free.  Block sizes are multiples of portBYTE_ALIGNMENT, so the bit
+ * is never needed to hold the size itself. */
+#define tlsfBLOCK_FREE_BIT                     ( ( size_t ) 1 )
+#define tlsfBLOCK_SIZE( pxBlock )              ( ( pxBlock )->xBlockSize & ~tlsfBLOCK_FREE_BIT )
+#define tlsfBLOCK_IS_FREE( pxBlock )           ( ( ( pxBlock )->xBlockSize & tlsfBLOCK_FREE_BIT ) != 0U )
+#define tlsfNEXT_PHYSICAL_BLOCK( pxBlock )     ( ( BlockLink_t * ) ( ( ( uint8_t * ) ( pxBlock ) ) + tlsfBLOCK_SIZE( pxBlock ) ) )
+
+/* Allocate the memory for the heap. */
+#if ( configAPPLICATION_ALLOCATED_HEAP == 1 )
+
+/* The application writer has already defined the array used for the RTOS
+* heap - probably so it can be placed in a special segment or address. */
+    extern uint8_t ucHeap[ configTOTAL_HEAP_SIZE ];
+#else
+    PRIVILEGED_DATA static uint8_t ucHeap[ configTOTAL_HEAP_SIZE ];
+#endif /* configAPPLICATION_ALLOCATED_HEAP */
+
+/* Every block, free or allocated, starts with a pointer to the block
+ * physically before it and its own size.  Free blocks also hold the links of
+ * the free list they are in, in the space that is handed to the application
+ * while the block is allocated. */
+typedef struct A_BLOCK_LINK
+{
+    struct A_BLOCK_LINK * pxPrevPhysBlock; /**< The block immediately below this one in memory, or NULL for the first block. */
+    size_t xBlockSize;                     /**< The size of the block, including its header, plus tlsfBLOCK_FREE_BIT while the block is free. */
+    struct A_BLOCK_LINK * pxNextFreeBlock; /**< The next block in the same free list.  Only valid while the block is free. */
+    struct A_BLOCK_LINK * pxPrevFreeBlock; /**< The previous block in the same free list.  Only valid while the block is free. */
+} BlockLink_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Called automatically to setup the required heap structures the first time
+ * pvPortMalloc() is called.
+ */
+static void prvHeapInit( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the index of the most significant set bit in xValue, which must not
+ * be zero.
+ */
+static UBaseType_t prvFindLastSet( size_t xValue ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the first and second level indexes of the free list that holds
+ * blocks of size xBlockSize.
+ */
+static void prvMappingInsert( size_t xBlockSize,
+                              UBaseType_t * puxFirstLevel,
+                              UBaseType_t * puxSecondLevel ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns a free block of at least xWantedSize bytes without removing it from
+ * its free list, or NULL if there is no such block.
+ */
+static BlockLink_t * prvSearchSuitableBlock( size_t xWantedSize ) PRIVILEGED_FUNCTION;
+
+/*
+ * Add a free block to, or remove it from, the free list for its size.
+ */
+static void prvInsertFreeBlock( BlockLink_t * pxBlock ) PRIVILEGED_FUNCTION;
+static void prvRemoveFreeBlock( BlockLink_t * pxBlock ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+/* The size of the header at the start of each allocated block, rounded up so
+ * the memory handed to the application stays correctly aligned. */
+static const size_t xHeapStructSize = ( offsetof( BlockLink_t, pxNextFreeBlock ) + ( size_t ) ( portBYTE_ALIGNMENT - 1 ) ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+/* Block sizes must not get too small to hold the free list links. */
+static const size_t xMinimumBlockSize = ( sizeof( BlockLink_t ) + ( size_t ) ( portBYTE_ALIGNMENT - 1 ) ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+/* Heads of the segregated free lists, and the bitmaps that record which lists
+ * are non-empty.  Bit n of uxFirstLevelBitmap is set if any bit of
+ * uxSecondLevelBitmaps[ n ] is set. */
+PRIVILEGED_DATA static BlockLink_t * pxFreeLists[ tlsfFL_INDEX_COUNT ][ tlsfSL_INDEX_COUNT ];
+PRIVILEGED_DATA static uint32_t ulFirstLevelBitmap = 0U;
+PRIVILEGED_DATA static uint32_t ulSecondLevelBitmaps[ tlsfFL_INDEX_COUNT ];
+
+/* Zero sized, permanently allocated block that marks the end of the heap. */
+PRIVILEGED_DATA static BlockLink_t * pxEnd = NULL;
+
+/* Keeps track of the number of calls to allocate and free memory as well as the
+ * number of free bytes remaining, but says nothing about fragmentation. */
+PRIVILEGED_DATA static size_t xFreeBytesRemaining = ( size_t ) 0U;
+PRIVILEGED_DATA static size_t xMinimumEverFreeBytesRemaining = ( size_t ) 0U;
+PRIVILEGED_DATA static size_t xNumberOfSuccessfulAllocations = ( size_t ) 0U;
+PRIVILEGED_DATA static size_t xNumberOfSuccessfulFrees = ( size_t ) 0U;
+
+/*-----------------------------------------------------------*/
+
+void * pvPortMalloc( size_t xWantedSize )
+{
+    BlockLink_t * pxBlock;
+    BlockLink_t * pxNewBlockLink;
+    void * pvReturn = NULL;
+    size_t xAdditionalRequiredSize;
+
+    if( xWantedSize > 0 )
+    {
+        /* The wanted size must be increased so it can contain a BlockLink_t
+         * header in addition to the requested amount of bytes, and rounded up
+         * to a multiple of portBYTE_ALIGNMENT. */
+        if( heapADD_WILL_OVERFLOW( xWantedSize, xHeapStructSize ) == 0 )
+        {
+            xWantedSize += xHeapStructSize;
+
+            if( ( xWantedSize & portBYTE_ALIGNMENT_MASK ) != 0x00 )
+            {
+                xAdditionalRequiredSize = portBYTE_ALIGNMENT - ( xWantedSize & portBYTE_ALIGNMENT_MASK );
+
+                if( heapADD_WILL_OVERFLOW( xWantedSize, xAdditionalRequiredSize ) == 0 )
+                {
+                    xWantedSize += xAdditionalRequiredSize;
+                }
+                else
+                {
+                    xWantedSize = 0;
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            if( ( xWantedSize != 0 ) && ( xWantedSize < xMinimumBlockSize ) )
+            {
+                xWantedSize = xMinimumBlockSize;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            xWantedSize = 0;
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    vTaskSuspendAll();
+    {
+        /* If this is the first call to malloc then the heap will require
+         * initialisation to setup the free lists. */
+        if( pxEnd == NULL )
+        {
+            prvHeapInit();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( ( xWantedSize > 0 ) && ( xWantedSize <= xFreeBytesRemaining ) && ( xWantedSize < tlsfMAX_BLOCK_SIZE ) )
+        {
+            pxBlock = prvSearchSuitableBlock( xWantedSize );
+
+            if( pxBlock != NULL )
+            {
+                prvRemoveFreeBlock( pxBlock );
+
+                /* If the block is larger than required it can be split into
+                 * two, and the upper part returned to the free lists. */
+                if( ( tlsfBLOCK_SIZE( pxBlock ) - xWantedSize ) >= xMinimumBlockSize )
+                {
+                    pxNewBlockLink = ( BlockLink_t * ) ( ( ( uint8_t * ) pxBlock ) + xWantedSize );
+                    configASSERT( ( ( ( size_t ) pxNewBlockLink ) & portBYTE_ALIGNMENT_MASK ) == 0 );
+
+                    pxNewBlockLink->pxPrevPhysBlock = pxBlock;
+                    pxNewBlockLink->xBlockSize = tlsfBLOCK_SIZE( pxBlock ) - xWantedSize;
+                    tlsfNEXT_PHYSICAL_BLOCK( pxNewBlockLink )->pxPrevPhysBlock = pxNewBlockLink;
+                    prvInsertFreeBlock( pxNewBlockLink );
+
+                    pxBlock->xBlockSize = xWantedSize;
+                }
+                else
+                {
+                    /* Mark the whole block as allocated. */
+                    pxBlock->xBlockSize = tlsfBLOCK_SIZE( pxBlock );
+                }
+
+                xFreeBytesRemaining -= pxBlock->xBlockSize;
+
+                if( xFreeBytesRemaining < xMinimumEverFreeBytesRemaining )
+                {
+                    xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                /* Return the memory space beyond the header. */
+                pvReturn = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xHeapStructSize );
+                xNumberOfSuccessfulAllocations++;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceMALLOC( pvReturn, xWantedSize );
+    }
+    ( void ) xTaskResumeAll();
+
+    #if ( configUSE_MALLOC_FAILED_HOOK == 1 )
+    {
+        if( pvReturn == NULL )
+        {
+            vApplicationMallocFailedHook();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif /* if ( configUSE_MALLOC_FAILED_HOOK == 1 ) */
+
+    configASSERT( ( ( ( size_t ) pvReturn ) & ( size_t ) portBYTE_ALIGNMENT_MASK ) == 0 );
+    return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vPortFree( void * pv )
+{
+    uint8_t * puc = ( uint8_t * ) pv;
+    BlockLink_t * pxBlock;
+    BlockLink_t * pxNeighbour;
+
+    if( pv != NULL )
+    {
+        /* The memory being freed will have a BlockLink_t structure immediately
+         * before it. */
+        puc -= xHeapStructSize;
+
+        /* This casting is to keep the compiler from issuing warnings. */
+        pxBlock = ( void * ) puc;
+
+        /* Check the block is actually allocated. */
+        configASSERT( tlsfBLOCK_IS_FREE( pxBlock ) == pdFALSE );
+        configASSERT( pxBlock->xBlockSize >= xMinimumBlockSize );
+
+        if( tlsfBLOCK_IS_FREE( pxBlock ) == pdFALSE )
+        {
+            #if ( configHEAP_CLEAR_MEMORY_ON_FREE == 1 )
+            {
+                ( void ) memset( puc + xHeapStructSize, 0, pxBlock->xBlockSize - xHeapStructSize );
+            }
+            #endif
+
+            vTaskSuspendAll();
+            {
+                /* Add this block to the list of free blocks. */
+                xFreeBytesRemaining += pxBlock->xBlockSize;
+                traceFREE( pv, pxBlock->xBlockSize );
+
+                /* Merge with the block below if it is free. */
+                pxNeighbour = pxBlock->pxPrevPhysBlock;
+
+                if( ( pxNeighbour != NULL ) && ( tlsfBLOCK_IS_FREE( pxNeighbour ) != pdFALSE ) )
+                {
+                    prvRemoveFreeBlock( pxNeighbour );
+                    pxNeighbour->xBlockSize = tlsfBLOCK_SIZE( pxNeighbour ) + pxBlock->xBlockSize;
+                    pxBlock = pxNeighbour;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                /* Merge with the block above if it is free.  The end marker is
+                 * never free, so there is always a block above. */
+                pxNeighbour = tlsfNEXT_PHYSICAL_BLOCK( pxBlock );
+
+                if( tlsfBLOCK_IS_FREE( pxNeighbour ) != pdFALSE )
+                {
+                    prvRemoveFreeBlock( pxNeighbour );
+                    pxBlock->xBlockSize = tlsfBLOCK_SIZE( pxBlock ) + tlsfBLOCK_SIZE( pxNeighbour );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                tlsfNEXT_PHYSICAL_BLOCK( pxBlock )->pxPrevPhysBlock = pxBlock;
+                prvInsertFreeBlock( pxBlock );
+                xNumberOfSuccessfulFrees++;
+            }
+            ( void ) xTaskResumeAll();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetFreeHeapSize( void )
+{
+    return xFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetMinimumEverFreeHeapSize( void )
+{
+    return xMinimumEverFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+void xPortResetHeapMinimumEverFreeHeapSize( void )
+{
+    xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+void vPortInitialiseBlocks( void )
+{
+    /* This just exists to keep the linker quiet. */
+}
+/*-----------------------------------------------------------*/
+
+void * pvPortCalloc( size_t xNum,
+                     size_t xSize )
+{
+    void * pv = NULL;
+
+    if( heapMULTIPLY_WILL_OVERFLOW( xNum, xSize ) == 0 )
+    {
+        pv = pvPortMalloc( xNum * xSize );
+
+        if( pv != NULL )
+        {
+            ( void ) memset( pv, 0, xNum * xSize );
+        }
+    }
+
+    return pv;
+}
+/*-----------------------------------------------------------*/
+
+static void prvHeapInit( void ) /* PRIVILEGED_FUNCTION */
+{
+    BlockLink_t * pxFirstFreeBlock;
+    portPOINTER_SIZE_TYPE uxStartAddress, uxEndAddress;
+    size_t xTotalHeapSize = configTOTAL_HEAP_SIZE;
+
+    /* Ensure the heap starts on a correctly aligned boundary. */
+    uxStartAddress = ( portPOINTER_SIZE_TYPE ) ucHeap;
+
+    if( ( uxStartAddress & portBYTE_ALIGNMENT_MASK ) != 0 )
+    {
+        uxStartAddress += ( portBYTE_ALIGNMENT - 1 );
+        uxStartAddress &= ~( ( portPOINTER_SIZE_TYPE ) portBYTE_ALIGNMENT_MASK );
+        xTotalHeapSize -= ( size_t ) ( uxStartAddress - ( portPOINTER_SIZE_TYPE ) ucHeap );
+    }
+
+    /* The end marker is placed at the end of the heap, leaving the rest of the
+     * heap as a single free block. */
+    uxEndAddress = uxStartAddress + ( portPOINTER_SIZE_TYPE ) xTotalHeapSize;
+    uxEndAddress -= ( portPOINTER_SIZE_TYPE ) xHeapStructSize;
+    uxEndAddress &= ~( ( portPOINTER_SIZE_TYPE ) portBYTE_ALIGNMENT_MASK );
+
+    pxFirstFreeBlock = ( BlockLink_t * ) uxStartAddress;
+    pxFirstFreeBlock->pxPrevPhysBlock = NULL;
+    pxFirstFreeBlock->xBlockSize = ( size_t ) ( uxEndAddress - uxStartAddress );
+
+    pxEnd = ( BlockLink_t * ) uxEndAddress;
+    pxEnd->pxPrevPhysBlock = pxFirstFreeBlock;
+    pxEnd->xBlockSize = 0;
+
+    ( void ) memset( pxFreeLists, 0, sizeof( pxFreeLists ) );
+    ( void ) memset( ulSecondLevelBitmaps, 0, sizeof( ulSecondLevelBitmaps ) );
+    ulFirstLevelBitmap = 0U;
+
+    /* Only one block exists - and it covers the entire usable heap space. */
+    xMinimumEverFreeBytesRemaining = pxFirstFreeBlock->xBlockSize;
+    xFreeBytesRemaining = pxFirstFreeBlock->xBlockSize;
+
+    prvInsertFreeBlock( pxFirstFreeBlock );
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvFindLastSet( size_t xValue )
+{
+    uint32_t ulValue = ( uint32_t ) xValue;
+    UBaseType_t uxBit = 0U;
+
+    /* A fixed number of steps regardless of the value, rather than a loop
+     * over the bits. */
+    if( ( ulValue & 0xffff0000UL ) != 0U )
+    {
+        ulValue >>= 16;
+        uxBit += 16U;
+    }
+
+    if( ( ulValue & 0xff00UL ) != 0U )
+    {
+        ulValue >>= 8;
+        uxBit += 8U;
+    }
+
+    if( ( ulValue & 0xf0UL ) != 0U )
+    {
+        ulValue >>= 4;
+        uxBit += 4U;
+    }
+
+    if( ( ulValue & 0xcUL ) != 0U )
+    {
+        ulValue >>= 2;
+        uxBit += 2U;
+    }
+
+    if( ( ulValue & 0x2UL ) != 0U )
+    {
+        uxBit += 1U;
+    }
+
+    return uxBit;
+}
+/*-----------------------------------------------------------*/
+
+static void prvMappingInsert( size_t xBlockSize,
+                              UBaseType_t * puxFirstLevel,
+                              UBaseType_t * puxSecondLevel )
+{
+    UBaseType_t uxFirstLevel;
+
+    if( xBlockSize < tlsfSMALL_BLOCK_SIZE )
+    {
+        *puxFirstLevel = 0U;
+        *puxSecondLevel = ( UBaseType_t ) ( xBlockSize >> tlsfALIGN_SIZE_LOG2 );
+    }
+    else
+    {
+        uxFirstLevel = prvFindLastSet( xBlockSize );
+        *puxSecondLevel = ( UBaseType_t ) ( xBlockSize >> ( uxFirstLevel - tlsfSL_INDEX_COUNT_LOG2 ) ) ^ tlsfSL_INDEX_COUNT;
+        *puxFirstLevel = uxFirstLevel - ( tlsfFL_INDEX_SHIFT - 1U );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static BlockLink_t * prvSearchSuitableBlock( size_t xWantedSize )
+{
+    UBaseType_t uxFirstLevel, uxSecondLevel;
+    uint32_t ulMap;
+    BlockLink_t * pxBlock = NULL;
+    const size_t xExactSize = xWantedSize;
+
+    /* Round the size up to the next second level class, so every block in the
+     * class that is found is large enough. */
+    if( xWantedSize >= tlsfSMALL_BLOCK_SIZE )
+    {
+        xWantedSize += ( ( size_t ) 1 << ( prvFindLastSet( xWantedSize ) - tlsfSL_INDEX_COUNT_LOG2 ) ) - 1U;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    prvMappingInsert( xWantedSize, &uxFirstLevel, &uxSecondLevel );
+
+    if( uxFirstLevel < tlsfFL_INDEX_COUNT )
+    {
+        /* Look for a non-empty list in the same first level range, at or above
+         * the second level class. */
+        ulMap = ulSecondLevelBitmaps[ uxFirstLevel ] & ( ~0UL << uxSecondLevel );
+
+        if( ulMap == 0U )
+        {
+            /* None, so use the smallest class of the next non-empty first
+             * level range. */
+            ulMap = ulFirstLevelBitmap & ( ~0UL << ( uxFirstLevel + 1U ) );
+
+            if( ulMap != 0U )
+            {
+                uxFirstLevel = prvFindLastSet( ulMap & ( ~ulMap + 1U ) );
+                ulMap = ulSecondLevelBitmaps[ uxFirstLevel ];
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( ulMap != 0U )
+        {
+            uxSecondLevel = prvFindLastSet( ulMap & ( ~ulMap + 1U ) );
+            pxBlock = pxFreeLists[ uxFirstLevel ][ uxSecondLevel ];
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    if( pxBlock == NULL )
+    {
+        /* No class above the request's own has a free block, but the block at
+         * the head of the request's own class may still be large enough.
+         * Checking just that one block keeps the search bounded, and stops a
+         * request close to the size of the largest free block failing only
+         * because of the rounding above. */
+        prvMappingInsert( xExactSize, &uxFirstLevel, &uxSecondLevel );
+
+        if( uxFirstLevel < tlsfFL_INDEX_COUNT )
+        {
+            pxBlock = pxFreeLists[ uxFirstLevel ][ uxSecondLevel ];
+
+            if( ( pxBlock != NULL ) && ( tlsfBLOCK_SIZE( pxBlock ) < xExactSize ) )
+            {
+                pxBlock = NULL;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return pxBlock;
+}
+/*-----------------------------------------------------------*/
+
+static void prvInsertFreeBlock( BlockLink_t * pxBlock )
+{
+    UBaseType_t uxFirstLevel, uxSecondLevel;
+    BlockLink_t * pxHead;
+
+    prvMappingInsert( tlsfBLOCK_SIZE( pxBlock ), &uxFirstLevel, &uxSecondLevel );
+
+    pxHead = pxFreeLists[ uxFirstLevel ][ uxSecondLevel ];
+    pxBlock->pxPrevFreeBlock = NULL;
+    pxBlock->pxNextFreeBlock = pxHead;
+
+    if( pxHead != NULL )
+    {
+        pxHead->pxPrevFreeBlock = pxBlock;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    pxFreeLists[ uxFirstLevel ][ uxSecondLevel ] = pxBlock;
+    ulFirstLevelBitmap |= ( 1UL << uxFirstLevel );
+    ulSecondLevelBitmaps[ uxFirstLevel ] |= ( 1UL << uxSecondLevel );
+
+    pxBlock->xBlockSize |= tlsfBLOCK_FREE_BIT;
+}
+/*-----------------------------------------------------------*/
+
+static void prvRemoveFreeBlock( BlockLink_t * pxBlock )
+{
+    UBaseType_t uxFirstLevel, uxSecondLevel;
+
+    prvMappingInsert( tlsfBLOCK_SIZE( pxBlock ), &uxFirstLevel, &uxSecondLevel );
+
+    if( pxBlock->pxNextFreeBlock != NULL )
+    {
+        pxBlock->pxNextFreeBlock->pxPrevFreeBlock = pxBlock->pxPrevFreeBlock;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    if( pxBlock->pxPrevFreeBlock != NULL )
+    {
+        pxBlock->pxPrevFreeBlock->pxNextFreeBlock = pxBlock->pxNextFreeBlock;
+    }
+    else
+    {
+        /* The block was at the head of its list. */
+        pxFreeLists[ uxFirstLevel ][ uxSecondLevel ] = pxBlock->pxNextFreeBlock;
+
+        if( pxBlock->pxNextFreeBlock == NULL )
+        {
+            ulSecondLevelBitmaps[ uxFirstLevel ] &= ~( 1UL << uxSecondLevel );
+
+            if( ulSecondLevelBitmaps[ uxFirstLevel ] == 0U )
+            {
+                ulFirstLevelBitmap &= ~( 1UL << uxFirstLevel );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+    pxBlock->xBlockSize &= ~tlsfBLOCK_FREE_BIT;
+}
+/*-----------------------------------------------------------*/
+
+void vPortGetHeapStats( HeapStats_t * pxHeapStats )
+{
+    BlockLink_t * pxBlock;
+    size_t xBlocks = 0, xMaxSize = 0, xMinSize = portMAX_DELAY; /* portMAX_DELAY used as a portable way of getting the maximum value. */
+    UBaseType_t uxFirstLevel, uxSecondLevel;
+
+    vTaskSuspendAll();
+    {
+        /* pxEnd is NULL if the heap has not been initialised yet. */
+        if( pxEnd != NULL )
+        {
+            for( uxFirstLevel = 0U; uxFirstLevel < tlsfFL_INDEX_COUNT; uxFirstLevel++ )
+            {
+                for( uxSecondLevel = 0U; uxSecondLevel < tlsfSL_INDEX_COUNT; uxSecondLevel++ )
+                {
+                    for( pxBlock = pxFreeLists[ uxFirstLevel ][ uxSecondLevel ]; pxBlock != NULL; pxBlock = pxBlock->pxNextFreeBlock )
+                    {
+                        /* Increment the number of blocks and record the largest
+                         * block seen so far. */
+                        xBlocks++;
+
+                        if( tlsfBLOCK_SIZE( pxBlock ) > xMaxSize )
+                        {
+                            xMaxSize = tlsfBLOCK_SIZE( pxBlock );
+                        }
+
+                        if( tlsfBLOCK_SIZE( pxBlock ) < xMinSize )
+                        {
+                            xMinSize = tlsfBLOCK_SIZE( pxBlock );
+                        }
+                    }
+                }
+            }
+        }
+    }
+    ( void ) xTaskResumeAll();
+
+    pxHeapStats->xSizeOfLargestFreeBlockInBytes = xMaxSize;
+    pxHeapStats->xSizeOfSmallestFreeBlockInBytes = xMinSize;
+    pxHeapStats->xNumberOfFreeBlocks = xBlocks;
+
+    taskENTER_CRITICAL();
+    {
+        pxHeapStats->xAvailableHeapSpaceInBytes = xFreeBytesRemaining;
+        pxHeapStats->xNumberOfSuccessfulAllocations = xNumberOfSuccessfulAllocations;
+        pxHeapStats->xNumberOfSuccessfulFrees = xNumberOfSuccessfulFrees;
+        pxHeapStats->xMinimumEverFreeBytesRemaining = xMinimumEverFreeBytesRemaining;
+    }
+    taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * Reset the state in this file. This state is normally initialized at start up.
+ * This function must be called by the application before restarting the
+ * scheduler.
+ */
+void vPortHeapResetState( void )
+{
+    pxEnd = NULL;
+
+    xFreeBytesRemaining = ( size_t ) 0U;
+    xMinimumEverFreeBytesRemaining = ( size_t ) 0U;
+    xNumberOfSuccessfulAllocations = ( size_t ) 0U;
+    xNumberOfSuccessfulFrees = ( size_t ) 0U;
+}
+/*-----------------------------------------------------------*/
@@ -47,12 +47,40 @@
  * correct privileged Vs unprivileged linkage and placement. */
 #undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
 
+#if ( ( configUSE_CEILING_MUTEXES == 1 ) && ( configUSE_MUTEXES != 1 ) )
+    #error configUSE_MUTEXES must be set to 1 when configUSE_CEILING_MUTEXES is set to 1.
+#endif
 
 /* Constants used with the cRxLock and cTxLock structure members. */
 #define queueUNLOCKED             ( ( int8_t ) -1 )
 #define queueLOCKED_UNMODIFIED    ( ( int8_t ) 0 )
 #define queueINT8_MAX             ( ( int8_t ) 127 )
 
+/* Bits used in the ucZeroCopyState structure member to record that a slot has
+ * been handed out by xQueueReserve() or xQueueAcquire() and not yet returned by
+ * xQueueCommit() or xQueueRelease(). */
+#define queueZERO_COPY_SEND_RESERVED       ( ( uint8_t ) 0x01U )
+#define queueZERO_COPY_RECEIVE_ACQUIRED    ( ( uint8_t ) 0x02U )
+
+/* The number of storage slots that cannot be written.  A slot reserved by
+ * xQueueReserve() is not yet counted in uxMessagesWaiting, but it is no longer
+ * free either, so every check for room in the queue uses this instead of
+ * uxMessagesWaiting. */
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+    #define queueSLOTS_IN_USE( pxQueue )                                                     \
+    ( ( UBaseType_t ) ( ( pxQueue )->uxMessagesWaiting +                                     \
+                        ( ( ( ( pxQueue )->ucZeroCopyState & queueZERO_COPY_SEND_RESERVED ) != 0U ) ? ( UBaseType_t ) 1U : ( UBaseType_t ) 0U ) ) )
+#else
+    #define queueSLOTS_IN_USE( pxQueue )    ( ( pxQueue )->uxMessagesWaiting )
+#endif
+
+/* A mutex created by xQueueCreateCeilingMutex() has a non-zero ceiling. */
+#if ( configUSE_CEILING_MUTEXES == 1 )
+    #define queueIS_CEILING_MUTEX( pxQueue )    ( ( ( pxQueue )->uxCeilingPriority != ( UBaseType_t ) 0U ) ? pdTRUE : pdFALSE )
+#else
+    #define queueIS_CEILING_MUTEX( pxQueue )    pdFALSE
+#endif
+
 /* When the Queue_t structure is used to represent a base queue its pcHead and
  * pcTail members are used as pointers into the queue storage area.  When the
  * Queue_t structure is used to represent a mutex pcHead and pcTail pointers are
@@ -133,6 +161,15 @@ typedef struct QueueDefinition /* The old naming convention is used to prevent b
         UBaseType_t uxQueueNumber;
         uint8_t ucQueueType;
     #endif
+
+    #if ( configUSE_QUEUE_ZERO_COPY == 1 )
+        uint8_t ucZeroCopyState; /**< queueZERO_COPY_SEND_RESERVED and/or queueZERO_COPY_RECEIVE_ACQUIRED while a slot is lent out by the zero copy API. */
+    #endif
+
+    #if ( configUSE_CEILING_MUTEXES == 1 )
+        UBaseType_t uxCeilingPriority;       /**< The priority the holder runs at while it holds the mutex, or zero if the structure is not used as a priority ceiling mutex. */
+        UBaseType_t uxPriorityBeforeCeiling; /**< The priority the holder had before it was raised to uxCeilingPriority. */
+    #endif
 } xQUEUE;
 
 /* The old xQUEUE name is maintained above then typedefed to the new Queue_t
@@ -210,6 +247,39 @@ static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue,
 static void prvCopyDataFromQueue( Queue_t * const pxQueue,
                                   void * const pvBuffer ) PRIVILEGED_FUNCTION;
 
+#if ( configUSE_QUEUE_BATCH_TRANSFER == 1 )
+
+/*
+ * Copies up to two contiguous runs of items into, or out of, the queue storage
+ * area so a batch of items costs at most two memcpy() calls.  Called from a
+ * critical section.
+ */
+    static void prvCopyItemsToQueue( Queue_t * const pxQueue,
+                                     const uint8_t * pucItems,
+                                     UBaseType_t uxItemCount ) PRIVILEGED_FUNCTION;
+    static void prvCopyItemsFromQueue( Queue_t * const pxQueue,
+                                       uint8_t * pucItems,
+                                       UBaseType_t uxItemCount ) PRIVILEGED_FUNCTION;
+#endif
+
+#if ( ( configUSE_QUEUE_BATCH_TRANSFER == 1 ) || ( configUSE_QUEUE_ZERO_COPY == 1 ) )
+
+/*
+ * Unblocks up to uxItemCount tasks waiting to receive from (or, for
+ * prvUnblockSenders(), send to) a queue after that many items were added to
+ * (removed from) it, or notifies the containing queue set once per item.  The
+ * event lists are left untouched if the queue is locked, the lock count being
+ * incremented instead.  Called from a critical section.
+ *
+ * @return pdTRUE if a task with a priority higher than the calling task was
+ * unblocked, otherwise pdFALSE.
+ */
+    static BaseType_t prvUnblockReceivers( Queue_t * const pxQueue,
+                                           UBaseType_t uxItemCount ) PRIVILEGED_FUNCTION;
+    static BaseType_t prvUnblockSenders( Queue_t * const pxQueue,
+                                         UBaseType_t uxItemCount ) PRIVILEGED_FUNCTION;
+#endif
+
 #if ( configUSE_QUEUE_SETS == 1 )
 
 /*
@@ -324,6 +394,12 @@ BaseType_t xQueueGenericReset( QueueHandle_t xQueue,
             pxQueue->cRxLock = queueUNLOCKED;
             pxQueue->cTxLock = queueUNLOCKED;
 
+            #if ( configUSE_QUEUE_ZERO_COPY == 1 )
+            {
+                pxQueue->ucZeroCopyState = ( uint8_t ) 0U;
+            }
+            #endif
+
             if( xNewQueue == pdFALSE )
             {
                 /* If there are tasks blocked waiting to read from the queue, then
@@ -526,7 +602,7 @@ BaseType_t xQueueGenericReset( QueueHandle_t xQueue,
             /* MISRA Ref 11.5.1 [Malloc memory assignment] */
             /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
             /* coverity[misra_c_2012_rule_11_5_violation] */
-            pxNewQueue = ( Queue_t * ) pvPortMalloc( sizeof( Queue_t ) + xQueueSizeInBytes );
+            pxNewQueue = ( Queue_t * ) pvPortMallocObject( sizeof( Queue_t ) + xQueueSizeInBytes );
 
             if( pxNewQueue != NULL )
             {
@@ -608,6 +684,13 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
     }
     #endif /* configUSE_QUEUE_SETS */
 
+    #if ( configUSE_CEILING_MUTEXES == 1 )
+    {
+        pxNewQueue->uxCeilingPriority = ( UBaseType_t ) 0U;
+        pxNewQueue->uxPriorityBeforeCeiling = ( UBaseType_t ) 0U;
+    }
+    #endif /* configUSE_CEILING_MUTEXES */
+
     traceQUEUE_CREATE( pxNewQueue );
 }
 /*-----------------------------------------------------------*/
@@ -687,6 +770,75 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
 #endif /* configUSE_MUTEXES */
 /*-----------------------------------------------------------*/
 
+#if ( ( configUSE_CEILING_MUTEXES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+
+    QueueHandle_t xQueueCreateCeilingMutex( const UBaseType_t uxCeilingPriority )
+    {
+        QueueHandle_t xNewQueue;
+        const UBaseType_t uxMutexLength = ( UBaseType_t ) 1, uxMutexSize = ( UBaseType_t ) 0;
+
+        traceENTER_xQueueCreateCeilingMutex( uxCeilingPriority );
+
+        /* A ceiling of the idle priority would never raise the holder. */
+        configASSERT( ( uxCeilingPriority > tskIDLE_PRIORITY ) && ( uxCeilingPriority < ( UBaseType_t ) configMAX_PRIORITIES ) );
+
+        xNewQueue = xQueueGenericCreate( uxMutexLength, uxMutexSize, queueQUEUE_TYPE_MUTEX );
+
+        if( xNewQueue != NULL )
+        {
+            /* Must be set before prvInitialiseMutex() gives the mutex. */
+            ( ( Queue_t * ) xNewQueue )->uxCeilingPriority = uxCeilingPriority;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        prvInitialiseMutex( ( Queue_t * ) xNewQueue );
+
+        traceRETURN_xQueueCreateCeilingMutex( xNewQueue );
+
+        return xNewQueue;
+    }
+
+#endif /* ( ( configUSE_CEILING_MUTEXES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_CEILING_MUTEXES == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+
+    QueueHandle_t xQueueCreateCeilingMutexStatic( const UBaseType_t uxCeilingPriority,
+                                                  StaticQueue_t * pxStaticQueue )
+    {
+        QueueHandle_t xNewQueue;
+        const UBaseType_t uxMutexLength = ( UBaseType_t ) 1, uxMutexSize = ( UBaseType_t ) 0;
+
+        traceENTER_xQueueCreateCeilingMutexStatic( uxCeilingPriority, pxStaticQueue );
+
+        /* A ceiling of the idle priority would never raise the holder. */
+        configASSERT( ( uxCeilingPriority > tskIDLE_PRIORITY ) && ( uxCeilingPriority < ( UBaseType_t ) configMAX_PRIORITIES ) );
+
+        xNewQueue = xQueueGenericCreateStatic( uxMutexLength, uxMutexSize, NULL, pxStaticQueue, queueQUEUE_TYPE_MUTEX );
+
+        if( xNewQueue != NULL )
+        {
+            /* Must be set before prvInitialiseMutex() gives the mutex. */
+            ( ( Queue_t * ) xNewQueue )->uxCeilingPriority = uxCeilingPriority;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        prvInitialiseMutex( ( Queue_t * ) xNewQueue );
+
+        traceRETURN_xQueueCreateCeilingMutexStatic( xNewQueue );
+
+        return xNewQueue;
+    }
+
+#endif /* ( ( configUSE_CEILING_MUTEXES == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) ) */
+/*-----------------------------------------------------------*/
+
 #if ( ( configUSE_MUTEXES == 1 ) && ( INCLUDE_xSemaphoreGetMutexHolder == 1 ) )
 
     TaskHandle_t xQueueGetMutexHolder( QueueHandle_t xSemaphore )
@@ -974,7 +1126,7 @@ BaseType_t xQueueGenericSend( QueueHandle_t xQueue,
              * highest priority task wanting to access the queue.  If the head item
              * in the queue is to be overwritten then it does not matter if the
              * queue is full. */
-            if( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) || ( xCopyPosition == queueOVERWRITE ) )
+            if( ( queueSLOTS_IN_USE( pxQueue ) < pxQueue->uxLength ) || ( xCopyPosition == queueOVERWRITE ) )
             {
                 traceQUEUE_SEND( pxQueue );
 
@@ -1205,7 +1357,7 @@ BaseType_t xQueueGenericSendFromISR( QueueHandle_t xQueue,
     /* coverity[misra_c_2012_directive_4_7_violation] */
     uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();
     {
-        if( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) || ( xCopyPosition == queueOVERWRITE ) )
+        if( ( queueSLOTS_IN_USE( pxQueue ) < pxQueue->uxLength ) || ( xCopyPosition == queueOVERWRITE ) )
         {
             const int8_t cTxLock = pxQueue->cTxLock;
             const UBaseType_t uxPreviousMessagesWaiting = pxQueue->uxMessagesWaiting;
@@ -1659,169 +1811,976 @@ BaseType_t xQueueReceive( QueueHandle_t xQueue,
 }
 /*-----------------------------------------------------------*/
 
-BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
-                                TickType_t xTicksToWait )
-{
-    BaseType_t xEntryTimeSet = pdFALSE;
-    TimeOut_t xTimeOut;
-    Queue_t * const pxQueue = xQueue;
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
 
-    #if ( configUSE_MUTEXES == 1 )
-        BaseType_t xInheritanceOccurred = pdFALSE;
-    #endif
+    BaseType_t xQueueReserve( QueueHandle_t xQueue,
+                              void ** const ppvItem,
+                              TickType_t xTicksToWait )
+    {
+        BaseType_t xEntryTimeSet = pdFALSE;
+        TimeOut_t xTimeOut;
+        Queue_t * const pxQueue = xQueue;
 
-    traceENTER_xQueueSemaphoreTake( xQueue, xTicksToWait );
+        traceENTER_xQueueReserve( xQueue, ppvItem, xTicksToWait );
 
-    /* Check the queue pointer is not NULL. */
-    configASSERT( ( pxQueue ) );
+        configASSERT( pxQueue );
+        configASSERT( ppvItem );
 
-    /* Check this really is a semaphore, in which case the item size will be
-     * 0. */
-    configASSERT( pxQueue->uxItemSize == 0 );
+        /* Semaphores and mutexes have no storage area to lend out. */
+        configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
 
-    /* Cannot block if the scheduler is suspended. */
-    #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
-    {
-        configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
-    }
-    #endif
+        /* Only one slot can be reserved at a time - the zero copy API assumes a
+         * single producer, in the same way stream buffers assume a single
+         * writer. */
+        configASSERT( ( pxQueue->ucZeroCopyState & queueZERO_COPY_SEND_RESERVED ) == 0U );
 
-    for( ; ; )
-    {
-        taskENTER_CRITICAL();
+        #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
         {
-            /* Semaphores are queues with an item size of 0, and where the
-             * number of messages in the queue is the semaphore's count value. */
-            const UBaseType_t uxSemaphoreCount = pxQueue->uxMessagesWaiting;
+            configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+        }
+        #endif
 
-            /* Is there data in the queue now?  To be running the calling task
-             * must be the highest priority task wanting to access the queue. */
-            if( uxSemaphoreCount > ( UBaseType_t ) 0 )
+        for( ; ; )
+        {
+            taskENTER_CRITICAL();
             {
-                traceQUEUE_RECEIVE( pxQueue );
+                /* Is there room on the queue now?  The slot at pcWriteTo is
+                 * handed to the caller but uxMessagesWaiting is not updated
+                 * until the item is committed, so receivers cannot see it.
+                 * Senders see it as used through queueSLOTS_IN_USE(). */
+                if( pxQueue->uxMessagesWaiting < pxQueue->uxLength )
+                {
+                    pxQueue->ucZeroCopyState |= queueZERO_COPY_SEND_RESERVED;
+                    *ppvItem = ( void * ) pxQueue->pcWriteTo;
 
-                /* Semaphores are queues with a data size of zero and where the
-                 * messages waiting is the semaphore's count.  Reduce the count. */
-                pxQueue->uxMessagesWaiting = ( UBaseType_t ) ( uxSemaphoreCount - ( UBaseType_t ) 1 );
+                    taskEXIT_CRITICAL();
 
-                #if ( configUSE_MUTEXES == 1 )
+                    traceRETURN_xQueueReserve( pdPASS );
+
+                    return pdPASS;
+                }
+                else
                 {
-                    if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
+                    if( xTicksToWait == ( TickType_t ) 0 )
                     {
-                        /* Record the information required to implement
-                         * priority inheritance should it become necessary. */
-                        pxQueue->u.xSemaphore.xMutexHolder = pvTaskIncrementMutexHeldCount();
+                        taskEXIT_CRITICAL();
+
+                        *ppvItem = NULL;
+
+                        traceQUEUE_SEND_FAILED( pxQueue );
+                        traceRETURN_xQueueReserve( errQUEUE_FULL );
+
+                        return errQUEUE_FULL;
+                    }
+                    else if( xEntryTimeSet == pdFALSE )
+                    {
+                        vTaskInternalSetTimeOutState( &xTimeOut );
+                        xEntryTimeSet = pdTRUE;
                     }
                     else
                     {
+                        /* Entry time was already set. */
                         mtCOVERAGE_TEST_MARKER();
                     }
                 }
-                #endif /* configUSE_MUTEXES */
+            }
+            taskEXIT_CRITICAL();
 
-                /* Check to see if other tasks are blocked waiting to give the
-                 * semaphore, and if so, unblock the highest priority such task. */
-                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+            vTaskSuspendAll();
+            prvLockQueue( pxQueue );
+
+            if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+            {
+                if( prvIsQueueFull( pxQueue ) != pdFALSE )
                 {
-                    if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
-                    {
-                        queueYIELD_IF_USING_PREEMPTION();
-                    }
-                    else
+                    traceBLOCKING_ON_QUEUE_SEND( pxQueue );
+                    vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToSend ), xTicksToWait );
+                    prvUnlockQueue( pxQueue );
+
+                    if( xTaskResumeAll() == pdFALSE )
                     {
-                        mtCOVERAGE_TEST_MARKER();
+                        taskYIELD_WITHIN_API();
                     }
                 }
                 else
                 {
-                    mtCOVERAGE_TEST_MARKER();
+                    /* Try again. */
+                    prvUnlockQueue( pxQueue );
+                    ( void ) xTaskResumeAll();
                 }
+            }
+            else
+            {
+                /* The timeout has expired. */
+                prvUnlockQueue( pxQueue );
+                ( void ) xTaskResumeAll();
 
-                taskEXIT_CRITICAL();
+                *ppvItem = NULL;
 
-                traceRETURN_xQueueSemaphoreTake( pdPASS );
+                traceQUEUE_SEND_FAILED( pxQueue );
+                traceRETURN_xQueueReserve( errQUEUE_FULL );
 
-                return pdPASS;
+                return errQUEUE_FULL;
+            }
+        }
+    }
+
+#endif /* configUSE_QUEUE_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+
+    BaseType_t xQueueCommit( QueueHandle_t xQueue )
+    {
+        Queue_t * const pxQueue = xQueue;
+
+        traceENTER_xQueueCommit( xQueue );
+
+        configASSERT( pxQueue );
+
+        taskENTER_CRITICAL();
+        {
+            /* A slot must have been obtained from xQueueReserve() first. */
+            configASSERT( ( pxQueue->ucZeroCopyState & queueZERO_COPY_SEND_RESERVED ) != 0U );
+
+            /* The reserved slot was counted as used, so it is still free. */
+            configASSERT( pxQueue->uxMessagesWaiting < pxQueue->uxLength );
+
+            traceQUEUE_SEND( pxQueue );
+
+            pxQueue->ucZeroCopyState &= ( uint8_t ) ~queueZERO_COPY_SEND_RESERVED;
+
+            /* The item was written in place, so only the bookkeeping that
+             * prvCopyDataToQueue() would have done is required. */
+            pxQueue->pcWriteTo += pxQueue->uxItemSize;
+
+            if( pxQueue->pcWriteTo >= pxQueue->u.xQueue.pcTail )
+            {
+                pxQueue->pcWriteTo = pxQueue->pcHead;
             }
             else
             {
-                if( xTicksToWait == ( TickType_t ) 0 )
-                {
-                    /* The semaphore count was 0 and no block time is specified
-                     * (or the block time has expired) so exit now. */
-                    taskEXIT_CRITICAL();
+                mtCOVERAGE_TEST_MARKER();
+            }
 
-                    traceQUEUE_RECEIVE_FAILED( pxQueue );
-                    traceRETURN_xQueueSemaphoreTake( errQUEUE_EMPTY );
+            pxQueue->uxMessagesWaiting = ( UBaseType_t ) ( pxQueue->uxMessagesWaiting + ( UBaseType_t ) 1 );
 
-                    return errQUEUE_EMPTY;
-                }
-                else if( xEntryTimeSet == pdFALSE )
-                {
-                    /* The semaphore count was 0 and a block time was specified
-                     * so configure the timeout structure ready to block. */
-                    vTaskInternalSetTimeOutState( &xTimeOut );
-                    xEntryTimeSet = pdTRUE;
-                }
-                else
-                {
-                    /* Entry time was already set. */
-                    mtCOVERAGE_TEST_MARKER();
-                }
+            /* If there was a task waiting for data to arrive on the queue
+             * then unblock it now. */
+            if( prvUnblockReceivers( pxQueue, ( UBaseType_t ) 1 ) != pdFALSE )
+            {
+                queueYIELD_IF_USING_PREEMPTION();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
             }
         }
         taskEXIT_CRITICAL();
 
-        /* Interrupts and other tasks can give to and take from the semaphore
-         * now the critical section has been exited. */
+        traceRETURN_xQueueCommit( pdPASS );
 
-        vTaskSuspendAll();
-        prvLockQueue( pxQueue );
+        return pdPASS;
+    }
 
-        /* Update the timeout state to see if it has expired yet. */
-        if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+#endif /* configUSE_QUEUE_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+
+    BaseType_t xQueueAcquire( QueueHandle_t xQueue,
+                              void ** const ppvItem,
+                              TickType_t xTicksToWait )
+    {
+        BaseType_t xEntryTimeSet = pdFALSE;
+        TimeOut_t xTimeOut;
+        Queue_t * const pxQueue = xQueue;
+
+        traceENTER_xQueueAcquire( xQueue, ppvItem, xTicksToWait );
+
+        configASSERT( pxQueue );
+        configASSERT( ppvItem );
+        configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+
+        /* Only one item can be acquired at a time - the zero copy API assumes a
+         * single consumer. */
+        configASSERT( ( pxQueue->ucZeroCopyState & queueZERO_COPY_RECEIVE_ACQUIRED ) == 0U );
+
+        #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
         {
-            /* A block time is specified and not expired.  If the semaphore
-             * count is 0 then enter the Blocked state to wait for a semaphore to
-             * become available.  As semaphores are implemented with queues the
-             * queue being empty is equivalent to the semaphore count being 0. */
-            if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
-            {
-                traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
+            configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+        }
+        #endif
 
-                #if ( configUSE_MUTEXES == 1 )
+        for( ; ; )
+        {
+            taskENTER_CRITICAL();
+            {
+                if( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 )
                 {
-                    if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
+                    int8_t * pcItem = pxQueue->u.xQueue.pcReadFrom + pxQueue->uxItemSize;
+
+                    if( pcItem >= pxQueue->u.xQueue.pcTail )
                     {
-                        taskENTER_CRITICAL();
-                        {
-                            xInheritanceOccurred = xTaskPriorityInherit( pxQueue->u.xSemaphore.xMutexHolder );
-                        }
-                        taskEXIT_CRITICAL();
+                        pcItem = pxQueue->pcHead;
                     }
                     else
                     {
                         mtCOVERAGE_TEST_MARKER();
                     }
-                }
-                #endif /* if ( configUSE_MUTEXES == 1 ) */
 
-                vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
-                prvUnlockQueue( pxQueue );
+                    /* The item stays counted in uxMessagesWaiting, so senders
+                     * cannot overwrite it until it is released. */
+                    pxQueue->ucZeroCopyState |= queueZERO_COPY_RECEIVE_ACQUIRED;
+                    *ppvItem = ( void * ) pcItem;
 
-                if( xTaskResumeAll() == pdFALSE )
-                {
-                    taskYIELD_WITHIN_API();
+                    taskEXIT_CRITICAL();
+
+                    traceRETURN_xQueueAcquire( pdPASS );
+
+                    return pdPASS;
                 }
                 else
                 {
-                    mtCOVERAGE_TEST_MARKER();
-                }
-            }
-            else
-            {
-                /* There was no timeout and the semaphore count was not 0, so
-                 * attempt to take the semaphore again. */
+                    if( xTicksToWait == ( TickType_t ) 0 )
+                    {
+                        taskEXIT_CRITICAL();
+
+                        *ppvItem = NULL;
+
+                        traceQUEUE_RECEIVE_FAILED( pxQueue );
+                        traceRETURN_xQueueAcquire( errQUEUE_EMPTY );
+
+                        return errQUEUE_EMPTY;
+                    }
+                    else if( xEntryTimeSet == pdFALSE )
+                    {
+                        vTaskInternalSetTimeOutState( &xTimeOut );
+                        xEntryTimeSet = pdTRUE;
+                    }
+                    else
+                    {
+                        /* Entry time was already set. */
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+            }
+            taskEXIT_CRITICAL();
+
+            vTaskSuspendAll();
+            prvLockQueue( pxQueue );
+
+            if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+            {
+                if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+                {
+                    traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
+                    vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+                    prvUnlockQueue( pxQueue );
+
+                    if( xTaskResumeAll() == pdFALSE )
+                    {
+                        taskYIELD_WITHIN_API();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    /* The queue contains data again.  Loop back to try and
+                     * acquire it. */
+                    prvUnlockQueue( pxQueue );
+                    ( void ) xTaskResumeAll();
+                }
+            }
+            else
+            {
+                prvUnlockQueue( pxQueue );
+                ( void ) xTaskResumeAll();
+
+                if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+                {
+                    *ppvItem = NULL;
+
+                    traceQUEUE_RECEIVE_FAILED( pxQueue );
+                    traceRETURN_xQueueAcquire( errQUEUE_EMPTY );
+
+                    return errQUEUE_EMPTY;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+    }
+
+#endif /* configUSE_QUEUE_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+
+    BaseType_t xQueueRelease( QueueHandle_t xQueue )
+    {
+        Queue_t * const pxQueue = xQueue;
+
+        traceENTER_xQueueRelease( xQueue );
+
+        configASSERT( pxQueue );
+
+        taskENTER_CRITICAL();
+        {
+            /* An item must have been obtained from xQueueAcquire() first. */
+            configASSERT( ( pxQueue->ucZeroCopyState & queueZERO_COPY_RECEIVE_ACQUIRED ) != 0U );
+
+            traceQUEUE_RECEIVE( pxQueue );
+
+            pxQueue->ucZeroCopyState &= ( uint8_t ) ~queueZERO_COPY_RECEIVE_ACQUIRED;
+
+            pxQueue->u.xQueue.pcReadFrom += pxQueue->uxItemSize;
+
+            if( pxQueue->u.xQueue.pcReadFrom >= pxQueue->u.xQueue.pcTail )
+            {
+                pxQueue->u.xQueue.pcReadFrom = pxQueue->pcHead;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            pxQueue->uxMessagesWaiting = ( UBaseType_t ) ( pxQueue->uxMessagesWaiting - ( UBaseType_t ) 1 );
+
+            /* There is now space in the queue, were any tasks waiting to post
+             * to the queue?  If so, unblock the highest priority waiting task. */
+            if( prvUnblockSenders( pxQueue, ( UBaseType_t ) 1 ) != pdFALSE )
+            {
+                queueYIELD_IF_USING_PREEMPTION();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        traceRETURN_xQueueRelease( pdPASS );
+
+        return pdPASS;
+    }
+
+#endif /* configUSE_QUEUE_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_BATCH_TRANSFER == 1 )
+
+    size_t xQueueSendMultiple( QueueHandle_t xQueue,
+                               const void * const pvItems,
+                               size_t xItemCount,
+                               TickType_t xTicksToWait )
+    {
+        BaseType_t xEntryTimeSet = pdFALSE;
+        TimeOut_t xTimeOut;
+        Queue_t * const pxQueue = xQueue;
+        UBaseType_t uxItemsToSend;
+
+        traceENTER_xQueueSendMultiple( xQueue, pvItems, xItemCount, xTicksToWait );
+
+        configASSERT( pxQueue );
+        configASSERT( pvItems );
+
+        /* Batches of zero sized items (semaphores) are not supported. */
+        configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+
+        #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+        {
+            configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+        }
+        #endif
+
+        for( ; ; )
+        {
+            taskENTER_CRITICAL();
+            {
+                /* Is there room for at least one item?  As many items as fit
+                 * are sent under this one critical section, and the decision
+                 * to yield is made once for the whole batch. */
+                if( queueSLOTS_IN_USE( pxQueue ) < pxQueue->uxLength )
+                {
+                    uxItemsToSend = pxQueue->uxLength - queueSLOTS_IN_USE( pxQueue );
+
+                    if( ( size_t ) uxItemsToSend > xItemCount )
+                    {
+                        uxItemsToSend = ( UBaseType_t ) xItemCount;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    traceQUEUE_SEND( pxQueue );
+
+                    prvCopyItemsToQueue( pxQueue, ( const uint8_t * ) pvItems, uxItemsToSend );
+
+                    if( prvUnblockReceivers( pxQueue, uxItemsToSend ) != pdFALSE )
+                    {
+                        queueYIELD_IF_USING_PREEMPTION();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    taskEXIT_CRITICAL();
+
+                    traceRETURN_xQueueSendMultiple( ( size_t ) uxItemsToSend );
+
+                    return ( size_t ) uxItemsToSend;
+                }
+                else
+                {
+                    if( xTicksToWait == ( TickType_t ) 0 )
+                    {
+                        taskEXIT_CRITICAL();
+
+                        traceQUEUE_SEND_FAILED( pxQueue );
+                        traceRETURN_xQueueSendMultiple( 0 );
+
+                        return 0;
+                    }
+                    else if( xEntryTimeSet == pdFALSE )
+                    {
+                        vTaskInternalSetTimeOutState( &xTimeOut );
+                        xEntryTimeSet = pdTRUE;
+                    }
+                    else
+                    {
+                        /* Entry time was already set. */
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+            }
+            taskEXIT_CRITICAL();
+
+            vTaskSuspendAll();
+            prvLockQueue( pxQueue );
+
+            if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+            {
+                if( prvIsQueueFull( pxQueue ) != pdFALSE )
+                {
+                    traceBLOCKING_ON_QUEUE_SEND( pxQueue );
+                    vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToSend ), xTicksToWait );
+                    prvUnlockQueue( pxQueue );
+
+                    if( xTaskResumeAll() == pdFALSE )
+                    {
+                        taskYIELD_WITHIN_API();
+                    }
+                }
+                else
+                {
+                    /* Try again. */
+                    prvUnlockQueue( pxQueue );
+                    ( void ) xTaskResumeAll();
+                }
+            }
+            else
+            {
+                /* The timeout has expired. */
+                prvUnlockQueue( pxQueue );
+                ( void ) xTaskResumeAll();
+
+                traceQUEUE_SEND_FAILED( pxQueue );
+                traceRETURN_xQueueSendMultiple( 0 );
+
+                return 0;
+            }
+        }
+    }
+
+#endif /* configUSE_QUEUE_BATCH_TRANSFER */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_BATCH_TRANSFER == 1 )
+
+    size_t xQueueSendMultipleFromISR( QueueHandle_t xQueue,
+                                      const void * const pvItems,
+                                      size_t xItemCount,
+                                      BaseType_t * const pxHigherPriorityTaskWoken )
+    {
+        UBaseType_t uxItemsToSend = 0;
+        UBaseType_t uxSavedInterruptStatus;
+        Queue_t * const pxQueue = xQueue;
+
+        traceENTER_xQueueSendMultipleFromISR( xQueue, pvItems, xItemCount, pxHigherPriorityTaskWoken );
+
+        configASSERT( pxQueue );
+        configASSERT( pvItems );
+        configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+
+        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+        /* MISRA Ref 4.7.1 [Return value shall be checked] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#dir-47 */
+        /* coverity[misra_c_2012_directive_4_7_violation] */
+        uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();
+        {
+            if( queueSLOTS_IN_USE( pxQueue ) < pxQueue->uxLength )
+            {
+                uxItemsToSend = pxQueue->uxLength - queueSLOTS_IN_USE( pxQueue );
+
+                if( ( size_t ) uxItemsToSend > xItemCount )
+                {
+                    uxItemsToSend = ( UBaseType_t ) xItemCount;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                traceQUEUE_SEND_FROM_ISR( pxQueue );
+
+                prvCopyItemsToQueue( pxQueue, ( const uint8_t * ) pvItems, uxItemsToSend );
+
+                if( prvUnblockReceivers( pxQueue, uxItemsToSend ) != pdFALSE )
+                {
+                    if( pxHigherPriorityTaskWoken != NULL )
+                    {
+                        *pxHigherPriorityTaskWoken = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                traceQUEUE_SEND_FROM_ISR_FAILED( pxQueue );
+            }
+        }
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+        traceRETURN_xQueueSendMultipleFromISR( ( size_t ) uxItemsToSend );
+
+        return ( size_t ) uxItemsToSend;
+    }
+
+#endif /* configUSE_QUEUE_BATCH_TRANSFER */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_BATCH_TRANSFER == 1 )
+
+    size_t xQueueReceiveMultiple( QueueHandle_t xQueue,
+                                  void * const pvBuffer,
+                                  size_t xMaxItemCount,
+                                  TickType_t xTicksToWait )
+    {
+        BaseType_t xEntryTimeSet = pdFALSE;
+        TimeOut_t xTimeOut;
+        Queue_t * const pxQueue = xQueue;
+        UBaseType_t uxItemsToReceive;
+
+        traceENTER_xQueueReceiveMultiple( xQueue, pvBuffer, xMaxItemCount, xTicksToWait );
+
+        configASSERT( pxQueue );
+        configASSERT( pvBuffer );
+        configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+
+        #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+        {
+            configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+        }
+        #endif
+
+        for( ; ; )
+        {
+            taskENTER_CRITICAL();
+            {
+                if( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 )
+                {
+                    uxItemsToReceive = pxQueue->uxMessagesWaiting;
+
+                    if( ( size_t ) uxItemsToReceive > xMaxItemCount )
+                    {
+                        uxItemsToReceive = ( UBaseType_t ) xMaxItemCount;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    prvCopyItemsFromQueue( pxQueue, ( uint8_t * ) pvBuffer, uxItemsToReceive );
+                    traceQUEUE_RECEIVE( pxQueue );
+
+                    if( prvUnblockSenders( pxQueue, uxItemsToReceive ) != pdFALSE )
+                    {
+                        queueYIELD_IF_USING_PREEMPTION();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    taskEXIT_CRITICAL();
+
+                    traceRETURN_xQueueReceiveMultiple( ( size_t ) uxItemsToReceive );
+
+                    return ( size_t ) uxItemsToReceive;
+                }
+                else
+                {
+                    if( xTicksToWait == ( TickType_t ) 0 )
+                    {
+                        taskEXIT_CRITICAL();
+
+                        traceQUEUE_RECEIVE_FAILED( pxQueue );
+                        traceRETURN_xQueueReceiveMultiple( 0 );
+
+                        return 0;
+                    }
+                    else if( xEntryTimeSet == pdFALSE )
+                    {
+                        vTaskInternalSetTimeOutState( &xTimeOut );
+                        xEntryTimeSet = pdTRUE;
+                    }
+                    else
+                    {
+                        /* Entry time was already set. */
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+            }
+            taskEXIT_CRITICAL();
+
+            vTaskSuspendAll();
+            prvLockQueue( pxQueue );
+
+            if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+            {
+                if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+                {
+                    traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
+                    vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+                    prvUnlockQueue( pxQueue );
+
+                    if( xTaskResumeAll() == pdFALSE )
+                    {
+                        taskYIELD_WITHIN_API();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    /* The queue contains data again.  Loop back to try and
+                     * read it. */
+                    prvUnlockQueue( pxQueue );
+                    ( void ) xTaskResumeAll();
+                }
+            }
+            else
+            {
+                prvUnlockQueue( pxQueue );
+                ( void ) xTaskResumeAll();
+
+                if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+                {
+                    traceQUEUE_RECEIVE_FAILED( pxQueue );
+                    traceRETURN_xQueueReceiveMultiple( 0 );
+
+                    return 0;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+    }
+
+#endif /* configUSE_QUEUE_BATCH_TRANSFER */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_BATCH_TRANSFER == 1 )
+
+    size_t xQueueReceiveMultipleFromISR( QueueHandle_t xQueue,
+                                         void * const pvBuffer,
+                                         size_t xMaxItemCount,
+                                         BaseType_t * const pxHigherPriorityTaskWoken )
+    {
+        UBaseType_t uxItemsToReceive = 0;
+        UBaseType_t uxSavedInterruptStatus;
+        Queue_t * const pxQueue = xQueue;
+
+        traceENTER_xQueueReceiveMultipleFromISR( xQueue, pvBuffer, xMaxItemCount, pxHigherPriorityTaskWoken );
+
+        configASSERT( pxQueue );
+        configASSERT( pvBuffer );
+        configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+
+        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+        /* MISRA Ref 4.7.1 [Return value shall be checked] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#dir-47 */
+        /* coverity[misra_c_2012_directive_4_7_violation] */
+        uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();
+        {
+            if( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 )
+            {
+                uxItemsToReceive = pxQueue->uxMessagesWaiting;
+
+                if( ( size_t ) uxItemsToReceive > xMaxItemCount )
+                {
+                    uxItemsToReceive = ( UBaseType_t ) xMaxItemCount;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                traceQUEUE_RECEIVE_FROM_ISR( pxQueue );
+
+                prvCopyItemsFromQueue( pxQueue, ( uint8_t * ) pvBuffer, uxItemsToReceive );
+
+                if( prvUnblockSenders( pxQueue, uxItemsToReceive ) != pdFALSE )
+                {
+                    if( pxHigherPriorityTaskWoken != NULL )
+                    {
+                        *pxHigherPriorityTaskWoken = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                traceQUEUE_RECEIVE_FROM_ISR_FAILED( pxQueue );
+            }
+        }
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+        traceRETURN_xQueueReceiveMultipleFromISR( ( size_t ) uxItemsToReceive );
+
+        return ( size_t ) uxItemsToReceive;
+    }
+
+#endif /* configUSE_QUEUE_BATCH_TRANSFER */
+/*-----------------------------------------------------------*/
+
+BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
+                                TickType_t xTicksToWait )
+{
+    BaseType_t xEntryTimeSet = pdFALSE;
+    TimeOut_t xTimeOut;
+    Queue_t * const pxQueue = xQueue;
+
+    #if ( configUSE_MUTEXES == 1 )
+        BaseType_t xInheritanceOccurred = pdFALSE;
+    #endif
+
+    traceENTER_xQueueSemaphoreTake( xQueue, xTicksToWait );
+
+    /* Check the queue pointer is not NULL. */
+    configASSERT( ( pxQueue ) );
+
+    /* Check this really is a semaphore, in which case the item size will be
+     * 0. */
+    configASSERT( pxQueue->uxItemSize == 0 );
+
+    /* Cannot block if the scheduler is suspended. */
+    #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+    {
+        configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+    }
+    #endif
+
+    for( ; ; )
+    {
+        taskENTER_CRITICAL();
+        {
+            /* Semaphores are queues with an item size of 0, and where the
+             * number of messages in the queue is the semaphore's count value. */
+            const UBaseType_t uxSemaphoreCount = pxQueue->uxMessagesWaiting;
+
+            /* Is there data in the queue now?  To be running the calling task
+             * must be the highest priority task wanting to access the queue. */
+            if( uxSemaphoreCount > ( UBaseType_t ) 0 )
+            {
+                traceQUEUE_RECEIVE( pxQueue );
+
+                /* Semaphores are queues with a data size of zero and where the
+                 * messages waiting is the semaphore's count.  Reduce the count. */
+                pxQueue->uxMessagesWaiting = ( UBaseType_t ) ( uxSemaphoreCount - ( UBaseType_t ) 1 );
+
+                #if ( configUSE_MUTEXES == 1 )
+                {
+                    if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
+                    {
+                        /* Record the information required to implement
+                         * priority inheritance should it become necessary. */
+                        pxQueue->u.xSemaphore.xMutexHolder = pvTaskIncrementMutexHeldCount();
+
+                        #if ( configUSE_CEILING_MUTEXES == 1 )
+                        {
+                            if( queueIS_CEILING_MUTEX( pxQueue ) != pdFALSE )
+                            {
+                                /* A priority ceiling mutex raises its holder to
+                                 * the ceiling straight away, so no task that
+                                 * uses the mutex can preempt the holder and no
+                                 * inheritance is needed. */
+                                pxQueue->uxPriorityBeforeCeiling = uxTaskPriorityRaiseToCeiling( pxQueue->uxCeilingPriority );
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+                        }
+                        #endif /* configUSE_CEILING_MUTEXES */
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #endif /* configUSE_MUTEXES */
+
+                /* Check to see if other tasks are blocked waiting to give the
+                 * semaphore, and if so, unblock the highest priority such task. */
+                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+                {
+                    if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+                    {
+                        queueYIELD_IF_USING_PREEMPTION();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                taskEXIT_CRITICAL();
+
+                traceRETURN_xQueueSemaphoreTake( pdPASS );
+
+                return pdPASS;
+            }
+            else
+            {
+                if( xTicksToWait == ( TickType_t ) 0 )
+                {
+                    /* The semaphore count was 0 and no block time is specified
+                     * (or the block time has expired) so exit now. */
+                    taskEXIT_CRITICAL();
+
+                    traceQUEUE_RECEIVE_FAILED( pxQueue );
+                    traceRETURN_xQueueSemaphoreTake( errQUEUE_EMPTY );
+
+                    return errQUEUE_EMPTY;
+                }
+                else if( xEntryTimeSet == pdFALSE )
+                {
+                    /* The semaphore count was 0 and a block time was specified
+                     * so configure the timeout structure ready to block. */
+                    vTaskInternalSetTimeOutState( &xTimeOut );
+                    xEntryTimeSet = pdTRUE;
+                }
+                else
+                {
+                    /* Entry time was already set. */
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        /* Interrupts and other tasks can give to and take from the semaphore
+         * now the critical section has been exited. */
+
+        vTaskSuspendAll();
+        prvLockQueue( pxQueue );
+
+        /* Update the timeout state to see if it has expired yet. */
+        if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+        {
+            /* A block time is specified and not expired.  If the semaphore
+             * count is 0 then enter the Blocked state to wait for a semaphore to
+             * become available.  As semaphores are implemented with queues the
+             * queue being empty is equivalent to the semaphore count being 0. */
+            if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+            {
+                traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
+
+                #if ( configUSE_MUTEXES == 1 )
+                {
+                    /* The holder of a priority ceiling mutex already runs at the
+                     * ceiling, so there is nothing to inherit. */
+                    if( ( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX ) && ( queueIS_CEILING_MUTEX( pxQueue ) == pdFALSE ) )
+                    {
+                        taskENTER_CRITICAL();
+                        {
+                            #if ( configUSE_TRANSITIVE_INHERITANCE == 1 )
+                            {
+                                /* Record the mutex this task is about to block on,
+                                 * so a task that blocks on a mutex this task holds
+                                 * can pass its priority on to the holder of this
+                                 * one. */
+                                vTaskSetBlockedOnMutex( ( void * ) pxQueue );
+                            }
+                            #endif
+
+                            xInheritanceOccurred = xTaskPriorityInherit( pxQueue->u.xSemaphore.xMutexHolder );
+                        }
+                        taskEXIT_CRITICAL();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #endif /* if ( configUSE_MUTEXES == 1 ) */
+
+                vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+                prvUnlockQueue( pxQueue );
+
+                if( xTaskResumeAll() == pdFALSE )
+                {
+                    taskYIELD_WITHIN_API();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                #if ( configUSE_TRANSITIVE_INHERITANCE == 1 )
+                {
+                    /* No longer blocked on the mutex. */
+                    vTaskSetBlockedOnMutex( NULL );
+                }
+                #endif
+            }
+            else
+            {
+                /* There was no timeout and the semaphore count was not 0, so
+                 * attempt to take the semaphore again. */
                 prvUnlockQueue( pxQueue );
                 ( void ) xTaskResumeAll();
             }
@@ -2235,7 +3194,7 @@ UBaseType_t uxQueueSpacesAvailable( const QueueHandle_t xQueue )
 
     portBASE_TYPE_ENTER_CRITICAL();
     {
-        uxReturn = ( UBaseType_t ) ( pxQueue->uxLength - pxQueue->uxMessagesWaiting );
+        uxReturn = ( UBaseType_t ) ( pxQueue->uxLength - queueSLOTS_IN_USE( pxQueue ) );
     }
     portBASE_TYPE_EXIT_CRITICAL();
 
@@ -2280,7 +3239,7 @@ void vQueueDelete( QueueHandle_t xQueue )
     {
         /* The queue can only have been allocated dynamically - free it
          * again. */
-        vPortFree( pxQueue );
+        vPortFreeObject( pxQueue );
     }
     #elif ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
     {
@@ -2288,7 +3247,7 @@ void vQueueDelete( QueueHandle_t xQueue )
          * check before attempting to free the memory. */
         if( pxQueue->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
         {
-            vPortFree( pxQueue );
+            vPortFreeObject( pxQueue );
         }
         else
         {
@@ -2406,6 +3365,19 @@ static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue,
 
     /* This function is called from a critical section. */
 
+    #if ( configUSE_QUEUE_ZERO_COPY == 1 )
+    {
+        /* Copying to the back while xQueueReserve() has lent out the slot at
+         * pcWriteTo, or writing to the front while xQueueAcquire() has lent
+         * out the item at the front, would corrupt the lent item.  Front sends
+         * are safe while a slot is reserved because queueSLOTS_IN_USE() keeps
+         * them out of the reserved slot, but an overwrite ignores the room
+         * check. */
+        configASSERT( !( ( xPosition != queueSEND_TO_FRONT ) && ( ( pxQueue->ucZeroCopyState & queueZERO_COPY_SEND_RESERVED ) != 0U ) ) );
+        configASSERT( !( ( xPosition != queueSEND_TO_BACK ) && ( ( pxQueue->ucZeroCopyState & queueZERO_COPY_RECEIVE_ACQUIRED ) != 0U ) ) );
+    }
+    #endif
+
     uxMessagesWaiting = pxQueue->uxMessagesWaiting;
 
     if( pxQueue->uxItemSize == ( UBaseType_t ) 0 )
@@ -2415,7 +3387,32 @@ static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue,
             if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
             {
                 /* The mutex is no longer being held. */
-                xReturn = xTaskPriorityDisinherit( pxQueue->u.xSemaphore.xMutexHolder );
+                #if ( configUSE_CEILING_MUTEXES == 1 )
+                {
+                    if( queueIS_CEILING_MUTEX( pxQueue ) != pdFALSE )
+                    {
+                        /* The give made by prvInitialiseMutex() has no holder
+                         * to restore, as with xTaskPriorityDisinherit(). */
+                        if( pxQueue->u.xSemaphore.xMutexHolder != NULL )
+                        {
+                            xReturn = xTaskPriorityRestoreFromCeiling( pxQueue->uxCeilingPriority, pxQueue->uxPriorityBeforeCeiling );
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else
+                    {
+                        xReturn = xTaskPriorityDisinherit( pxQueue->u.xSemaphore.xMutexHolder );
+                    }
+                }
+                #else /* configUSE_CEILING_MUTEXES */
+                {
+                    xReturn = xTaskPriorityDisinherit( pxQueue->u.xSemaphore.xMutexHolder );
+                }
+                #endif /* configUSE_CEILING_MUTEXES */
+
                 pxQueue->u.xSemaphore.xMutexHolder = NULL;
             }
             else
@@ -2483,6 +3480,11 @@ static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue,
 static void prvCopyDataFromQueue( Queue_t * const pxQueue,
                                   void * const pvBuffer )
 {
+    /* The item at the front of the queue is lent out by xQueueAcquire(). */
+    #if ( configUSE_QUEUE_ZERO_COPY == 1 )
+        configASSERT( ( pxQueue->ucZeroCopyState & queueZERO_COPY_RECEIVE_ACQUIRED ) == 0U );
+    #endif
+
     if( pxQueue->uxItemSize != ( UBaseType_t ) 0 )
     {
         pxQueue->u.xQueue.pcReadFrom += pxQueue->uxItemSize;
@@ -2501,6 +3503,226 @@ static void prvCopyDataFromQueue( Queue_t * const pxQueue,
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_QUEUE_BATCH_TRANSFER == 1 )
+
+    static void prvCopyItemsToQueue( Queue_t * const pxQueue,
+                                     const uint8_t * pucItems,
+                                     UBaseType_t uxItemCount )
+    {
+        const size_t xBytes = ( size_t ) uxItemCount * ( size_t ) pxQueue->uxItemSize;
+        size_t xFirstBytes = ( size_t ) ( pxQueue->u.xQueue.pcTail - pxQueue->pcWriteTo );
+
+        /* This function is called from a critical section. */
+
+        #if ( configUSE_QUEUE_ZERO_COPY == 1 )
+            configASSERT( ( pxQueue->ucZeroCopyState & queueZERO_COPY_SEND_RESERVED ) == 0U );
+        #endif
+
+        /* The caller has already checked there is space for all the items. */
+        configASSERT( ( pxQueue->uxMessagesWaiting + uxItemCount ) <= pxQueue->uxLength );
+
+        if( xFirstBytes > xBytes )
+        {
+            xFirstBytes = xBytes;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        ( void ) memcpy( ( void * ) pxQueue->pcWriteTo, ( const void * ) pucItems, xFirstBytes );
+
+        if( xBytes > xFirstBytes )
+        {
+            /* The batch wraps, write the rest to the start of the storage
+             * area. */
+            ( void ) memcpy( ( void * ) pxQueue->pcHead, ( const void * ) &( pucItems[ xFirstBytes ] ), xBytes - xFirstBytes );
+            pxQueue->pcWriteTo = pxQueue->pcHead + ( xBytes - xFirstBytes );
+        }
+        else
+        {
+            pxQueue->pcWriteTo += xBytes;
+        }
+
+        if( pxQueue->pcWriteTo >= pxQueue->u.xQueue.pcTail )
+        {
+            pxQueue->pcWriteTo = pxQueue->pcHead;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        pxQueue->uxMessagesWaiting = ( UBaseType_t ) ( pxQueue->uxMessagesWaiting + uxItemCount );
+    }
+
+#endif /* configUSE_QUEUE_BATCH_TRANSFER */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_BATCH_TRANSFER == 1 )
+
+    static void prvCopyItemsFromQueue( Queue_t * const pxQueue,
+                                       uint8_t * pucItems,
+                                       UBaseType_t uxItemCount )
+    {
+        const size_t xBytes = ( size_t ) uxItemCount * ( size_t ) pxQueue->uxItemSize;
+        int8_t * pcReadFrom = pxQueue->u.xQueue.pcReadFrom + pxQueue->uxItemSize;
+        size_t xFirstBytes;
+
+        /* This function is called from a critical section. */
+
+        #if ( configUSE_QUEUE_ZERO_COPY == 1 )
+            configASSERT( ( pxQueue->ucZeroCopyState & queueZERO_COPY_RECEIVE_ACQUIRED ) == 0U );
+        #endif
+
+        configASSERT( uxItemCount <= pxQueue->uxMessagesWaiting );
+
+        /* pcReadFrom points to the last item read, so the first item to read
+         * is the one after it. */
+        if( pcReadFrom >= pxQueue->u.xQueue.pcTail )
+        {
+            pcReadFrom = pxQueue->pcHead;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        xFirstBytes = ( size_t ) ( pxQueue->u.xQueue.pcTail - pcReadFrom );
+
+        if( xFirstBytes > xBytes )
+        {
+            xFirstBytes = xBytes;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        ( void ) memcpy( ( void * ) pucItems, ( const void * ) pcReadFrom, xFirstBytes );
+
+        if( xBytes > xFirstBytes )
+        {
+            ( void ) memcpy( ( void * ) &( pucItems[ xFirstBytes ] ), ( const void * ) pxQueue->pcHead, xBytes - xFirstBytes );
+            pcReadFrom = pxQueue->pcHead + ( xBytes - xFirstBytes );
+        }
+        else
+        {
+            pcReadFrom += xBytes;
+        }
+
+        /* Leave pcReadFrom pointing at the last item read, as
+         * prvCopyDataFromQueue() does. */
+        pxQueue->u.xQueue.pcReadFrom = pcReadFrom - pxQueue->uxItemSize;
+        pxQueue->uxMessagesWaiting = ( UBaseType_t ) ( pxQueue->uxMessagesWaiting - uxItemCount );
+    }
+
+#endif /* configUSE_QUEUE_BATCH_TRANSFER */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_QUEUE_BATCH_TRANSFER == 1 ) || ( configUSE_QUEUE_ZERO_COPY == 1 ) )
+
+    static BaseType_t prvUnblockReceivers( Queue_t * const pxQueue,
+                                           UBaseType_t uxItemCount )
+    {
+        BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+        UBaseType_t ux;
+
+        /* This function is called from a critical section. */
+
+        for( ux = 0; ux < uxItemCount; ux++ )
+        {
+            const int8_t cTxLock = pxQueue->cTxLock;
+
+            if( cTxLock != queueUNLOCKED )
+            {
+                /* The task that unlocks the queue performs one unblock per
+                 * lock count. */
+                prvIncrementQueueTxLock( pxQueue, cTxLock );
+            }
+
+            #if ( configUSE_QUEUE_SETS == 1 )
+                else if( pxQueue->pxQueueSetContainer != NULL )
+                {
+                    /* A queue set holds one entry per item in its member
+                     * queues, so it is notified once per item. */
+                    if( prvNotifyQueueSetContainer( pxQueue ) != pdFALSE )
+                    {
+                        xHigherPriorityTaskWoken = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+            #endif /* configUSE_QUEUE_SETS */
+            else if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+            {
+                /* Each waiting receiver takes one item, so wake at most one
+                 * receiver per item added. */
+                if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                {
+                    xHigherPriorityTaskWoken = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                /* No more tasks to unblock. */
+                break;
+            }
+        }
+
+        return xHigherPriorityTaskWoken;
+    }
+
+#endif /* if ( ( configUSE_QUEUE_BATCH_TRANSFER == 1 ) || ( configUSE_QUEUE_ZERO_COPY == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_QUEUE_BATCH_TRANSFER == 1 ) || ( configUSE_QUEUE_ZERO_COPY == 1 ) )
+
+    static BaseType_t prvUnblockSenders( Queue_t * const pxQueue,
+                                         UBaseType_t uxItemCount )
+    {
+        BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+        UBaseType_t ux;
+
+        /* This function is called from a critical section. */
+
+        for( ux = 0; ux < uxItemCount; ux++ )
+        {
+            const int8_t cRxLock = pxQueue->cRxLock;
+
+            if( cRxLock != queueUNLOCKED )
+            {
+                prvIncrementQueueRxLock( pxQueue, cRxLock );
+            }
+            else if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+            {
+                if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+                {
+                    xHigherPriorityTaskWoken = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                break;
+            }
+        }
+
+        return xHigherPriorityTaskWoken;
+    }
+
+#endif /* if ( ( configUSE_QUEUE_BATCH_TRANSFER == 1 ) || ( configUSE_QUEUE_ZERO_COPY == 1 ) ) */
+/*-----------------------------------------------------------*/
+
 static void prvUnlockQueue( Queue_t * const pxQueue )
 {
     /* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED. */
@@ -2672,7 +3894,7 @@ static BaseType_t prvIsQueueFull( const Queue_t * pxQueue )
 
     taskENTER_CRITICAL();
     {
-        if( pxQueue->uxMessagesWaiting == pxQueue->uxLength )
+        if( queueSLOTS_IN_USE( pxQueue ) == pxQueue->uxLength )
         {
             xReturn = pdTRUE;
         }
@@ -2696,7 +3918,7 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
 
     configASSERT( pxQueue );
 
-    if( pxQueue->uxMessagesWaiting == pxQueue->uxLength )
+    if( queueSLOTS_IN_USE( pxQueue ) == pxQueue->uxLength )
     {
         xReturn = pdTRUE;
     }
@@ -2750,7 +3972,7 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
 
         portDISABLE_INTERRUPTS();
         {
-            if( pxQueue->uxMessagesWaiting < pxQueue->uxLength )
+            if( queueSLOTS_IN_USE( pxQueue ) < pxQueue->uxLength )
             {
                 /* There is room in the queue, copy the data into the queue. */
                 prvCopyDataToQueue( pxQueue, pvItemToQueue, queueSEND_TO_BACK );
@@ -2904,7 +4126,7 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
 
         /* Cannot block within an ISR so if there is no space on the queue then
          * exit without doing anything. */
-        if( pxQueue->uxMessagesWaiting < pxQueue->uxLength )
+        if( queueSLOTS_IN_USE( pxQueue ) < pxQueue->uxLength )
         {
             prvCopyDataToQueue( pxQueue, pvItemToQueue, queueSEND_TO_BACK );
 
@@ -0,0 +1,776 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "atomic.h"
+#include "rw_lock.h"
+
+/* The MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+ * for the header files above, but not in this file, in order to generate the
+ * correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* This entire source file will be skipped if the application is not configured
+ * to include reader-writer locks.  This #if is closed at the very bottom of
+ * this file. */
+#if ( configUSE_RW_LOCKS == 1 )
+
+    #if ( configUSE_MUTEXES != 1 )
+        #error configUSE_MUTEXES must be set to 1 to build rw_lock.c
+    #endif
+
+/* Bits stored in the ucFlags member of the lock structure. */
+    #define rwlockFLAGS_IS_STATICALLY_ALLOCATED    ( ( uint8_t ) 1 )
+    #define rwlockFLAGS_WRITER_PENDING             ( ( uint8_t ) 2 )
+
+/* Bits stored in the ulState member of the lock structure. */
+    #define rwlockWRITER_BIT                       ( ( uint32_t ) 0x80000000UL )
+    #define rwlockSLOW_PATH_BIT                    ( ( uint32_t ) 0x40000000UL )
+    #define rwlockREADER_COUNT_MASK                ( ( uint32_t ) 0x3fffffffUL )
+
+/*
+ * ulState holds the number of tasks holding the lock for reading, plus
+ * rwlockWRITER_BIT while a task holds it for writing.  Taking the lock for
+ * reading when no task holds or is waiting for it for writing is a single
+ * compare and swap that increments the reader count, and giving it back is a
+ * single compare and swap that decrements it, so readers on different cores
+ * do not serialise on a kernel lock.
+ *
+ * Everything else - writers, and readers that find the lock held or wanted for
+ * writing - runs with the scheduler suspended and first sets
+ * rwlockSLOW_PATH_BIT, which makes the reader fast paths fail.  While the bit
+ * is set ulState and the waiting task lists are only accessed with the
+ * scheduler suspended, so need no other protection.  The bit is cleared again
+ * once no tasks are waiting.
+ *
+ * Writers are preferred: a reader cannot take the lock while a writer is
+ * waiting, and a writer giving the lock back hands it straight to the highest
+ * priority waiting writer, if any, before readers are considered.
+ */
+    typedef struct RWLockDef_t
+    {
+        volatile uint32_t ulState;     /**< Reader count plus rwlockWRITER_BIT and rwlockSLOW_PATH_BIT. */
+        TaskHandle_t xWriter;          /**< The task holding the lock for writing, valid while rwlockWRITER_BIT is set. */
+        List_t xTasksWaitingToRead;    /**< List of tasks blocked waiting to take the lock for reading.  Stored in priority order. */
+        List_t xTasksWaitingToWrite;   /**< List of tasks blocked waiting to take the lock for writing.  Stored in priority order. */
+        uint8_t ucFlags;
+    } RWLock_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * The part of xRWLockTakeRead() that is executed when the lock could not be
+ * taken with a single compare and swap.
+ */
+    static BaseType_t prvTakeReadContended( RWLock_t * const pxLock,
+                                            TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/*
+ * The part of xRWLockGiveRead() that is executed when the lock could not be
+ * given back with a single compare and swap.
+ */
+    static BaseType_t prvGiveReadContended( RWLock_t * const pxLock ) PRIVILEGED_FUNCTION;
+
+/*
+ * Set rwlockSLOW_PATH_BIT, after which the reader fast paths cannot change
+ * ulState.  Must be called with the scheduler suspended.
+ */
+    static void prvEnterSlowPath( RWLock_t * const pxLock ) PRIVILEGED_FUNCTION;
+
+/*
+ * Clear rwlockSLOW_PATH_BIT again if no tasks are waiting for the lock.  Must
+ * be called with the scheduler suspended.
+ */
+    static void prvExitSlowPath( RWLock_t * const pxLock ) PRIVILEGED_FUNCTION;
+
+/*
+ * If a task is waiting to write, make the highest priority such task the
+ * writer and unblock it.  Must be called with the scheduler suspended, with
+ * the lock otherwise free.
+ */
+    static void prvHandOverToWriter( RWLock_t * const pxLock ) PRIVILEGED_FUNCTION;
+
+/*
+ * Unblock every task waiting to read.  Each one takes the lock for reading
+ * when it runs, unless a writer has got in first.  Must be called with the
+ * scheduler suspended.
+ */
+    static void prvUnblockAllReaders( RWLock_t * const pxLock ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the priority of the highest priority task blocked on the lock, or
+ * tskIDLE_PRIORITY if no tasks are blocked.  Must be called with the scheduler
+ * suspended.
+ */
+    static UBaseType_t prvGetHighestWaitingPriority( const RWLock_t * const pxLock ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called by both the static and dynamic create functions to initialise the
+ * lock structure.
+ */
+    static void prvInitialiseNewRWLock( RWLock_t * const pxLock,
+                                        uint8_t ucFlags ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+    #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+        RWLockHandle_t xRWLockCreate( void )
+        {
+            RWLock_t * pxLock;
+
+            traceENTER_xRWLockCreate();
+
+            /* MISRA Ref 11.5.1 [Malloc memory assignment] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+            /* coverity[misra_c_2012_rule_11_5_violation] */
+            pxLock = ( RWLock_t * ) pvPortMallocObject( sizeof( RWLock_t ) );
+
+            if( pxLock != NULL )
+            {
+                prvInitialiseNewRWLock( pxLock, 0 );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            traceRETURN_xRWLockCreate( pxLock );
+
+            return pxLock;
+        }
+
+    #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+    #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+        RWLockHandle_t xRWLockCreateStatic( StaticRWLock_t * pxStaticLock )
+        {
+            RWLock_t * pxLock = NULL;
+
+            traceENTER_xRWLockCreateStatic( pxStaticLock );
+
+            configASSERT( pxStaticLock );
+
+            #if ( configASSERT_DEFINED == 1 )
+            {
+                /* Sanity check that the size of the structure used to declare a
+                 * variable of type StaticRWLock_t equals the size of the real
+                 * lock structure. */
+                volatile size_t xSize = sizeof( StaticRWLock_t );
+                configASSERT( xSize == sizeof( RWLock_t ) );
+            }
+            #endif /* configASSERT_DEFINED */
+
+            if( pxStaticLock != NULL )
+            {
+                /* MISRA Ref 11.3.1 [Misaligned access] */
+                /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-113 */
+                /* coverity[misra_c_2012_rule_11_3_violation] */
+                pxLock = ( RWLock_t * ) pxStaticLock;
+                prvInitialiseNewRWLock( pxLock, rwlockFLAGS_IS_STATICALLY_ALLOCATED );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            traceRETURN_xRWLockCreateStatic( pxLock );
+
+            return pxLock;
+        }
+
+    #endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+    void vRWLockDelete( RWLockHandle_t xLock )
+    {
+        RWLock_t * pxLock = xLock;
+
+        traceENTER_vRWLockDelete( xLock );
+
+        configASSERT( pxLock );
+
+        /* A lock must not be deleted while it is held or tasks are blocked on
+         * it. */
+        configASSERT( pxLock->ulState == 0U );
+        configASSERT( listLIST_IS_EMPTY( &( pxLock->xTasksWaitingToRead ) ) != pdFALSE );
+        configASSERT( listLIST_IS_EMPTY( &( pxLock->xTasksWaitingToWrite ) ) != pdFALSE );
+
+        if( ( pxLock->ucFlags & rwlockFLAGS_IS_STATICALLY_ALLOCATED ) == ( uint8_t ) 0 )
+        {
+            #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+            {
+                vPortFreeObject( ( void * ) pxLock );
+            }
+            #endif
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_vRWLockDelete();
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xRWLockTakeRead( RWLockHandle_t xLock,
+                                TickType_t xTicksToWait )
+    {
+        RWLock_t * const pxLock = xLock;
+        uint32_t ulState;
+        BaseType_t xReturn;
+
+        traceENTER_xRWLockTakeRead( xLock, xTicksToWait );
+
+        configASSERT( pxLock );
+
+        /* A task holding the lock for writing would deadlock. */
+        configASSERT( !( ( ( pxLock->ulState & rwlockWRITER_BIT ) != 0U ) && ( pxLock->xWriter == xTaskGetCurrentTaskHandle() ) ) );
+
+        /* Cannot block if the scheduler is suspended. */
+        #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+        {
+            configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+        }
+        #endif
+
+        ulState = pxLock->ulState;
+        configASSERT( ( ulState & rwlockREADER_COUNT_MASK ) != rwlockREADER_COUNT_MASK );
+
+        if( ( ( ulState & ( rwlockWRITER_BIT | rwlockSLOW_PATH_BIT ) ) == 0U ) &&
+            ( Atomic_CompareAndSwap_u32( &( pxLock->ulState ), ulState + 1U, ulState ) == ATOMIC_COMPARE_AND_SWAP_SUCCESS ) )
+        {
+            /* No task held or was waiting for the lock for writing. */
+            traceRW_LOCK_TAKE_READ( xLock );
+            xReturn = pdPASS;
+        }
+        else
+        {
+            xReturn = prvTakeReadContended( pxLock, xTicksToWait );
+        }
+
+        traceRETURN_xRWLockTakeRead( xReturn );
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xRWLockGiveRead( RWLockHandle_t xLock )
+    {
+        RWLock_t * const pxLock = xLock;
+        uint32_t ulState;
+        BaseType_t xReturn;
+
+        traceENTER_xRWLockGiveRead( xLock );
+
+        configASSERT( pxLock );
+
+        ulState = pxLock->ulState;
+
+        if( ( ( ulState & rwlockSLOW_PATH_BIT ) == 0U ) &&
+            ( ( ulState & rwlockREADER_COUNT_MASK ) != 0U ) &&
+            ( Atomic_CompareAndSwap_u32( &( pxLock->ulState ), ulState - 1U, ulState ) == ATOMIC_COMPARE_AND_SWAP_SUCCESS ) )
+        {
+            /* No tasks were waiting for the lock. */
+            traceRW_LOCK_GIVE_READ( xLock );
+            xReturn = pdPASS;
+        }
+        else
+        {
+            xReturn = prvGiveReadContended( pxLock );
+        }
+
+        traceRETURN_xRWLockGiveRead( xReturn );
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xRWLockTakeWrite( RWLockHandle_t xLock,
+                                 TickType_t xTicksToWait )
+    {
+        RWLock_t * const pxLock = xLock;
+        TaskHandle_t const xCallingTask = xTaskGetCurrentTaskHandle();
+        TimeOut_t xTimeOut;
+        BaseType_t xReturn = errQUEUE_EMPTY;
+        BaseType_t xInheritanceOccurred = pdFALSE;
+        BaseType_t xTimedOut = pdFALSE;
+        BaseType_t xBlocked;
+
+        traceENTER_xRWLockTakeWrite( xLock, xTicksToWait );
+
+        configASSERT( pxLock );
+
+        /* Reader-writer locks are not recursive. */
+        configASSERT( !( ( ( pxLock->ulState & rwlockWRITER_BIT ) != 0U ) && ( pxLock->xWriter == xCallingTask ) && ( ( pxLock->ucFlags & rwlockFLAGS_WRITER_PENDING ) == 0U ) ) );
+
+        /* Cannot block if the scheduler is suspended. */
+        #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+        {
+            configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+        }
+        #endif
+
+        vTaskSetTimeOutState( &xTimeOut );
+
+        for( ; ; )
+        {
+            xBlocked = pdFALSE;
+
+            vTaskSuspendAll();
+            {
+                prvEnterSlowPath( pxLock );
+
+                if( ( ( pxLock->ucFlags & rwlockFLAGS_WRITER_PENDING ) != 0U ) && ( pxLock->xWriter == xCallingTask ) )
+                {
+                    /* The previous holder handed the lock to this task when it
+                     * unblocked it. */
+                    pxLock->ucFlags &= ( uint8_t ) ~rwlockFLAGS_WRITER_PENDING;
+                    ( void ) pvTaskIncrementMutexHeldCount();
+                    traceRW_LOCK_TAKE_WRITE( pxLock );
+                    xReturn = pdPASS;
+                }
+                else if( ( pxLock->ulState & ( rwlockWRITER_BIT | rwlockREADER_COUNT_MASK ) ) == 0U )
+                {
+                    pxLock->ulState |= rwlockWRITER_BIT;
+                    pxLock->xWriter = xCallingTask;
+                    ( void ) pvTaskIncrementMutexHeldCount();
+                    traceRW_LOCK_TAKE_WRITE( pxLock );
+                    xReturn = pdPASS;
+                }
+                else if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+                {
+                    /* Only a writer can inherit the calling task's priority.
+                     * There can be any number of readers, so while readers
+                     * hold the lock the calling task waits without
+                     * inheritance. */
+                    if( ( pxLock->ulState & rwlockWRITER_BIT ) != 0U )
+                    {
+                        taskENTER_CRITICAL();
+                        {
+                            xInheritanceOccurred |= xTaskPriorityInherit( pxLock->xWriter );
+                        }
+                        taskEXIT_CRITICAL();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    traceBLOCKING_ON_RW_LOCK_TAKE_WRITE( pxLock );
+                    vTaskPlaceOnEventList( &( pxLock->xTasksWaitingToWrite ), xTicksToWait );
+                    xBlocked = pdTRUE;
+                }
+                else
+                {
+                    /* Timed out.  Drop any priority this task passed to the
+                     * writer, unless the writer has not yet run to claim the
+                     * lock, in which case the raised priority is kept until it
+                     * gives the lock back. */
+                    if( ( xInheritanceOccurred != pdFALSE ) &&
+                        ( ( pxLock->ulState & rwlockWRITER_BIT ) != 0U ) &&
+                        ( ( pxLock->ucFlags & rwlockFLAGS_WRITER_PENDING ) == 0U ) )
+                    {
+                        taskENTER_CRITICAL();
+                        {
+                            vTaskPriorityDisinheritAfterTimeout( pxLock->xWriter, prvGetHighestWaitingPriority( pxLock ) );
+                        }
+                        taskEXIT_CRITICAL();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    /* Readers may have been waiting only because this task was
+                     * waiting to write. */
+                    if( ( ( pxLock->ulState & rwlockWRITER_BIT ) == 0U ) &&
+                        ( listLIST_IS_EMPTY( &( pxLock->xTasksWaitingToWrite ) ) != pdFALSE ) )
+                    {
+                        prvUnblockAllReaders( pxLock );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    traceRW_LOCK_TAKE_WRITE_FAILED( pxLock );
+                    xTimedOut = pdTRUE;
+                }
+
+                prvExitSlowPath( pxLock );
+            }
+
+            if( xTaskResumeAll() == pdFALSE )
+            {
+                if( xBlocked != pdFALSE )
+                {
+                    taskYIELD_WITHIN_API();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            if( ( xReturn == pdPASS ) || ( xTimedOut != pdFALSE ) )
+            {
+                break;
+            }
+        }
+
+        traceRETURN_xRWLockTakeWrite( xReturn );
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xRWLockGiveWrite( RWLockHandle_t xLock )
+    {
+        RWLock_t * const pxLock = xLock;
+        BaseType_t xReturn = pdPASS;
+        BaseType_t xYieldRequired = pdFALSE;
+
+        traceENTER_xRWLockGiveWrite( xLock );
+
+        configASSERT( pxLock );
+
+        /* Only the writer can give the lock back. */
+        if( ( ( pxLock->ulState & rwlockWRITER_BIT ) != 0U ) &&
+            ( pxLock->xWriter == xTaskGetCurrentTaskHandle() ) &&
+            ( ( pxLock->ucFlags & rwlockFLAGS_WRITER_PENDING ) == 0U ) )
+        {
+            traceRW_LOCK_GIVE_WRITE( xLock );
+
+            vTaskSuspendAll();
+            {
+                /* Drop any priority the calling task inherited from the tasks
+                 * blocked on the lock. */
+                taskENTER_CRITICAL();
+                {
+                    xYieldRequired = xTaskPriorityDisinherit( pxLock->xWriter );
+                }
+                taskEXIT_CRITICAL();
+
+                prvEnterSlowPath( pxLock );
+
+                pxLock->ulState &= ~rwlockWRITER_BIT;
+                pxLock->xWriter = NULL;
+
+                if( listLIST_IS_EMPTY( &( pxLock->xTasksWaitingToWrite ) ) == pdFALSE )
+                {
+                    prvHandOverToWriter( pxLock );
+                }
+                else
+                {
+                    prvUnblockAllReaders( pxLock );
+                }
+
+                prvExitSlowPath( pxLock );
+            }
+
+            if( ( xTaskResumeAll() == pdFALSE ) && ( xYieldRequired != pdFALSE ) )
+            {
+                taskYIELD_WITHIN_API();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            xReturn = pdFAIL;
+        }
+
+        traceRETURN_xRWLockGiveWrite( xReturn );
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvTakeReadContended( RWLock_t * const pxLock,
+                                            TickType_t xTicksToWait )
+    {
+        TimeOut_t xTimeOut;
+        BaseType_t xReturn = errQUEUE_EMPTY;
+        BaseType_t xInheritanceOccurred = pdFALSE;
+        BaseType_t xTimedOut = pdFALSE;
+        BaseType_t xBlocked;
+
+        vTaskSetTimeOutState( &xTimeOut );
+
+        for( ; ; )
+        {
+            xBlocked = pdFALSE;
+
+            vTaskSuspendAll();
+            {
+                prvEnterSlowPath( pxLock );
+
+                /* Writers are preferred, so a reader cannot take the lock
+                 * while a writer is waiting even if only readers hold it. */
+                if( ( ( pxLock->ulState & rwlockWRITER_BIT ) == 0U ) &&
+                    ( listLIST_IS_EMPTY( &( pxLock->xTasksWaitingToWrite ) ) != pdFALSE ) )
+                {
+                    ( pxLock->ulState )++;
+                    traceRW_LOCK_TAKE_READ( pxLock );
+                    xReturn = pdPASS;
+                }
+                else if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+                {
+                    if( ( pxLock->ulState & rwlockWRITER_BIT ) != 0U )
+                    {
+                        taskENTER_CRITICAL();
+                        {
+                            xInheritanceOccurred |= xTaskPriorityInherit( pxLock->xWriter );
+                        }
+                        taskEXIT_CRITICAL();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    traceBLOCKING_ON_RW_LOCK_TAKE_READ( pxLock );
+                    vTaskPlaceOnEventList( &( pxLock->xTasksWaitingToRead ), xTicksToWait );
+                    xBlocked = pdTRUE;
+                }
+                else
+                {
+                    if( ( xInheritanceOccurred != pdFALSE ) &&
+                        ( ( pxLock->ulState & rwlockWRITER_BIT ) != 0U ) &&
+                        ( ( pxLock->ucFlags & rwlockFLAGS_WRITER_PENDING ) == 0U ) )
+                    {
+                        taskENTER_CRITICAL();
+                        {
+                            vTaskPriorityDisinheritAfterTimeout( pxLock->xWriter, prvGetHighestWaitingPriority( pxLock ) );
+                        }
+                        taskEXIT_CRITICAL();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    traceRW_LOCK_TAKE_READ_FAILED( pxLock );
+                    xTimedOut = pdTRUE;
+                }
+
+                prvExitSlowPath( pxLock );
+            }
+
+            if( xTaskResumeAll() == pdFALSE )
+            {
+                if( xBlocked != pdFALSE )
+                {
+                    taskYIELD_WITHIN_API();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            if( ( xReturn == pdPASS ) || ( xTimedOut != pdFALSE ) )
+            {
+                break;
+            }
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvGiveReadContended( RWLock_t * const pxLock )
+    {
+        BaseType_t xReturn = pdPASS;
+
+        vTaskSuspendAll();
+        {
+            prvEnterSlowPath( pxLock );
+
+            if( ( pxLock->ulState & rwlockREADER_COUNT_MASK ) != 0U )
+            {
+                traceRW_LOCK_GIVE_READ( pxLock );
+                ( pxLock->ulState )--;
+
+                /* The last reader out lets a waiting writer in. */
+                if( ( pxLock->ulState & rwlockREADER_COUNT_MASK ) == 0U )
+                {
+                    prvHandOverToWriter( pxLock );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                /* No task held the lock for reading. */
+                xReturn = pdFAIL;
+            }
+
+            prvExitSlowPath( pxLock );
+        }
+        ( void ) xTaskResumeAll();
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvEnterSlowPath( RWLock_t * const pxLock )
+    {
+        uint32_t ulState;
+
+        do
+        {
+            ulState = pxLock->ulState;
+        } while( Atomic_CompareAndSwap_u32( &( pxLock->ulState ), ulState | rwlockSLOW_PATH_BIT, ulState ) != ATOMIC_COMPARE_AND_SWAP_SUCCESS );
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvExitSlowPath( RWLock_t * const pxLock )
+    {
+        if( ( listLIST_IS_EMPTY( &( pxLock->xTasksWaitingToRead ) ) != pdFALSE ) &&
+            ( listLIST_IS_EMPTY( &( pxLock->xTasksWaitingToWrite ) ) != pdFALSE ) )
+        {
+            pxLock->ulState &= ~rwlockSLOW_PATH_BIT;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvHandOverToWriter( RWLock_t * const pxLock )
+    {
+        if( listLIST_IS_EMPTY( &( pxLock->xTasksWaitingToWrite ) ) == pdFALSE )
+        {
+            /* The unblocked task finds itself recorded as the writer when it
+             * runs, so no other task can take the lock in the meantime.  It
+             * accounts for the lock in its held mutex count at that point,
+             * which is why the lock is marked as pending until then. */
+            pxLock->xWriter = ( TaskHandle_t ) listGET_OWNER_OF_HEAD_ENTRY( &( pxLock->xTasksWaitingToWrite ) );
+            pxLock->ulState |= rwlockWRITER_BIT;
+            pxLock->ucFlags |= rwlockFLAGS_WRITER_PENDING;
+
+            /* The scheduler is suspended, so xTaskResumeAll() performs any
+             * context switch the unblocked task needs. */
+            ( void ) xTaskRemoveFromEventList( &( pxLock->xTasksWaitingToWrite ) );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvUnblockAllReaders( RWLock_t * const pxLock )
+    {
+        while( listLIST_IS_EMPTY( &( pxLock->xTasksWaitingToRead ) ) == pdFALSE )
+        {
+            ( void ) xTaskRemoveFromEventList( &( pxLock->xTasksWaitingToRead ) );
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static UBaseType_t prvGetHighestWaitingPriority( const RWLock_t * const pxLock )
+    {
+        UBaseType_t uxHighestPriorityOfWaitingTasks = tskIDLE_PRIORITY;
+        UBaseType_t uxPriority;
+
+        /* The waiting tasks are held in priority order, and the item value of
+         * each task's event list item is configMAX_PRIORITIES minus the task's
+         * priority. */
+        if( listCURRENT_LIST_LENGTH( &( pxLock->xTasksWaitingToRead ) ) > 0U )
+        {
+            uxHighestPriorityOfWaitingTasks = ( UBaseType_t ) ( ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) listGET_ITEM_VALUE_OF_HEAD_ENTRY( &( pxLock->xTasksWaitingToRead ) ) );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( listCURRENT_LIST_LENGTH( &( pxLock->xTasksWaitingToWrite ) ) > 0U )
+        {
+            uxPriority = ( UBaseType_t ) ( ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) listGET_ITEM_VALUE_OF_HEAD_ENTRY( &( pxLock->xTasksWaitingToWrite ) ) );
+
+            if( uxPriority > uxHighestPriorityOfWaitingTasks )
+            {
+                uxHighestPriorityOfWaitingTasks = uxPriority;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return uxHighestPriorityOfWaitingTasks;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvInitialiseNewRWLock( RWLock_t * const pxLock,
+                                        uint8_t ucFlags )
+    {
+        pxLock->ulState = 0U;
+        pxLock->xWriter = NULL;
+        vListInitialise( &( pxLock->xTasksWaitingToRead ) );
+        vListInitialise( &( pxLock->xTasksWaitingToWrite ) );
+        pxLock->ucFlags = ucFlags;
+
+        traceRW_LOCK_CREATE( pxLock );
+    }
+
+/* This entire source file will be skipped if the application is not configured
+ * to include reader-writer locks.  If you want to include reader-writer locks
+ * then ensure configUSE_RW_LOCKS is set to 1 in FreeRTOSConfig.h. */
+#endif /* configUSE_RW_LOCKS == 1 */
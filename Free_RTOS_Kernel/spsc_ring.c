@@ -0,0 +1,487 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/* Standard includes. */
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "atomic.h"
+#include "spsc_ring.h"
+
+/* The MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+ * for the header files above, but not in this file, in order to generate the
+ * correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* This entire source file will be skipped if the application is not configured
+ * to include SPSC rings.  This #if is closed at the very bottom of this file. */
+#if ( configUSE_SPSC_RINGS == 1 )
+
+    #if ( configUSE_TASK_NOTIFICATIONS != 1 )
+        #error configUSE_TASK_NOTIFICATIONS must be set to 1 to build spsc_ring.c
+    #endif
+
+    #if ( configSPSC_RING_NOTIFICATION_INDEX >= configTASK_NOTIFICATION_ARRAY_ENTRIES )
+        #error configSPSC_RING_NOTIFICATION_INDEX must be less than configTASK_NOTIFICATION_ARRAY_ENTRIES
+    #endif
+
+/* Bits stored in the ucFlags member of the ring structure. */
+    #define spscFLAGS_IS_STATICALLY_ALLOCATED    ( ( uint8_t ) 1 )
+
+/*
+ * The head and tail are free running counters: the number of items in the
+ * ring is always ( ulHead - ulTail ), even after the counters wrap, and the
+ * slot an index refers to is ( index & ulIndexMask ).  Only the producer writes
+ * ulHead and only the consumer writes ulTail, so neither needs a critical
+ * section to update.
+ */
+    typedef struct SpscRingDef_t
+    {
+        volatile uint32_t ulHead;        /**< Count of items ever written.  Written by the producer only. */
+        volatile uint32_t ulTail;        /**< Count of items ever read.  Written by the consumer only. */
+        uint32_t ulIndexMask;            /**< The number of items the ring can hold, minus one. */
+        size_t xItemSize;                /**< The size of each item in bytes. */
+        uint8_t * pucStorage;            /**< The ring's storage area. */
+        void * volatile pvTaskToNotify;  /**< Handle of the consumer while it is about to block, or is blocked, on an empty ring.  NULL otherwise. */
+        uint8_t ucFlags;
+    } SpscRing_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Called by both the task and interrupt level send functions once an item has
+ * been published.  Returns the consumer's handle if the consumer is blocked, or
+ * about to block, waiting for data, otherwise NULL.  The handle is cleared
+ * atomically so the consumer is notified exactly once.
+ */
+    static TaskHandle_t prvTakeTaskToNotify( SpscRing_t * const pxRing ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called by both the task and interrupt level send functions to copy an item
+ * into the ring and publish it.
+ */
+    static BaseType_t prvWriteItem( SpscRing_t * const pxRing,
+                                    const void * pvItem ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called by both the static and dynamic create functions to initialise the
+ * ring structure.
+ */
+    static void prvInitialiseNewRing( SpscRing_t * const pxRing,
+                                      uint8_t * const pucStorage,
+                                      size_t xItemCount,
+                                      size_t xItemSize,
+                                      uint8_t ucFlags ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+    #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+        SpscRingHandle_t xSpscRingCreate( size_t xItemCount,
+                                          size_t xItemSize )
+        {
+            SpscRing_t * pxRing = NULL;
+            uint8_t * pucAllocatedMemory;
+
+            traceENTER_xSpscRingCreate( xItemCount, xItemSize );
+
+            /* The ring length must be a non zero power of two, and the
+             * storage size must not overflow. */
+            configASSERT( xItemCount > ( size_t ) 0 );
+            configASSERT( ( xItemCount & ( xItemCount - ( size_t ) 1 ) ) == ( size_t ) 0 );
+            configASSERT( xItemSize > ( size_t ) 0 );
+
+            if( ( xItemCount > ( size_t ) 0 ) &&
+                ( xItemSize > ( size_t ) 0 ) &&
+                ( ( ( SIZE_MAX - sizeof( SpscRing_t ) ) / xItemCount ) >= xItemSize ) )
+            {
+                /* The structure and the storage area are allocated in one
+                 * block, the storage area immediately following the
+                 * structure. */
+                /* MISRA Ref 11.5.1 [Malloc memory assignment] */
+                /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+                /* coverity[misra_c_2012_rule_11_5_violation] */
+                pucAllocatedMemory = ( uint8_t * ) pvPortMallocObject( sizeof( SpscRing_t ) + ( xItemCount * xItemSize ) );
+
+                if( pucAllocatedMemory != NULL )
+                {
+                    /* MISRA Ref 11.3.1 [Misaligned access] */
+                    /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-113 */
+                    /* coverity[misra_c_2012_rule_11_3_violation] */
+                    pxRing = ( SpscRing_t * ) pucAllocatedMemory;
+                    prvInitialiseNewRing( pxRing, pucAllocatedMemory + sizeof( SpscRing_t ), xItemCount, xItemSize, 0 );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            traceRETURN_xSpscRingCreate( pxRing );
+
+            return pxRing;
+        }
+
+    #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+    #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+        SpscRingHandle_t xSpscRingCreateStatic( size_t xItemCount,
+                                                size_t xItemSize,
+                                                uint8_t * const pucRingStorageArea,
+                                                StaticSpscRing_t * const pxStaticRing )
+        {
+            SpscRing_t * pxRing = NULL;
+
+            traceENTER_xSpscRingCreateStatic( xItemCount, xItemSize, pucRingStorageArea, pxStaticRing );
+
+            configASSERT( pucRingStorageArea );
+            configASSERT( pxStaticRing );
+            configASSERT( xItemCount > ( size_t ) 0 );
+            configASSERT( ( xItemCount & ( xItemCount - ( size_t ) 1 ) ) == ( size_t ) 0 );
+            configASSERT( xItemSize > ( size_t ) 0 );
+
+            #if ( configASSERT_DEFINED == 1 )
+            {
+                /* Sanity check that the size of the structure used to declare a
+                 * variable of type StaticSpscRing_t equals the size of the real
+                 * ring structure. */
+                volatile size_t xSize = sizeof( StaticSpscRing_t );
+                configASSERT( xSize == sizeof( SpscRing_t ) );
+            }
+            #endif /* configASSERT_DEFINED */
+
+            if( ( pucRingStorageArea != NULL ) && ( pxStaticRing != NULL ) )
+            {
+                /* MISRA Ref 11.3.1 [Misaligned access] */
+                /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-113 */
+                /* coverity[misra_c_2012_rule_11_3_violation] */
+                pxRing = ( SpscRing_t * ) pxStaticRing;
+                prvInitialiseNewRing( pxRing, pucRingStorageArea, xItemCount, xItemSize, spscFLAGS_IS_STATICALLY_ALLOCATED );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            traceRETURN_xSpscRingCreateStatic( pxRing );
+
+            return pxRing;
+        }
+
+    #endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+    void vSpscRingDelete( SpscRingHandle_t xRing )
+    {
+        SpscRing_t * pxRing = xRing;
+
+        traceENTER_vSpscRingDelete( xRing );
+
+        configASSERT( pxRing );
+
+        /* Deleting a ring while the consumer is blocked on it would leave the
+         * consumer waiting for a notification that will never arrive. */
+        configASSERT( pxRing->pvTaskToNotify == NULL );
+
+        if( ( pxRing->ucFlags & spscFLAGS_IS_STATICALLY_ALLOCATED ) == ( uint8_t ) 0 )
+        {
+            #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+            {
+                vPortFreeObject( ( void * ) pxRing );
+            }
+            #endif
+        }
+        else
+        {
+            /* The structure was statically allocated, so just clear it. */
+            ( void ) memset( pxRing, 0x00, sizeof( SpscRing_t ) );
+        }
+
+        traceRETURN_vSpscRingDelete();
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xSpscRingSendFromISR( SpscRingHandle_t xRing,
+                                     const void * pvItem,
+                                     BaseType_t * const pxHigherPriorityTaskWoken )
+    {
+        SpscRing_t * const pxRing = xRing;
+        TaskHandle_t xTaskToNotify;
+        BaseType_t xReturn;
+
+        traceENTER_xSpscRingSendFromISR( xRing, pvItem, pxHigherPriorityTaskWoken );
+
+        configASSERT( pxRing );
+        configASSERT( pvItem );
+
+        xReturn = prvWriteItem( pxRing, pvItem );
+
+        if( xReturn == pdPASS )
+        {
+            xTaskToNotify = prvTakeTaskToNotify( pxRing );
+
+            if( xTaskToNotify != NULL )
+            {
+                vTaskNotifyGiveIndexedFromISR( xTaskToNotify, configSPSC_RING_NOTIFICATION_INDEX, pxHigherPriorityTaskWoken );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_xSpscRingSendFromISR( xReturn );
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xSpscRingSend( SpscRingHandle_t xRing,
+                              const void * pvItem )
+    {
+        SpscRing_t * const pxRing = xRing;
+        TaskHandle_t xTaskToNotify;
+        BaseType_t xReturn;
+
+        traceENTER_xSpscRingSend( xRing, pvItem );
+
+        configASSERT( pxRing );
+        configASSERT( pvItem );
+
+        xReturn = prvWriteItem( pxRing, pvItem );
+
+        if( xReturn == pdPASS )
+        {
+            xTaskToNotify = prvTakeTaskToNotify( pxRing );
+
+            if( xTaskToNotify != NULL )
+            {
+                ( void ) xTaskNotifyGiveIndexed( xTaskToNotify, configSPSC_RING_NOTIFICATION_INDEX );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_xSpscRingSend( xReturn );
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xSpscRingReceive( SpscRingHandle_t xRing,
+                                 void * pvBuffer,
+                                 TickType_t xTicksToWait )
+    {
+        SpscRing_t * const pxRing = xRing;
+        TimeOut_t xTimeOut;
+        uint32_t ulTail;
+        BaseType_t xReturn = errQUEUE_EMPTY;
+
+        traceENTER_xSpscRingReceive( xRing, pvBuffer, xTicksToWait );
+
+        configASSERT( pxRing );
+        configASSERT( pvBuffer );
+
+        vTaskSetTimeOutState( &xTimeOut );
+
+        /* Only the consumer writes ulTail, so it can be read once outside the
+         * loop. */
+        ulTail = pxRing->ulTail;
+
+        for( ; ; )
+        {
+            if( pxRing->ulHead != ulTail )
+            {
+                /* Ensure the item is not read before the head index that
+                 * published it. */
+                portMEMORY_BARRIER();
+
+                ( void ) memcpy( pvBuffer, ( const void * ) &( pxRing->pucStorage[ ( ulTail & pxRing->ulIndexMask ) * pxRing->xItemSize ] ), pxRing->xItemSize );
+
+                /* Ensure the item has been copied out before the slot is
+                 * handed back to the producer. */
+                portMEMORY_BARRIER();
+                pxRing->ulTail = ulTail + 1U;
+
+                xReturn = pdPASS;
+                break;
+            }
+
+            if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) != pdFALSE )
+            {
+                /* The ring is empty and the block time has expired (or was
+                 * zero). */
+                break;
+            }
+
+            /* Tell the producer a notification is required, then check the
+             * ring again before blocking in case an item was published before
+             * the producer could see pvTaskToNotify. */
+            pxRing->pvTaskToNotify = ( void * ) xTaskGetCurrentTaskHandle();
+            portMEMORY_BARRIER();
+
+            if( pxRing->ulHead == ulTail )
+            {
+                traceBLOCKING_ON_SPSC_RING_RECEIVE( xRing );
+                ( void ) ulTaskNotifyTakeIndexed( configSPSC_RING_NOTIFICATION_INDEX, pdTRUE, xTicksToWait );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            /* Withdraw the request.  If the producer already took it a
+             * notification may be left pending, which is harmless as the next
+             * wait always re-checks the ring before and after blocking. */
+            ( void ) Atomic_SwapPointers_p32( &( pxRing->pvTaskToNotify ), NULL );
+        }
+
+        traceRETURN_xSpscRingReceive( xReturn );
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    size_t xSpscRingItemsWaiting( SpscRingHandle_t xRing )
+    {
+        const SpscRing_t * const pxRing = xRing;
+        size_t xReturn;
+
+        traceENTER_xSpscRingItemsWaiting( xRing );
+
+        configASSERT( pxRing );
+
+        /* Unsigned arithmetic gives the right answer even after the free
+         * running counters wrap. */
+        xReturn = ( size_t ) ( pxRing->ulHead - pxRing->ulTail );
+
+        traceRETURN_xSpscRingItemsWaiting( xReturn );
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvWriteItem( SpscRing_t * const pxRing,
+                                    const void * pvItem )
+    {
+        /* Only the producer writes ulHead, so the local copy stays valid. */
+        const uint32_t ulHead = pxRing->ulHead;
+        BaseType_t xReturn;
+
+        if( ( ulHead - pxRing->ulTail ) <= pxRing->ulIndexMask )
+        {
+            /* Ensure the slot is not overwritten before the consumer's tail
+             * index that released it was read. */
+            portMEMORY_BARRIER();
+
+            ( void ) memcpy( ( void * ) &( pxRing->pucStorage[ ( ulHead & pxRing->ulIndexMask ) * pxRing->xItemSize ] ), pvItem, pxRing->xItemSize );
+
+            /* Ensure the item is in the ring before it is published. */
+            portMEMORY_BARRIER();
+            pxRing->ulHead = ulHead + 1U;
+
+            /* Ensure the head is published before pvTaskToNotify is read -
+             * the mirror of the consumer storing pvTaskToNotify before it
+             * re-reads the head. */
+            portMEMORY_BARRIER();
+
+            traceSPSC_RING_SEND( pxRing );
+            xReturn = pdPASS;
+        }
+        else
+        {
+            traceSPSC_RING_SEND_FAILED( pxRing );
+            xReturn = errQUEUE_FULL;
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static TaskHandle_t prvTakeTaskToNotify( SpscRing_t * const pxRing )
+    {
+        TaskHandle_t xReturn = NULL;
+
+        /* The plain read keeps the common case, where the consumer is busy,
+         * free of any interrupt masking.  The atomic swap is only used when
+         * the consumer is, or is about to be, blocked. */
+        if( pxRing->pvTaskToNotify != NULL )
+        {
+            xReturn = ( TaskHandle_t ) Atomic_SwapPointers_p32( &( pxRing->pvTaskToNotify ), NULL );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvInitialiseNewRing( SpscRing_t * const pxRing,
+                                      uint8_t * const pucStorage,
+                                      size_t xItemCount,
+                                      size_t xItemSize,
+                                      uint8_t ucFlags )
+    {
+        ( void ) memset( ( void * ) pxRing, 0x00, sizeof( SpscRing_t ) );
+        pxRing->pucStorage = pucStorage;
+        pxRing->ulIndexMask = ( uint32_t ) ( xItemCount - ( size_t ) 1 );
+        pxRing->xItemSize = xItemSize;
+        pxRing->ucFlags = ucFlags;
+
+        traceSPSC_RING_CREATE( pxRing );
+    }
+
+/* This entire source file will be skipped if the application is not configured
+ * to include SPSC rings.  If you want to include SPSC rings then ensure
+ * configUSE_SPSC_RINGS is set to 1 in FreeRTOSConfig.h. */
+#endif /* configUSE_SPSC_RINGS == 1 */
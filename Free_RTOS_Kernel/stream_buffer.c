@@ -225,6 +225,7 @@
     #define sbFLAGS_IS_MESSAGE_BUFFER          ( ( uint8_t ) 1 ) /* Set if the stream buffer was created as a message buffer, in which case it holds discrete messages rather than a stream. */
     #define sbFLAGS_IS_STATICALLY_ALLOCATED    ( ( uint8_t ) 2 ) /* Set if the stream buffer was created using statically allocated memory. */
     #define sbFLAGS_IS_BATCHING_BUFFER         ( ( uint8_t ) 4 ) /* Set if the stream buffer was created as a batching buffer, meaning the receiver task will only unblock when the trigger level exceededs. */
+    #define sbFLAGS_IS_EXTERNALLY_INDEXED      ( ( uint8_t ) 8 ) /* Set if the stream buffer's storage area is supplied by, and its head or tail advanced by, hardware outside the kernel. */
 
 /*-----------------------------------------------------------*/
 
@@ -314,6 +315,77 @@ static size_t prvReadBytesFromBuffer( StreamBuffer_t * pxStreamBuffer,
                                       size_t xCount,
                                       size_t xTail ) PRIVILEGED_FUNCTION;
 
+#if ( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+
+/*
+ * Returns the number of bytes that can be written to the buffer's data storage
+ * area starting at xHead without wrapping.  If ppvData is not NULL then
+ * *ppvData is set to point to pucBuffer[ xHead ].
+ */
+    static size_t prvContiguousSpaceAtHead( const StreamBuffer_t * const pxStreamBuffer,
+                                            void ** ppvData ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the number of bytes that can be read from the buffer's data storage
+ * area starting at xTail without wrapping.  If ppvData is not NULL then
+ * *ppvData is set to point to pucBuffer[ xTail ].
+ */
+    static size_t prvContiguousBytesAtTail( const StreamBuffer_t * const pxStreamBuffer,
+                                            void ** ppvData ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns xIndex moved on by xCount bytes, wrapping back to the start of the
+ * buffer's data storage area if necessary.
+ */
+    static size_t prvAdvanceIndex( const StreamBuffer_t * const pxStreamBuffer,
+                                   size_t xIndex,
+                                   size_t xCount ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_STREAM_BUFFER_ZERO_COPY */
+
+#if ( configUSE_STREAM_BUFFER_EXTERNAL_INDEX == 1 )
+
+/*
+ * Sets *pxIndex, which is either the buffer's xHead or xTail, to the position
+ * reported by the hardware and returns the number of bytes it moved forward.
+ */
+    static size_t prvMoveExternalIndex( StreamBuffer_t * const pxStreamBuffer,
+                                        volatile size_t * const pxIndex,
+                                        size_t xNewIndex ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_STREAM_BUFFER_EXTERNAL_INDEX */
+
+#if ( configUSE_STREAM_BUFFER_VECTORED_IO == 1 )
+
+/*
+ * Returns the total number of bytes described by an array of vectors.
+ */
+    static size_t prvVectorsLength( const StreamBufferVector_t * pxVectors,
+                                    size_t xVectorCount ) PRIVILEGED_FUNCTION;
+
+/*
+ * The vectored equivalent of prvWriteMessageToBuffer().  The segments are
+ * written back to back and xHead is only updated once all of them have been
+ * copied, so a reader never sees part of a message.
+ */
+    static size_t prvWriteVectoredMessageToBuffer( StreamBuffer_t * const pxStreamBuffer,
+                                                   const StreamBufferVector_t * pxVectors,
+                                                   size_t xVectorCount,
+                                                   size_t xDataLengthBytes,
+                                                   size_t xSpace,
+                                                   size_t xRequiredSpace ) PRIVILEGED_FUNCTION;
+
+/*
+ * The vectored equivalent of prvReadMessageFromBuffer().  Consecutive bytes
+ * are scattered across the segments in order.
+ */
+    static size_t prvReadVectoredMessageFromBuffer( StreamBuffer_t * pxStreamBuffer,
+                                                    const StreamBufferVector_t * pxVectors,
+                                                    size_t xVectorCount,
+                                                    size_t xBytesAvailable ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_STREAM_BUFFER_VECTORED_IO */
+
 /*
  * Called by both pxStreamBufferCreate() and pxStreamBufferCreateStatic() to
  * initialise the members of the newly created stream buffer structure.
@@ -382,7 +454,7 @@ static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
         if( xBufferSizeBytes < ( xBufferSizeBytes + 1U + sizeof( StreamBuffer_t ) ) )
         {
             xBufferSizeBytes++;
-            pvAllocatedMemory = pvPortMalloc( xBufferSizeBytes + sizeof( StreamBuffer_t ) );
+            pvAllocatedMemory = pvPortMallocObject( xBufferSizeBytes + sizeof( StreamBuffer_t ) );
         }
         else
         {
@@ -570,7 +642,7 @@ void vStreamBufferDelete( StreamBufferHandle_t xStreamBuffer )
         {
             /* Both the structure and the buffer were allocated using a single call
             * to pvPortMalloc(), hence only one call to vPortFree() is required. */
-            vPortFree( ( void * ) pxStreamBuffer );
+            vPortFreeObject( ( void * ) pxStreamBuffer );
         }
         #else
         {
@@ -1328,6 +1400,1149 @@ static size_t prvReadMessageFromBuffer( StreamBuffer_t * pxStreamBuffer,
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+
+    size_t xStreamBufferReserve( StreamBufferHandle_t xStreamBuffer,
+                                 void ** ppvData,
+                                 TickType_t xTicksToWait )
+    {
+        StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+        size_t xReturn;
+        TimeOut_t xTimeOut;
+
+        traceENTER_xStreamBufferReserve( xStreamBuffer, ppvData, xTicksToWait );
+
+        configASSERT( ppvData );
+        configASSERT( pxStreamBuffer );
+
+        /* Message buffers store a length in front of each message, so cannot
+         * be written in place. */
+        configASSERT( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) == ( uint8_t ) 0 );
+
+        if( xTicksToWait != ( TickType_t ) 0 )
+        {
+            vTaskSetTimeOutState( &xTimeOut );
+
+            do
+            {
+                /* Wait until there is at least one free byte in the buffer. */
+                taskENTER_CRITICAL();
+                {
+                    if( xStreamBufferSpacesAvailable( pxStreamBuffer ) == ( size_t ) 0 )
+                    {
+                        /* Clear notification state as going to wait for space. */
+                        ( void ) xTaskNotifyStateClearIndexed( NULL, pxStreamBuffer->uxNotificationIndex );
+
+                        /* Should only be one writer. */
+                        configASSERT( pxStreamBuffer->xTaskWaitingToSend == NULL );
+                        pxStreamBuffer->xTaskWaitingToSend = xTaskGetCurrentTaskHandle();
+                    }
+                    else
+                    {
+                        taskEXIT_CRITICAL();
+                        break;
+                    }
+                }
+                taskEXIT_CRITICAL();
+
+                traceBLOCKING_ON_STREAM_BUFFER_SEND( xStreamBuffer );
+                ( void ) xTaskNotifyWaitIndexed( pxStreamBuffer->uxNotificationIndex, ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
+                pxStreamBuffer->xTaskWaitingToSend = NULL;
+            } while( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        xReturn = prvContiguousSpaceAtHead( pxStreamBuffer, ppvData );
+
+        traceRETURN_xStreamBufferReserve( xReturn );
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    size_t xStreamBufferReserveFromISR( StreamBufferHandle_t xStreamBuffer,
+                                        void ** ppvData )
+    {
+        StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+        size_t xReturn;
+
+        traceENTER_xStreamBufferReserveFromISR( xStreamBuffer, ppvData );
+
+        configASSERT( ppvData );
+        configASSERT( pxStreamBuffer );
+        configASSERT( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) == ( uint8_t ) 0 );
+
+        xReturn = prvContiguousSpaceAtHead( pxStreamBuffer, ppvData );
+
+        traceRETURN_xStreamBufferReserveFromISR( xReturn );
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    void vStreamBufferCommit( StreamBufferHandle_t xStreamBuffer,
+                              size_t xBytesWritten )
+    {
+        StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+
+        traceENTER_vStreamBufferCommit( xStreamBuffer, xBytesWritten );
+
+        configASSERT( pxStreamBuffer );
+
+        /* Only the writer moves xHead, so the space at the head can only have
+         * grown since it was reserved. */
+        configASSERT( xBytesWritten <= prvContiguousSpaceAtHead( pxStreamBuffer, NULL ) );
+
+        if( xBytesWritten > ( size_t ) 0 )
+        {
+            pxStreamBuffer->xHead = prvAdvanceIndex( pxStreamBuffer, pxStreamBuffer->xHead, xBytesWritten );
+
+            traceSTREAM_BUFFER_SEND( xStreamBuffer, xBytesWritten );
+
+            /* Was a task waiting for the data? */
+            if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
+            {
+                prvSEND_COMPLETED( pxStreamBuffer );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_vStreamBufferCommit();
+    }
+/*-----------------------------------------------------------*/
+
+    void vStreamBufferCommitFromISR( StreamBufferHandle_t xStreamBuffer,
+                                     size_t xBytesWritten,
+                                     BaseType_t * const pxHigherPriorityTaskWoken )
+    {
+        StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+
+        traceENTER_vStreamBufferCommitFromISR( xStreamBuffer, xBytesWritten, pxHigherPriorityTaskWoken );
+
+        configASSERT( pxStreamBuffer );
+        configASSERT( xBytesWritten <= prvContiguousSpaceAtHead( pxStreamBuffer, NULL ) );
+
+        if( xBytesWritten > ( size_t ) 0 )
+        {
+            pxStreamBuffer->xHead = prvAdvanceIndex( pxStreamBuffer, pxStreamBuffer->xHead, xBytesWritten );
+
+            /* Was a task waiting for the data? */
+            if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
+            {
+                /* MISRA Ref 4.7.1 [Return value shall be checked] */
+                /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#dir-47 */
+                /* coverity[misra_c_2012_directive_4_7_violation] */
+                prvSEND_COMPLETE_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceSTREAM_BUFFER_SEND_FROM_ISR( xStreamBuffer, xBytesWritten );
+        traceRETURN_vStreamBufferCommitFromISR();
+    }
+/*-----------------------------------------------------------*/
+
+    size_t xStreamBufferPeek( StreamBufferHandle_t xStreamBuffer,
+                              void ** ppvData,
+                              TickType_t xTicksToWait )
+    {
+        StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+        size_t xReturn = 0, xBytesAvailable, xMinimumBytes;
+
+        traceENTER_xStreamBufferPeek( xStreamBuffer, ppvData, xTicksToWait );
+
+        configASSERT( ppvData );
+        configASSERT( pxStreamBuffer );
+
+        /* Message buffers store a length in front of each message, so cannot
+         * be read in place. */
+        configASSERT( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) == ( uint8_t ) 0 );
+
+        /* As with xStreamBufferReceive(), a batching buffer only reports data
+         * once it holds more than the trigger level. */
+        if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_BATCHING_BUFFER ) != ( uint8_t ) 0 )
+        {
+            xMinimumBytes = pxStreamBuffer->xTriggerLevelBytes;
+        }
+        else
+        {
+            xMinimumBytes = 0;
+        }
+
+        if( xTicksToWait != ( TickType_t ) 0 )
+        {
+            /* Checking if there is data and clearing the notification state must be
+             * performed atomically. */
+            taskENTER_CRITICAL();
+            {
+                xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+
+                if( xBytesAvailable <= xMinimumBytes )
+                {
+                    /* Clear notification state as going to wait for data. */
+                    ( void ) xTaskNotifyStateClearIndexed( NULL, pxStreamBuffer->uxNotificationIndex );
+
+                    /* Should only be one reader. */
+                    configASSERT( pxStreamBuffer->xTaskWaitingToReceive == NULL );
+                    pxStreamBuffer->xTaskWaitingToReceive = xTaskGetCurrentTaskHandle();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            taskEXIT_CRITICAL();
+
+            if( xBytesAvailable <= xMinimumBytes )
+            {
+                /* Wait for data to be available. */
+                traceBLOCKING_ON_STREAM_BUFFER_RECEIVE( xStreamBuffer );
+                ( void ) xTaskNotifyWaitIndexed( pxStreamBuffer->uxNotificationIndex, ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
+                pxStreamBuffer->xTaskWaitingToReceive = NULL;
+
+                /* Recheck the data available after blocking. */
+                xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+        }
+
+        if( xBytesAvailable > xMinimumBytes )
+        {
+            xReturn = prvContiguousBytesAtTail( pxStreamBuffer, ppvData );
+        }
+        else
+        {
+            *ppvData = NULL;
+        }
+
+        traceRETURN_xStreamBufferPeek( xReturn );
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    size_t xStreamBufferPeekFromISR( StreamBufferHandle_t xStreamBuffer,
+                                     void ** ppvData )
+    {
+        StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+        size_t xReturn = 0, xMinimumBytes;
+
+        traceENTER_xStreamBufferPeekFromISR( xStreamBuffer, ppvData );
+
+        configASSERT( ppvData );
+        configASSERT( pxStreamBuffer );
+        configASSERT( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) == ( uint8_t ) 0 );
+
+        if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_BATCHING_BUFFER ) != ( uint8_t ) 0 )
+        {
+            xMinimumBytes = pxStreamBuffer->xTriggerLevelBytes;
+        }
+        else
+        {
+            xMinimumBytes = 0;
+        }
+
+        if( prvBytesInBuffer( pxStreamBuffer ) > xMinimumBytes )
+        {
+            xReturn = prvContiguousBytesAtTail( pxStreamBuffer, ppvData );
+        }
+        else
+        {
+            *ppvData = NULL;
+        }
+
+        traceRETURN_xStreamBufferPeekFromISR( xReturn );
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    void vStreamBufferConsume( StreamBufferHandle_t xStreamBuffer,
+                               size_t xBytesRead )
+    {
+        StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+
+        traceENTER_vStreamBufferConsume( xStreamBuffer, xBytesRead );
+
+        configASSERT( pxStreamBuffer );
+
+        /* Only the reader moves xTail, so the data at the tail can only have
+         * grown since it was peeked. */
+        configASSERT( xBytesRead <= prvContiguousBytesAtTail( pxStreamBuffer, NULL ) );
+
+        if( xBytesRead > ( size_t ) 0 )
+        {
+            pxStreamBuffer->xTail = prvAdvanceIndex( pxStreamBuffer, pxStreamBuffer->xTail, xBytesRead );
+
+            /* Was a task waiting for space in the buffer? */
+            traceSTREAM_BUFFER_RECEIVE( xStreamBuffer, xBytesRead );
+            prvRECEIVE_COMPLETED( xStreamBuffer );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_vStreamBufferConsume();
+    }
+/*-----------------------------------------------------------*/
+
+    void vStreamBufferConsumeFromISR( StreamBufferHandle_t xStreamBuffer,
+                                      size_t xBytesRead,
+                                      BaseType_t * const pxHigherPriorityTaskWoken )
+    {
+        StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+
+        traceENTER_vStreamBufferConsumeFromISR( xStreamBuffer, xBytesRead, pxHigherPriorityTaskWoken );
+
+        configASSERT( pxStreamBuffer );
+        configASSERT( xBytesRead <= prvContiguousBytesAtTail( pxStreamBuffer, NULL ) );
+
+        if( xBytesRead > ( size_t ) 0 )
+        {
+            pxStreamBuffer->xTail = prvAdvanceIndex( pxStreamBuffer, pxStreamBuffer->xTail, xBytesRead );
+
+            /* MISRA Ref 4.7.1 [Return value shall be checked] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#dir-47 */
+            /* coverity[misra_c_2012_directive_4_7_violation] */
+            prvRECEIVE_COMPLETED_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceSTREAM_BUFFER_RECEIVE_FROM_ISR( xStreamBuffer, xBytesRead );
+        traceRETURN_vStreamBufferConsumeFromISR();
+    }
+/*-----------------------------------------------------------*/
+
+    static size_t prvContiguousSpaceAtHead( const StreamBuffer_t * const pxStreamBuffer,
+                                            void ** ppvData )
+    {
+        const size_t xHead = pxStreamBuffer->xHead;
+
+        if( ppvData != NULL )
+        {
+            *ppvData = ( void * ) &( pxStreamBuffer->pucBuffer[ xHead ] );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* The free space may wrap, in which case only the part up to the end
+         * of the storage area is reported.  The rest becomes available once
+         * this part has been committed. */
+        return configMIN( xStreamBufferSpacesAvailable( ( StreamBufferHandle_t ) pxStreamBuffer ), pxStreamBuffer->xLength - xHead );
+    }
+/*-----------------------------------------------------------*/
+
+    static size_t prvContiguousBytesAtTail( const StreamBuffer_t * const pxStreamBuffer,
+                                            void ** ppvData )
+    {
+        const size_t xTail = pxStreamBuffer->xTail;
+
+        if( ppvData != NULL )
+        {
+            *ppvData = ( void * ) &( pxStreamBuffer->pucBuffer[ xTail ] );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return configMIN( prvBytesInBuffer( pxStreamBuffer ), pxStreamBuffer->xLength - xTail );
+    }
+/*-----------------------------------------------------------*/
+
+    static size_t prvAdvanceIndex( const StreamBuffer_t * const pxStreamBuffer,
+                                   size_t xIndex,
+                                   size_t xCount )
+    {
+        xIndex += xCount;
+
+        if( xIndex >= pxStreamBuffer->xLength )
+        {
+            xIndex -= pxStreamBuffer->xLength;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xIndex;
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* configUSE_STREAM_BUFFER_ZERO_COPY */
+
+#if ( configUSE_STREAM_BUFFER_EXTERNAL_INDEX == 1 )
+
+    #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+    StreamBufferHandle_t xStreamBufferCreateExternallyIndexed( size_t xBufferSizeBytes,
+                                                               size_t xTriggerLevelBytes,
+                                                               uint8_t * const pucStreamBufferStorageArea,
+                                                               StreamBufferCallbackFunction_t pxSendCompletedCallback,
+                                                               StreamBufferCallbackFunction_t pxReceiveCompletedCallback )
+    {
+        StreamBuffer_t * pxStreamBuffer;
+
+        traceENTER_xStreamBufferCreateExternallyIndexed( xBufferSizeBytes, xTriggerLevelBytes, pucStreamBufferStorageArea, pxSendCompletedCallback, pxReceiveCompletedCallback );
+
+        configASSERT( pucStreamBufferStorageArea );
+
+        /* The storage area is used exactly as supplied - it is not extended by
+         * one byte as in xStreamBufferGenericCreate() - so its length can match
+         * the ring size programmed into the hardware.  A ring of two bytes is
+         * the smallest that can hold any data. */
+        configASSERT( xBufferSizeBytes > ( size_t ) 1 );
+        configASSERT( xTriggerLevelBytes < xBufferSizeBytes );
+
+        /* A trigger level of 0 would cause a waiting task to unblock even when
+         * the buffer was empty. */
+        if( xTriggerLevelBytes == ( size_t ) 0 )
+        {
+            xTriggerLevelBytes = ( size_t ) 1;
+        }
+
+        /* Only the structure is allocated.  vStreamBufferDelete() frees it and
+         * leaves the application's storage area alone. */
+        /* MISRA Ref 11.5.1 [Malloc memory assignment] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+        /* coverity[misra_c_2012_rule_11_5_violation] */
+        pxStreamBuffer = ( StreamBuffer_t * ) pvPortMallocObject( sizeof( StreamBuffer_t ) );
+
+        if( ( pxStreamBuffer != NULL ) && ( pucStreamBufferStorageArea != NULL ) )
+        {
+            prvInitialiseNewStreamBuffer( pxStreamBuffer,
+                                          pucStreamBufferStorageArea,
+                                          xBufferSizeBytes,
+                                          xTriggerLevelBytes,
+                                          sbFLAGS_IS_EXTERNALLY_INDEXED,
+                                          pxSendCompletedCallback,
+                                          pxReceiveCompletedCallback );
+
+            traceSTREAM_BUFFER_CREATE( pxStreamBuffer, sbTYPE_STREAM_BUFFER );
+        }
+        else
+        {
+            vPortFreeObject( pxStreamBuffer );
+            pxStreamBuffer = NULL;
+            traceSTREAM_BUFFER_CREATE_FAILED( sbTYPE_STREAM_BUFFER );
+        }
+
+        traceRETURN_xStreamBufferCreateExternallyIndexed( pxStreamBuffer );
+
+        return pxStreamBuffer;
+    }
+
+    #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+    size_t xStreamBufferSetHead( StreamBufferHandle_t xStreamBuffer,
+                                 size_t xNewHead )
+    {
+        StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+        size_t xReturn;
+
+        traceENTER_xStreamBufferSetHead( xStreamBuffer, xNewHead );
+
+        configASSERT( pxStreamBuffer );
+        configASSERT( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_EXTERNALLY_INDEXED ) != ( uint8_t ) 0 );
+        configASSERT( xNewHead < pxStreamBuffer->xLength );
+
+        xReturn = prvMoveExternalIndex( pxStreamBuffer, &( pxStreamBuffer->xHead ), xNewHead );
+
+        if( xReturn > ( size_t ) 0 )
+        {
+            traceSTREAM_BUFFER_SEND( xStreamBuffer, xReturn );
+
+            /* Was a task waiting for the data? */
+            if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
+            {
+                prvSEND_COMPLETED( pxStreamBuffer );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_xStreamBufferSetHead( xReturn );
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    size_t xStreamBufferSetHeadFromISR( StreamBufferHandle_t xStreamBuffer,
+                                        size_t xNewHead,
+                                        BaseType_t * const pxHigherPriorityTaskWoken )
+    {
+        StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+        size_t xReturn;
+
+        traceENTER_xStreamBufferSetHeadFromISR( xStreamBuffer, xNewHead, pxHigherPriorityTaskWoken );
+
+        configASSERT( pxStreamBuffer );
+        configASSERT( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_EXTERNALLY_INDEXED ) != ( uint8_t ) 0 );
+        configASSERT( xNewHead < pxStreamBuffer->xLength );
+
+        xReturn = prvMoveExternalIndex( pxStreamBuffer, &( pxStreamBuffer->xHead ), xNewHead );
+
+        if( xReturn > ( size_t ) 0 )
+        {
+            /* Was a task waiting for the data? */
+            if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
+            {
+                /* MISRA Ref 4.7.1 [Return value shall be checked] */
+                /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#dir-47 */
+                /* coverity[misra_c_2012_directive_4_7_violation] */
+                prvSEND_COMPLETE_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceSTREAM_BUFFER_SEND_FROM_ISR( xStreamBuffer, xReturn );
+        traceRETURN_xStreamBufferSetHeadFromISR( xReturn );
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    size_t xStreamBufferSetTail( StreamBufferHandle_t xStreamBuffer,
+                                 size_t xNewTail )
+    {
+        StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+        size_t xReturn;
+
+        traceENTER_xStreamBufferSetTail( xStreamBuffer, xNewTail );
+
+        configASSERT( pxStreamBuffer );
+        configASSERT( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_EXTERNALLY_INDEXED ) != ( uint8_t ) 0 );
+        configASSERT( xNewTail < pxStreamBuffer->xLength );
+
+        xReturn = prvMoveExternalIndex( pxStreamBuffer, &( pxStreamBuffer->xTail ), xNewTail );
+
+        /* Was a task waiting for space in the buffer? */
+        if( xReturn > ( size_t ) 0 )
+        {
+            traceSTREAM_BUFFER_RECEIVE( xStreamBuffer, xReturn );
+            prvRECEIVE_COMPLETED( xStreamBuffer );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_xStreamBufferSetTail( xReturn );
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    size_t xStreamBufferSetTailFromISR( StreamBufferHandle_t xStreamBuffer,
+                                        size_t xNewTail,
+                                        BaseType_t * const pxHigherPriorityTaskWoken )
+    {
+        StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+        size_t xReturn;
+
+        traceENTER_xStreamBufferSetTailFromISR( xStreamBuffer, xNewTail, pxHigherPriorityTaskWoken );
+
+        configASSERT( pxStreamBuffer );
+        configASSERT( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_EXTERNALLY_INDEXED ) != ( uint8_t ) 0 );
+        configASSERT( xNewTail < pxStreamBuffer->xLength );
+
+        xReturn = prvMoveExternalIndex( pxStreamBuffer, &( pxStreamBuffer->xTail ), xNewTail );
+
+        if( xReturn > ( size_t ) 0 )
+        {
+            /* MISRA Ref 4.7.1 [Return value shall be checked] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#dir-47 */
+            /* coverity[misra_c_2012_directive_4_7_violation] */
+            prvRECEIVE_COMPLETED_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceSTREAM_BUFFER_RECEIVE_FROM_ISR( xStreamBuffer, xReturn );
+        traceRETURN_xStreamBufferSetTailFromISR( xReturn );
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static size_t prvMoveExternalIndex( StreamBuffer_t * const pxStreamBuffer,
+                                        volatile size_t * const pxIndex,
+                                        size_t xNewIndex )
+    {
+        size_t xDistance;
+
+        /* The hardware only ever moves forward, so the distance is measured
+         * forwards from the current index, wrapping at the end of the storage
+         * area. */
+        xDistance = ( pxStreamBuffer->xLength + xNewIndex ) - *pxIndex;
+
+        if( xDistance >= pxStreamBuffer->xLength )
+        {
+            xDistance -= pxStreamBuffer->xLength;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        *pxIndex = xNewIndex;
+
+        return xDistance;
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* configUSE_STREAM_BUFFER_EXTERNAL_INDEX */
+
+#if ( configUSE_STREAM_BUFFER_VECTORED_IO == 1 )
+
+    size_t xStreamBufferSendVectored( StreamBufferHandle_t xStreamBuffer,
+                                      const StreamBufferVector_t * pxVectors,
+                                      size_t xVectorCount,
+                                      TickType_t xTicksToWait )
+    {
+        StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+        size_t xReturn, xSpace = 0;
+        size_t xDataLengthBytes, xRequiredSpace;
+        TimeOut_t xTimeOut;
+        size_t xMaxReportedSpace;
+
+        traceENTER_xStreamBufferSendVectored( xStreamBuffer, pxVectors, xVectorCount, xTicksToWait );
+
+        configASSERT( pxVectors );
+        configASSERT( pxStreamBuffer );
+
+        xDataLengthBytes = prvVectorsLength( pxVectors, xVectorCount );
+        xRequiredSpace = xDataLengthBytes;
+
+        /* The maximum amount of space a stream buffer will ever report is its
+         * length minus 1. */
+        xMaxReportedSpace = pxStreamBuffer->xLength - ( size_t ) 1;
+
+        /* As in xStreamBufferSend(), a message buffer also needs space for
+         * the message length and must be able to take the whole message,
+         * whereas a stream buffer accepts as much as fits. */
+        if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+        {
+            xRequiredSpace += sbBYTES_TO_STORE_MESSAGE_LENGTH;
+
+            /* Overflow? */
+            configASSERT( xRequiredSpace > xDataLengthBytes );
+
+            if( xRequiredSpace > xMaxReportedSpace )
+            {
+                /* The message would not fit even if the entire buffer was
+                 * empty, so don't wait for space. */
+                xTicksToWait = ( TickType_t ) 0;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            if( xRequiredSpace > xMaxReportedSpace )
+            {
+                xRequiredSpace = xMaxReportedSpace;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+        if( xTicksToWait != ( TickType_t ) 0 )
+        {
+            vTaskSetTimeOutState( &xTimeOut );
+
+            do
+            {
+                /* Wait until the required number of bytes are free in the
+                 * buffer. */
+                taskENTER_CRITICAL();
+                {
+                    xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
+
+                    if( xSpace < xRequiredSpace )
+                    {
+                        /* Clear notification state as going to wait for space. */
+                        ( void ) xTaskNotifyStateClearIndexed( NULL, pxStreamBuffer->uxNotificationIndex );
+
+                        /* Should only be one writer. */
+                        configASSERT( pxStreamBuffer->xTaskWaitingToSend == NULL );
+                        pxStreamBuffer->xTaskWaitingToSend = xTaskGetCurrentTaskHandle();
+                    }
+                    else
+                    {
+                        taskEXIT_CRITICAL();
+                        break;
+                    }
+                }
+                taskEXIT_CRITICAL();
+
+                traceBLOCKING_ON_STREAM_BUFFER_SEND( xStreamBuffer );
+                ( void ) xTaskNotifyWaitIndexed( pxStreamBuffer->uxNotificationIndex, ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
+                pxStreamBuffer->xTaskWaitingToSend = NULL;
+            } while( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( xSpace == ( size_t ) 0 )
+        {
+            xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        xReturn = prvWriteVectoredMessageToBuffer( pxStreamBuffer, pxVectors, xVectorCount, xDataLengthBytes, xSpace, xRequiredSpace );
+
+        if( xReturn > ( size_t ) 0 )
+        {
+            traceSTREAM_BUFFER_SEND( xStreamBuffer, xReturn );
+
+            /* Was a task waiting for the data? */
+            if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
+            {
+                prvSEND_COMPLETED( pxStreamBuffer );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+            traceSTREAM_BUFFER_SEND_FAILED( xStreamBuffer );
+        }
+
+        traceRETURN_xStreamBufferSendVectored( xReturn );
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    size_t xStreamBufferSendVectoredFromISR( StreamBufferHandle_t xStreamBuffer,
+                                             const StreamBufferVector_t * pxVectors,
+                                             size_t xVectorCount,
+                                             BaseType_t * const pxHigherPriorityTaskWoken )
+    {
+        StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+        size_t xReturn, xSpace;
+        size_t xDataLengthBytes, xRequiredSpace;
+
+        traceENTER_xStreamBufferSendVectoredFromISR( xStreamBuffer, pxVectors, xVectorCount, pxHigherPriorityTaskWoken );
+
+        configASSERT( pxVectors );
+        configASSERT( pxStreamBuffer );
+
+        xDataLengthBytes = prvVectorsLength( pxVectors, xVectorCount );
+        xRequiredSpace = xDataLengthBytes;
+
+        if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+        {
+            xRequiredSpace += sbBYTES_TO_STORE_MESSAGE_LENGTH;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
+        xReturn = prvWriteVectoredMessageToBuffer( pxStreamBuffer, pxVectors, xVectorCount, xDataLengthBytes, xSpace, xRequiredSpace );
+
+        if( xReturn > ( size_t ) 0 )
+        {
+            /* Was a task waiting for the data? */
+            if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
+            {
+                /* MISRA Ref 4.7.1 [Return value shall be checked] */
+                /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#dir-47 */
+                /* coverity[misra_c_2012_directive_4_7_violation] */
+                prvSEND_COMPLETE_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceSTREAM_BUFFER_SEND_FROM_ISR( xStreamBuffer, xReturn );
+        traceRETURN_xStreamBufferSendVectoredFromISR( xReturn );
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    size_t xStreamBufferReceiveVectored( StreamBufferHandle_t xStreamBuffer,
+                                         const StreamBufferVector_t * pxVectors,
+                                         size_t xVectorCount,
+                                         TickType_t xTicksToWait )
+    {
+        StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+        size_t xReceivedLength = 0, xBytesAvailable, xBytesToStoreMessageLength;
+
+        traceENTER_xStreamBufferReceiveVectored( xStreamBuffer, pxVectors, xVectorCount, xTicksToWait );
+
+        configASSERT( pxVectors );
+        configASSERT( pxStreamBuffer );
+
+        /* See the comments in xStreamBufferReceive(). */
+        if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+        {
+            xBytesToStoreMessageLength = sbBYTES_TO_STORE_MESSAGE_LENGTH;
+        }
+        else if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_BATCHING_BUFFER ) != ( uint8_t ) 0 )
+        {
+            xBytesToStoreMessageLength = pxStreamBuffer->xTriggerLevelBytes;
+        }
+        else
+        {
+            xBytesToStoreMessageLength = 0;
+        }
+
+        if( xTicksToWait != ( TickType_t ) 0 )
+        {
+            /* Checking if there is data and clearing the notification state must be
+             * performed atomically. */
+            taskENTER_CRITICAL();
+            {
+                xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+
+                if( xBytesAvailable <= xBytesToStoreMessageLength )
+                {
+                    /* Clear notification state as going to wait for data. */
+                    ( void ) xTaskNotifyStateClearIndexed( NULL, pxStreamBuffer->uxNotificationIndex );
+
+                    /* Should only be one reader. */
+                    configASSERT( pxStreamBuffer->xTaskWaitingToReceive == NULL );
+                    pxStreamBuffer->xTaskWaitingToReceive = xTaskGetCurrentTaskHandle();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            taskEXIT_CRITICAL();
+
+            if( xBytesAvailable <= xBytesToStoreMessageLength )
+            {
+                /* Wait for data to be available. */
+                traceBLOCKING_ON_STREAM_BUFFER_RECEIVE( xStreamBuffer );
+                ( void ) xTaskNotifyWaitIndexed( pxStreamBuffer->uxNotificationIndex, ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
+                pxStreamBuffer->xTaskWaitingToReceive = NULL;
+
+                /* Recheck the data available after blocking. */
+                xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+        }
+
+        if( xBytesAvailable > xBytesToStoreMessageLength )
+        {
+            xReceivedLength = prvReadVectoredMessageFromBuffer( pxStreamBuffer, pxVectors, xVectorCount, xBytesAvailable );
+
+            /* Was a task waiting for space in the buffer? */
+            if( xReceivedLength != ( size_t ) 0 )
+            {
+                traceSTREAM_BUFFER_RECEIVE( xStreamBuffer, xReceivedLength );
+                prvRECEIVE_COMPLETED( xStreamBuffer );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            traceSTREAM_BUFFER_RECEIVE_FAILED( xStreamBuffer );
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_xStreamBufferReceiveVectored( xReceivedLength );
+
+        return xReceivedLength;
+    }
+/*-----------------------------------------------------------*/
+
+    size_t xStreamBufferReceiveVectoredFromISR( StreamBufferHandle_t xStreamBuffer,
+                                                const StreamBufferVector_t * pxVectors,
+                                                size_t xVectorCount,
+                                                BaseType_t * const pxHigherPriorityTaskWoken )
+    {
+        StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+        size_t xReceivedLength = 0, xBytesAvailable, xBytesToStoreMessageLength;
+
+        traceENTER_xStreamBufferReceiveVectoredFromISR( xStreamBuffer, pxVectors, xVectorCount, pxHigherPriorityTaskWoken );
+
+        configASSERT( pxVectors );
+        configASSERT( pxStreamBuffer );
+
+        if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+        {
+            xBytesToStoreMessageLength = sbBYTES_TO_STORE_MESSAGE_LENGTH;
+        }
+        else
+        {
+            xBytesToStoreMessageLength = 0;
+        }
+
+        xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+
+        if( xBytesAvailable > xBytesToStoreMessageLength )
+        {
+            xReceivedLength = prvReadVectoredMessageFromBuffer( pxStreamBuffer, pxVectors, xVectorCount, xBytesAvailable );
+
+            /* Was a task waiting for space in the buffer? */
+            if( xReceivedLength != ( size_t ) 0 )
+            {
+                /* MISRA Ref 4.7.1 [Return value shall be checked] */
+                /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#dir-47 */
+                /* coverity[misra_c_2012_directive_4_7_violation] */
+                prvRECEIVE_COMPLETED_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceSTREAM_BUFFER_RECEIVE_FROM_ISR( xStreamBuffer, xReceivedLength );
+        traceRETURN_xStreamBufferReceiveVectoredFromISR( xReceivedLength );
+
+        return xReceivedLength;
+    }
+/*-----------------------------------------------------------*/
+
+    static size_t prvVectorsLength( const StreamBufferVector_t * pxVectors,
+                                    size_t xVectorCount )
+    {
+        size_t xLength = 0;
+        size_t x;
+
+        for( x = 0; x < xVectorCount; x++ )
+        {
+            /* Overflow? */
+            configASSERT( ( xLength + pxVectors[ x ].xLengthBytes ) >= xLength );
+            xLength += pxVectors[ x ].xLengthBytes;
+        }
+
+        return xLength;
+    }
+/*-----------------------------------------------------------*/
+
+    static size_t prvWriteVectoredMessageToBuffer( StreamBuffer_t * const pxStreamBuffer,
+                                                   const StreamBufferVector_t * pxVectors,
+                                                   size_t xVectorCount,
+                                                   size_t xDataLengthBytes,
+                                                   size_t xSpace,
+                                                   size_t xRequiredSpace )
+    {
+        size_t xNextHead = pxStreamBuffer->xHead;
+        size_t xRemaining, xCount, x;
+        configMESSAGE_BUFFER_LENGTH_TYPE xMessageLength;
+
+        if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+        {
+            /* Convert xDataLengthBytes to the message length type. */
+            xMessageLength = ( configMESSAGE_BUFFER_LENGTH_TYPE ) xDataLengthBytes;
+
+            /* Ensure the data length given fits within configMESSAGE_BUFFER_LENGTH_TYPE. */
+            configASSERT( ( size_t ) xMessageLength == xDataLengthBytes );
+
+            if( xSpace >= xRequiredSpace )
+            {
+                /* There is enough space to write both the message length and
+                 * every segment of the message. */
+                xNextHead = prvWriteBytesToBuffer( pxStreamBuffer, ( const uint8_t * ) &( xMessageLength ), sbBYTES_TO_STORE_MESSAGE_LENGTH, xNextHead );
+            }
+            else
+            {
+                /* Not enough space, so do not write data to the buffer. */
+                xDataLengthBytes = 0;
+            }
+        }
+        else
+        {
+            /* Plan to write as many bytes as possible. */
+            xDataLengthBytes = configMIN( xDataLengthBytes, xSpace );
+        }
+
+        xRemaining = xDataLengthBytes;
+
+        for( x = 0; ( x < xVectorCount ) && ( xRemaining != ( size_t ) 0 ); x++ )
+        {
+            xCount = configMIN( pxVectors[ x ].xLengthBytes, xRemaining );
+
+            if( xCount != ( size_t ) 0 )
+            {
+                /* MISRA Ref 11.5.5 [Void pointer assignment] */
+                /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+                /* coverity[misra_c_2012_rule_11_5_violation] */
+                xNextHead = prvWriteBytesToBuffer( pxStreamBuffer, ( const uint8_t * ) pxVectors[ x ].pvData, xCount, xNextHead );
+                xRemaining -= xCount;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+        if( xDataLengthBytes != ( size_t ) 0 )
+        {
+            /* Publish the whole message at once. */
+            pxStreamBuffer->xHead = xNextHead;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xDataLengthBytes;
+    }
+/*-----------------------------------------------------------*/
+
+    static size_t prvReadVectoredMessageFromBuffer( StreamBuffer_t * pxStreamBuffer,
+                                                    const StreamBufferVector_t * pxVectors,
+                                                    size_t xVectorCount,
+                                                    size_t xBytesAvailable )
+    {
+        size_t xCount, xNextMessageLength, xRemaining, xSegmentCount, x;
+        configMESSAGE_BUFFER_LENGTH_TYPE xTempNextMessageLength;
+        size_t xNextTail = pxStreamBuffer->xTail;
+        const size_t xBufferLengthBytes = prvVectorsLength( pxVectors, xVectorCount );
+
+        if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+        {
+            /* A discrete message is being received.  First receive the length
+             * of the message. */
+            xNextTail = prvReadBytesFromBuffer( pxStreamBuffer, ( uint8_t * ) &xTempNextMessageLength, sbBYTES_TO_STORE_MESSAGE_LENGTH, xNextTail );
+            xNextMessageLength = ( size_t ) xTempNextMessageLength;
+            xBytesAvailable -= sbBYTES_TO_STORE_MESSAGE_LENGTH;
+
+            /* The segments together must be able to hold the whole message,
+             * otherwise the message is left in the buffer. */
+            if( xNextMessageLength > xBufferLengthBytes )
+            {
+                xNextMessageLength = 0;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            /* A stream of bytes is being received, so read as many bytes as
+             * the segments can hold. */
+            xNextMessageLength = xBufferLengthBytes;
+        }
+
+        /* Use the minimum of the wanted bytes and the available bytes. */
+        xCount = configMIN( xNextMessageLength, xBytesAvailable );
+
+        if( xCount != ( size_t ) 0 )
+        {
+            xRemaining = xCount;
+
+            for( x = 0; ( x < xVectorCount ) && ( xRemaining != ( size_t ) 0 ); x++ )
+            {
+                xSegmentCount = configMIN( pxVectors[ x ].xLengthBytes, xRemaining );
+
+                if( xSegmentCount != ( size_t ) 0 )
+                {
+                    /* MISRA Ref 11.5.5 [Void pointer assignment] */
+                    /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+                    /* coverity[misra_c_2012_rule_11_5_violation] */
+                    xNextTail = prvReadBytesFromBuffer( pxStreamBuffer, ( uint8_t * ) pxVectors[ x ].pvData, xSegmentCount, xNextTail );
+                    xRemaining -= xSegmentCount;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+
+            /* Update the tail to mark the data as officially consumed. */
+            pxStreamBuffer->xTail = xNextTail;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xCount;
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* configUSE_STREAM_BUFFER_VECTORED_IO */
+
 BaseType_t xStreamBufferIsEmpty( StreamBufferHandle_t xStreamBuffer )
 {
     const StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
@@ -39,6 +39,7 @@
 #include "FreeRTOS.h"
 #include "task.h"
 #include "timers.h"
+#include "queue.h"
 #include "stack_macros.h"
 
 /* The default definitions are only available for non-MPU ports. The
@@ -48,6 +49,12 @@
     #error configKERNEL_PROVIDED_STATIC_MEMORY cannot be set to 1 when using an MPU port. The vApplicationGet*TaskMemory() functions must be provided manually.
 #endif
 
+/* Transitive priority inheritance follows a chain of blocked tasks from each
+ * mutex to the task that holds it. */
+#if ( ( configUSE_TRANSITIVE_INHERITANCE == 1 ) && ( ( configUSE_MUTEXES != 1 ) || ( INCLUDE_xSemaphoreGetMutexHolder != 1 ) ) )
+    #error configUSE_MUTEXES and INCLUDE_xSemaphoreGetMutexHolder must be set to 1 when configUSE_TRANSITIVE_INHERITANCE is set to 1.
+#endif
+
 /* The MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
  * for the header files above, but not in this file, in order to generate the
  * correct privileged Vs unprivileged linkage and placement. */
@@ -64,6 +71,61 @@
     #include <stdio.h>
 #endif /* configUSE_STATS_FORMATTING_FUNCTIONS == 1 ) */
 
+#if ( configUSE_EDF_SCHEDULING == 1 )
+
+/* Evaluates to true if deadline xA comes before deadline xB.  The deadlines are
+ * compared through their difference, so the order holds across a tick count
+ * overflow as long as the deadlines are less than half the tick range apart.
+ * portMAX_DELAY, used for a task without a deadline, comes after every other
+ * deadline. */
+    #define taskDEADLINE_IS_BEFORE( xA, xB )                     \
+    ( ( ( xA ) != portMAX_DELAY ) &&                             \
+      ( ( ( xB ) == portMAX_DELAY ) ||                           \
+        ( ( ( TickType_t ) ( ( xA ) - ( xB ) ) ) > ( portMAX_DELAY >> 1 ) ) ) )
+#endif
+
+/* Evaluates to true if pxTCB, which has just become ready, should run in place
+ * of the running task.  With configUSE_EDF_SCHEDULING a ready task of the same
+ * priority with an earlier deadline also preempts.  With
+ * configUSE_TIME_PARTITIONING a task of a partition that is outside its window
+ * never preempts.  Only used by the single core scheduler. */
+#if ( configUSE_EDF_SCHEDULING == 1 )
+    #define taskOUTRANKS_CURRENT_TASK( pxTCB )                   \
+    ( ( ( pxTCB )->uxPriority > pxCurrentTCB->uxPriority ) ||    \
+      ( ( ( pxTCB )->uxPriority == pxCurrentTCB->uxPriority ) && \
+        taskDEADLINE_IS_BEFORE( ( pxTCB )->xDeadline, pxCurrentTCB->xDeadline ) ) )
+#else
+    #define taskOUTRANKS_CURRENT_TASK( pxTCB )    ( ( pxTCB )->uxPriority > pxCurrentTCB->uxPriority )
+#endif
+
+#if ( configUSE_TIME_PARTITIONING == 1 )
+
+/* Evaluates to true if pxTCB can run in the current window: no schedule is
+ * set, the task is not bound to a partition, or its partition owns the
+ * window. */
+    #define taskPARTITION_IS_ACTIVE( pxTCB )                     \
+    ( ( pxPartitionWindows == NULL ) ||                          \
+      ( ( pxTCB )->uxPartition == tskNO_PARTITION ) ||           \
+      ( ( pxTCB )->uxPartition == uxActivePartition ) )
+
+    #define taskPREEMPTS_CURRENT_TASK( pxTCB ) \
+    ( ( taskPARTITION_IS_ACTIVE( pxTCB ) ) && ( taskOUTRANKS_CURRENT_TASK( pxTCB ) ) )
+
+/* The time base used to measure the overhead of switching between partition
+ * windows: the run time stats counter, if there is one. */
+    #if ( configGENERATE_RUN_TIME_STATS == 1 )
+        #ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+            #define taskGET_PARTITION_TIMESTAMP( ulTime )    portALT_GET_RUN_TIME_COUNTER_VALUE( ulTime )
+        #else
+            #define taskGET_PARTITION_TIMESTAMP( ulTime )    ( ulTime ) = portGET_RUN_TIME_COUNTER_VALUE()
+        #endif
+    #else
+        #define taskGET_PARTITION_TIMESTAMP( ulTime )    ( ulTime ) = ( configRUN_TIME_COUNTER_TYPE ) 0U
+    #endif
+#else
+    #define taskPREEMPTS_CURRENT_TASK( pxTCB )    taskOUTRANKS_CURRENT_TASK( pxTCB )
+#endif
+
 #if ( configUSE_PREEMPTION == 0 )
 
 /* If the cooperative scheduler is being used then a yield should not be
@@ -86,7 +148,7 @@
 
         #define taskYIELD_ANY_CORE_IF_USING_PREEMPTION( pxTCB ) \
     do {                                                        \
-        if( pxCurrentTCB->uxPriority < ( pxTCB )->uxPriority )  \
+        if( taskPREEMPTS_CURRENT_TASK( pxTCB ) )                \
         {                                                       \
             portYIELD_WITHIN_API();                             \
         }                                                       \
@@ -172,6 +234,28 @@
     #define taskRESERVED_TASK_NAME_LENGTH    1U
 #endif /* if ( ( configNUMBER_OF_CORES > 1 ) */
 
+/* With configUSE_EDF_SCHEDULING each ready list is kept ordered by task
+ * deadline, held in the value of the state list item and compared with
+ * taskDEADLINE_IS_BEFORE(), and the task at the head of the highest priority
+ * ready list is selected.  Otherwise tasks are added to the end of their ready
+ * list and selected in turn. */
+#if ( configUSE_EDF_SCHEDULING == 1 )
+    #define taskINSERT_INTO_READY_LIST( pxTCB )                                                                    \
+    do {                                                                                                           \
+        listSET_LIST_ITEM_VALUE( &( ( pxTCB )->xStateListItem ), ( pxTCB )->xDeadline );                          \
+        prvInsertByDeadline( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xStateListItem ) );    \
+    } while( 0 )
+
+    #define taskSELECT_FROM_READY_LIST( pxReadyList )    prvSelectEarliestDeadlineTask( pxReadyList )
+#else
+    #define taskINSERT_INTO_READY_LIST( pxTCB ) \
+    listINSERT_END( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xStateListItem ) )
+
+    #define taskSELECT_FROM_READY_LIST( pxReadyList )    listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, ( pxReadyList ) )
+#endif
+
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
 
 /* If configUSE_PORT_OPTIMISED_TASK_SELECTION is 0 then task selection is
@@ -204,7 +288,7 @@
                                                                                          \
         /* listGET_OWNER_OF_NEXT_ENTRY indexes through the list, so the tasks of \
          * the  same priority get an equal share of the processor time. */                    \
-        listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ uxTopPriority ] ) ); \
+        taskSELECT_FROM_READY_LIST( &( pxReadyTasksLists[ uxTopPriority ] ) );                \
         uxTopReadyPriority = uxTopPriority;                                                   \
     } while( 0 ) /* taskSELECT_HIGHEST_PRIORITY_TASK */
     #else /* if ( configNUMBER_OF_CORES == 1 ) */
@@ -239,7 +323,7 @@
         /* Find the highest priority list that contains ready tasks. */                         \
         portGET_HIGHEST_PRIORITY( uxTopPriority, uxTopReadyPriority );                          \
         configASSERT( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ uxTopPriority ] ) ) > 0 ); \
-        listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ uxTopPriority ] ) );   \
+        taskSELECT_FROM_READY_LIST( &( pxReadyTasksLists[ uxTopPriority ] ) );                  \
     } while( 0 )
 
 /*-----------------------------------------------------------*/
@@ -279,15 +363,36 @@
 
 /*
  * Place the task represented by pxTCB into the appropriate ready list for
- * the task.  It is inserted at the end of the list.
+ * the task.  It is inserted at the end of the list, or in deadline order when
+ * configUSE_EDF_SCHEDULING is 1.  When configUSE_TIME_PARTITIONING is 1 a task
+ * whose partition is outside its window is instead placed at the end of the
+ * list of its partition, from which it is moved to the ready list when a
+ * window of the partition starts.
  */
-#define prvAddTaskToReadyList( pxTCB )                                                                     \
-    do {                                                                                                   \
-        traceMOVED_TASK_TO_READY_STATE( pxTCB );                                                           \
-        taskRECORD_READY_PRIORITY( ( pxTCB )->uxPriority );                                                \
-        listINSERT_END( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xStateListItem ) ); \
-        tracePOST_MOVED_TASK_TO_READY_STATE( pxTCB );                                                      \
+#if ( configUSE_TIME_PARTITIONING == 1 )
+    #define prvAddTaskToReadyList( pxTCB )                                                                         \
+    do {                                                                                                           \
+        if( taskPARTITION_IS_ACTIVE( pxTCB ) )                                                                     \
+        {                                                                                                          \
+            traceMOVED_TASK_TO_READY_STATE( pxTCB );                                                               \
+            taskRECORD_READY_PRIORITY( ( pxTCB )->uxPriority );                                                    \
+            taskINSERT_INTO_READY_LIST( pxTCB );                                                                   \
+            tracePOST_MOVED_TASK_TO_READY_STATE( pxTCB );                                                          \
+        }                                                                                                          \
+        else                                                                                                       \
+        {                                                                                                          \
+            listINSERT_END( &( xPartitionReadyLists[ ( pxTCB )->uxPartition ] ), &( ( pxTCB )->xStateListItem ) ); \
+        }                                                                                                          \
+    } while( 0 )
+#else
+    #define prvAddTaskToReadyList( pxTCB )                      \
+    do {                                                        \
+        traceMOVED_TASK_TO_READY_STATE( pxTCB );                \
+        taskRECORD_READY_PRIORITY( ( pxTCB )->uxPriority );     \
+        taskINSERT_INTO_READY_LIST( pxTCB );                    \
+        tracePOST_MOVED_TASK_TO_READY_STATE( pxTCB );           \
     } while( 0 )
+#endif
 /*-----------------------------------------------------------*/
 
 /*
@@ -415,6 +520,18 @@ typedef struct tskTaskControlBlock       /* The old naming convention is used to
         UBaseType_t uxMutexesHeld;
     #endif
 
+    #if ( configUSE_TRANSITIVE_INHERITANCE == 1 )
+        void * pvBlockedOnMutex; /**< The mutex the task is blocked on, or NULL.  Used to pass an inherited priority on to the holder of that mutex. */
+    #endif
+
+    #if ( configUSE_EDF_SCHEDULING == 1 )
+        TickType_t xDeadline; /**< Absolute deadline, in ticks, that orders the task within its ready list.  portMAX_DELAY if the task has no deadline. */
+    #endif
+
+    #if ( configUSE_TIME_PARTITIONING == 1 )
+        UBaseType_t uxPartition; /**< The partition the task is bound to, or tskNO_PARTITION if it can run in every window. */
+    #endif
+
     #if ( configUSE_APPLICATION_TASK_TAG == 1 )
         TaskHookFunction_t pxTaskTag;
     #endif
@@ -529,6 +646,36 @@ static const volatile UBaseType_t uxTopUsedPriority = configMAX_PRIORITIES - 1U;
  * from either an ISR or a task. */
 PRIVILEGED_DATA static volatile UBaseType_t uxSchedulerSuspended = ( UBaseType_t ) 0U;
 
+#if ( ( configCHECK_FOR_STACK_OVERFLOW == 3 ) && ( portUSING_MPU_WRAPPERS != 1 ) )
+
+/* Tick count at which the idle task last scanned the stack guard zones. */
+PRIVILEGED_DATA static TickType_t xLastStackGuardScanTime = ( TickType_t ) 0U;
+
+#endif
+
+#if ( configUSE_TIME_PARTITIONING == 1 )
+
+/* The major frame set by xTaskSetPartitionSchedule(), or NULL if tasks are not
+ * partitioned, the window of it that is running, the partition that owns that
+ * window, and the tick count at which the next window starts. */
+PRIVILEGED_DATA static const TaskPartitionWindow_t * pxPartitionWindows = NULL;
+PRIVILEGED_DATA static UBaseType_t uxPartitionWindowCount = ( UBaseType_t ) 0U;
+PRIVILEGED_DATA static UBaseType_t uxPartitionWindowIndex = ( UBaseType_t ) 0U;
+PRIVILEGED_DATA static UBaseType_t uxActivePartition = tskNO_PARTITION;
+PRIVILEGED_DATA static TickType_t xNextPartitionSwitchTime = ( TickType_t ) 0U;
+
+/* Ready tasks of the partitions that are outside their window. */
+PRIVILEGED_DATA static List_t xPartitionReadyLists[ configMAX_PARTITIONS ];
+
+PRIVILEGED_DATA static TaskPartitionStatus_t xPartitionStatus[ configMAX_PARTITIONS ];
+
+/* Set when a window of another partition starts and cleared by the context
+ * switch that follows, which records the time between the two. */
+PRIVILEGED_DATA static BaseType_t xPartitionSwitchPending = pdFALSE;
+PRIVILEGED_DATA static configRUN_TIME_COUNTER_TYPE ulPartitionSwitchStartTime = 0U;
+
+#endif
+
 #if ( configGENERATE_RUN_TIME_STATS == 1 )
 
 /* Do not move these variables to function scope as doing so prevents the
@@ -624,6 +771,43 @@ static portTASK_FUNCTION_PROTO( prvIdleTask, pvParameters ) PRIVILEGED_FUNCTION;
 
 #endif
 
+/*
+ * Used when configUSE_EDF_SCHEDULING is 1.  prvInsertByDeadline() inserts a
+ * ready list item after the items whose deadline is not later than its own,
+ * prvSelectEarliestDeadlineTask() selects the task at the head of pxReadyList,
+ * which is ordered by deadline, and prvSetDeadline() changes the deadline of a
+ * task and moves it within its ready list if it is ready.
+ */
+#if ( configUSE_EDF_SCHEDULING == 1 )
+
+    static void prvInsertByDeadline( List_t * const pxReadyList,
+                                     ListItem_t * const pxNewListItem ) PRIVILEGED_FUNCTION;
+
+    static void prvSelectEarliestDeadlineTask( List_t * const pxReadyList ) PRIVILEGED_FUNCTION;
+
+    static void prvSetDeadline( TCB_t * const pxTCB,
+                                const TickType_t xDeadline ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Used when configUSE_TIME_PARTITIONING is 1.  prvParkInactiveTasks() moves
+ * every ready task that cannot run in the current window from the ready lists
+ * to the list of its partition and returns how many it moved.
+ * prvReadyPartitionTasks() moves the tasks of a partition back to the ready
+ * lists.  prvSwitchPartitionWindow() starts the next window of the major frame
+ * and returns pdTRUE if a context switch is needed.
+ */
+#if ( configUSE_TIME_PARTITIONING == 1 )
+
+    static UBaseType_t prvParkInactiveTasks( void ) PRIVILEGED_FUNCTION;
+
+    static void prvReadyPartitionTasks( UBaseType_t uxPartition ) PRIVILEGED_FUNCTION;
+
+    static BaseType_t prvSwitchPartitionWindow( void ) PRIVILEGED_FUNCTION;
+
+#endif
+
 /*
  * Used only by the idle task.  This checks to see if anything has been placed
  * in the list of tasks waiting to be deleted.  If so the task is cleaned up
@@ -676,6 +860,23 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
 
 #endif
 
+/*
+ * Used when configCHECK_FOR_STACK_OVERFLOW is 3.  prvGetStackOverflowDepth()
+ * returns how many words of its guard zone pxTCB has used, and
+ * prvCheckStackGuards() is called by the idle task to scan the guard zone of
+ * every task once every configSTACK_CANARY_SCAN_PERIOD_TICKS ticks, calling
+ * the stack overflow hook for the first task found to have used its guard zone.
+ */
+#if ( ( configCHECK_FOR_STACK_OVERFLOW == 3 ) && ( portUSING_MPU_WRAPPERS != 1 ) )
+
+    static configSTACK_DEPTH_TYPE prvGetStackOverflowDepth( const TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+
+    static TCB_t * prvSearchForStackOverflowWithinSingleList( List_t * pxList ) PRIVILEGED_FUNCTION;
+
+    static void prvCheckStackGuards( void ) PRIVILEGED_FUNCTION;
+
+#endif
+
 /*
  * Return the amount of time, in ticks, that will pass before the kernel will
  * next move a task from the Blocked state to the Running state or before the
@@ -692,6 +893,32 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
 
 #endif
 
+#if ( configUSE_MUTEXES == 1 )
+
+/*
+ * Raise the priority of pxTCB, which holds a mutex, to uxNewPriority, moving it
+ * to the ready list for its new priority if it is in the Ready state.  Must be
+ * called from a critical section.
+ */
+    static void prvRaisePriority( TCB_t * const pxTCB,
+                                  UBaseType_t uxNewPriority ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if ( configUSE_TRANSITIVE_INHERITANCE == 1 )
+
+/*
+ * Called after pxMutexHolderTCB has inherited uxPriority.  If
+ * pxMutexHolderTCB is blocked on another mutex then the holder of that mutex
+ * also inherits uxPriority, and so on along the chain of blocked holders, up
+ * to configMAX_INHERITANCE_DEPTH holders in total.  Must be called from a
+ * critical section.
+ */
+    static void prvInheritAlongChain( TCB_t * const pxMutexHolderTCB,
+                                      UBaseType_t uxPriority ) PRIVILEGED_FUNCTION;
+
+#endif
+
 /*
  * Set xNextTaskUnblockTime to the time at which the next Blocked state task
  * will exit the Blocked state.
@@ -772,7 +999,8 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
                                   const configSTACK_DEPTH_TYPE uxStackDepth,
                                   void * const pvParameters,
                                   UBaseType_t uxPriority,
-                                  TaskHandle_t * const pxCreatedTask ) PRIVILEGED_FUNCTION;
+                                  TaskHandle_t * const pxCreatedTask,
+                                  BaseType_t xStackRegion ) PRIVILEGED_FUNCTION;
 #endif /* #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) */
 
 /*
@@ -1532,7 +1760,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
             /* MISRA Ref 11.5.1 [Malloc memory assignment] */
             /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
             /* coverity[misra_c_2012_rule_11_5_violation] */
-            pxNewTCB = ( TCB_t * ) pvPortMalloc( sizeof( TCB_t ) );
+            pxNewTCB = ( TCB_t * ) pvPortMallocObject( sizeof( TCB_t ) );
 
             if( pxNewTCB != NULL )
             {
@@ -1644,10 +1872,15 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
                                   const configSTACK_DEPTH_TYPE uxStackDepth,
                                   void * const pvParameters,
                                   UBaseType_t uxPriority,
-                                  TaskHandle_t * const pxCreatedTask )
+                                  TaskHandle_t * const pxCreatedTask,
+                                  BaseType_t xStackRegion )
     {
         TCB_t * pxNewTCB;
 
+        /* The region is only passed on when configUSE_HEAP_REGION_HINTS is 1;
+         * otherwise pvPortMallocStackInRegion() discards it. */
+        ( void ) xStackRegion;
+
         /* If the stack grows down then allocate the stack then the TCB so the stack
          * does not grow into the TCB.  Likewise if the stack grows up then allocate
          * the TCB then the stack. */
@@ -1659,7 +1892,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
             /* MISRA Ref 11.5.1 [Malloc memory assignment] */
             /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
             /* coverity[misra_c_2012_rule_11_5_violation] */
-            pxNewTCB = ( TCB_t * ) pvPortMalloc( sizeof( TCB_t ) );
+            pxNewTCB = ( TCB_t * ) pvPortMallocObject( sizeof( TCB_t ) );
 
             if( pxNewTCB != NULL )
             {
@@ -1671,12 +1904,12 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
                 /* MISRA Ref 11.5.1 [Malloc memory assignment] */
                 /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
                 /* coverity[misra_c_2012_rule_11_5_violation] */
-                pxNewTCB->pxStack = ( StackType_t * ) pvPortMallocStack( ( ( ( size_t ) uxStackDepth ) * sizeof( StackType_t ) ) );
+                pxNewTCB->pxStack = ( StackType_t * ) pvPortMallocStackInRegion( ( ( ( size_t ) uxStackDepth ) * sizeof( StackType_t ) ), xStackRegion );
 
                 if( pxNewTCB->pxStack == NULL )
                 {
                     /* Could not allocate the stack.  Delete the allocated TCB. */
-                    vPortFree( pxNewTCB );
+                    vPortFreeObject( pxNewTCB );
                     pxNewTCB = NULL;
                 }
             }
@@ -1689,7 +1922,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
             /* MISRA Ref 11.5.1 [Malloc memory assignment] */
             /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
             /* coverity[misra_c_2012_rule_11_5_violation] */
-            pxStack = pvPortMallocStack( ( ( ( size_t ) uxStackDepth ) * sizeof( StackType_t ) ) );
+            pxStack = pvPortMallocStackInRegion( ( ( ( size_t ) uxStackDepth ) * sizeof( StackType_t ) ), xStackRegion );
 
             if( pxStack != NULL )
             {
@@ -1697,7 +1930,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
                 /* MISRA Ref 11.5.1 [Malloc memory assignment] */
                 /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
                 /* coverity[misra_c_2012_rule_11_5_violation] */
-                pxNewTCB = ( TCB_t * ) pvPortMalloc( sizeof( TCB_t ) );
+                pxNewTCB = ( TCB_t * ) pvPortMallocObject( sizeof( TCB_t ) );
 
                 if( pxNewTCB != NULL )
                 {
@@ -1749,7 +1982,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
 
         traceENTER_xTaskCreate( pxTaskCode, pcName, uxStackDepth, pvParameters, uxPriority, pxCreatedTask );
 
-        pxNewTCB = prvCreateTask( pxTaskCode, pcName, uxStackDepth, pvParameters, uxPriority, pxCreatedTask );
+        pxNewTCB = prvCreateTask( pxTaskCode, pcName, uxStackDepth, pvParameters, uxPriority, pxCreatedTask, portHEAP_REGION_ANY );
 
         if( pxNewTCB != NULL )
         {
@@ -1774,6 +2007,46 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
     }
 /*-----------------------------------------------------------*/
 
+    #if ( configUSE_HEAP_REGION_HINTS == 1 )
+        BaseType_t xTaskCreateInRegion( TaskFunction_t pxTaskCode,
+                                        const char * const pcName,
+                                        const configSTACK_DEPTH_TYPE uxStackDepth,
+                                        void * const pvParameters,
+                                        UBaseType_t uxPriority,
+                                        TaskHandle_t * const pxCreatedTask,
+                                        BaseType_t xStackRegion )
+        {
+            TCB_t * pxNewTCB;
+            BaseType_t xReturn;
+
+            traceENTER_xTaskCreateInRegion( pxTaskCode, pcName, uxStackDepth, pvParameters, uxPriority, pxCreatedTask, xStackRegion );
+
+            pxNewTCB = prvCreateTask( pxTaskCode, pcName, uxStackDepth, pvParameters, uxPriority, pxCreatedTask, xStackRegion );
+
+            if( pxNewTCB != NULL )
+            {
+                #if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_CORE_AFFINITY == 1 ) )
+                {
+                    /* Set the task's affinity before scheduling it. */
+                    pxNewTCB->uxCoreAffinityMask = configTASK_DEFAULT_CORE_AFFINITY;
+                }
+                #endif
+
+                prvAddNewTaskToReadyList( pxNewTCB );
+                xReturn = pdPASS;
+            }
+            else
+            {
+                xReturn = errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY;
+            }
+
+            traceRETURN_xTaskCreateInRegion( xReturn );
+
+            return xReturn;
+        }
+    #endif /* #if ( configUSE_HEAP_REGION_HINTS == 1 ) */
+/*-----------------------------------------------------------*/
+
     #if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_CORE_AFFINITY == 1 ) )
         BaseType_t xTaskCreateAffinitySet( TaskFunction_t pxTaskCode,
                                            const char * const pcName,
@@ -1788,7 +2061,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
 
             traceENTER_xTaskCreateAffinitySet( pxTaskCode, pcName, uxStackDepth, pvParameters, uxPriority, uxCoreAffinityMask, pxCreatedTask );
 
-            pxNewTCB = prvCreateTask( pxTaskCode, pcName, uxStackDepth, pvParameters, uxPriority, pxCreatedTask );
+            pxNewTCB = prvCreateTask( pxTaskCode, pcName, uxStackDepth, pvParameters, uxPriority, pxCreatedTask, portHEAP_REGION_ANY );
 
             if( pxNewTCB != NULL )
             {
@@ -1839,6 +2112,14 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
         uxPriority &= ~portPRIVILEGE_BIT;
     #endif /* portUSING_MPU_WRAPPERS == 1 */
 
+    #if ( configCHECK_FOR_STACK_OVERFLOW == 3 )
+    {
+        /* The guard zone is part of the stack, so a stack no larger than the
+         * guard zone would be reported as overflowed straight away. */
+        configASSERT( uxStackDepth > ( configSTACK_DEPTH_TYPE ) configSTACK_GUARD_WORDS );
+    }
+    #endif
+
     /* Avoid dependency on memset() if it is not required. */
     #if ( tskSET_NEW_STACKS_TO_KNOWN_VALUE == 1 )
     {
@@ -1929,6 +2210,19 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
     }
     #endif /* configUSE_MUTEXES */
 
+    #if ( configUSE_EDF_SCHEDULING == 1 )
+    {
+        /* Tasks without a deadline run after those with one. */
+        pxNewTCB->xDeadline = portMAX_DELAY;
+    }
+    #endif
+
+    #if ( configUSE_TIME_PARTITIONING == 1 )
+    {
+        pxNewTCB->uxPartition = tskNO_PARTITION;
+    }
+    #endif
+
     vListInitialiseItem( &( pxNewTCB->xStateListItem ) );
     vListInitialiseItem( &( pxNewTCB->xEventListItem ) );
 
@@ -2453,114 +2747,719 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
 #endif /* INCLUDE_xTaskDelayUntil */
 /*-----------------------------------------------------------*/
 
-#if ( INCLUDE_vTaskDelay == 1 )
+#if ( configUSE_EDF_SCHEDULING == 1 )
 
-    void vTaskDelay( const TickType_t xTicksToDelay )
+    static void prvInsertByDeadline( List_t * const pxReadyList,
+                                     ListItem_t * const pxNewListItem )
     {
-        BaseType_t xAlreadyYielded = pdFALSE;
-
-        traceENTER_vTaskDelay( xTicksToDelay );
+        const ListItem_t * const pxEnd = listGET_END_MARKER( pxReadyList );
+        const TickType_t xDeadline = listGET_LIST_ITEM_VALUE( pxNewListItem );
+        ListItem_t * pxIterator;
 
-        /* A delay time of zero just forces a reschedule. */
-        if( xTicksToDelay > ( TickType_t ) 0U )
+        /* vListInsert() orders by the raw item value, which puts a deadline
+         * past a tick count overflow ahead of the deadlines before it, so the
+         * position is found with taskDEADLINE_IS_BEFORE() instead.  The new
+         * item goes after those with the same deadline, as with vListInsert(),
+         * so tasks with equal deadlines take turns. */
+        for( pxIterator = ( ListItem_t * ) pxEnd;
+             ( pxIterator->pxNext != pxEnd ) &&
+             ( taskDEADLINE_IS_BEFORE( xDeadline, listGET_LIST_ITEM_VALUE( pxIterator->pxNext ) ) == pdFALSE );
+             pxIterator = pxIterator->pxNext )
         {
-            vTaskSuspendAll();
-            {
-                configASSERT( uxSchedulerSuspended == 1U );
+            /* Iterating to the insertion position. */
+        }
 
-                traceTASK_DELAY();
+        pxNewListItem->pxNext = pxIterator->pxNext;
+        pxNewListItem->pxNext->pxPrevious = pxNewListItem;
+        pxNewListItem->pxPrevious = pxIterator;
+        pxIterator->pxNext = pxNewListItem;
+        pxNewListItem->pxContainer = pxReadyList;
 
-                /* A task that is removed from the event list while the
-                 * scheduler is suspended will not get placed in the ready
-                 * list or removed from the blocked list until the scheduler
-                 * is resumed.
-                 *
-                 * This task cannot be in an event list as it is the currently
-                 * executing task. */
-                prvAddCurrentTaskToDelayedList( xTicksToDelay, pdFALSE );
+        ( pxReadyList->uxNumberOfItems ) = ( UBaseType_t ) ( pxReadyList->uxNumberOfItems + 1U );
+    }
+
+#endif /* configUSE_EDF_SCHEDULING */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_EDF_SCHEDULING == 1 )
+
+    static void prvSelectEarliestDeadlineTask( List_t * const pxReadyList )
+    {
+        ListItem_t * const pxRunningItem = &( pxCurrentTCB->xStateListItem );
+        const ListItem_t * pxNextItem;
+
+        /* A task that is switched out while still ready is first moved behind
+         * the other ready tasks that have the same deadline, so tasks with
+         * equal deadlines, such as those without a deadline, take turns as
+         * they do when the list is not ordered. */
+        if( listIS_CONTAINED_WITHIN( pxReadyList, pxRunningItem ) != pdFALSE )
+        {
+            pxNextItem = listGET_NEXT( pxRunningItem );
+
+            if( ( pxNextItem != listGET_END_MARKER( pxReadyList ) ) &&
+                ( listGET_LIST_ITEM_VALUE( pxNextItem ) == listGET_LIST_ITEM_VALUE( pxRunningItem ) ) )
+            {
+                ( void ) uxListRemove( pxRunningItem );
+                prvInsertByDeadline( pxReadyList, pxRunningItem );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
             }
-            xAlreadyYielded = xTaskResumeAll();
         }
         else
         {
             mtCOVERAGE_TEST_MARKER();
         }
 
-        /* Force a reschedule if xTaskResumeAll has not already done so, we may
-         * have put ourselves to sleep. */
-        if( xAlreadyYielded == pdFALSE )
+        /* The earliest deadline is at the head of the list. */
+
+        /* MISRA Ref 11.5.3 [Void pointer assignment] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+        /* coverity[misra_c_2012_rule_11_5_violation] */
+        pxCurrentTCB = listGET_OWNER_OF_HEAD_ENTRY( pxReadyList );
+    }
+
+#endif /* configUSE_EDF_SCHEDULING */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_EDF_SCHEDULING == 1 )
+
+    static void prvSetDeadline( TCB_t * const pxTCB,
+                                const TickType_t xDeadline )
+    {
+        /* Called from a critical section. */
+        pxTCB->xDeadline = xDeadline;
+
+        /* A ready task is moved to keep its ready list in deadline order.  The
+         * ready priority does not need updating as the task is put straight
+         * back into the same list. */
+        if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxTCB->uxPriority ] ), &( pxTCB->xStateListItem ) ) != pdFALSE )
         {
-            taskYIELD_WITHIN_API();
+            ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+            taskINSERT_INTO_READY_LIST( pxTCB );
         }
         else
         {
             mtCOVERAGE_TEST_MARKER();
         }
-
-        traceRETURN_vTaskDelay();
     }
 
-#endif /* INCLUDE_vTaskDelay */
+#endif /* configUSE_EDF_SCHEDULING */
 /*-----------------------------------------------------------*/
 
-#if ( ( INCLUDE_eTaskGetState == 1 ) || ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_xTaskAbortDelay == 1 ) )
+#if ( configUSE_EDF_SCHEDULING == 1 )
 
-    eTaskState eTaskGetState( TaskHandle_t xTask )
+    void vTaskSetDeadline( TaskHandle_t xTask,
+                           TickType_t xDeadline )
     {
-        eTaskState eReturn;
-        List_t const * pxStateList;
-        List_t const * pxEventList;
-        List_t const * pxDelayedList;
-        List_t const * pxOverflowedDelayedList;
-        const TCB_t * const pxTCB = xTask;
+        TCB_t * pxTCB;
 
-        traceENTER_eTaskGetState( xTask );
+        traceENTER_vTaskSetDeadline( xTask, xDeadline );
 
-        configASSERT( pxTCB != NULL );
+        taskENTER_CRITICAL();
+        {
+            /* If null is passed in here then it is the deadline of the calling
+             * task that is being changed. */
+            pxTCB = prvGetTCBFromHandle( xTask );
+            configASSERT( pxTCB != NULL );
 
-        #if ( configNUMBER_OF_CORES == 1 )
-            if( pxTCB == pxCurrentTCB )
+            prvSetDeadline( pxTCB, xDeadline );
+
+            if( xSchedulerRunning != pdFALSE )
             {
-                /* The task calling this function is querying its own state. */
-                eReturn = eRunning;
+                if( pxTCB == pxCurrentTCB )
+                {
+                    /* A later deadline can place another ready task of the
+                     * same priority ahead of the calling task. */
+                    if( listGET_OWNER_OF_HEAD_ENTRY( &( pxReadyTasksLists[ pxTCB->uxPriority ] ) ) != pxTCB )
+                    {
+                        taskYIELD_TASK_CORE_IF_USING_PREEMPTION( pxTCB );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxTCB->uxPriority ] ), &( pxTCB->xStateListItem ) ) != pdFALSE )
+                {
+                    /* An earlier deadline can place a ready task ahead of the
+                     * running task. */
+                    taskYIELD_ANY_CORE_IF_USING_PREEMPTION( pxTCB );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
             }
             else
-        #endif
-        {
-            taskENTER_CRITICAL();
             {
-                pxStateList = listLIST_ITEM_CONTAINER( &( pxTCB->xStateListItem ) );
-                pxEventList = listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) );
-                pxDelayedList = pxDelayedTaskList;
-                pxOverflowedDelayedList = pxOverflowDelayedTaskList;
+                mtCOVERAGE_TEST_MARKER();
             }
-            taskEXIT_CRITICAL();
+        }
+        taskEXIT_CRITICAL();
 
-            if( pxEventList == &xPendingReadyList )
-            {
-                /* The task has been placed on the pending ready list, so its
-                 * state is eReady regardless of what list the task's state list
-                 * item is currently placed on. */
-                eReturn = eReady;
-            }
-            else if( ( pxStateList == pxDelayedList ) || ( pxStateList == pxOverflowedDelayedList ) )
-            {
-                /* The task being queried is referenced from one of the Blocked
-                 * lists. */
-                eReturn = eBlocked;
-            }
+        traceRETURN_vTaskSetDeadline();
+    }
 
-            #if ( INCLUDE_vTaskSuspend == 1 )
-                else if( pxStateList == &xSuspendedTaskList )
-                {
-                    /* The task being queried is referenced from the suspended
-                     * list.  Is it genuinely suspended or is it blocked
-                     * indefinitely? */
-                    if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) == NULL )
-                    {
-                        #if ( configUSE_TASK_NOTIFICATIONS == 1 )
-                        {
-                            BaseType_t x;
+#endif /* configUSE_EDF_SCHEDULING */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_EDF_SCHEDULING == 1 )
+
+    TickType_t xTaskGetDeadline( TaskHandle_t xTask )
+    {
+        TCB_t const * pxTCB;
+        TickType_t xReturn;
+
+        traceENTER_xTaskGetDeadline( xTask );
+
+        portBASE_TYPE_ENTER_CRITICAL();
+        {
+            /* If null is passed in here then it is the deadline of the calling
+             * task that is being queried. */
+            pxTCB = prvGetTCBFromHandle( xTask );
+            configASSERT( pxTCB != NULL );
+
+            xReturn = pxTCB->xDeadline;
+        }
+        portBASE_TYPE_EXIT_CRITICAL();
+
+        traceRETURN_xTaskGetDeadline( xReturn );
+
+        return xReturn;
+    }
+
+#endif /* configUSE_EDF_SCHEDULING */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_EDF_SCHEDULING == 1 ) && ( INCLUDE_xTaskDelayUntil == 1 ) )
+
+    BaseType_t xTaskDelayUntilWithDeadline( TickType_t * const pxPreviousWakeTime,
+                                            const TickType_t xTimeIncrement,
+                                            const TickType_t xRelativeDeadline )
+    {
+        BaseType_t xReturn;
+
+        traceENTER_xTaskDelayUntilWithDeadline( pxPreviousWakeTime, xTimeIncrement, xRelativeDeadline );
+
+        configASSERT( pxPreviousWakeTime );
+
+        /* The deadline of the next release is set before the task blocks, so
+         * the task is placed in deadline order as soon as it is unblocked.  The
+         * calling task has finished the work of its current release, so no
+         * yield is needed here if this lets another task ahead of it. */
+        taskENTER_CRITICAL();
+        {
+            prvSetDeadline( pxCurrentTCB, *pxPreviousWakeTime + xTimeIncrement + xRelativeDeadline );
+        }
+        taskEXIT_CRITICAL();
+
+        xReturn = xTaskDelayUntil( pxPreviousWakeTime, xTimeIncrement );
+
+        traceRETURN_xTaskDelayUntilWithDeadline( xReturn );
+
+        return xReturn;
+    }
+
+#endif /* ( ( configUSE_EDF_SCHEDULING == 1 ) && ( INCLUDE_xTaskDelayUntil == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TIME_PARTITIONING == 1 )
+
+    static UBaseType_t prvParkInactiveTasks( void )
+    {
+        UBaseType_t uxPriority;
+        UBaseType_t uxParked = ( UBaseType_t ) 0U;
+        ListItem_t * pxItem;
+        ListItem_t const * pxEndMarker;
+        TCB_t * pxTCB;
+
+        for( uxPriority = ( UBaseType_t ) 0U; uxPriority < ( UBaseType_t ) configMAX_PRIORITIES; uxPriority++ )
+        {
+            pxEndMarker = listGET_END_MARKER( &( pxReadyTasksLists[ uxPriority ] ) );
+            pxItem = listGET_HEAD_ENTRY( &( pxReadyTasksLists[ uxPriority ] ) );
+
+            while( pxItem != pxEndMarker )
+            {
+                /* MISRA Ref 11.5.3 [Void pointer assignment] */
+                /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+                /* coverity[misra_c_2012_rule_11_5_violation] */
+                pxTCB = listGET_LIST_ITEM_OWNER( pxItem );
+
+                /* Move on before the item is removed from the list. */
+                pxItem = listGET_NEXT( pxItem );
+
+                if( taskPARTITION_IS_ACTIVE( pxTCB ) == pdFALSE )
+                {
+                    if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+                    {
+                        taskRESET_READY_PRIORITY( pxTCB->uxPriority );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    listINSERT_END( &( xPartitionReadyLists[ pxTCB->uxPartition ] ), &( pxTCB->xStateListItem ) );
+                    uxParked++;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+
+        return uxParked;
+    }
+
+#endif /* configUSE_TIME_PARTITIONING */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TIME_PARTITIONING == 1 )
+
+    static void prvReadyPartitionTasks( UBaseType_t uxPartition )
+    {
+        List_t * const pxList = &( xPartitionReadyLists[ uxPartition ] );
+        TCB_t * pxTCB;
+
+        /* The partition must already own the window, otherwise
+         * prvAddTaskToReadyList() would place each task back in pxList. */
+        configASSERT( uxPartition == uxActivePartition );
+
+        while( listLIST_IS_EMPTY( pxList ) == pdFALSE )
+        {
+            /* MISRA Ref 11.5.3 [Void pointer assignment] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+            /* coverity[misra_c_2012_rule_11_5_violation] */
+            pxTCB = listGET_OWNER_OF_HEAD_ENTRY( pxList );
+            listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
+            prvAddTaskToReadyList( pxTCB );
+        }
+    }
+
+#endif /* configUSE_TIME_PARTITIONING */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TIME_PARTITIONING == 1 )
+
+    static BaseType_t prvSwitchPartitionWindow( void )
+    {
+        const UBaseType_t uxOutgoingPartition = uxActivePartition;
+        UBaseType_t uxIncomingPartition;
+        BaseType_t xSwitchRequired = pdFALSE;
+
+        /* Called from the tick interrupt with the scheduler not suspended, so
+         * the ready lists can be accessed. */
+        taskGET_PARTITION_TIMESTAMP( ulPartitionSwitchStartTime );
+
+        uxPartitionWindowIndex++;
+
+        if( uxPartitionWindowIndex >= uxPartitionWindowCount )
+        {
+            uxPartitionWindowIndex = ( UBaseType_t ) 0U;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        uxIncomingPartition = pxPartitionWindows[ uxPartitionWindowIndex ].uxPartition;
+        xNextPartitionSwitchTime += pxPartitionWindows[ uxPartitionWindowIndex ].xDuration;
+
+        if( uxIncomingPartition != uxOutgoingPartition )
+        {
+            uxActivePartition = uxIncomingPartition;
+
+            /* Only tasks of the outgoing partition can be ready but no longer
+             * able to run, so any moved out of the ready lists had work left
+             * when its window ended. */
+            if( prvParkInactiveTasks() != ( UBaseType_t ) 0U )
+            {
+                xPartitionStatus[ uxOutgoingPartition ].ulOverruns++;
+
+                #if ( configUSE_PARTITION_OVERRUN_HOOK == 1 )
+                {
+                    vApplicationPartitionOverrunHook( uxOutgoingPartition );
+                }
+                #endif
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            if( uxIncomingPartition != tskNO_PARTITION )
+            {
+                xPartitionStatus[ uxIncomingPartition ].ulWindows++;
+                prvReadyPartitionTasks( uxIncomingPartition );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            /* The running task may belong to the outgoing partition, and tasks
+             * of the incoming one may outrank it. */
+            xPartitionSwitchPending = pdTRUE;
+            xSwitchRequired = pdTRUE;
+        }
+        else
+        {
+            /* Consecutive windows of the same partition act as one. */
+            if( uxIncomingPartition != tskNO_PARTITION )
+            {
+                xPartitionStatus[ uxIncomingPartition ].ulWindows++;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+        return xSwitchRequired;
+    }
+
+#endif /* configUSE_TIME_PARTITIONING */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TIME_PARTITIONING == 1 )
+
+    BaseType_t xTaskSetPartitionSchedule( const TaskPartitionWindow_t * const pxWindows,
+                                          UBaseType_t uxWindowCount )
+    {
+        BaseType_t xReturn = pdPASS;
+        UBaseType_t uxWindow;
+
+        traceENTER_xTaskSetPartitionSchedule( pxWindows, uxWindowCount );
+
+        /* The windows are counted from the start of the scheduler. */
+        configASSERT( xSchedulerRunning == pdFALSE );
+        configASSERT( pxWindows != NULL );
+
+        if( uxWindowCount == ( UBaseType_t ) 0U )
+        {
+            xReturn = pdFAIL;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        for( uxWindow = ( UBaseType_t ) 0U; uxWindow < uxWindowCount; uxWindow++ )
+        {
+            if( ( pxWindows[ uxWindow ].xDuration == ( TickType_t ) 0U ) ||
+                ( ( pxWindows[ uxWindow ].uxPartition >= ( UBaseType_t ) configMAX_PARTITIONS ) &&
+                  ( pxWindows[ uxWindow ].uxPartition != tskNO_PARTITION ) ) )
+            {
+                xReturn = pdFAIL;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+        if( xReturn == pdPASS )
+        {
+            taskENTER_CRITICAL();
+            {
+                pxPartitionWindows = pxWindows;
+                uxPartitionWindowCount = uxWindowCount;
+                uxPartitionWindowIndex = ( UBaseType_t ) 0U;
+                uxActivePartition = pxWindows[ 0 ].uxPartition;
+
+                ( void ) memset( xPartitionStatus, 0x00, sizeof( xPartitionStatus ) );
+
+                for( uxWindow = ( UBaseType_t ) 0U; uxWindow < uxWindowCount; uxWindow++ )
+                {
+                    if( pxWindows[ uxWindow ].uxPartition != tskNO_PARTITION )
+                    {
+                        xPartitionStatus[ pxWindows[ uxWindow ].uxPartition ].xBudget += pxWindows[ uxWindow ].xDuration;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+
+                /* Tasks already bound to a partition other than that of the
+                 * first window must wait for their window.  The lists only
+                 * exist once a task has been created. */
+                if( uxCurrentNumberOfTasks != ( UBaseType_t ) 0U )
+                {
+                    ( void ) prvParkInactiveTasks();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            taskEXIT_CRITICAL();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_xTaskSetPartitionSchedule( xReturn );
+
+        return xReturn;
+    }
+
+#endif /* configUSE_TIME_PARTITIONING */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TIME_PARTITIONING == 1 )
+
+    void vTaskSetPartition( TaskHandle_t xTask,
+                            UBaseType_t uxPartition )
+    {
+        TCB_t * pxTCB;
+        UBaseType_t uxOldPartition;
+
+        traceENTER_vTaskSetPartition( xTask, uxPartition );
+
+        configASSERT( ( uxPartition < ( UBaseType_t ) configMAX_PARTITIONS ) || ( uxPartition == tskNO_PARTITION ) );
+
+        taskENTER_CRITICAL();
+        {
+            /* If null is passed in here then it is the calling task that is
+             * being bound. */
+            pxTCB = prvGetTCBFromHandle( xTask );
+            configASSERT( pxTCB != NULL );
+
+            uxOldPartition = pxTCB->uxPartition;
+            pxTCB->uxPartition = uxPartition;
+
+            if( ( uxOldPartition != tskNO_PARTITION ) &&
+                ( listIS_CONTAINED_WITHIN( &( xPartitionReadyLists[ uxOldPartition ] ), &( pxTCB->xStateListItem ) ) != pdFALSE ) )
+            {
+                /* The task was waiting for a window of its old partition.  It
+                 * is either made ready or moved to the list of its new
+                 * partition. */
+                listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
+                prvAddTaskToReadyList( pxTCB );
+
+                if( xSchedulerRunning != pdFALSE )
+                {
+                    taskYIELD_ANY_CORE_IF_USING_PREEMPTION( pxTCB );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else if( ( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxTCB->uxPriority ] ), &( pxTCB->xStateListItem ) ) != pdFALSE ) &&
+                     ( taskPARTITION_IS_ACTIVE( pxTCB ) == pdFALSE ) )
+            {
+                /* The task is ready, but its new partition is outside its
+                 * window. */
+                if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+                {
+                    taskRESET_READY_PRIORITY( pxTCB->uxPriority );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                listINSERT_END( &( xPartitionReadyLists[ uxPartition ] ), &( pxTCB->xStateListItem ) );
+
+                if( ( xSchedulerRunning != pdFALSE ) && ( pxTCB == pxCurrentTCB ) )
+                {
+                    taskYIELD_TASK_CORE_IF_USING_PREEMPTION( pxTCB );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        traceRETURN_vTaskSetPartition();
+    }
+
+#endif /* configUSE_TIME_PARTITIONING */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TIME_PARTITIONING == 1 )
+
+    UBaseType_t uxTaskGetPartition( TaskHandle_t xTask )
+    {
+        TCB_t const * pxTCB;
+        UBaseType_t uxReturn;
+
+        traceENTER_uxTaskGetPartition( xTask );
+
+        portBASE_TYPE_ENTER_CRITICAL();
+        {
+            /* If null is passed in here then it is the partition of the
+             * calling task that is being queried. */
+            pxTCB = prvGetTCBFromHandle( xTask );
+            configASSERT( pxTCB != NULL );
+
+            uxReturn = pxTCB->uxPartition;
+        }
+        portBASE_TYPE_EXIT_CRITICAL();
+
+        traceRETURN_uxTaskGetPartition( uxReturn );
+
+        return uxReturn;
+    }
+
+#endif /* configUSE_TIME_PARTITIONING */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TIME_PARTITIONING == 1 )
+
+    BaseType_t xTaskGetPartitionStatus( UBaseType_t uxPartition,
+                                        TaskPartitionStatus_t * pxPartitionStatus )
+    {
+        BaseType_t xReturn;
+
+        traceENTER_xTaskGetPartitionStatus( uxPartition, pxPartitionStatus );
+
+        configASSERT( pxPartitionStatus != NULL );
+
+        if( uxPartition < ( UBaseType_t ) configMAX_PARTITIONS )
+        {
+            /* The counters are updated from the tick interrupt. */
+            taskENTER_CRITICAL();
+            {
+                *pxPartitionStatus = xPartitionStatus[ uxPartition ];
+            }
+            taskEXIT_CRITICAL();
+
+            xReturn = pdPASS;
+        }
+        else
+        {
+            xReturn = pdFAIL;
+        }
+
+        traceRETURN_xTaskGetPartitionStatus( xReturn );
+
+        return xReturn;
+    }
+
+#endif /* configUSE_TIME_PARTITIONING */
+/*-----------------------------------------------------------*/
+
+#if ( INCLUDE_vTaskDelay == 1 )
+
+    void vTaskDelay( const TickType_t xTicksToDelay )
+    {
+        BaseType_t xAlreadyYielded = pdFALSE;
+
+        traceENTER_vTaskDelay( xTicksToDelay );
+
+        /* A delay time of zero just forces a reschedule. */
+        if( xTicksToDelay > ( TickType_t ) 0U )
+        {
+            vTaskSuspendAll();
+            {
+                configASSERT( uxSchedulerSuspended == 1U );
+
+                traceTASK_DELAY();
+
+                /* A task that is removed from the event list while the
+                 * scheduler is suspended will not get placed in the ready
+                 * list or removed from the blocked list until the scheduler
+                 * is resumed.
+                 *
+                 * This task cannot be in an event list as it is the currently
+                 * executing task. */
+                prvAddCurrentTaskToDelayedList( xTicksToDelay, pdFALSE );
+            }
+            xAlreadyYielded = xTaskResumeAll();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* Force a reschedule if xTaskResumeAll has not already done so, we may
+         * have put ourselves to sleep. */
+        if( xAlreadyYielded == pdFALSE )
+        {
+            taskYIELD_WITHIN_API();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_vTaskDelay();
+    }
+
+#endif /* INCLUDE_vTaskDelay */
+/*-----------------------------------------------------------*/
+
+#if ( ( INCLUDE_eTaskGetState == 1 ) || ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_xTaskAbortDelay == 1 ) )
+
+    eTaskState eTaskGetState( TaskHandle_t xTask )
+    {
+        eTaskState eReturn;
+        List_t const * pxStateList;
+        List_t const * pxEventList;
+        List_t const * pxDelayedList;
+        List_t const * pxOverflowedDelayedList;
+        const TCB_t * const pxTCB = xTask;
+
+        traceENTER_eTaskGetState( xTask );
+
+        configASSERT( pxTCB != NULL );
+
+        #if ( configNUMBER_OF_CORES == 1 )
+            if( pxTCB == pxCurrentTCB )
+            {
+                /* The task calling this function is querying its own state. */
+                eReturn = eRunning;
+            }
+            else
+        #endif
+        {
+            taskENTER_CRITICAL();
+            {
+                pxStateList = listLIST_ITEM_CONTAINER( &( pxTCB->xStateListItem ) );
+                pxEventList = listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) );
+                pxDelayedList = pxDelayedTaskList;
+                pxOverflowedDelayedList = pxOverflowDelayedTaskList;
+            }
+            taskEXIT_CRITICAL();
+
+            if( pxEventList == &xPendingReadyList )
+            {
+                /* The task has been placed on the pending ready list, so its
+                 * state is eReady regardless of what list the task's state list
+                 * item is currently placed on. */
+                eReturn = eReady;
+            }
+            else if( ( pxStateList == pxDelayedList ) || ( pxStateList == pxOverflowedDelayedList ) )
+            {
+                /* The task being queried is referenced from one of the Blocked
+                 * lists. */
+                eReturn = eBlocked;
+            }
+
+            #if ( INCLUDE_vTaskSuspend == 1 )
+                else if( pxStateList == &xSuspendedTaskList )
+                {
+                    /* The task being queried is referenced from the suspended
+                     * list.  Is it genuinely suspended or is it blocked
+                     * indefinitely? */
+                    if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) == NULL )
+                    {
+                        #if ( configUSE_TASK_NOTIFICATIONS == 1 )
+                        {
+                            BaseType_t x;
 
                             /* The task does not appear on the event list item of
                              * and of the RTOS objects, but could still be in the
@@ -3484,7 +4383,7 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
                     {
                         /* Ready lists can be accessed so move the task from the
                          * suspended list to the ready list directly. */
-                        if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                        if( taskPREEMPTS_CURRENT_TASK( pxTCB ) )
                         {
                             xYieldRequired = pdTRUE;
 
@@ -3733,6 +4632,41 @@ void vTaskStartScheduler( void )
          * starts to run. */
         portDISABLE_INTERRUPTS();
 
+        #if ( configUSE_TIME_PARTITIONING == 1 )
+        {
+            if( pxPartitionWindows != NULL )
+            {
+                /* The first window of the major frame starts with the
+                 * scheduler. */
+                xNextPartitionSwitchTime = ( TickType_t ) configINITIAL_TICK_COUNT + pxPartitionWindows[ 0 ].xDuration;
+
+                if( uxActivePartition != tskNO_PARTITION )
+                {
+                    xPartitionStatus[ uxActivePartition ].ulWindows++;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                /* The task chosen to run first when the tasks were created may
+                 * since have been bound to a partition outside its window. */
+                if( taskPARTITION_IS_ACTIVE( pxCurrentTCB ) == pdFALSE )
+                {
+                    taskSELECT_HIGHEST_PRIORITY_TASK();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configUSE_TIME_PARTITIONING */
+
         #if ( configUSE_C_RUNTIME_TLS_SUPPORT == 1 )
         {
             /* Switch C-Runtime's TLS Block to point to the TLS
@@ -4056,7 +4990,7 @@ BaseType_t xTaskResumeAll( void )
                         {
                             /* If the moved task has a priority higher than the current
                              * task then a yield must be performed. */
-                            if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                            if( taskPREEMPTS_CURRENT_TASK( pxTCB ) )
                             {
                                 xYieldPendings[ xCoreID ] = pdTRUE;
                             }
@@ -4339,6 +5273,16 @@ char * pcTaskGetName( TaskHandle_t xTaskToQuery )
                 }
             } while( uxQueue > ( UBaseType_t ) tskIDLE_PRIORITY );
 
+            #if ( configUSE_TIME_PARTITIONING == 1 )
+            {
+                /* Search the ready tasks of partitions outside their window. */
+                for( uxQueue = ( UBaseType_t ) 0U; ( uxQueue < ( UBaseType_t ) configMAX_PARTITIONS ) && ( pxTCB == NULL ); uxQueue++ )
+                {
+                    pxTCB = prvSearchForNameWithinSingleList( &( xPartitionReadyLists[ uxQueue ] ), pcNameToQuery );
+                }
+            }
+            #endif
+
             /* Search the delayed lists. */
             if( pxTCB == NULL )
             {
@@ -4458,6 +5402,17 @@ char * pcTaskGetName( TaskHandle_t xTaskToQuery )
                     uxTask = ( UBaseType_t ) ( uxTask + prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &( pxReadyTasksLists[ uxQueue ] ), eReady ) );
                 } while( uxQueue > ( UBaseType_t ) tskIDLE_PRIORITY );
 
+                #if ( configUSE_TIME_PARTITIONING == 1 )
+                {
+                    /* The tasks of partitions outside their window are also in
+                     * the Ready state. */
+                    for( uxQueue = ( UBaseType_t ) 0U; uxQueue < ( UBaseType_t ) configMAX_PARTITIONS; uxQueue++ )
+                    {
+                        uxTask = ( UBaseType_t ) ( uxTask + prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &( xPartitionReadyLists[ uxQueue ] ), eReady ) );
+                    }
+                }
+                #endif
+
                 /* Fill in an TaskStatus_t structure with information on each
                  * task in the Blocked state. */
                 uxTask = ( UBaseType_t ) ( uxTask + prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxDelayedTaskList, eBlocked ) );
@@ -4684,7 +5639,7 @@ BaseType_t xTaskCatchUpTicks( TickType_t xTicksToCatchUp )
                         /* Preemption is on, but a context switch should only be
                          * performed if the unblocked task has a priority that is
                          * higher than the currently executing task. */
-                        if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                        if( taskPREEMPTS_CURRENT_TASK( pxTCB ) )
                         {
                             /* Pend the yield to be performed when the scheduler
                              * is unsuspended. */
@@ -4730,6 +5685,14 @@ BaseType_t xTaskIncrementTick( void )
 
     traceENTER_xTaskIncrementTick();
 
+    #if ( configUSE_CRITICAL_PROFILER == 1 )
+    {
+        /* The port calls xTaskIncrementTick() with interrupts masked, so its
+         * body is profiled as a critical section of its own. */
+        vCriticalProfilerEnter( __FILE__, ( uint32_t ) __LINE__ );
+    }
+    #endif
+
     /* Called by the portable layer each time a tick interrupt occurs.
      * Increments the tick then checks to see if the new tick value will cause any
      * tasks to be unblocked. */
@@ -4758,6 +5721,48 @@ BaseType_t xTaskIncrementTick( void )
             mtCOVERAGE_TEST_MARKER();
         }
 
+        #if ( configUSE_TIME_PARTITIONING == 1 )
+        {
+            if( pxPartitionWindows != NULL )
+            {
+                /* Charge the tick that has just ended to the partition of the
+                 * task that was running during it. */
+                if( ( uxActivePartition != tskNO_PARTITION ) && ( pxCurrentTCB->uxPartition == uxActivePartition ) )
+                {
+                    xPartitionStatus[ uxActivePartition ].ulUsedTicks++;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                /* The window is switched before the delayed tasks are
+                 * unblocked, so a task that wakes at the boundary is placed
+                 * according to the incoming window rather than being parked
+                 * with the outgoing partition and counted as its overrun. */
+                if( xConstTickCount == xNextPartitionSwitchTime )
+                {
+                    if( prvSwitchPartitionWindow() != pdFALSE )
+                    {
+                        xSwitchRequired = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configUSE_TIME_PARTITIONING */
+
         /* See if this tick has made a timeout expire.  Tasks are stored in
          * the  queue in the order of their wake time - meaning once one task
          * has been found whose block time has not expired there is no need to
@@ -4835,7 +5840,7 @@ BaseType_t xTaskIncrementTick( void )
                              * processing time (which happens when both
                              * preemption and time slicing are on) is
                              * handled below.*/
-                            if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                            if( taskPREEMPTS_CURRENT_TASK( pxTCB ) )
                             {
                                 xSwitchRequired = pdTRUE;
                             }
@@ -4860,7 +5865,26 @@ BaseType_t xTaskIncrementTick( void )
          * writer has not explicitly turned time slicing off. */
         #if ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) )
         {
-            #if ( configNUMBER_OF_CORES == 1 )
+            #if ( ( configNUMBER_OF_CORES == 1 ) && ( configUSE_EDF_SCHEDULING == 1 ) )
+            {
+                /* The ready list is ordered by deadline, so only the tasks
+                 * that share the running task's deadline, which follow it in
+                 * the list, take turns with it. */
+                const List_t * const pxReadyList = &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] );
+                const ListItem_t * const pxNextItem = listGET_NEXT( &( pxCurrentTCB->xStateListItem ) );
+
+                if( ( listIS_CONTAINED_WITHIN( pxReadyList, &( pxCurrentTCB->xStateListItem ) ) != pdFALSE ) &&
+                    ( pxNextItem != listGET_END_MARKER( pxReadyList ) ) &&
+                    ( listGET_LIST_ITEM_VALUE( pxNextItem ) == pxCurrentTCB->xDeadline ) )
+                {
+                    xSwitchRequired = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #elif ( configNUMBER_OF_CORES == 1 )
             {
                 if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ) ) > 1U )
                 {
@@ -4966,6 +5990,12 @@ BaseType_t xTaskIncrementTick( void )
         #endif
     }
 
+    #if ( configUSE_CRITICAL_PROFILER == 1 )
+    {
+        vCriticalProfilerExit();
+    }
+    #endif
+
     traceRETURN_xTaskIncrementTick( xSwitchRequired );
 
     return xSwitchRequired;
@@ -5110,6 +6140,14 @@ BaseType_t xTaskIncrementTick( void )
     {
         traceENTER_vTaskSwitchContext();
 
+        #if ( configUSE_CRITICAL_PROFILER == 1 )
+        {
+            /* As for xTaskIncrementTick(), the port calls
+             * vTaskSwitchContext() with interrupts masked. */
+            vCriticalProfilerEnter( __FILE__, ( uint32_t ) __LINE__ );
+        }
+        #endif
+
         if( uxSchedulerSuspended != ( UBaseType_t ) 0U )
         {
             /* The scheduler is currently suspended - do not allow a context
@@ -5167,6 +6205,43 @@ BaseType_t xTaskIncrementTick( void )
             taskSELECT_HIGHEST_PRIORITY_TASK();
             traceTASK_SWITCHED_IN();
 
+            #if ( configUSE_TIME_PARTITIONING == 1 )
+            {
+                if( xPartitionSwitchPending != pdFALSE )
+                {
+                    configRUN_TIME_COUNTER_TYPE ulOverhead;
+
+                    /* This is the first context switch since a window of
+                     * another partition started. */
+                    xPartitionSwitchPending = pdFALSE;
+                    taskGET_PARTITION_TIMESTAMP( ulOverhead );
+                    ulOverhead -= ulPartitionSwitchStartTime;
+
+                    if( uxActivePartition != tskNO_PARTITION )
+                    {
+                        xPartitionStatus[ uxActivePartition ].ulLastSwitchOverhead = ulOverhead;
+
+                        if( ulOverhead > xPartitionStatus[ uxActivePartition ].ulMaxSwitchOverhead )
+                        {
+                            xPartitionStatus[ uxActivePartition ].ulMaxSwitchOverhead = ulOverhead;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif /* configUSE_TIME_PARTITIONING */
+
             /* Macro to inject port specific behaviour immediately after
              * switching tasks, such as setting an end of stack watchpoint
              * or reconfiguring the MPU. */
@@ -5188,6 +6263,12 @@ BaseType_t xTaskIncrementTick( void )
             #endif
         }
 
+        #if ( configUSE_CRITICAL_PROFILER == 1 )
+        {
+            vCriticalProfilerExit();
+        }
+        #endif
+
         traceRETURN_vTaskSwitchContext();
     }
 #else /* if ( configNUMBER_OF_CORES == 1 ) */
@@ -5446,7 +6527,7 @@ BaseType_t xTaskRemoveFromEventList( const List_t * const pxEventList )
 
     #if ( configNUMBER_OF_CORES == 1 )
     {
-        if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+        if( taskPREEMPTS_CURRENT_TASK( pxUnblockedTCB ) )
         {
             /* Return true if the task removed from the event list has a higher
              * priority than the calling task.  This allows the calling task to know if
@@ -5529,7 +6610,7 @@ void vTaskRemoveFromUnorderedEventList( ListItem_t * pxEventListItem,
 
     #if ( configNUMBER_OF_CORES == 1 )
     {
-        if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+        if( taskPREEMPTS_CURRENT_TASK( pxUnblockedTCB ) )
         {
             /* The unblocked task has a priority above that of the calling task, so
              * a context switch is required.  This function is called with the
@@ -5556,6 +6637,91 @@ void vTaskRemoveFromUnorderedEventList( ListItem_t * pxEventListItem,
 }
 /*-----------------------------------------------------------*/
 
+#if ( ( configUSE_EVENT_GROUPS == 1 ) && ( configUSE_DIRECT_EVENT_GROUPS == 1 ) )
+
+    BaseType_t xTaskRemoveFromUnorderedEventListFromISR( ListItem_t * pxEventListItem,
+                                                         const TickType_t xItemValue )
+    {
+        TCB_t * pxUnblockedTCB;
+        BaseType_t xReturn;
+
+        traceENTER_xTaskRemoveFromUnorderedEventListFromISR( pxEventListItem, xItemValue );
+
+        /* THIS FUNCTION MUST BE CALLED FROM A CRITICAL SECTION.  It is used by
+         * event groups that interrupts unblock directly, and unlike
+         * vTaskRemoveFromUnorderedEventList() it can be called while the
+         * scheduler is not suspended. */
+
+        /* Store the new item value in the event list. */
+        listSET_LIST_ITEM_VALUE( pxEventListItem, xItemValue | taskEVENT_LIST_ITEM_VALUE_IN_USE );
+
+        /* MISRA Ref 11.5.3 [Void pointer assignment] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+        /* coverity[misra_c_2012_rule_11_5_violation] */
+        pxUnblockedTCB = listGET_LIST_ITEM_OWNER( pxEventListItem );
+        configASSERT( pxUnblockedTCB );
+        listREMOVE_ITEM( pxEventListItem );
+
+        if( uxSchedulerSuspended == ( UBaseType_t ) 0U )
+        {
+            listREMOVE_ITEM( &( pxUnblockedTCB->xStateListItem ) );
+            prvAddTaskToReadyList( pxUnblockedTCB );
+
+            #if ( configUSE_TICKLESS_IDLE != 0 )
+            {
+                /* See xTaskRemoveFromEventList(). */
+                prvResetNextTaskUnblockTime();
+            }
+            #endif
+        }
+        else
+        {
+            /* The delayed and ready lists cannot be accessed, so hold this task
+             * pending until the scheduler is resumed.  The event list item keeps
+             * the value stored above, which the task reads when it runs. */
+            listINSERT_END( &( xPendingReadyList ), &( pxUnblockedTCB->xEventListItem ) );
+        }
+
+        #if ( configNUMBER_OF_CORES == 1 )
+        {
+            if( taskPREEMPTS_CURRENT_TASK( pxUnblockedTCB ) )
+            {
+                /* Return true if the unblocked task has a higher priority than
+                 * the interrupted task, and mark that a yield is pending in case
+                 * the caller does not use the return value. */
+                xReturn = pdTRUE;
+                xYieldPendings[ 0 ] = pdTRUE;
+            }
+            else
+            {
+                xReturn = pdFALSE;
+            }
+        }
+        #else /* #if ( configNUMBER_OF_CORES == 1 ) */
+        {
+            xReturn = pdFALSE;
+
+            #if ( configUSE_PREEMPTION == 1 )
+            {
+                prvYieldForTask( pxUnblockedTCB );
+
+                if( xYieldPendings[ portGET_CORE_ID() ] != pdFALSE )
+                {
+                    xReturn = pdTRUE;
+                }
+            }
+            #endif /* #if ( configUSE_PREEMPTION == 1 ) */
+        }
+        #endif /* #if ( configNUMBER_OF_CORES == 1 ) */
+
+        traceRETURN_xTaskRemoveFromUnorderedEventListFromISR( xReturn );
+
+        return xReturn;
+    }
+
+#endif /* ( configUSE_EVENT_GROUPS == 1 ) && ( configUSE_DIRECT_EVENT_GROUPS == 1 ) */
+/*-----------------------------------------------------------*/
+
 void vTaskSetTimeOutState( TimeOut_t * const pxTimeOut )
 {
     traceENTER_vTaskSetTimeOutState( pxTimeOut );
@@ -5825,6 +6991,14 @@ static portTASK_FUNCTION( prvIdleTask, pvParameters )
          * is responsible for freeing the deleted task's TCB and stack. */
         prvCheckTasksWaitingTermination();
 
+        #if ( ( configCHECK_FOR_STACK_OVERFLOW == 3 ) && ( portUSING_MPU_WRAPPERS != 1 ) )
+        {
+            /* The guard zone contents are not checked on each context switch,
+             * so scan them from here, at most once per scan period. */
+            prvCheckStackGuards();
+        }
+        #endif
+
         #if ( configUSE_PREEMPTION == 0 )
         {
             /* If we are not using preemption we keep forcing a task switch to
@@ -6077,6 +7251,15 @@ static void prvInitialiseTaskLists( void )
     vListInitialise( &xDelayedTaskList2 );
     vListInitialise( &xPendingReadyList );
 
+    #if ( configUSE_TIME_PARTITIONING == 1 )
+    {
+        for( uxPriority = ( UBaseType_t ) 0U; uxPriority < ( UBaseType_t ) configMAX_PARTITIONS; uxPriority++ )
+        {
+            vListInitialise( &( xPartitionReadyLists[ uxPriority ] ) );
+        }
+    }
+    #endif /* configUSE_TIME_PARTITIONING */
+
     #if ( INCLUDE_vTaskDelete == 1 )
     {
         vListInitialise( &xTasksWaitingTermination );
@@ -6392,69 +7575,280 @@ static void prvCheckTasksWaitingTermination( void )
         uint8_t * pucEndOfStack;
         configSTACK_DEPTH_TYPE uxReturn;
 
-        traceENTER_uxTaskGetStackHighWaterMark2( xTask );
+        traceENTER_uxTaskGetStackHighWaterMark2( xTask );
+
+        /* uxTaskGetStackHighWaterMark() and uxTaskGetStackHighWaterMark2() are
+         * the same except for their return type.  Using configSTACK_DEPTH_TYPE
+         * allows the user to determine the return type.  It gets around the
+         * problem of the value overflowing on 8-bit types without breaking
+         * backward compatibility for applications that expect an 8-bit return
+         * type. */
+
+        pxTCB = prvGetTCBFromHandle( xTask );
+        configASSERT( pxTCB != NULL );
+
+        #if portSTACK_GROWTH < 0
+        {
+            pucEndOfStack = ( uint8_t * ) pxTCB->pxStack;
+        }
+        #else
+        {
+            pucEndOfStack = ( uint8_t * ) pxTCB->pxEndOfStack;
+        }
+        #endif
+
+        uxReturn = prvTaskCheckFreeStackSpace( pucEndOfStack );
+
+        traceRETURN_uxTaskGetStackHighWaterMark2( uxReturn );
+
+        return uxReturn;
+    }
+
+#endif /* INCLUDE_uxTaskGetStackHighWaterMark2 */
+/*-----------------------------------------------------------*/
+
+#if ( INCLUDE_uxTaskGetStackHighWaterMark == 1 )
+
+    UBaseType_t uxTaskGetStackHighWaterMark( TaskHandle_t xTask )
+    {
+        TCB_t * pxTCB;
+        uint8_t * pucEndOfStack;
+        UBaseType_t uxReturn;
+
+        traceENTER_uxTaskGetStackHighWaterMark( xTask );
+
+        pxTCB = prvGetTCBFromHandle( xTask );
+        configASSERT( pxTCB != NULL );
+
+        #if portSTACK_GROWTH < 0
+        {
+            pucEndOfStack = ( uint8_t * ) pxTCB->pxStack;
+        }
+        #else
+        {
+            pucEndOfStack = ( uint8_t * ) pxTCB->pxEndOfStack;
+        }
+        #endif
+
+        uxReturn = ( UBaseType_t ) prvTaskCheckFreeStackSpace( pucEndOfStack );
+
+        traceRETURN_uxTaskGetStackHighWaterMark( uxReturn );
+
+        return uxReturn;
+    }
+
+#endif /* INCLUDE_uxTaskGetStackHighWaterMark */
+/*-----------------------------------------------------------*/
+
+#if ( ( configCHECK_FOR_STACK_OVERFLOW == 3 ) && ( portUSING_MPU_WRAPPERS != 1 ) )
+
+    static configSTACK_DEPTH_TYPE prvGetStackOverflowDepth( const TCB_t * pxTCB )
+    {
+        const uint8_t * pucStackByte;
+        const StackType_t * pxGuardLimit;
+        configSTACK_DEPTH_TYPE uxIntactBytes = 0U;
+        configSTACK_DEPTH_TYPE uxDepth;
+        configSTACK_DEPTH_TYPE uxSavedDepth = 0U;
+
+        /* Count the guard zone bytes that still hold the fill pattern, starting
+         * from the far end of the stack.  Stack usage grows towards the far
+         * end, so the first overwritten byte marks the deepest point the task
+         * has reached. */
+        #if ( portSTACK_GROWTH < 0 )
+        {
+            pucStackByte = ( const uint8_t * ) pxTCB->pxStack;
+            pxGuardLimit = pxTCB->pxStack + configSTACK_GUARD_WORDS;
+        }
+        #else
+        {
+            pucStackByte = ( const uint8_t * ) pxTCB->pxEndOfStack;
+            pxGuardLimit = pxTCB->pxEndOfStack - configSTACK_GUARD_WORDS;
+        }
+        #endif
+
+        while( ( uxIntactBytes < ( configSTACK_DEPTH_TYPE ) ( configSTACK_GUARD_WORDS * sizeof( StackType_t ) ) ) &&
+               ( *pucStackByte == ( uint8_t ) tskSTACK_FILL_BYTE ) )
+        {
+            pucStackByte -= portSTACK_GROWTH;
+            uxIntactBytes++;
+        }
+
+        uxDepth = ( configSTACK_DEPTH_TYPE ) configSTACK_GUARD_WORDS - ( uxIntactBytes / ( configSTACK_DEPTH_TYPE ) sizeof( StackType_t ) );
+
+        /* The saved stack pointer can be beyond the guard zone, and the stack
+         * buffer, even when the fill pattern happens to be intact. */
+        #if ( portSTACK_GROWTH < 0 )
+        {
+            if( pxTCB->pxTopOfStack < pxGuardLimit )
+            {
+                uxSavedDepth = ( configSTACK_DEPTH_TYPE ) ( pxGuardLimit - pxTCB->pxTopOfStack );
+            }
+        }
+        #else
+        {
+            if( pxTCB->pxTopOfStack > pxGuardLimit )
+            {
+                uxSavedDepth = ( configSTACK_DEPTH_TYPE ) ( pxTCB->pxTopOfStack - pxGuardLimit );
+            }
+        }
+        #endif
+
+        if( uxSavedDepth > uxDepth )
+        {
+            uxDepth = uxSavedDepth;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return uxDepth;
+    }
+
+#endif /* ( ( configCHECK_FOR_STACK_OVERFLOW == 3 ) && ( portUSING_MPU_WRAPPERS != 1 ) ) */
+/*-----------------------------------------------------------*/
+
+#if ( ( configCHECK_FOR_STACK_OVERFLOW == 3 ) && ( portUSING_MPU_WRAPPERS != 1 ) )
+
+    static TCB_t * prvSearchForStackOverflowWithinSingleList( List_t * pxList )
+    {
+        TCB_t * pxReturn = NULL;
+        TCB_t * pxTCB;
+        const ListItem_t * pxEndMarker = listGET_END_MARKER( pxList );
+        ListItem_t * pxIterator;
+
+        /* This function is called with the scheduler suspended. */
+
+        if( listCURRENT_LIST_LENGTH( pxList ) > ( UBaseType_t ) 0 )
+        {
+            for( pxIterator = listGET_HEAD_ENTRY( pxList ); pxIterator != pxEndMarker; pxIterator = listGET_NEXT( pxIterator ) )
+            {
+                /* MISRA Ref 11.5.3 [Void pointer assignment] */
+                /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+                /* coverity[misra_c_2012_rule_11_5_violation] */
+                pxTCB = listGET_LIST_ITEM_OWNER( pxIterator );
+
+                if( prvGetStackOverflowDepth( pxTCB ) > ( configSTACK_DEPTH_TYPE ) 0U )
+                {
+                    pxReturn = pxTCB;
+                    break;
+                }
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pxReturn;
+    }
+
+#endif /* ( ( configCHECK_FOR_STACK_OVERFLOW == 3 ) && ( portUSING_MPU_WRAPPERS != 1 ) ) */
+/*-----------------------------------------------------------*/
+
+#if ( ( configCHECK_FOR_STACK_OVERFLOW == 3 ) && ( portUSING_MPU_WRAPPERS != 1 ) )
+
+    static void prvCheckStackGuards( void )
+    {
+        UBaseType_t uxQueue = configMAX_PRIORITIES;
+        TCB_t * pxTCB = NULL;
+
+        /* Only the idle task accesses xLastStackGuardScanTime, so no critical
+         * section is needed to read it. */
+        if( ( xTickCount - xLastStackGuardScanTime ) >= configSTACK_CANARY_SCAN_PERIOD_TICKS )
+        {
+            xLastStackGuardScanTime = xTickCount;
+
+            vTaskSuspendAll();
+            {
+                /* Search the ready lists. */
+                do
+                {
+                    uxQueue--;
+                    pxTCB = prvSearchForStackOverflowWithinSingleList( &( pxReadyTasksLists[ uxQueue ] ) );
+
+                    if( pxTCB != NULL )
+                    {
+                        break;
+                    }
+                } while( uxQueue > ( UBaseType_t ) tskIDLE_PRIORITY );
+
+                #if ( configUSE_TIME_PARTITIONING == 1 )
+                {
+                    /* Search the ready tasks of partitions outside their
+                     * window. */
+                    for( uxQueue = ( UBaseType_t ) 0U; ( uxQueue < ( UBaseType_t ) configMAX_PARTITIONS ) && ( pxTCB == NULL ); uxQueue++ )
+                    {
+                        pxTCB = prvSearchForStackOverflowWithinSingleList( &( xPartitionReadyLists[ uxQueue ] ) );
+                    }
+                }
+                #endif
+
+                /* Search the delayed lists.  Tasks in the pending ready list
+                 * are still referenced from one of these, or from the suspended
+                 * list. */
+                if( pxTCB == NULL )
+                {
+                    pxTCB = prvSearchForStackOverflowWithinSingleList( ( List_t * ) pxDelayedTaskList );
+                }
 
-        /* uxTaskGetStackHighWaterMark() and uxTaskGetStackHighWaterMark2() are
-         * the same except for their return type.  Using configSTACK_DEPTH_TYPE
-         * allows the user to determine the return type.  It gets around the
-         * problem of the value overflowing on 8-bit types without breaking
-         * backward compatibility for applications that expect an 8-bit return
-         * type. */
+                if( pxTCB == NULL )
+                {
+                    pxTCB = prvSearchForStackOverflowWithinSingleList( ( List_t * ) pxOverflowDelayedTaskList );
+                }
 
-        pxTCB = prvGetTCBFromHandle( xTask );
-        configASSERT( pxTCB != NULL );
+                #if ( INCLUDE_vTaskSuspend == 1 )
+                {
+                    if( pxTCB == NULL )
+                    {
+                        /* Search the suspended list. */
+                        pxTCB = prvSearchForStackOverflowWithinSingleList( &xSuspendedTaskList );
+                    }
+                }
+                #endif
 
-        #if portSTACK_GROWTH < 0
-        {
-            pucEndOfStack = ( uint8_t * ) pxTCB->pxStack;
+                /* The hook is called with the scheduler still suspended so the
+                 * task cannot be deleted while the hook inspects it. */
+                if( pxTCB != NULL )
+                {
+                    vApplicationStackOverflowHook( ( TaskHandle_t ) pxTCB, pxTCB->pcTaskName );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            ( void ) xTaskResumeAll();
         }
-        #else
+        else
         {
-            pucEndOfStack = ( uint8_t * ) pxTCB->pxEndOfStack;
+            mtCOVERAGE_TEST_MARKER();
         }
-        #endif
-
-        uxReturn = prvTaskCheckFreeStackSpace( pucEndOfStack );
-
-        traceRETURN_uxTaskGetStackHighWaterMark2( uxReturn );
-
-        return uxReturn;
     }
 
-#endif /* INCLUDE_uxTaskGetStackHighWaterMark2 */
+#endif /* ( ( configCHECK_FOR_STACK_OVERFLOW == 3 ) && ( portUSING_MPU_WRAPPERS != 1 ) ) */
 /*-----------------------------------------------------------*/
 
-#if ( INCLUDE_uxTaskGetStackHighWaterMark == 1 )
+#if ( ( configCHECK_FOR_STACK_OVERFLOW == 3 ) && ( portUSING_MPU_WRAPPERS != 1 ) )
 
-    UBaseType_t uxTaskGetStackHighWaterMark( TaskHandle_t xTask )
+    configSTACK_DEPTH_TYPE uxTaskGetStackOverflowDepth( TaskHandle_t xTask )
     {
         TCB_t * pxTCB;
-        uint8_t * pucEndOfStack;
-        UBaseType_t uxReturn;
+        configSTACK_DEPTH_TYPE uxReturn;
 
-        traceENTER_uxTaskGetStackHighWaterMark( xTask );
+        traceENTER_uxTaskGetStackOverflowDepth( xTask );
 
         pxTCB = prvGetTCBFromHandle( xTask );
         configASSERT( pxTCB != NULL );
 
-        #if portSTACK_GROWTH < 0
-        {
-            pucEndOfStack = ( uint8_t * ) pxTCB->pxStack;
-        }
-        #else
-        {
-            pucEndOfStack = ( uint8_t * ) pxTCB->pxEndOfStack;
-        }
-        #endif
-
-        uxReturn = ( UBaseType_t ) prvTaskCheckFreeStackSpace( pucEndOfStack );
+        uxReturn = prvGetStackOverflowDepth( pxTCB );
 
-        traceRETURN_uxTaskGetStackHighWaterMark( uxReturn );
+        traceRETURN_uxTaskGetStackOverflowDepth( uxReturn );
 
         return uxReturn;
     }
 
-#endif /* INCLUDE_uxTaskGetStackHighWaterMark */
+#endif /* ( ( configCHECK_FOR_STACK_OVERFLOW == 3 ) && ( portUSING_MPU_WRAPPERS != 1 ) ) */
 /*-----------------------------------------------------------*/
 
 #if ( INCLUDE_vTaskDelete == 1 )
@@ -6478,7 +7872,7 @@ static void prvCheckTasksWaitingTermination( void )
             /* The task can only have been allocated dynamically - free both
              * the stack and TCB. */
             vPortFreeStack( pxTCB->pxStack );
-            vPortFree( pxTCB );
+            vPortFreeObject( pxTCB );
         }
         #elif ( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 )
         {
@@ -6490,13 +7884,13 @@ static void prvCheckTasksWaitingTermination( void )
                 /* Both the stack and TCB were allocated dynamically, so both
                  * must be freed. */
                 vPortFreeStack( pxTCB->pxStack );
-                vPortFree( pxTCB );
+                vPortFreeObject( pxTCB );
             }
             else if( pxTCB->ucStaticallyAllocated == tskSTATICALLY_ALLOCATED_STACK_ONLY )
             {
                 /* Only the stack was statically allocated, so the TCB is the
                  * only memory that must be freed. */
-                vPortFree( pxTCB );
+                vPortFreeObject( pxTCB );
             }
             else
             {
@@ -6652,55 +8046,15 @@ static void prvResetNextTaskUnblockTime( void )
              * inherit the priority of the task attempting to obtain the mutex. */
             if( pxMutexHolderTCB->uxPriority < pxCurrentTCB->uxPriority )
             {
-                /* Adjust the mutex holder state to account for its new
-                 * priority.  Only reset the event list item value if the value is
-                 * not being used for anything else. */
-                if( ( listGET_LIST_ITEM_VALUE( &( pxMutexHolderTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == ( ( TickType_t ) 0U ) )
-                {
-                    listSET_LIST_ITEM_VALUE( &( pxMutexHolderTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) pxCurrentTCB->uxPriority );
-                }
-                else
-                {
-                    mtCOVERAGE_TEST_MARKER();
-                }
-
-                /* If the task being modified is in the ready state it will need
-                 * to be moved into a new list. */
-                if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxMutexHolderTCB->uxPriority ] ), &( pxMutexHolderTCB->xStateListItem ) ) != pdFALSE )
-                {
-                    if( uxListRemove( &( pxMutexHolderTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
-                    {
-                        /* It is known that the task is in its ready list so
-                         * there is no need to check again and the port level
-                         * reset macro can be called directly. */
-                        portRESET_READY_PRIORITY( pxMutexHolderTCB->uxPriority, uxTopReadyPriority );
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
+                prvRaisePriority( pxMutexHolderTCB, pxCurrentTCB->uxPriority );
 
-                    /* Inherit the priority before being moved into the new list. */
-                    pxMutexHolderTCB->uxPriority = pxCurrentTCB->uxPriority;
-                    prvAddTaskToReadyList( pxMutexHolderTCB );
-                    #if ( configNUMBER_OF_CORES > 1 )
-                    {
-                        /* The priority of the task is raised. Yield for this task
-                         * if it is not running. */
-                        if( taskTASK_IS_RUNNING( pxMutexHolderTCB ) != pdTRUE )
-                        {
-                            prvYieldForTask( pxMutexHolderTCB );
-                        }
-                    }
-                    #endif /* if ( configNUMBER_OF_CORES > 1 ) */
-                }
-                else
+                #if ( configUSE_TRANSITIVE_INHERITANCE == 1 )
                 {
-                    /* Just inherit the priority. */
-                    pxMutexHolderTCB->uxPriority = pxCurrentTCB->uxPriority;
+                    /* If the mutex holder is itself blocked on a mutex, pass the
+                     * priority on along the chain of holders. */
+                    prvInheritAlongChain( pxMutexHolderTCB, pxCurrentTCB->uxPriority );
                 }
-
-                traceTASK_PRIORITY_INHERIT( pxMutexHolderTCB, pxCurrentTCB->uxPriority );
+                #endif
 
                 /* Inheritance occurred. */
                 xReturn = pdTRUE;
@@ -6737,6 +8091,255 @@ static void prvResetNextTaskUnblockTime( void )
 #endif /* configUSE_MUTEXES */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_MUTEXES == 1 )
+
+    static void prvRaisePriority( TCB_t * const pxTCB,
+                                  UBaseType_t uxNewPriority )
+    {
+        /* Adjust the mutex holder state to account for its new
+         * priority.  Only reset the event list item value if the value is
+         * not being used for anything else. */
+        if( ( listGET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == ( ( TickType_t ) 0U ) )
+        {
+            listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxNewPriority );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* If the task being modified is in the ready state it will need
+         * to be moved into a new list. */
+        if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxTCB->uxPriority ] ), &( pxTCB->xStateListItem ) ) != pdFALSE )
+        {
+            if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+            {
+                /* It is known that the task is in its ready list so
+                 * there is no need to check again and the port level
+                 * reset macro can be called directly. */
+                portRESET_READY_PRIORITY( pxTCB->uxPriority, uxTopReadyPriority );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            /* Inherit the priority before being moved into the new list. */
+            pxTCB->uxPriority = uxNewPriority;
+            prvAddTaskToReadyList( pxTCB );
+            #if ( configNUMBER_OF_CORES > 1 )
+            {
+                /* The priority of the task is raised. Yield for this task
+                 * if it is not running. */
+                if( taskTASK_IS_RUNNING( pxTCB ) != pdTRUE )
+                {
+                    prvYieldForTask( pxTCB );
+                }
+            }
+            #endif /* if ( configNUMBER_OF_CORES > 1 ) */
+        }
+        else
+        {
+            /* Just inherit the priority. */
+            pxTCB->uxPriority = uxNewPriority;
+        }
+
+        traceTASK_PRIORITY_INHERIT( pxTCB, uxNewPriority );
+    }
+
+#endif /* configUSE_MUTEXES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRANSITIVE_INHERITANCE == 1 )
+
+    static void prvInheritAlongChain( TCB_t * const pxMutexHolderTCB,
+                                      UBaseType_t uxPriority )
+    {
+        TCB_t * pxTCB = pxMutexHolderTCB;
+        TCB_t * pxNextHolderTCB;
+        List_t * pxEventList;
+        UBaseType_t uxDepth;
+
+        for( uxDepth = ( UBaseType_t ) 1U; uxDepth < ( UBaseType_t ) configMAX_INHERITANCE_DEPTH; uxDepth++ )
+        {
+            /* pvBlockedOnMutex is only cleared once the task runs again, so
+             * also check the task is still on the mutex's event list. */
+            pxEventList = listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) );
+
+            if( ( pxTCB->pvBlockedOnMutex == NULL ) || ( pxEventList == NULL ) )
+            {
+                break;
+            }
+
+            /* The task's priority has just been raised, so move it to its new
+             * position in the list of tasks waiting for the mutex, otherwise a
+             * lower priority task could be given the mutex first. */
+            if( ( listGET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == ( ( TickType_t ) 0U ) )
+            {
+                ( void ) uxListRemove( &( pxTCB->xEventListItem ) );
+                vListInsert( pxEventList, &( pxTCB->xEventListItem ) );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            /* MISRA Ref 11.5.3 [Void pointer assignment] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+            /* coverity[misra_c_2012_rule_11_5_violation] */
+            pxNextHolderTCB = ( TCB_t * ) xQueueGetMutexHolderFromISR( ( QueueHandle_t ) pxTCB->pvBlockedOnMutex );
+
+            /* Stop if the mutex is not held by a task, or if the chain leads
+             * back to the calling task, which means the tasks are deadlocked. */
+            if( ( pxNextHolderTCB == NULL ) || ( pxNextHolderTCB == pxCurrentTCB ) )
+            {
+                break;
+            }
+
+            /* A holder that already has a priority at least as high as
+             * uxPriority passed that priority along the rest of the chain when
+             * it blocked. */
+            if( pxNextHolderTCB->uxPriority >= uxPriority )
+            {
+                break;
+            }
+
+            prvRaisePriority( pxNextHolderTCB, uxPriority );
+            pxTCB = pxNextHolderTCB;
+        }
+    }
+
+#endif /* configUSE_TRANSITIVE_INHERITANCE */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRANSITIVE_INHERITANCE == 1 )
+
+    void vTaskSetBlockedOnMutex( void * pvMutex )
+    {
+        traceENTER_vTaskSetBlockedOnMutex( pvMutex );
+
+        pxCurrentTCB->pvBlockedOnMutex = pvMutex;
+
+        traceRETURN_vTaskSetBlockedOnMutex();
+    }
+
+#endif /* configUSE_TRANSITIVE_INHERITANCE */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_CEILING_MUTEXES == 1 )
+
+    UBaseType_t uxTaskPriorityRaiseToCeiling( UBaseType_t uxCeilingPriority )
+    {
+        UBaseType_t uxPriorityBeforeCeiling;
+
+        traceENTER_uxTaskPriorityRaiseToCeiling( uxCeilingPriority );
+
+        /* The ceiling must be at least the priority of every task that uses
+         * the mutex. */
+        configASSERT( pxCurrentTCB->uxBasePriority <= uxCeilingPriority );
+
+        uxPriorityBeforeCeiling = pxCurrentTCB->uxPriority;
+
+        if( uxPriorityBeforeCeiling < uxCeilingPriority )
+        {
+            prvRaisePriority( pxCurrentTCB, uxCeilingPriority );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_uxTaskPriorityRaiseToCeiling( uxPriorityBeforeCeiling );
+
+        return uxPriorityBeforeCeiling;
+    }
+
+#endif /* configUSE_CEILING_MUTEXES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_CEILING_MUTEXES == 1 )
+
+    BaseType_t xTaskPriorityRestoreFromCeiling( UBaseType_t uxCeilingPriority,
+                                                UBaseType_t uxPriorityBeforeCeiling )
+    {
+        TCB_t * const pxTCB = pxCurrentTCB;
+        UBaseType_t uxNewPriority;
+        BaseType_t xReturn = pdFALSE;
+
+        traceENTER_xTaskPriorityRestoreFromCeiling( uxCeilingPriority, uxPriorityBeforeCeiling );
+
+        configASSERT( pxTCB->uxMutexesHeld );
+        ( pxTCB->uxMutexesHeld )--;
+
+        if( pxTCB->uxMutexesHeld == ( UBaseType_t ) 0 )
+        {
+            /* No other mutexes are held, so neither a ceiling nor an
+             * inherited priority is needed any more. */
+            uxNewPriority = pxTCB->uxBasePriority;
+        }
+        else if( pxTCB->uxPriority == uxCeilingPriority )
+        {
+            /* Still running at this mutex's ceiling, so drop back to the
+             * priority held before it was taken, which accounts for any other
+             * ceiling mutexes taken first. */
+            uxNewPriority = uxPriorityBeforeCeiling;
+        }
+        else
+        {
+            /* The priority was changed again after this mutex was taken, for
+             * example by inheritance or by a ceiling mutex that is still held,
+             * so leave it until the remaining mutexes are given back. */
+            uxNewPriority = pxTCB->uxPriority;
+        }
+
+        if( uxNewPriority < pxTCB->uxPriority )
+        {
+            /* The task must be running to give back the mutex, so it is in
+             * the ready list for its current priority. */
+            if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+            {
+                portRESET_READY_PRIORITY( pxTCB->uxPriority, uxTopReadyPriority );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            traceTASK_PRIORITY_DISINHERIT( pxTCB, uxNewPriority );
+            pxTCB->uxPriority = uxNewPriority;
+
+            /* Reset the event list item value.  It cannot be in use for any
+             * other purpose if this task is running. */
+            listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) pxTCB->uxPriority );
+            prvAddTaskToReadyList( pxTCB );
+            #if ( configNUMBER_OF_CORES > 1 )
+            {
+                /* The priority of the task is dropped. Yield the core on
+                 * which the task is running. */
+                if( taskTASK_IS_RUNNING( pxTCB ) == pdTRUE )
+                {
+                    prvYieldCore( pxTCB->xTaskRunState );
+                }
+            }
+            #endif /* if ( configNUMBER_OF_CORES > 1 ) */
+
+            /* A task that was kept out by the ceiling may now be able to
+             * run. */
+            xReturn = pdTRUE;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_xTaskPriorityRestoreFromCeiling( xReturn );
+
+        return xReturn;
+    }
+
+#endif /* configUSE_CEILING_MUTEXES */
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_MUTEXES == 1 )
 
     BaseType_t xTaskPriorityDisinherit( TaskHandle_t const pxMutexHolder )
@@ -7686,6 +9289,47 @@ TickType_t uxTaskResetEventItemValue( void )
 #endif /* configUSE_MUTEXES */
 /*-----------------------------------------------------------*/
 
+#if ( ( configUSE_MUTEXES == 1 ) && ( configUSE_FAST_MUTEXES == 1 ) )
+
+    BaseType_t xTaskDecrementMutexHeldCount( void )
+    {
+        TCB_t * pxTCB;
+        BaseType_t xReturn = pdFALSE;
+
+        traceENTER_xTaskDecrementMutexHeldCount();
+
+        pxTCB = pxCurrentTCB;
+        configASSERT( pxTCB );
+        configASSERT( pxTCB->uxMutexesHeld );
+
+        /* uxMutexesHeld is only written by the task that owns it.  If the task
+         * has not inherited a priority, or still holds another mutex, giving
+         * back this mutex cannot change its priority.  Another task can only
+         * raise the priority of this task through a mutex this task holds, so
+         * it cannot do so through the mutex being given back. */
+        if( ( pxTCB->uxPriority == pxTCB->uxBasePriority ) || ( pxTCB->uxMutexesHeld > ( UBaseType_t ) 1U ) )
+        {
+            ( pxTCB->uxMutexesHeld )--;
+        }
+        else
+        {
+            /* The last mutex held is being given back with an inherited
+             * priority, so the ready lists must be updated. */
+            taskENTER_CRITICAL();
+            {
+                xReturn = xTaskPriorityDisinherit( pxTCB );
+            }
+            taskEXIT_CRITICAL();
+        }
+
+        traceRETURN_xTaskDecrementMutexHeldCount( xReturn );
+
+        return xReturn;
+    }
+
+#endif /* ( configUSE_MUTEXES == 1 ) && ( configUSE_FAST_MUTEXES == 1 ) */
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_TASK_NOTIFICATIONS == 1 )
 
     uint32_t ulTaskGenericNotifyTake( UBaseType_t uxIndexToWaitOn,
@@ -8156,7 +9800,7 @@ TickType_t uxTaskResetEventItemValue( void )
 
                 #if ( configNUMBER_OF_CORES == 1 )
                 {
-                    if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                    if( taskPREEMPTS_CURRENT_TASK( pxTCB ) )
                     {
                         /* The notified task has a priority above the currently
                          * executing task so a yield is required. */
@@ -8290,7 +9934,7 @@ TickType_t uxTaskResetEventItemValue( void )
 
                 #if ( configNUMBER_OF_CORES == 1 )
                 {
-                    if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                    if( taskPREEMPTS_CURRENT_TASK( pxTCB ) )
                     {
                         /* The notified task has a priority above the currently
                          * executing task so a yield is required. */
@@ -346,7 +346,7 @@
             /* MISRA Ref 11.5.1 [Malloc memory assignment] */
             /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
             /* coverity[misra_c_2012_rule_11_5_violation] */
-            pxNewTimer = ( Timer_t * ) pvPortMalloc( sizeof( Timer_t ) );
+            pxNewTimer = ( Timer_t * ) pvPortMallocObject( sizeof( Timer_t ) );
 
             if( pxNewTimer != NULL )
             {
@@ -1054,7 +1054,7 @@
                                  * allocated. */
                                 if( ( pxTimer->ucStatus & tmrSTATUS_IS_STATICALLY_ALLOCATED ) == ( uint8_t ) 0 )
                                 {
-                                    vPortFree( pxTimer );
+                                    vPortFreeObject( pxTimer );
                                 }
                                 else
                                 {
@@ -0,0 +1,165 @@
+/**
+ * @file coro_cpp_bench.cpp
+ * @brief Casos da suíte para as co-rotinas C++20 de src/rtos_coro.hpp.
+ *
+ * Cada caso repete um caso de kernel_bench.c com duas co-rotinas C++ num
+ * grupo executado pela própria tarefa da suíte, no lugar de duas tarefas:
+ * - cpp_coro_yield_switch, contra context_switch_yield e coro_yield_switch;
+ * - cpp_coro_notify_round_trip, contra task_notify_round_trip e
+ *   coro_notify_round_trip;
+ * - cpp_coro_queue_round_trip, contra queue_round_trip_blocking.
+ *
+ * Os quadros vêm de um pool de BENCH_CPP_FRAME_COUNT blocos; um quadro que
+ * não cabe no bloco faz o caso falhar.
+ */
+
+#include "kernel_bench.h"
+#include "rtos_coro.hpp"
+
+// Bloco do pool de quadros. Os quadros destes casos ficam bem abaixo disso
+// no RP2040; a folga é para o host de 64 bits, onde os ponteiros dobram.
+#define BENCH_CPP_FRAME_BYTES 384
+#define BENCH_CPP_FRAME_COUNT 2
+
+namespace {
+
+uint8_t frame_storage[blockpoolSTORAGE_SIZE(BENCH_CPP_FRAME_BYTES, BENCH_CPP_FRAME_COUNT)];
+StaticBlockPool_t frame_pool_buffer;
+BlockPoolHandle_t frame_pool;
+
+// Coro_t das co-rotinas que se notificam
+Coro_t *ping_coro;
+Coro_t *echo_coro;
+
+rtos::queue<uint32_t> request_queue;
+rtos::queue<uint32_t> reply_queue;
+
+rtos::coro_task yielder(uint32_t iterations) {
+    for (uint32_t i = 0; i < iterations; i++) {
+        co_await rtos::yield();
+    }
+}
+
+rtos::coro_task notify_ping(uint32_t iterations) {
+    for (uint32_t i = 0; i < iterations; i++) {
+        (void) xCoroNotifyGive(echo_coro);
+        (void) co_await rtos::notification();
+    }
+}
+
+rtos::coro_task notify_echo(uint32_t iterations) {
+    for (uint32_t i = 0; i < iterations; i++) {
+        (void) co_await rtos::notification();
+        (void) xCoroNotifyGive(ping_coro);
+    }
+}
+
+rtos::coro_task queue_ping(uint32_t iterations) {
+    for (uint32_t i = 0; i < iterations; i++) {
+        (void) request_queue.send(i);
+        (void) co_await reply_queue.receive();
+    }
+}
+
+rtos::coro_task queue_echo(uint32_t iterations) {
+    for (uint32_t i = 0; i < iterations; i++) {
+        std::optional<uint32_t> item = co_await request_queue.receive();
+        (void) reply_queue.send(*item);
+    }
+}
+
+/**
+ * @brief Executa as duas co-rotinas até terminarem.
+ *
+ * @return Tempo gasto, ou BENCH_FAILED se faltou um quadro.
+ */
+uint64_t run_pair(rtos::coro_group &group, rtos::coro_task first, rtos::coro_task second) {
+    if (!first || !second) {
+        return BENCH_FAILED;
+    }
+
+    ping_coro = group.spawn(std::move(first));
+    echo_coro = group.spawn(std::move(second));
+
+    uint64_t start = bench_counter();
+    group.run();
+
+    return bench_counter() - start;
+}
+
+/**
+ * @brief Cria o pool de quadros na primeira vez e o grupo dos casos.
+ */
+bool setup_group(rtos::coro_group &group, UBaseType_t queue_events) {
+    if (frame_pool == NULL) {
+        frame_pool = xBlockPoolCreateStatic(BENCH_CPP_FRAME_BYTES, BENCH_CPP_FRAME_COUNT,
+                                            frame_storage, &frame_pool_buffer);
+        rtos::set_frame_pool(frame_pool);
+    }
+
+    return group.create(queue_events);
+}
+
+uint64_t bench_cpp_yield_switch(uint32_t iterations, uint32_t param) {
+    rtos::coro_group group;
+
+    (void) param;
+    if (!setup_group(group, 0)) {
+        return BENCH_FAILED;
+    }
+
+    uint64_t elapsed = run_pair(group, yielder(iterations), yielder(iterations));
+    group.destroy();
+
+    return elapsed;
+}
+
+uint64_t bench_cpp_notify_round_trip(uint32_t iterations, uint32_t param) {
+    rtos::coro_group group;
+
+    (void) param;
+    if (!setup_group(group, 0)) {
+        return BENCH_FAILED;
+    }
+
+    uint64_t elapsed = run_pair(group, notify_ping(iterations), notify_echo(iterations));
+    group.destroy();
+
+    return elapsed;
+}
+
+uint64_t bench_cpp_queue_round_trip(uint32_t iterations, uint32_t param) {
+    rtos::coro_group group;
+    uint64_t elapsed = BENCH_FAILED;
+
+    (void) param;
+
+    bool created = request_queue.create(1);
+    created = reply_queue.create(1) && created;
+
+    if (created && setup_group(group, 2)) {
+        if (group.add_queue(request_queue.handle()) && group.add_queue(reply_queue.handle())) {
+            elapsed = run_pair(group, queue_ping(iterations), queue_echo(iterations));
+        }
+        group.destroy();
+    }
+
+    if (request_queue.handle() != NULL) {
+        request_queue.destroy();
+    }
+    if (reply_queue.handle() != NULL) {
+        reply_queue.destroy();
+    }
+
+    return elapsed;
+}
+
+}  // namespace
+
+extern "C" const bench_case_t bench_cpp_cases[] = {
+    { "cpp_coro_yield_switch", bench_cpp_yield_switch, BENCH_ITERATIONS, 0, 2 },
+    { "cpp_coro_notify_round_trip", bench_cpp_notify_round_trip, BENCH_ITERATIONS, 0, 1 },
+    { "cpp_coro_queue_round_trip", bench_cpp_queue_round_trip, BENCH_ITERATIONS, 0, 1 },
+};
+
+extern "C" const size_t bench_cpp_case_count = sizeof(bench_cpp_cases) / sizeof(bench_cpp_cases[0]);
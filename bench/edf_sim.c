@@ -0,0 +1,212 @@
+/**
+ * @file edf_sim.c
+ * @brief Simulação no host: perdas de prazo com prioridade fixa e com EDF.
+ *
+ * Simula, em passos de 1 us, um processador executando um conjunto de tarefas
+ * periódicas com prazo igual ao período, semelhante ao da aplicação (sensor,
+ * LED, buzzer e botões), sob duas políticas:
+ *
+ * - Prioridade fixa (FP): prioridades por taxa monotônica, como o escalonador
+ *   padrão do FreeRTOS com uma prioridade distinta por tarefa.
+ * - EDF: todas as tarefas na mesma prioridade, executando primeiro a de prazo
+ *   mais próximo, como configUSE_EDF_SCHEDULING com xTaskDelayUntilWithDeadline().
+ *
+ * Os tempos de execução são multiplicados por um fator de carga para varrer a
+ * utilização de abaixo até acima de 100%. Um trabalho que perde o prazo não é
+ * abortado: continua executando, como uma tarefa do FreeRTOS, e o próximo
+ * trabalho da mesma tarefa só começa quando ele termina.
+ *
+ * Compilação e execução (fora do build do firmware):
+ *
+ *     cc -O2 -o edf_sim bench/edf_sim.c && ./edf_sim
+ *
+ * A saída é uma linha CSV por fator de carga, com o número de trabalhos
+ * concluídos e de prazos perdidos em cada política e o pior tempo de resposta
+ * de cada tarefa (0 se a tarefa não concluiu nenhum trabalho).
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+
+// Duração da simulação em microssegundos (o hiperperíodo do conjunto é longo,
+// então basta um intervalo que cubra muitos períodos da tarefa mais lenta)
+#define SIM_DURATION_US 10000000u
+
+typedef struct {
+    const char *name;
+    uint32_t period_us;   // Período, igual ao prazo relativo
+    uint32_t wcet_us;     // Tempo de execução com fator de carga 1
+    uint32_t priority;    // Prioridade FP (maior é mais prioritária)
+
+    // Estado da simulação
+    uint64_t next_release;
+    uint64_t deadline;
+    uint32_t remaining;   // Tempo restante do trabalho atual, 0 se ocioso
+    uint32_t pending;     // Liberações aguardando o trabalho atual terminar
+    uint32_t jobs;
+    uint32_t misses;
+    uint64_t worst_response;
+    uint64_t release;
+} sim_task_t;
+
+// Conjunto de tarefas: utilização 0,9 com fator de carga 1. Os períodos não
+// são harmônicos, o que faz a prioridade fixa perder prazos antes de 100%.
+static sim_task_t tasks[] = {
+    { .name = "sensor", .period_us = 7000, .wcet_us = 2100, .priority = 4 },
+    { .name = "led", .period_us = 10000, .wcet_us = 2500, .priority = 3 },
+    { .name = "buzzer", .period_us = 23000, .wcet_us = 5750, .priority = 2 },
+    { .name = "button", .period_us = 50000, .wcet_us = 5000, .priority = 1 },
+};
+
+#define TASK_COUNT (sizeof(tasks) / sizeof(tasks[0]))
+
+typedef enum { POLICY_FP, POLICY_EDF } policy_t;
+
+static void sim_reset(void) {
+    for (unsigned i = 0; i < TASK_COUNT; i++) {
+        tasks[i].next_release = 0;
+        tasks[i].deadline = 0;
+        tasks[i].remaining = 0;
+        tasks[i].pending = 0;
+        tasks[i].jobs = 0;
+        tasks[i].misses = 0;
+        tasks[i].worst_response = 0;
+        tasks[i].release = 0;
+    }
+}
+
+/**
+ * @brief Inicia o próximo trabalho da tarefa, liberado em release.
+ */
+static void sim_start_job(sim_task_t *t, uint64_t release, double load) {
+    t->release = release;
+    t->deadline = release + t->period_us;
+    t->remaining = (uint32_t) (t->wcet_us * load + 0.5);
+    if (t->remaining == 0) {
+        t->remaining = 1;
+    }
+}
+
+/**
+ * @brief Escolhe a tarefa a executar conforme a política.
+ *
+ * Empates são decididos pela ordem na tabela, como a ordem de inserção na
+ * lista de prontas do kernel.
+ */
+static sim_task_t *sim_pick(policy_t policy) {
+    sim_task_t *best = NULL;
+
+    for (unsigned i = 0; i < TASK_COUNT; i++) {
+        sim_task_t *t = &tasks[i];
+        if (t->remaining == 0) {
+            continue;
+        }
+        if (best == NULL ||
+            (policy == POLICY_FP && t->priority > best->priority) ||
+            (policy == POLICY_EDF && t->deadline < best->deadline)) {
+            best = t;
+        }
+    }
+
+    return best;
+}
+
+/**
+ * @brief Executa a simulação e devolve o total de prazos perdidos.
+ */
+static uint32_t sim_run(policy_t policy, double load, uint32_t *jobs_out) {
+    uint32_t misses = 0, jobs = 0;
+
+    sim_reset();
+
+    for (uint64_t now = 0; now < SIM_DURATION_US; now++) {
+        // Liberações deste instante
+        for (unsigned i = 0; i < TASK_COUNT; i++) {
+            sim_task_t *t = &tasks[i];
+            if (now == t->next_release) {
+                t->next_release += t->period_us;
+                if (t->remaining == 0 && t->pending == 0) {
+                    sim_start_job(t, now, load);
+                } else {
+                    t->pending++;
+                }
+            }
+        }
+
+        sim_task_t *run = sim_pick(policy);
+        if (run == NULL) {
+            continue;
+        }
+
+        if (--run->remaining == 0) {
+            uint64_t finish = now + 1;
+            uint64_t response = finish - run->release;
+
+            run->jobs++;
+            if (finish > run->deadline) {
+                run->misses++;
+            }
+            if (response > run->worst_response) {
+                run->worst_response = response;
+            }
+
+            // Liberação atrasada: o trabalho seguinte herda o instante e o
+            // prazo originais, como com xTaskDelayUntil()
+            if (run->pending > 0) {
+                run->pending--;
+                sim_start_job(run, run->next_release - (uint64_t) (run->pending + 1) * run->period_us, load);
+            }
+        }
+    }
+
+    // Trabalhos ainda não concluídos ao fim da simulação cujo prazo já passou
+    // também são perdas; sem isso, uma tarefa que deixa de executar por
+    // completo não apareceria nos resultados.
+    for (unsigned i = 0; i < TASK_COUNT; i++) {
+        sim_task_t *t = &tasks[i];
+        if (t->remaining > 0 && t->deadline < SIM_DURATION_US) {
+            t->misses += 1 + t->pending;
+        }
+        misses += t->misses;
+        jobs += t->jobs;
+    }
+    *jobs_out = jobs;
+
+    return misses;
+}
+
+int main(void) {
+    double base_utilization = 0.0;
+
+    for (unsigned i = 0; i < TASK_COUNT; i++) {
+        base_utilization += (double) tasks[i].wcet_us / tasks[i].period_us;
+    }
+
+    printf("carga,utilizacao,trabalhos_fp,perdas_fp,trabalhos_edf,perdas_edf");
+    for (unsigned i = 0; i < TASK_COUNT; i++) {
+        printf(",pior_resp_fp_%s,pior_resp_edf_%s", tasks[i].name, tasks[i].name);
+    }
+    printf("\n");
+
+    for (int step = 80; step <= 130; step += 5) {
+        double load = step / 100.0;
+        uint64_t worst_fp[TASK_COUNT];
+        uint32_t jobs_fp, jobs_edf;
+
+        uint32_t misses_fp = sim_run(POLICY_FP, load, &jobs_fp);
+        for (unsigned i = 0; i < TASK_COUNT; i++) {
+            worst_fp[i] = tasks[i].worst_response;
+        }
+        uint32_t misses_edf = sim_run(POLICY_EDF, load, &jobs_edf);
+
+        printf("%.2f,%.3f,%u,%u,%u,%u", load, base_utilization * load,
+               jobs_fp, misses_fp, jobs_edf, misses_edf);
+        for (unsigned i = 0; i < TASK_COUNT; i++) {
+            printf(",%llu,%llu", (unsigned long long) worst_fp[i],
+                   (unsigned long long) tasks[i].worst_response);
+        }
+        printf("\n");
+    }
+
+    return 0;
+}
@@ -0,0 +1,335 @@
+/**
+ * @file inheritance_sim.c
+ * @brief Simulação no host: pior bloqueio numa cadeia de mutexes com herança
+ * de prioridade direta e transitiva.
+ *
+ * Simula, em passos de 1 us, um processador com uma cadeia de mutexes
+ * aninhados: a tarefa alta (H) espera o mutex 1, cujo dono espera o mutex 2,
+ * e assim por diante até a tarefa baixa (L), dona do último mutex e ainda no
+ * meio da sua seção crítica. Cada elo intermediário é uma tarefa de
+ * prioridade média-baixa. Uma tarefa periódica de prioridade entre essas e a
+ * de H interfere com a carga indicada. Três políticas são comparadas:
+ *
+ * - Sem herança: cada tarefa executa na sua prioridade base.
+ * - Herança direta: só o dono do mutex que a tarefa espera herda a prioridade
+ *   dela, como o kernel com configUSE_TRANSITIVE_INHERITANCE em 0. Numa
+ *   cadeia de dois ou mais mutexes, L fica abaixo da tarefa interferente.
+ * - Herança transitiva: a prioridade de H passa por até
+ *   SIM_INHERITANCE_DEPTH donos da cadeia, como configMAX_INHERITANCE_DEPTH.
+ *   Numa cadeia mais longa que isso, L volta a ficar sem a herança.
+ *
+ * Para cada comprimento de cadeia e carga, a fase da tarefa interferente é
+ * varrida ao longo de um período e fica o pior bloqueio de H: do pedido do
+ * mutex 1 até obtê-lo.
+ *
+ * Compilação e execução (fora do build do firmware):
+ *
+ *     cc -O2 -o inheritance_sim bench/inheritance_sim.c && ./inheritance_sim
+ *
+ * A saída é uma linha CSV por comprimento de cadeia e carga, com o pior
+ * bloqueio de H em microssegundos em cada política.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+// Profundidade da herança transitiva, igual a configMAX_INHERITANCE_DEPTH
+#define SIM_INHERITANCE_DEPTH 4
+
+// Maior cadeia simulada: uma além da profundidade, para mostrar o limite
+#define SIM_MAX_CHAIN (SIM_INHERITANCE_DEPTH + 1)
+
+// Tarefas: H, L, um elo por mutex além do último e a interferente
+#define SIM_MAX_TASKS (SIM_MAX_CHAIN + 2)
+#define SIM_MAX_STEPS 6
+
+// Limite de cada simulação; um bloqueio que chega a ele sai como o limite
+#define SIM_LIMIT_US 1000000u
+
+// Prioridades, como no FreeRTOS: maior é mais prioritária
+#define PRIO_LOW         1
+#define PRIO_LINK        2
+#define PRIO_INTERFERER  3
+#define PRIO_HIGH        4
+
+// Seções críticas: o que falta a L quando H pede o mutex, e a de cada elo
+#define LOW_SECTION_US   2000u
+#define LINK_SECTION_US  100u
+#define HIGH_SECTION_US  100u
+
+// Período da tarefa interferente e passo da varredura da sua fase
+#define INTERFERER_PERIOD_US 1000u
+#define PHASE_STEP_US        50u
+
+// Instantes de liberação: L primeiro, depois os elos, de trás para a frente,
+// e por fim H, com a cadeia montada
+#define LINK_SPACING_US  10u
+#define HIGH_RELEASE_US  100u
+
+typedef enum { STEP_COMPUTE, STEP_LOCK, STEP_UNLOCK } step_kind_t;
+
+typedef struct {
+    step_kind_t kind;
+    uint32_t arg;   // Microssegundos de COMPUTE, ou o mutex de LOCK e UNLOCK
+} sim_step_t;
+
+typedef struct {
+    uint32_t base_priority;
+    uint64_t release;
+    uint32_t period_us;    // 0 para uma tarefa que executa uma vez só
+    sim_step_t steps[SIM_MAX_STEPS];
+    unsigned step_count;
+
+    // Estado da simulação
+    bool active;
+    unsigned step;
+    uint32_t remaining;    // Restante do COMPUTE atual
+    int blocked_on;        // Mutex esperado, ou -1
+} sim_task_t;
+
+typedef enum { POLICY_NONE, POLICY_DIRECT, POLICY_TRANSITIVE } policy_t;
+
+static sim_task_t tasks[SIM_MAX_TASKS];
+static unsigned task_count;
+
+// Dono de cada mutex, ou -1
+static int holder[SIM_MAX_CHAIN];
+
+/**
+ * @brief Prioridade efetiva de uma tarefa: a maior entre a base e a das
+ * tarefas que esperam mutexes dela, seguindo a cadeia por até depth elos.
+ */
+static uint32_t sim_priority(unsigned t, unsigned depth) {
+    uint32_t priority = tasks[t].base_priority;
+
+    if (depth == 0) {
+        return priority;
+    }
+
+    for (unsigned w = 0; w < task_count; w++) {
+        int m = tasks[w].blocked_on;
+        if (m >= 0 && holder[m] == (int) t) {
+            uint32_t inherited = sim_priority(w, depth - 1);
+            if (inherited > priority) {
+                priority = inherited;
+            }
+        }
+    }
+
+    return priority;
+}
+
+static unsigned sim_depth(policy_t policy) {
+    switch (policy) {
+    case POLICY_DIRECT:
+        return 1;
+    case POLICY_TRANSITIVE:
+        return SIM_INHERITANCE_DEPTH;
+    default:
+        return 0;
+    }
+}
+
+/**
+ * @brief Devolve um mutex à tarefa de maior prioridade que o espera, como a
+ * lista de espera ordenada por prioridade do kernel.
+ */
+static void sim_unlock(unsigned m, unsigned depth) {
+    int next = -1;
+
+    holder[m] = -1;
+    for (unsigned w = 0; w < task_count; w++) {
+        if (tasks[w].blocked_on == (int) m &&
+            (next < 0 || sim_priority(w, depth) > sim_priority((unsigned) next, depth))) {
+            next = (int) w;
+        }
+    }
+
+    if (next >= 0) {
+        holder[m] = next;
+        tasks[next].blocked_on = -1;
+        tasks[next].step++;
+    }
+}
+
+/**
+ * @brief Executa os passos instantâneos (LOCK e UNLOCK) da tarefa até um
+ * COMPUTE, um bloqueio ou o fim do roteiro.
+ */
+static void sim_advance(unsigned t, unsigned depth) {
+    sim_task_t *task = &tasks[t];
+
+    while (task->active && task->blocked_on < 0) {
+        if (task->step == task->step_count) {
+            task->active = false;
+            break;
+        }
+
+        const sim_step_t *step = &task->steps[task->step];
+        if (step->kind == STEP_COMPUTE) {
+            if (task->remaining == 0) {
+                task->remaining = step->arg;
+            }
+            break;
+        }
+        if (step->kind == STEP_LOCK) {
+            if (holder[step->arg] < 0) {
+                holder[step->arg] = (int) t;
+                task->step++;
+            } else {
+                task->blocked_on = (int) step->arg;
+            }
+        } else {
+            sim_unlock(step->arg, depth);
+            task->step++;
+        }
+    }
+}
+
+static void sim_add(uint32_t priority, uint64_t release, uint32_t period_us,
+                    const sim_step_t *steps, unsigned step_count) {
+    sim_task_t *task = &tasks[task_count++];
+
+    *task = (sim_task_t) { .base_priority = priority, .release = release,
+                           .period_us = period_us, .step_count = step_count,
+                           .blocked_on = -1 };
+    for (unsigned i = 0; i < step_count; i++) {
+        task->steps[i] = steps[i];
+    }
+}
+
+/**
+ * @brief Monta a cadeia de chain mutexes e a tarefa interferente.
+ *
+ * @return Índice de H na tabela.
+ */
+static unsigned sim_build(unsigned chain, uint32_t interferer_us, uint32_t phase_us) {
+    task_count = 0;
+    for (unsigned m = 0; m < SIM_MAX_CHAIN; m++) {
+        holder[m] = -1;
+    }
+
+    // L: dono do último mutex, com a seção crítica por terminar
+    const sim_step_t low[] = {
+        { STEP_LOCK, chain - 1 }, { STEP_COMPUTE, LOW_SECTION_US }, { STEP_UNLOCK, chain - 1 },
+    };
+    sim_add(PRIO_LOW, 0, 0, low, 3);
+
+    // Elo i: dono do mutex i, esperando o mutex i + 1
+    for (unsigned i = chain - 1; i-- > 0;) {
+        const sim_step_t link[] = {
+            { STEP_LOCK, i }, { STEP_LOCK, i + 1 }, { STEP_COMPUTE, LINK_SECTION_US },
+            { STEP_UNLOCK, i + 1 }, { STEP_UNLOCK, i },
+        };
+        sim_add(PRIO_LINK, (uint64_t) (chain - 1 - i) * LINK_SPACING_US, 0, link, 5);
+    }
+
+    // Tarefa interferente, sem mutexes
+    if (interferer_us > 0) {
+        const sim_step_t interferer[] = { { STEP_COMPUTE, interferer_us } };
+        sim_add(PRIO_INTERFERER, phase_us, INTERFERER_PERIOD_US, interferer, 1);
+    }
+
+    const sim_step_t high[] = {
+        { STEP_LOCK, 0 }, { STEP_COMPUTE, HIGH_SECTION_US }, { STEP_UNLOCK, 0 },
+    };
+    sim_add(PRIO_HIGH, HIGH_RELEASE_US, 0, high, 3);
+
+    return task_count - 1;
+}
+
+/**
+ * @brief Executa um cenário e devolve o bloqueio de H em microssegundos.
+ */
+static uint64_t sim_run(policy_t policy, unsigned chain, uint32_t interferer_us, uint32_t phase_us) {
+    const unsigned depth = sim_depth(policy);
+    const unsigned high = sim_build(chain, interferer_us, phase_us);
+    uint64_t requested = 0;
+
+    for (uint64_t now = 0; now < SIM_LIMIT_US; now++) {
+        // Liberações deste instante; um trabalho da interferente que ainda
+        // não terminou absorve a liberação seguinte, o que não acontece com
+        // carga abaixo de 100%
+        for (unsigned t = 0; t < task_count; t++) {
+            sim_task_t *task = &tasks[t];
+            if (now == task->release) {
+                if (!task->active) {
+                    task->active = true;
+                    task->step = 0;
+                    task->remaining = 0;
+                }
+                if (task->period_us > 0) {
+                    task->release += task->period_us;
+                }
+            }
+            sim_advance(t, depth);
+        }
+
+        if (tasks[high].active && tasks[high].blocked_on >= 0 && requested == 0) {
+            requested = now;
+        }
+        if (requested != 0 && holder[0] == (int) high) {
+            return now - requested;
+        }
+
+        // A tarefa pronta de maior prioridade efetiva executa 1 us; empates
+        // ficam com a primeira da tabela
+        int run = -1;
+        uint32_t best = 0;
+        for (unsigned t = 0; t < task_count; t++) {
+            if (tasks[t].active && tasks[t].blocked_on < 0) {
+                uint32_t priority = sim_priority(t, depth);
+                if (run < 0 || priority > best) {
+                    run = (int) t;
+                    best = priority;
+                }
+            }
+        }
+        if (run >= 0 && --tasks[run].remaining == 0) {
+            tasks[run].step++;
+            sim_advance((unsigned) run, depth);
+        }
+    }
+
+    return SIM_LIMIT_US;
+}
+
+/**
+ * @brief Pior bloqueio de H ao longo das fases da tarefa interferente.
+ */
+static uint64_t sim_worst(policy_t policy, unsigned chain, uint32_t interferer_us) {
+    uint64_t worst = 0;
+
+    for (uint32_t phase = 0; phase < INTERFERER_PERIOD_US; phase += PHASE_STEP_US) {
+        uint64_t blocking = sim_run(policy, chain, interferer_us, phase);
+        if (blocking > worst) {
+            worst = blocking;
+        }
+        if (interferer_us == 0) {
+            break;
+        }
+    }
+
+    return worst;
+}
+
+int main(void) {
+    static const unsigned loads[] = { 0, 25, 50, 75, 90 };
+
+    printf("mutexes_na_cadeia,carga_interferente,bloqueio_sem_heranca,bloqueio_direta,"
+           "bloqueio_transitiva\n");
+
+    for (unsigned chain = 1; chain <= SIM_MAX_CHAIN; chain++) {
+        for (unsigned i = 0; i < sizeof(loads) / sizeof(loads[0]); i++) {
+            uint32_t interferer_us = INTERFERER_PERIOD_US * loads[i] / 100u;
+
+            printf("%u,%.2f,%llu,%llu,%llu\n", chain, loads[i] / 100.0,
+                   (unsigned long long) sim_worst(POLICY_NONE, chain, interferer_us),
+                   (unsigned long long) sim_worst(POLICY_DIRECT, chain, interferer_us),
+                   (unsigned long long) sim_worst(POLICY_TRANSITIVE, chain, interferer_us));
+        }
+    }
+
+    return 0;
+}
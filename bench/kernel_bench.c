@@ -0,0 +1,1769 @@
+/**
+ * @file kernel_bench.c
+ * @brief Casos da suíte de microbenchmarks e geração do JSON.
+ *
+ * Os casos cobrem troca de contexto e yield, filas (com e sem bloqueio, e a
+ * partir de interrupção), semáforos e mutexes, notificações, grupos de
+ * eventos, stream buffers e temporizadores, além das comparações das
+ * extensões do kernel deste repositório: fila sem cópia e em lote, anel SPSC,
+ * mutex rápido e com teto de prioridade, trava de leitores e escritores,
+ * grupos de eventos indexados e diretos, pools de blocos e o heap escolhido
+ * em FREERTOS_HEAP. Os casos de uma extensão só são compilados quando ela
+ * está habilitada no FreeRTOSConfig.h. Os casos das co-rotinas C++20 ficam
+ * em coro_cpp_bench.cpp.
+ *
+ * Os casos que medem uma operação isolada (enviar e receber na mesma tarefa,
+ * por exemplo) não trocam de contexto. Os de ida e volta usam uma tarefa
+ * auxiliar de prioridade maior que a da suíte, de modo que cada volta inclui
+ * exatamente duas trocas de contexto.
+ *
+ * O que as comparações não cobrem, ou cobrem em parte:
+ *
+ * - Heap: os casos medem só o heap de FREERTOS_HEAP. Comparar o tlsf com o
+ *   heap_4 pede dois builds, um com cada heap, e a comparação dos dois JSON.
+ * - Verificação de estouro de pilha: do mesmo modo, um build com
+ *   BENCH_STACK_OVERFLOW_CHECK em 2 e outro em 3.
+ * - Grupos de eventos: a varredura de tarefas em espera para em
+ *   BENCH_MAX_IDLE_WAITERS (22), porque um grupo com tick de 32 bits tem 24
+ *   bits e a ida e volta usa dois. Não chega a 32 tarefas.
+ * - Anel SPSC: o estresse usa duas tarefas, não uma interrupção e uma tarefa.
+ *   No host não há interrupções, e os casos "ISR" chamam as funções FromISR a
+ *   partir de uma tarefa.
+ * - Filas em lote no host: rodam no port POSIX com a configuração de
+ *   bench/posix, não no firmware com stubs do Pico SDK.
+ * - Herança transitiva de prioridade: o pior caso não é medido aqui. Ele é
+ *   simulado em inheritance_sim.c.
+ */
+
+#include "kernel_bench.h"
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+#include "event_groups.h"
+#include "stream_buffer.h"
+#include "timers.h"
+#if (configUSE_FAST_MUTEXES == 1)
+#include "fast_mutex.h"
+#endif
+#if (configUSE_RW_LOCKS == 1)
+#include "rw_lock.h"
+#endif
+#if (configUSE_SPSC_RINGS == 1)
+#include "spsc_ring.h"
+#endif
+#if (configUSE_BLOCK_POOLS == 1)
+#include "block_pool.h"
+#endif
+#if (configUSE_CORO_SCHEDULER == 1)
+#include "coro.h"
+#endif
+
+// Definidos pelo CMake; identificam o resultado no histórico
+#ifndef BENCH_GIT_COMMIT
+#define BENCH_GIT_COMMIT "desconhecido"
+#endif
+#ifndef BENCH_HEAP_NAME
+#define BENCH_HEAP_NAME "desconhecido"
+#endif
+
+// Definido pelo CMake quando coro_cpp_bench.cpp faz parte do executável
+#ifndef BENCH_CPP_COROUTINES
+#define BENCH_CPP_COROUTINES 0
+#endif
+
+// 1 se o heap escolhido fornece vPortGetHeapStats() (heap_4, heap_5, tlsf e
+// banked), para a fragmentação do padrão aleatório
+#ifndef BENCH_HEAP_STATS
+#define BENCH_HEAP_STATS 0
+#endif
+
+// Prioridades das tarefas auxiliares
+#define BENCH_PRIO_ABOVE (BENCH_TASK_PRIORITY + 1)
+#define BENCH_PRIO_SAME  BENCH_TASK_PRIORITY
+
+#define BENCH_HELPER_STACK_WORDS (configMINIMAL_STACK_SIZE * 2)
+
+// Comprimento das filas: as medidas de envio e recebimento isolados são
+// feitas em rajadas deste tamanho, alternando com a operação complementar
+#define BENCH_QUEUE_LENGTH 64
+
+// Item dos pools de blocos e da comparação com o heap
+#define BENCH_ITEM_BYTES 64
+
+// Maior item das filas com cópia e sem cópia, e o comprimento delas: cada
+// iteração envia e recebe um item, então poucas posições bastam
+#define BENCH_MAX_ITEM_BYTES   256
+#define BENCH_ITEM_QUEUE_LENGTH 4
+
+// Maior lote dos envios e recebimentos em lote; cabe inteiro na fila
+#define BENCH_MAX_BATCH_ITEMS BENCH_QUEUE_LENGTH
+
+#define BENCH_STREAM_BUFFER_BYTES 1024
+
+// Bits dos grupos de eventos: ida, volta e o primeiro das tarefas que só
+// esperam, cada uma no seu bit
+#define BENCH_BIT_PING   (1u << 0)
+#define BENCH_BIT_PONG   (1u << 1)
+#define BENCH_BIT_IDLE_0 2
+
+// Uma tarefa ociosa por bit, do BENCH_BIT_IDLE_0 ao último dos 24 bits
+// utilizáveis de um grupo de eventos com tick de 32 bits
+#define BENCH_MAX_IDLE_WAITERS (24 - BENCH_BIT_IDLE_0)
+#define BENCH_MAX_READERS      4
+
+// Tarefa da suíte, notificada pelas auxiliares
+static TaskHandle_t bench_runner;
+
+// Escrito nos laços para o compilador não eliminá-los
+static volatile uint32_t bench_sink;
+
+// Estado compartilhado com as funções executadas em interrupção e com as
+// tarefas auxiliares
+static QueueHandle_t bench_queue;
+static QueueHandle_t bench_reply_queue;
+static EventGroupHandle_t bench_event_group;
+static uint32_t bench_isr_count;
+static bool bench_isr_direct;
+static volatile uint64_t bench_isr_elapsed;
+static volatile uint64_t bench_woken_at;
+
+// Métrica própria de um caso, além do tempo, gravada com bench_metric(); o
+// JSON traz a maior entre as repetições
+static const char *bench_metric_name;
+static double bench_metric_value;
+
+/**
+ * @brief Grava uma métrica do caso em execução, como a fragmentação do heap.
+ */
+static void bench_metric(const char *name, double value) {
+    if (bench_metric_name == NULL || value > bench_metric_value) {
+        bench_metric_value = value;
+    }
+    bench_metric_name = name;
+}
+
+/**
+ * @brief Cria uma tarefa auxiliar.
+ *
+ * @return Handle da tarefa, ou NULL se não houver memória.
+ */
+static TaskHandle_t bench_spawn(TaskFunction_t function, const char *name, void *params,
+                                UBaseType_t priority) {
+    TaskHandle_t task = NULL;
+
+    if (xTaskCreate(function, name, BENCH_HELPER_STACK_WORDS, params, priority, &task) != pdPASS) {
+        return NULL;
+    }
+
+    return task;
+}
+
+// ---------------------------------------------------------------------------
+// Referência e escalonamento
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Custo do próprio laço de medida, para referência.
+ */
+static uint64_t bench_loop_overhead(uint32_t iterations, uint32_t param) {
+    (void) param;
+
+    uint64_t start = bench_counter();
+    for (uint32_t i = 0; i < iterations; i++) {
+        bench_sink = i;
+    }
+
+    return bench_counter() - start;
+}
+
+/**
+ * @brief taskYIELD() sem outra tarefa pronta na mesma prioridade.
+ */
+static uint64_t bench_yield_no_switch(uint32_t iterations, uint32_t param) {
+    (void) param;
+
+    uint64_t start = bench_counter();
+    for (uint32_t i = 0; i < iterations; i++) {
+        taskYIELD();
+    }
+
+    return bench_counter() - start;
+}
+
+static void bench_yield_helper(void *params) {
+    (void) params;
+
+    for (;;) {
+        taskYIELD();
+    }
+}
+
+/**
+ * @brief Troca de contexto por taskYIELD() entre duas tarefas de mesma
+ * prioridade; cada iteração são duas trocas.
+ */
+static uint64_t bench_context_switch_yield(uint32_t iterations, uint32_t param) {
+    (void) param;
+
+    TaskHandle_t helper = bench_spawn(bench_yield_helper, "bench_yield", NULL, BENCH_PRIO_SAME);
+    if (helper == NULL) {
+        return BENCH_FAILED;
+    }
+
+    uint64_t start = bench_counter();
+    for (uint32_t i = 0; i < iterations; i++) {
+        taskYIELD();
+    }
+    uint64_t elapsed = bench_counter() - start;
+
+    vTaskDelete(helper);
+
+    return elapsed;
+}
+
+// ---------------------------------------------------------------------------
+// Notificações de tarefa
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief xTaskNotifyGive() e ulTaskNotifyTake() na própria tarefa.
+ */
+static uint64_t bench_notify_give_take(uint32_t iterations, uint32_t param) {
+    (void) param;
+
+    uint64_t start = bench_counter();
+    for (uint32_t i = 0; i < iterations; i++) {
+        xTaskNotifyGive(bench_runner);
+        (void) ulTaskNotifyTake(pdTRUE, 0);
+    }
+
+    return bench_counter() - start;
+}
+
+static void bench_notify_echo(void *params) {
+    (void) params;
+
+    for (;;) {
+        (void) ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        xTaskNotifyGive(bench_runner);
+    }
+}
+
+/**
+ * @brief Ida e volta por notificação com uma tarefa de prioridade maior.
+ */
+static uint64_t bench_notify_round_trip(uint32_t iterations, uint32_t param) {
+    (void) param;
+
+    TaskHandle_t helper = bench_spawn(bench_notify_echo, "bench_echo", NULL, BENCH_PRIO_ABOVE);
+    if (helper == NULL) {
+        return BENCH_FAILED;
+    }
+
+    uint64_t start = bench_counter();
+    for (uint32_t i = 0; i < iterations; i++) {
+        xTaskNotifyGive(helper);
+        (void) ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    }
+    uint64_t elapsed = bench_counter() - start;
+
+    vTaskDelete(helper);
+
+    return elapsed;
+}
+
+// ---------------------------------------------------------------------------
+// Filas
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief xQueueSend() sem bloqueio, em rajadas que enchem a fila.
+ */
+static uint64_t bench_queue_send(uint32_t iterations, uint32_t param) {
+    QueueHandle_t queue = xQueueCreate(BENCH_QUEUE_LENGTH, sizeof(uint32_t));
+    uint64_t total = 0;
+    uint32_t item = 0;
+
+    (void) param;
+    if (queue == NULL) {
+        return BENCH_FAILED;
+    }
+
+    for (uint32_t done = 0; done < iterations; done += BENCH_QUEUE_LENGTH) {
+        uint32_t burst = iterations - done < BENCH_QUEUE_LENGTH ? iterations - done : BENCH_QUEUE_LENGTH;
+
+        uint64_t start = bench_counter();
+        for (uint32_t i = 0; i < burst; i++) {
+            (void) xQueueSend(queue, &item, 0);
+        }
+        total += bench_counter() - start;
+
+        for (uint32_t i = 0; i < burst; i++) {
+            (void) xQueueReceive(queue, &item, 0);
+        }
+    }
+
+    vQueueDelete(queue);
+
+    return total;
+}
+
+/**
+ * @brief xQueueReceive() sem bloqueio, em rajadas que esvaziam a fila.
+ */
+static uint64_t bench_queue_receive(uint32_t iterations, uint32_t param) {
+    QueueHandle_t queue = xQueueCreate(BENCH_QUEUE_LENGTH, sizeof(uint32_t));
+    uint64_t total = 0;
+    uint32_t item = 0;
+
+    (void) param;
+    if (queue == NULL) {
+        return BENCH_FAILED;
+    }
+
+    for (uint32_t done = 0; done < iterations; done += BENCH_QUEUE_LENGTH) {
+        uint32_t burst = iterations - done < BENCH_QUEUE_LENGTH ? iterations - done : BENCH_QUEUE_LENGTH;
+
+        for (uint32_t i = 0; i < burst; i++) {
+            (void) xQueueSend(queue, &item, 0);
+        }
+
+        uint64_t start = bench_counter();
+        for (uint32_t i = 0; i < burst; i++) {
+            (void) xQueueReceive(queue, &item, 0);
+        }
+        total += bench_counter() - start;
+    }
+
+    vQueueDelete(queue);
+
+    return total;
+}
+
+static void bench_isr_queue_send(void) {
+    BaseType_t woken = pdFALSE;
+    uint32_t item = 0;
+
+    uint64_t start = bench_counter();
+    for (uint32_t i = 0; i < bench_isr_count; i++) {
+        (void) xQueueSendFromISR(bench_queue, &item, &woken);
+    }
+    bench_isr_elapsed = bench_counter() - start;
+
+    portYIELD_FROM_ISR(woken);
+}
+
+static void bench_isr_queue_receive(void) {
+    BaseType_t woken = pdFALSE;
+    uint32_t item;
+
+    uint64_t start = bench_counter();
+    for (uint32_t i = 0; i < bench_isr_count; i++) {
+        (void) xQueueReceiveFromISR(bench_queue, &item, &woken);
+    }
+    bench_isr_elapsed = bench_counter() - start;
+
+    portYIELD_FROM_ISR(woken);
+}
+
+/**
+ * @brief xQueueSendFromISR() em rajadas de param itens por interrupção, para
+ * comparar com xSpscRingSendFromISR() no mesmo tamanho de rajada.
+ */
+static uint64_t bench_queue_send_from_isr_burst(uint32_t iterations, uint32_t param) {
+    uint64_t total = 0;
+
+    if (param == 0 || param > BENCH_QUEUE_LENGTH) {
+        return BENCH_FAILED;
+    }
+    bench_queue = xQueueCreate(BENCH_QUEUE_LENGTH, sizeof(uint32_t));
+    if (bench_queue == NULL) {
+        return BENCH_FAILED;
+    }
+
+    for (uint32_t done = 0; done < iterations; done += param) {
+        bench_isr_count = iterations - done < param ? iterations - done : param;
+
+        bench_run_in_isr(bench_isr_queue_send);
+        total += bench_isr_elapsed;
+        xQueueReset(bench_queue);
+    }
+
+    vQueueDelete(bench_queue);
+
+    return total;
+}
+
+/**
+ * @brief xQueueSendFromISR() (param 0) ou xQueueReceiveFromISR() (param 1),
+ * em rajadas dentro de uma interrupção.
+ */
+static uint64_t bench_queue_from_isr(uint32_t iterations, uint32_t param) {
+    uint64_t total = 0;
+    uint32_t item = 0;
+
+    bench_queue = xQueueCreate(BENCH_QUEUE_LENGTH, sizeof(uint32_t));
+    if (bench_queue == NULL) {
+        return BENCH_FAILED;
+    }
+
+    for (uint32_t done = 0; done < iterations; done += BENCH_QUEUE_LENGTH) {
+        bench_isr_count = iterations - done < BENCH_QUEUE_LENGTH ? iterations - done : BENCH_QUEUE_LENGTH;
+
+        if (param == 0) {
+            bench_run_in_isr(bench_isr_queue_send);
+            total += bench_isr_elapsed;
+            xQueueReset(bench_queue);
+        } else {
+            for (uint32_t i = 0; i < bench_isr_count; i++) {
+                (void) xQueueSend(bench_queue, &item, 0);
+            }
+            bench_run_in_isr(bench_isr_queue_receive);
+            total += bench_isr_elapsed;
+        }
+    }
+
+    vQueueDelete(bench_queue);
+
+    return total;
+}
+
+static void bench_queue_echo(void *params) {
+    uint32_t item;
+
+    (void) params;
+
+    for (;;) {
+        (void) xQueueReceive(bench_queue, &item, portMAX_DELAY);
+        (void) xQueueSend(bench_reply_queue, &item, portMAX_DELAY);
+    }
+}
+
+/**
+ * @brief Ida e volta bloqueante por duas filas com uma tarefa de prioridade
+ * maior: o envio a acorda e o recebimento espera a resposta.
+ */
+static uint64_t bench_queue_round_trip(uint32_t iterations, uint32_t param) {
+    TaskHandle_t helper = NULL;
+    uint64_t elapsed = BENCH_FAILED;
+    uint32_t item = 0;
+
+    (void) param;
+
+    bench_queue = xQueueCreate(1, sizeof(uint32_t));
+    bench_reply_queue = xQueueCreate(1, sizeof(uint32_t));
+    if (bench_queue != NULL && bench_reply_queue != NULL) {
+        helper = bench_spawn(bench_queue_echo, "bench_qecho", NULL, BENCH_PRIO_ABOVE);
+    }
+
+    if (helper != NULL) {
+        uint64_t start = bench_counter();
+        for (uint32_t i = 0; i < iterations; i++) {
+            (void) xQueueSend(bench_queue, &i, portMAX_DELAY);
+            (void) xQueueReceive(bench_reply_queue, &item, portMAX_DELAY);
+        }
+        elapsed = bench_counter() - start;
+
+        vTaskDelete(helper);
+    }
+
+    if (bench_queue != NULL) {
+        vQueueDelete(bench_queue);
+    }
+    if (bench_reply_queue != NULL) {
+        vQueueDelete(bench_reply_queue);
+    }
+
+    return elapsed;
+}
+
+static void bench_isr_queue_wake(void) {
+    BaseType_t woken = pdFALSE;
+    uint32_t item = 0;
+
+    (void) xQueueSendFromISR(bench_queue, &item, &woken);
+    portYIELD_FROM_ISR(woken);
+}
+
+static void bench_queue_wake_helper(void *params) {
+    uint32_t item;
+
+    (void) params;
+
+    for (;;) {
+        (void) xQueueReceive(bench_queue, &item, portMAX_DELAY);
+        bench_woken_at = bench_counter();
+        xTaskNotifyGive(bench_runner);
+    }
+}
+
+/**
+ * @brief Latência de uma interrupção que envia a uma fila até a tarefa que
+ * esperava nela voltar a executar.
+ */
+static uint64_t bench_queue_isr_wake(uint32_t iterations, uint32_t param) {
+    TaskHandle_t helper = NULL;
+    uint64_t total = 0;
+
+    (void) param;
+
+    bench_queue = xQueueCreate(1, sizeof(uint32_t));
+    if (bench_queue != NULL) {
+        helper = bench_spawn(bench_queue_wake_helper, "bench_qwake", NULL, BENCH_PRIO_ABOVE);
+    }
+    if (helper == NULL) {
+        if (bench_queue != NULL) {
+            vQueueDelete(bench_queue);
+        }
+        return BENCH_FAILED;
+    }
+
+    for (uint32_t i = 0; i < iterations; i++) {
+        uint64_t start = bench_counter();
+        bench_run_in_isr(bench_isr_queue_wake);
+        (void) ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        total += bench_woken_at - start;
+    }
+
+    vTaskDelete(helper);
+    vQueueDelete(bench_queue);
+
+    return total;
+}
+
+/**
+ * @brief Item de param bytes enviado e recebido por cópia, para comparar com
+ * a fila sem cópia.
+ */
+static uint64_t bench_queue_copy_item(uint32_t iterations, uint32_t param) {
+    static uint8_t item[BENCH_MAX_ITEM_BYTES];
+    QueueHandle_t queue;
+
+    if (param > sizeof(item)) {
+        return BENCH_FAILED;
+    }
+    queue = xQueueCreate(BENCH_ITEM_QUEUE_LENGTH, param);
+    if (queue == NULL) {
+        return BENCH_FAILED;
+    }
+
+    // O produtor monta o item num buffer próprio, que a fila copia
+    uint64_t start = bench_counter();
+    for (uint32_t i = 0; i < iterations; i++) {
+        memset(item, (int) i, param);
+        (void) xQueueSend(queue, item, 0);
+        (void) xQueueReceive(queue, item, 0);
+        bench_sink = item[0];
+    }
+    uint64_t elapsed = bench_counter() - start;
+
+    vQueueDelete(queue);
+
+    return elapsed;
+}
+
+#if (configUSE_QUEUE_ZERO_COPY == 1)
+/**
+ * @brief O mesmo item, montado e lido diretamente no armazenamento da fila
+ * com xQueueReserve()/xQueueCommit() e xQueueAcquire()/xQueueRelease().
+ */
+static uint64_t bench_queue_zero_copy_item(uint32_t iterations, uint32_t param) {
+    QueueHandle_t queue;
+    uint8_t *slot;
+
+    if (param > BENCH_MAX_ITEM_BYTES) {
+        return BENCH_FAILED;
+    }
+    queue = xQueueCreate(BENCH_ITEM_QUEUE_LENGTH, param);
+    if (queue == NULL) {
+        return BENCH_FAILED;
+    }
+
+    uint64_t start = bench_counter();
+    for (uint32_t i = 0; i < iterations; i++) {
+        if (xQueueReserve(queue, (void **) &slot, 0) == pdPASS) {
+            memset(slot, (int) i, param);
+            (void) xQueueCommit(queue);
+        }
+        if (xQueueAcquire(queue, (void **) &slot, 0) == pdPASS) {
+            bench_sink = slot[0];
+            (void) xQueueRelease(queue);
+        }
+    }
+    uint64_t elapsed = bench_counter() - start;
+
+    vQueueDelete(queue);
+
+    return elapsed;
+}
+#endif
+
+#if (configUSE_QUEUE_BATCH_TRANSFER == 1)
+/**
+ * @brief xQueueSendMultiple() e xQueueReceiveMultiple() de lotes de param
+ * itens de 4 bytes; o tempo é por item.
+ */
+static uint64_t bench_queue_batch(uint32_t iterations, uint32_t param) {
+    static uint32_t items[BENCH_MAX_BATCH_ITEMS];
+    QueueHandle_t queue;
+
+    if (param == 0 || param > BENCH_MAX_BATCH_ITEMS) {
+        return BENCH_FAILED;
+    }
+    queue = xQueueCreate(BENCH_QUEUE_LENGTH, sizeof(uint32_t));
+    if (queue == NULL) {
+        return BENCH_FAILED;
+    }
+
+    uint64_t start = bench_counter();
+    for (uint32_t i = 0; i < iterations; i++) {
+        (void) xQueueSendMultiple(queue, items, param, 0);
+        (void) xQueueReceiveMultiple(queue, items, param, 0);
+    }
+    uint64_t elapsed = bench_counter() - start;
+
+    vQueueDelete(queue);
+
+    return elapsed;
+}
+#endif
+
+/**
+ * @brief Par envio e recebimento de um item de 4 bytes, para comparar com o
+ * lote e com o anel SPSC.
+ */
+static uint64_t bench_queue_send_receive(uint32_t iterations, uint32_t param) {
+    QueueHandle_t queue = xQueueCreate(BENCH_QUEUE_LENGTH, sizeof(uint32_t));
+    uint32_t item = 0;
+
+    (void) param;
+    if (queue == NULL) {
+        return BENCH_FAILED;
+    }
+
+    uint64_t start = bench_counter();
+    for (uint32_t i = 0; i < iterations; i++) {
+        (void) xQueueSend(queue, &item, 0);
+        (void) xQueueReceive(queue, &item, 0);
+    }
+    uint64_t elapsed = bench_counter() - start;
+
+    vQueueDelete(queue);
+
+    return elapsed;
+}
+
+#if (configUSE_SPSC_RINGS == 1)
+static SpscRingHandle_t bench_ring;
+
+/**
+ * @brief Par xSpscRingSend() e xSpscRingReceive() de um item de 4 bytes.
+ */
+static uint64_t bench_spsc_send_receive(uint32_t iterations, uint32_t param) {
+    SpscRingHandle_t ring = xSpscRingCreate(BENCH_QUEUE_LENGTH, sizeof(uint32_t));
+    uint32_t item = 0;
+
+    (void) param;
+    if (ring == NULL) {
+        return BENCH_FAILED;
+    }
+
+    uint64_t start = bench_counter();
+    for (uint32_t i = 0; i < iterations; i++) {
+        (void) xSpscRingSend(ring, &item);
+        (void) xSpscRingReceive(ring, &item, 0);
+    }
+    uint64_t elapsed = bench_counter() - start;
+
+    vSpscRingDelete(ring);
+
+    return elapsed;
+}
+
+static void bench_isr_spsc_send(void) {
+    BaseType_t woken = pdFALSE;
+    uint32_t item = 0;
+
+    uint64_t start = bench_counter();
+    for (uint32_t i = 0; i < bench_isr_count; i++) {
+        (void) xSpscRingSendFromISR(bench_ring, &item, &woken);
+    }
+    bench_isr_elapsed = bench_counter() - start;
+
+    portYIELD_FROM_ISR(woken);
+}
+
+/**
+ * @brief xSpscRingSendFromISR() em rajadas de param itens por interrupção,
+ * para comparar com xQueueSendFromISR() no mesmo tamanho de rajada.
+ */
+static uint64_t bench_spsc_send_from_isr(uint32_t iterations, uint32_t param) {
+    uint64_t total = 0;
+    uint32_t item;
+
+    if (param == 0 || param > BENCH_QUEUE_LENGTH) {
+        return BENCH_FAILED;
+    }
+    bench_ring = xSpscRingCreate(BENCH_QUEUE_LENGTH, sizeof(uint32_t));
+    if (bench_ring == NULL) {
+        return BENCH_FAILED;
+    }
+
+    for (uint32_t done = 0; done < iterations; done += param) {
+        bench_isr_count = iterations - done < param ? iterations - done : param;
+
+        bench_run_in_isr(bench_isr_spsc_send);
+        total += bench_isr_elapsed;
+
+        while (xSpscRingReceive(bench_ring, &item, 0) == pdPASS) {
+        }
+    }
+
+    vSpscRingDelete(bench_ring);
+
+    return total;
+}
+
+// Item do teste de estresse: o complemento detecta uma cópia pela metade
+typedef struct {
+    uint32_t sequence;
+    uint32_t check;
+} bench_spsc_item_t;
+
+static void bench_spsc_producer(void *params) {
+    uint32_t count = (uint32_t) (uintptr_t) params;
+
+    for (uint32_t i = 0; i < count; i++) {
+        bench_spsc_item_t item = { i, ~i };
+
+        // Anel cheio: cede a vez ao consumidor, que tem a mesma prioridade
+        while (xSpscRingSend(bench_ring, &item) != pdPASS) {
+            taskYIELD();
+        }
+    }
+
+    for (;;) {
+        (void) ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    }
+}
+
+/**
+ * @brief Teste de estresse do anel SPSC: uma tarefa produz iterations itens
+ * numerados num anel de param posições e a suíte os consome, na mesma
+ * prioridade.
+ *
+ * Com a fatia de tempo ligada, o tick interrompe as duas tarefas em pontos
+ * arbitrários do envio e do recebimento, e o anel pequeno passa o tempo todo
+ * entre cheio e vazio, de modo que o consumidor bloqueia e é acordado a cada
+ * poucos itens. O caso falha se um item chega fora de ordem, repetido ou
+ * corrompido, ou se o consumidor não é acordado (notificação perdida). O tempo
+ * é por item.
+ */
+static uint64_t bench_spsc_stress(uint32_t iterations, uint32_t param) {
+    TaskHandle_t producer;
+    bench_spsc_item_t item;
+    uint64_t elapsed = BENCH_FAILED;
+    uint32_t expected = 0;
+
+    bench_ring = xSpscRingCreate(param, sizeof(bench_spsc_item_t));
+    if (bench_ring == NULL) {
+        return BENCH_FAILED;
+    }
+
+    producer = bench_spawn(bench_spsc_producer, "bench_spsc", (void *) (uintptr_t) iterations,
+                           BENCH_PRIO_SAME);
+    if (producer != NULL) {
+        uint64_t start = bench_counter();
+        for (; expected < iterations; expected++) {
+            if (xSpscRingReceive(bench_ring, &item, pdMS_TO_TICKS(100)) != pdPASS ||
+                item.sequence != expected || item.check != ~expected) {
+                break;
+            }
+        }
+        if (expected == iterations && xSpscRingItemsWaiting(bench_ring) == 0) {
+            elapsed = bench_counter() - start;
+        }
+
+        vTaskDelete(producer);
+    }
+
+    vSpscRingDelete(bench_ring);
+
+    return elapsed;
+}
+#endif
+
+// ---------------------------------------------------------------------------
+// Semáforos e mutexes
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Par give e take de um semáforo binário (param 0), de um mutex
+ * (param 1) ou de um mutex com teto de prioridade (param 2).
+ */
+static uint64_t bench_semaphore_give_take(uint32_t iterations, uint32_t param) {
+    SemaphoreHandle_t semaphore;
+
+    switch (param) {
+    case 0:
+        semaphore = xSemaphoreCreateBinary();
+        break;
+    case 1:
+        semaphore = xSemaphoreCreateMutex();
+        break;
+#if (configUSE_CEILING_MUTEXES == 1)
+    case 2:
+        semaphore = xSemaphoreCreateCeilingMutex(BENCH_PRIO_ABOVE);
+        break;
+#endif
+    default:
+        semaphore = NULL;
+        break;
+    }
+    if (semaphore == NULL) {
+        return BENCH_FAILED;
+    }
+
+    // O mutex é criado livre; o semáforo binário, vazio
+    if (param == 0) {
+        (void) xSemaphoreGive(semaphore);
+    }
+
+    uint64_t start = bench_counter();
+    for (uint32_t i = 0; i < iterations; i++) {
+        (void) xSemaphoreTake(semaphore, 0);
+        (void) xSemaphoreGive(semaphore);
+    }
+    uint64_t elapsed = bench_counter() - start;
+
+    vSemaphoreDelete(semaphore);
+
+    return elapsed;
+}
+
+#if (configUSE_FAST_MUTEXES == 1)
+/**
+ * @brief Par take e give de um mutex rápido sem disputa.
+ */
+static uint64_t bench_fast_mutex(uint32_t iterations, uint32_t param) {
+    FastMutexHandle_t mutex = xFastMutexCreate();
+
+    (void) param;
+    if (mutex == NULL) {
+        return BENCH_FAILED;
+    }
+
+    uint64_t start = bench_counter();
+    for (uint32_t i = 0; i < iterations; i++) {
+        (void) xFastMutexTake(mutex, 0);
+        (void) xFastMutexGive(mutex);
+    }
+    uint64_t elapsed = bench_counter() - start;
+
+    vFastMutexDelete(mutex);
+
+    return elapsed;
+}
+#endif
+
+#if (configUSE_RW_LOCKS == 1)
+static RWLockHandle_t bench_rw_lock;
+
+/**
+ * @brief Par take e give de leitura (param 0) ou de escrita (param 1) sem
+ * disputa.
+ */
+static uint64_t bench_rw_lock_uncontended(uint32_t iterations, uint32_t param) {
+    RWLockHandle_t lock = xRWLockCreate();
+
+    if (lock == NULL) {
+        return BENCH_FAILED;
+    }
+
+    uint64_t start = bench_counter();
+    for (uint32_t i = 0; i < iterations; i++) {
+        if (param == 0) {
+            (void) xRWLockTakeRead(lock, 0);
+            (void) xRWLockGiveRead(lock);
+        } else {
+            (void) xRWLockTakeWrite(lock, 0);
+            (void) xRWLockGiveWrite(lock);
+        }
+    }
+    uint64_t elapsed = bench_counter() - start;
+
+    vRWLockDelete(lock);
+
+    return elapsed;
+}
+
+static void bench_reader(void *params) {
+    uint32_t iterations = (uint32_t) (uintptr_t) params;
+
+    (void) ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+    // Cede o processador com a trava de leitura tomada, para que os leitores
+    // a segurem ao mesmo tempo
+    for (uint32_t i = 0; i < iterations; i++) {
+        (void) xRWLockTakeRead(bench_rw_lock, portMAX_DELAY);
+        taskYIELD();
+        (void) xRWLockGiveRead(bench_rw_lock);
+    }
+
+    xTaskNotifyGive(bench_runner);
+    for (;;) {
+        (void) ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    }
+}
+
+/**
+ * @brief Leituras com param leitores simultâneos, que cedem o processador
+ * entre o take e o give; o tempo é por leitura, troca incluída.
+ */
+static uint64_t bench_rw_lock_readers(uint32_t iterations, uint32_t param) {
+    TaskHandle_t readers[BENCH_MAX_READERS] = { NULL };
+    uint64_t elapsed = BENCH_FAILED;
+    uint32_t created = 0;
+
+    bench_rw_lock = xRWLockCreate();
+    if (bench_rw_lock == NULL || param > BENCH_MAX_READERS) {
+        return BENCH_FAILED;
+    }
+
+    // Acima dos leitores enquanto os cria e libera, para que nenhum comece
+    // antes dos outros
+    vTaskPrioritySet(NULL, BENCH_PRIO_ABOVE + 1);
+    for (; created < param; created++) {
+        readers[created] = bench_spawn(bench_reader, "bench_reader",
+                                       (void *) (uintptr_t) iterations, BENCH_PRIO_ABOVE);
+        if (readers[created] == NULL) {
+            break;
+        }
+    }
+
+    if (created == param) {
+        for (uint32_t i = 0; i < param; i++) {
+            xTaskNotifyGive(readers[i]);
+        }
+
+        uint64_t start = bench_counter();
+        vTaskPrioritySet(NULL, BENCH_TASK_PRIORITY);
+        for (uint32_t i = 0; i < param; i++) {
+            (void) ulTaskNotifyTake(pdFALSE, portMAX_DELAY);
+        }
+        elapsed = bench_counter() - start;
+    }
+
+    vTaskPrioritySet(NULL, BENCH_TASK_PRIORITY);
+    for (uint32_t i = 0; i < created; i++) {
+        vTaskDelete(readers[i]);
+    }
+    vRWLockDelete(bench_rw_lock);
+
+    return elapsed;
+}
+#endif
+
+// ---------------------------------------------------------------------------
+// Grupos de eventos
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Par xEventGroupSetBits() e xEventGroupWaitBits() sem bloqueio.
+ */
+static uint64_t bench_event_group_set_wait(uint32_t iterations, uint32_t param) {
+    EventGroupHandle_t group = xEventGroupCreate();
+
+    (void) param;
+    if (group == NULL) {
+        return BENCH_FAILED;
+    }
+
+    uint64_t start = bench_counter();
+    for (uint32_t i = 0; i < iterations; i++) {
+        (void) xEventGroupSetBits(group, BENCH_BIT_PING);
+        (void) xEventGroupWaitBits(group, BENCH_BIT_PING, pdTRUE, pdFALSE, 0);
+    }
+    uint64_t elapsed = bench_counter() - start;
+
+    vEventGroupDelete(group);
+
+    return elapsed;
+}
+
+static void bench_event_echo(void *params) {
+    (void) params;
+
+    for (;;) {
+        (void) xEventGroupWaitBits(bench_event_group, BENCH_BIT_PING, pdTRUE, pdFALSE, portMAX_DELAY);
+        (void) xEventGroupSetBits(bench_event_group, BENCH_BIT_PONG);
+    }
+}
+
+static void bench_event_idle_waiter(void *params) {
+    EventBits_t bit = (EventBits_t) (uintptr_t) params;
+
+    for (;;) {
+        (void) xEventGroupWaitBits(bench_event_group, bit, pdTRUE, pdFALSE, portMAX_DELAY);
+    }
+}
+
+// Tipos de grupo de eventos comparados
+typedef enum {
+    BENCH_GROUP_PLAIN,
+    BENCH_GROUP_INDEXED,
+    BENCH_GROUP_DIRECT,
+} bench_group_kind_t;
+
+static EventGroupHandle_t bench_event_group_create(bench_group_kind_t kind) {
+    switch (kind) {
+#if (configUSE_INDEXED_EVENT_GROUPS == 1)
+    case BENCH_GROUP_INDEXED:
+        return xEventGroupCreateIndexed();
+#endif
+#if (configUSE_DIRECT_EVENT_GROUPS == 1)
+    case BENCH_GROUP_DIRECT:
+        return xEventGroupCreateDirect();
+#endif
+    case BENCH_GROUP_PLAIN:
+        return xEventGroupCreate();
+    default:
+        return NULL;
+    }
+}
+
+/**
+ * @brief Ida e volta por um grupo de eventos com uma tarefa de prioridade
+ * maior, com idle_waiters outras tarefas esperando em outros bits.
+ *
+ * Cada xEventGroupSetBits() de um grupo comum percorre todas as tarefas que
+ * esperam no grupo; o de um grupo indexado, só as que esperam no bit.
+ */
+static uint64_t bench_event_group_round_trip(uint32_t iterations, uint32_t idle_waiters,
+                                             bench_group_kind_t kind) {
+    TaskHandle_t waiters[BENCH_MAX_IDLE_WAITERS] = { NULL };
+    TaskHandle_t helper = NULL;
+    uint64_t elapsed = BENCH_FAILED;
+    uint32_t created = 0;
+
+    if (idle_waiters > BENCH_MAX_IDLE_WAITERS) {
+        return BENCH_FAILED;
+    }
+
+    bench_event_group = bench_event_group_create(kind);
+    if (bench_event_group == NULL) {
+        return BENCH_FAILED;
+    }
+
+    for (; created < idle_waiters; created++) {
+        waiters[created] = bench_spawn(bench_event_idle_waiter, "bench_evidle",
+                                       (void *) (uintptr_t) (1u << (BENCH_BIT_IDLE_0 + created)),
+                                       BENCH_PRIO_ABOVE);
+        if (waiters[created] == NULL) {
+            break;
+        }
+    }
+
+    if (created == idle_waiters) {
+        helper = bench_spawn(bench_event_echo, "bench_evecho", NULL, BENCH_PRIO_ABOVE);
+    }
+
+    if (helper != NULL) {
+        uint64_t start = bench_counter();
+        for (uint32_t i = 0; i < iterations; i++) {
+            (void) xEventGroupSetBits(bench_event_group, BENCH_BIT_PING);
+            (void) xEventGroupWaitBits(bench_event_group, BENCH_BIT_PONG, pdTRUE, pdFALSE,
+                                       portMAX_DELAY);
+        }
+        elapsed = bench_counter() - start;
+
+        vTaskDelete(helper);
+    }
+
+    for (uint32_t i = 0; i < created; i++) {
+        vTaskDelete(waiters[i]);
+    }
+    vEventGroupDelete(bench_event_group);
+
+    return elapsed;
+}
+
+static uint64_t bench_event_group_round_trip_plain(uint32_t iterations, uint32_t param) {
+    return bench_event_group_round_trip(iterations, param, BENCH_GROUP_PLAIN);
+}
+
+#if (configUSE_INDEXED_EVENT_GROUPS == 1)
+static uint64_t bench_event_group_round_trip_indexed(uint32_t iterations, uint32_t param) {
+    return bench_event_group_round_trip(iterations, param, BENCH_GROUP_INDEXED);
+}
+#endif
+
+#if (INCLUDE_xTimerPendFunctionCall == 1) || (configUSE_DIRECT_EVENT_GROUPS == 1)
+static void bench_event_wake_helper(void *params) {
+    (void) params;
+
+    for (;;) {
+        (void) xEventGroupWaitBits(bench_event_group, BENCH_BIT_PING, pdTRUE, pdFALSE, portMAX_DELAY);
+        bench_woken_at = bench_counter();
+        xTaskNotifyGive(bench_runner);
+    }
+}
+
+static void bench_isr_event_set(void) {
+    BaseType_t woken = pdFALSE;
+
+#if (configUSE_DIRECT_EVENT_GROUPS == 1)
+    if (bench_isr_direct) {
+        (void) xEventGroupSetBitsDirectFromISR(bench_event_group, BENCH_BIT_PING, &woken);
+    } else
+#endif
+    {
+        (void) xEventGroupSetBitsFromISR(bench_event_group, BENCH_BIT_PING, &woken);
+    }
+
+    portYIELD_FROM_ISR(woken);
+}
+
+/**
+ * @brief Latência de uma interrupção que liga um bit até a tarefa que
+ * esperava nele voltar a executar: adiada pela tarefa de serviço dos
+ * temporizadores (param 0) ou direta, num grupo criado com
+ * xEventGroupCreateDirect() (param 1).
+ */
+static uint64_t bench_event_group_isr_wake(uint32_t iterations, uint32_t param) {
+    TaskHandle_t helper;
+    uint64_t total = 0;
+
+    bench_event_group = bench_event_group_create(param != 0 ? BENCH_GROUP_DIRECT : BENCH_GROUP_PLAIN);
+    if (bench_event_group == NULL) {
+        return BENCH_FAILED;
+    }
+    helper = bench_spawn(bench_event_wake_helper, "bench_evwake", NULL, BENCH_PRIO_ABOVE);
+    if (helper == NULL) {
+        vEventGroupDelete(bench_event_group);
+        return BENCH_FAILED;
+    }
+
+    bench_isr_direct = param != 0;
+    for (uint32_t i = 0; i < iterations; i++) {
+        uint64_t start = bench_counter();
+        bench_run_in_isr(bench_isr_event_set);
+        (void) ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        total += bench_woken_at - start;
+    }
+
+    vTaskDelete(helper);
+    vEventGroupDelete(bench_event_group);
+
+    return total;
+}
+#endif
+
+// ---------------------------------------------------------------------------
+// Stream buffers
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Par xStreamBufferSend() e xStreamBufferReceive() de param bytes.
+ */
+static uint64_t bench_stream_buffer(uint32_t iterations, uint32_t param) {
+    static uint8_t data[BENCH_STREAM_BUFFER_BYTES / 4];
+    StreamBufferHandle_t buffer = xStreamBufferCreate(BENCH_STREAM_BUFFER_BYTES, 1);
+
+    if (buffer == NULL || param > sizeof(data)) {
+        if (buffer != NULL) {
+            vStreamBufferDelete(buffer);
+        }
+        return BENCH_FAILED;
+    }
+
+    uint64_t start = bench_counter();
+    for (uint32_t i = 0; i < iterations; i++) {
+        (void) xStreamBufferSend(buffer, data, param, 0);
+        (void) xStreamBufferReceive(buffer, data, param, 0);
+    }
+    uint64_t elapsed = bench_counter() - start;
+
+    vStreamBufferDelete(buffer);
+
+    return elapsed;
+}
+
+// ---------------------------------------------------------------------------
+// Temporizadores
+// ---------------------------------------------------------------------------
+
+static void bench_timer_callback(TimerHandle_t timer) {
+    (void) timer;
+
+    bench_woken_at = bench_counter();
+    xTaskNotifyGive(bench_runner);
+}
+
+/**
+ * @brief Par xTimerStart() e xTimerStop().
+ *
+ * A tarefa de serviço dos temporizadores tem prioridade maior que a da
+ * suíte, então cada comando é tratado antes de a chamada retornar: o tempo
+ * inclui o envio, o tratamento e as duas trocas de contexto.
+ */
+static uint64_t bench_timer_start_stop(uint32_t iterations, uint32_t param) {
+    TimerHandle_t timer = xTimerCreate("bench_timer", pdMS_TO_TICKS(1000), pdFALSE, NULL,
+                                       bench_timer_callback);
+
+    (void) param;
+    if (timer == NULL) {
+        return BENCH_FAILED;
+    }
+
+    uint64_t start = bench_counter();
+    for (uint32_t i = 0; i < iterations; i++) {
+        (void) xTimerStart(timer, portMAX_DELAY);
+        (void) xTimerStop(timer, portMAX_DELAY);
+    }
+    uint64_t elapsed = bench_counter() - start;
+
+    (void) xTimerDelete(timer, portMAX_DELAY);
+
+    return elapsed;
+}
+
+/**
+ * @brief Atraso da chamada de um temporizador além do de uma tarefa
+ * acordada por vTaskDelay().
+ *
+ * A suíte acorda logo após um tick, arma um temporizador de um tick e mede
+ * até a chamada. Descontado o período do tick, o que sobra é quanto a
+ * chamada do temporizador chega depois do que uma tarefa acordaria pelo
+ * mesmo tick: o tratamento da lista de temporizadores na tarefa de serviço.
+ */
+static uint64_t bench_timer_expiry(uint32_t iterations, uint32_t param) {
+    TimerHandle_t timer = xTimerCreate("bench_timer", 1, pdFALSE, NULL, bench_timer_callback);
+    uint64_t tick = bench_counter_hz() / configTICK_RATE_HZ;
+    uint64_t total = 0;
+
+    (void) param;
+    if (timer == NULL) {
+        return BENCH_FAILED;
+    }
+
+    for (uint32_t i = 0; i < iterations; i++) {
+        vTaskDelay(1);
+        uint64_t start = bench_counter();
+        (void) xTimerStart(timer, portMAX_DELAY);
+        (void) ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        uint64_t elapsed = bench_woken_at - start;
+        total += elapsed > tick ? elapsed - tick : 0;
+    }
+
+    (void) xTimerDelete(timer, portMAX_DELAY);
+
+    return total;
+}
+
+#if (configUSE_CORO_SCHEDULER == 1)
+// ---------------------------------------------------------------------------
+// Co-rotinas
+// ---------------------------------------------------------------------------
+
+// As duas co-rotinas dos casos abaixo, as voltas que faltam a cada uma e o
+// resultado das esperas; ficam fora das funções porque as co-rotinas não
+// guardam variáveis locais entre as esperas
+static Coro_t bench_coros[2];
+static uint32_t bench_coro_remaining[2];
+static uint32_t bench_coro_value;
+
+/**
+ * @brief Cede a vez até acabarem as voltas; duas delas se alternam.
+ */
+static void bench_coro_yielder(Coro_t *coro, void *params) {
+    uint32_t *remaining = params;
+
+    coroSTART(coro);
+    while (*remaining > 0) {
+        (*remaining)--;
+        coroYIELD(coro);
+    }
+    coroEND(coro);
+}
+
+/**
+ * @brief Notifica a outra co-rotina e espera a resposta, a cada volta.
+ */
+static void bench_coro_ping(Coro_t *coro, void *params) {
+    uint32_t *remaining = params;
+
+    coroSTART(coro);
+    while (*remaining > 0) {
+        (*remaining)--;
+        (void) xCoroNotifyGive(&bench_coros[1]);
+        coroNOTIFY_TAKE(coro, pdTRUE, portMAX_DELAY, &bench_coro_value);
+    }
+    coroEND(coro);
+}
+
+/**
+ * @brief Devolve cada notificação recebida, como bench_notify_echo().
+ */
+static void bench_coro_echo(Coro_t *coro, void *params) {
+    uint32_t *remaining = params;
+
+    coroSTART(coro);
+    while (*remaining > 0) {
+        (*remaining)--;
+        coroNOTIFY_TAKE(coro, pdTRUE, portMAX_DELAY, &bench_coro_value);
+        (void) xCoroNotifyGive(&bench_coros[0]);
+    }
+    coroEND(coro);
+}
+
+/**
+ * @brief Executa as duas co-rotinas, com iterations voltas cada, num grupo
+ * hospedado pela própria tarefa da suíte, até ambas terminarem.
+ */
+static uint64_t bench_coro_pair(uint32_t iterations, CoroFunction_t first, CoroFunction_t second) {
+    CoroScheduler_t scheduler;
+
+    if (xCoroSchedulerCreate(&scheduler, 0) != pdPASS) {
+        return BENCH_FAILED;
+    }
+
+    bench_coro_remaining[0] = iterations;
+    bench_coro_remaining[1] = iterations;
+    vCoroCreate(&scheduler, &bench_coros[0], first, &bench_coro_remaining[0]);
+    vCoroCreate(&scheduler, &bench_coros[1], second, &bench_coro_remaining[1]);
+
+    uint64_t start = bench_counter();
+    vCoroSchedulerRun(&scheduler);
+    uint64_t elapsed = bench_counter() - start;
+
+    vCoroSchedulerDelete(&scheduler);
+
+    return elapsed;
+}
+
+/**
+ * @brief Troca entre duas co-rotinas que cedem a vez, para comparar com
+ * context_switch_yield.
+ */
+static uint64_t bench_coro_yield_switch(uint32_t iterations, uint32_t param) {
+    (void) param;
+    return bench_coro_pair(iterations, bench_coro_yielder, bench_coro_yielder);
+}
+
+/**
+ * @brief Ida e volta de notificações entre duas co-rotinas, para comparar
+ * com task_notify_round_trip.
+ */
+static uint64_t bench_coro_notify_round_trip(uint32_t iterations, uint32_t param) {
+    (void) param;
+    return bench_coro_pair(iterations, bench_coro_ping, bench_coro_echo);
+}
+#endif
+
+// ---------------------------------------------------------------------------
+// Memória
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Par pvPortMalloc() e vPortFree() de param bytes, do heap escolhido
+ * em FREERTOS_HEAP.
+ */
+static uint64_t bench_heap(uint32_t iterations, uint32_t param) {
+    uint64_t start = bench_counter();
+    for (uint32_t i = 0; i < iterations; i++) {
+        void *block = pvPortMalloc(param);
+        if (block == NULL) {
+            return BENCH_FAILED;
+        }
+        vPortFree(block);
+    }
+
+    return bench_counter() - start;
+}
+
+// Padrão aleatório de alocações: cada operação sorteia uma de
+// BENCH_FRAG_SLOTS posições e libera o bloco que está nela ou aloca um de
+// tamanho sorteado entre BENCH_FRAG_MIN_BYTES e BENCH_FRAG_MAX_BYTES. A
+// semente é fixa, então a sequência é a mesma em cada repetição e em cada
+// commit, e os heaps são comparados com a mesma carga.
+#define BENCH_FRAG_SLOTS     32
+#define BENCH_FRAG_MIN_BYTES 16
+#define BENCH_FRAG_MAX_BYTES 512
+#define BENCH_FRAG_SEED      0x2545F491u
+
+static uint32_t bench_random(uint32_t *state) {
+    uint32_t x = *state;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+
+    return x;
+}
+
+/**
+ * @brief Executa operations passos do padrão aleatório.
+ *
+ * Cada pvPortMalloc() e vPortFree() é medido isoladamente. Com
+ * BENCH_HEAP_STATS em 1, a fragmentação é amostrada depois de cada passo,
+ * fora da medida, e a maior vai para o JSON: os bytes livres fora do maior
+ * bloco livre, que não dependem do tamanho total do heap como o índice por
+ * mil de vHeapGetSnapshot().
+ *
+ * @param worst Recebe o pior pvPortMalloc() isolado.
+ *
+ * @return Soma das medidas, ou BENCH_FAILED se o heap esgotou.
+ */
+static uint64_t bench_heap_pattern(uint32_t operations, uint64_t *worst) {
+    void *blocks[BENCH_FRAG_SLOTS] = { NULL };
+    uint32_t state = BENCH_FRAG_SEED;
+    uint64_t total = 0;
+    bool failed = false;
+
+    *worst = 0;
+    for (uint32_t i = 0; i < operations && !failed; i++) {
+        uint32_t slot = bench_random(&state) % BENCH_FRAG_SLOTS;
+        uint64_t start;
+        uint64_t elapsed;
+
+        if (blocks[slot] != NULL) {
+            start = bench_counter();
+            vPortFree(blocks[slot]);
+            elapsed = bench_counter() - start;
+            blocks[slot] = NULL;
+        } else {
+            size_t size = BENCH_FRAG_MIN_BYTES +
+                          bench_random(&state) % (BENCH_FRAG_MAX_BYTES - BENCH_FRAG_MIN_BYTES + 1);
+            start = bench_counter();
+            blocks[slot] = pvPortMalloc(size);
+            elapsed = bench_counter() - start;
+            failed = blocks[slot] == NULL;
+            if (elapsed > *worst) {
+                *worst = elapsed;
+            }
+        }
+        total += elapsed;
+
+#if BENCH_HEAP_STATS
+        HeapStats_t stats;
+        vPortGetHeapStats(&stats);
+        bench_metric("fragmented_free_bytes",
+                     (double) (stats.xAvailableHeapSpaceInBytes - stats.xSizeOfLargestFreeBlockInBytes));
+#endif
+    }
+
+    for (uint32_t slot = 0; slot < BENCH_FRAG_SLOTS; slot++) {
+        vPortFree(blocks[slot]);
+    }
+
+    return failed ? BENCH_FAILED : total;
+}
+
+/**
+ * @brief Tempo médio por operação do padrão aleatório.
+ */
+static uint64_t bench_heap_fragmenting(uint32_t iterations, uint32_t param) {
+    uint64_t worst;
+
+    (void) param;
+    return bench_heap_pattern(iterations, &worst);
+}
+
+/**
+ * @brief Pior pvPortMalloc() isolado em param passos do padrão aleatório;
+ * com uma iteração, o tempo por operação do JSON é essa latência.
+ */
+static uint64_t bench_heap_fragmenting_worst(uint32_t iterations, uint32_t param) {
+    uint64_t worst;
+
+    (void) iterations;
+    return bench_heap_pattern(param, &worst) == BENCH_FAILED ? BENCH_FAILED : worst;
+}
+
+#if (configUSE_BLOCK_POOLS == 1)
+/**
+ * @brief Par pvBlockPoolAlloc() e vBlockPoolFree() de blocos de
+ * BENCH_ITEM_BYTES, para comparar com o heap.
+ */
+static uint64_t bench_block_pool(uint32_t iterations, uint32_t param) {
+    static uint8_t storage[blockpoolSTORAGE_SIZE(BENCH_ITEM_BYTES, 4)];
+    static StaticBlockPool_t pool_buffer;
+    BlockPoolHandle_t pool = xBlockPoolCreateStatic(BENCH_ITEM_BYTES, 4, storage, &pool_buffer);
+
+    (void) param;
+    if (pool == NULL) {
+        return BENCH_FAILED;
+    }
+
+    uint64_t start = bench_counter();
+    for (uint32_t i = 0; i < iterations; i++) {
+        void *block = pvBlockPoolAlloc(pool);
+        vBlockPoolFree(pool, block);
+    }
+
+    return bench_counter() - start;
+}
+#endif
+
+// ---------------------------------------------------------------------------
+// Tabela de casos
+// ---------------------------------------------------------------------------
+
+// Um lote de n itens por chamada, com o mesmo total de itens em todos os
+// tamanhos; ops_per_s sai em itens por segundo, comparável ao de
+// queue_send_receive
+#define BENCH_QUEUE_BATCH_CASE(n) \
+    { "queue_batch_" #n "_send_receive_per_item", bench_queue_batch, BENCH_ITERATIONS / (n), (n), (n) }
+
+// Ida e volta por um grupo de eventos com n tarefas ociosas esperando em
+// outros bits, até BENCH_MAX_IDLE_WAITERS
+#define BENCH_EVENT_WAITERS_CASE(prefix, function, n) \
+    { prefix "_round_trip_" #n "_waiters", function, BENCH_ITERATIONS, (n), 1 }
+
+static const bench_case_t bench_cases[] = {
+    { "loop_overhead", bench_loop_overhead, BENCH_ITERATIONS, 0, 1 },
+    { "yield_no_switch", bench_yield_no_switch, BENCH_ITERATIONS, 0, 1 },
+    { "context_switch_yield", bench_context_switch_yield, BENCH_ITERATIONS, 0, 2 },
+    { "task_notify_give_take", bench_notify_give_take, BENCH_ITERATIONS, 0, 1 },
+    { "task_notify_round_trip", bench_notify_round_trip, BENCH_ITERATIONS, 0, 1 },
+    { "queue_send", bench_queue_send, BENCH_ITERATIONS, 0, 1 },
+    { "queue_receive", bench_queue_receive, BENCH_ITERATIONS, 0, 1 },
+    // Rajadas de 64 itens por interrupção; as de 1 e 8 vêm a seguir, e as do
+    // anel SPSC usam os mesmos tamanhos
+    { "queue_send_from_isr", bench_queue_from_isr, BENCH_ITERATIONS, 0, 1 },
+    { "queue_send_from_isr_burst_1", bench_queue_send_from_isr_burst, BENCH_ITERATIONS, 1, 1 },
+    { "queue_send_from_isr_burst_8", bench_queue_send_from_isr_burst, BENCH_ITERATIONS, 8, 1 },
+    { "queue_receive_from_isr", bench_queue_from_isr, BENCH_ITERATIONS, 1, 1 },
+    { "queue_round_trip_blocking", bench_queue_round_trip, BENCH_ITERATIONS, 0, 1 },
+    { "queue_isr_to_task_wake", bench_queue_isr_wake, BENCH_ITERATIONS / 10, 0, 1 },
+    { "queue_send_receive", bench_queue_send_receive, BENCH_ITERATIONS, 0, 1 },
+#if (configUSE_QUEUE_BATCH_TRANSFER == 1)
+    BENCH_QUEUE_BATCH_CASE(1),
+    BENCH_QUEUE_BATCH_CASE(2),
+    BENCH_QUEUE_BATCH_CASE(4),
+    BENCH_QUEUE_BATCH_CASE(8),
+    BENCH_QUEUE_BATCH_CASE(16),
+    BENCH_QUEUE_BATCH_CASE(32),
+    BENCH_QUEUE_BATCH_CASE(64),
+#endif
+    { "queue_copy_4b_send_receive", bench_queue_copy_item, BENCH_ITERATIONS, 4, 1 },
+    { "queue_copy_16b_send_receive", bench_queue_copy_item, BENCH_ITERATIONS, 16, 1 },
+    { "queue_copy_64b_send_receive", bench_queue_copy_item, BENCH_ITERATIONS, 64, 1 },
+    { "queue_copy_256b_send_receive", bench_queue_copy_item, BENCH_ITERATIONS, 256, 1 },
+#if (configUSE_QUEUE_ZERO_COPY == 1)
+    { "queue_zero_copy_4b_reserve_acquire", bench_queue_zero_copy_item, BENCH_ITERATIONS, 4, 1 },
+    { "queue_zero_copy_16b_reserve_acquire", bench_queue_zero_copy_item, BENCH_ITERATIONS, 16, 1 },
+    { "queue_zero_copy_64b_reserve_acquire", bench_queue_zero_copy_item, BENCH_ITERATIONS, 64, 1 },
+    { "queue_zero_copy_256b_reserve_acquire", bench_queue_zero_copy_item, BENCH_ITERATIONS, 256, 1 },
+#endif
+#if (configUSE_SPSC_RINGS == 1)
+    { "spsc_ring_send_receive", bench_spsc_send_receive, BENCH_ITERATIONS, 0, 1 },
+    { "spsc_ring_send_from_isr", bench_spsc_send_from_isr, BENCH_ITERATIONS, BENCH_QUEUE_LENGTH, 1 },
+    { "spsc_ring_send_from_isr_burst_1", bench_spsc_send_from_isr, BENCH_ITERATIONS, 1, 1 },
+    { "spsc_ring_send_from_isr_burst_8", bench_spsc_send_from_isr, BENCH_ITERATIONS, 8, 1 },
+    { "spsc_ring_stress_sequence", bench_spsc_stress, BENCH_ITERATIONS * 20, 8, 1 },
+#endif
+    { "semaphore_give_take", bench_semaphore_give_take, BENCH_ITERATIONS, 0, 1 },
+    { "mutex_take_give", bench_semaphore_give_take, BENCH_ITERATIONS, 1, 1 },
+#if (configUSE_CEILING_MUTEXES == 1)
+    { "ceiling_mutex_take_give", bench_semaphore_give_take, BENCH_ITERATIONS, 2, 1 },
+#endif
+#if (configUSE_FAST_MUTEXES == 1)
+    { "fast_mutex_take_give", bench_fast_mutex, BENCH_ITERATIONS, 0, 1 },
+#endif
+#if (configUSE_RW_LOCKS == 1)
+    { "rw_lock_read_take_give", bench_rw_lock_uncontended, BENCH_ITERATIONS, 0, 1 },
+    { "rw_lock_write_take_give", bench_rw_lock_uncontended, BENCH_ITERATIONS, 1, 1 },
+    { "rw_lock_read_1_reader", bench_rw_lock_readers, BENCH_ITERATIONS / 4, 1, 1 },
+    { "rw_lock_read_2_readers", bench_rw_lock_readers, BENCH_ITERATIONS / 4, 2, 2 },
+    { "rw_lock_read_4_readers", bench_rw_lock_readers, BENCH_ITERATIONS / 4, 4, 4 },
+#endif
+    { "event_group_set_wait", bench_event_group_set_wait, BENCH_ITERATIONS, 0, 1 },
+    { "event_group_round_trip", bench_event_group_round_trip_plain, BENCH_ITERATIONS, 0, 1 },
+    BENCH_EVENT_WAITERS_CASE("event_group", bench_event_group_round_trip_plain, 1),
+    BENCH_EVENT_WAITERS_CASE("event_group", bench_event_group_round_trip_plain, 2),
+    BENCH_EVENT_WAITERS_CASE("event_group", bench_event_group_round_trip_plain, 4),
+    BENCH_EVENT_WAITERS_CASE("event_group", bench_event_group_round_trip_plain, 8),
+    BENCH_EVENT_WAITERS_CASE("event_group", bench_event_group_round_trip_plain, 16),
+    BENCH_EVENT_WAITERS_CASE("event_group", bench_event_group_round_trip_plain, 22),
+#if (configUSE_INDEXED_EVENT_GROUPS == 1)
+    { "event_group_indexed_round_trip", bench_event_group_round_trip_indexed, BENCH_ITERATIONS, 0, 1 },
+    BENCH_EVENT_WAITERS_CASE("event_group_indexed", bench_event_group_round_trip_indexed, 1),
+    BENCH_EVENT_WAITERS_CASE("event_group_indexed", bench_event_group_round_trip_indexed, 2),
+    BENCH_EVENT_WAITERS_CASE("event_group_indexed", bench_event_group_round_trip_indexed, 4),
+    BENCH_EVENT_WAITERS_CASE("event_group_indexed", bench_event_group_round_trip_indexed, 8),
+    BENCH_EVENT_WAITERS_CASE("event_group_indexed", bench_event_group_round_trip_indexed, 16),
+    BENCH_EVENT_WAITERS_CASE("event_group_indexed", bench_event_group_round_trip_indexed, 22),
+#endif
+#if (INCLUDE_xTimerPendFunctionCall == 1)
+    { "event_group_isr_to_task_deferred", bench_event_group_isr_wake, BENCH_ITERATIONS / 10, 0, 1 },
+#endif
+#if (configUSE_DIRECT_EVENT_GROUPS == 1)
+    { "event_group_isr_to_task_direct", bench_event_group_isr_wake, BENCH_ITERATIONS / 10, 1, 1 },
+#endif
+    { "stream_buffer_send_receive_1b", bench_stream_buffer, BENCH_ITERATIONS, 1, 1 },
+    { "stream_buffer_send_receive_16b", bench_stream_buffer, BENCH_ITERATIONS, 16, 1 },
+    { "stream_buffer_send_receive_64b", bench_stream_buffer, BENCH_ITERATIONS, 64, 1 },
+    { "stream_buffer_send_receive_256b", bench_stream_buffer, BENCH_ITERATIONS, 256, 1 },
+    { "timer_start_stop", bench_timer_start_stop, BENCH_ITERATIONS / 10, 0, 1 },
+    { "timer_expiry_latency", bench_timer_expiry, 20, 0, 1 },
+#if (configUSE_CORO_SCHEDULER == 1)
+    { "coro_yield_switch", bench_coro_yield_switch, BENCH_ITERATIONS, 0, 2 },
+    { "coro_notify_round_trip", bench_coro_notify_round_trip, BENCH_ITERATIONS, 0, 1 },
+#endif
+    { "heap_malloc_free_16b", bench_heap, BENCH_ITERATIONS, 16, 1 },
+    { "heap_malloc_free_64b", bench_heap, BENCH_ITERATIONS, BENCH_ITEM_BYTES, 1 },
+    { "heap_malloc_free_256b", bench_heap, BENCH_ITERATIONS, 256, 1 },
+    { "heap_fragmenting_pattern", bench_heap_fragmenting, BENCH_ITERATIONS, 0, 1 },
+    { "heap_fragmenting_malloc_worst", bench_heap_fragmenting_worst, 1, BENCH_ITERATIONS, 1 },
+#if (configUSE_BLOCK_POOLS == 1)
+    { "block_pool_alloc_free_64b", bench_block_pool, BENCH_ITERATIONS, 0, 1 },
+#endif
+};
+
+// ---------------------------------------------------------------------------
+// Execução e JSON
+// ---------------------------------------------------------------------------
+
+static void bench_sort(uint64_t *values, size_t count) {
+    for (size_t i = 1; i < count; i++) {
+        uint64_t value = values[i];
+        size_t j = i;
+        while (j > 0 && values[j - 1] > value) {
+            values[j] = values[j - 1];
+            j--;
+        }
+        values[j] = value;
+    }
+}
+
+/**
+ * @brief Executa um caso BENCH_RUNS vezes e escreve o seu objeto JSON.
+ *
+ * @return true se todas as repetições foram executadas.
+ */
+static bool bench_run_case(const bench_case_t *bench, bool first) {
+    uint64_t runs[BENCH_RUNS];
+    char line[256];
+    char metric[64] = "";
+
+    bench_metric_name = NULL;
+    for (unsigned r = 0; r < BENCH_RUNS; r++) {
+        // Notificações que sobraram de um caso anterior não podem acordar a
+        // suíte antes da hora
+        (void) xTaskNotifyStateClear(NULL);
+        (void) ulTaskNotifyValueClear(NULL, UINT32_MAX);
+
+        runs[r] = bench->run(bench->iterations, bench->param);
+
+        // Dá à tarefa ociosa a chance de liberar as tarefas auxiliares
+        // apagadas, antes da próxima repetição
+        vTaskDelay(1);
+
+        if (runs[r] == BENCH_FAILED) {
+            snprintf(line, sizeof(line), "%s\n    {\"name\": \"%s\", \"error\": \"falhou\"}",
+                     first ? "" : ",", bench->name);
+            bench_write(line);
+            return false;
+        }
+    }
+
+    bench_sort(runs, BENCH_RUNS);
+
+    double ops = (double) bench->iterations * bench->ops_per_iteration;
+    double ns_per_count = 1e9 / (double) bench_counter_hz();
+    double ns_min = runs[0] * ns_per_count / ops;
+    double ns_median = runs[BENCH_RUNS / 2] * ns_per_count / ops;
+    double ns_max = runs[BENCH_RUNS - 1] * ns_per_count / ops;
+    uint64_t cpu_hz = bench_cpu_hz();
+    char cycles[32];
+
+    if (cpu_hz != 0) {
+        snprintf(cycles, sizeof(cycles), "%.1f", ns_median * (double) cpu_hz / 1e9);
+    } else {
+        snprintf(cycles, sizeof(cycles), "null");
+    }
+
+    if (bench_metric_name != NULL) {
+        snprintf(metric, sizeof(metric), ", \"%s\": %.0f", bench_metric_name, bench_metric_value);
+    }
+
+    snprintf(line, sizeof(line),
+             "%s\n    {\"name\": \"%s\", \"ops\": %lu, \"runs\": %u, "
+             "\"ns_min\": %.1f, \"ns_median\": %.1f, \"ns_max\": %.1f, "
+             "\"cycles_median\": %s, \"ops_per_s\": %.0f%s}",
+             first ? "" : ",", bench->name, (unsigned long) ops, (unsigned) BENCH_RUNS,
+             ns_min, ns_median, ns_max, cycles, ns_median > 0.0 ? 1e9 / ns_median : 0.0, metric);
+    bench_write(line);
+
+    return true;
+}
+
+/**
+ * @brief Escreve o cabeçalho do documento, com a configuração do kernel que
+ * afeta os resultados e o tamanho do descritor de uma tarefa e de uma
+ * co-rotina.
+ */
+static void bench_write_header(void) {
+    char line[640];
+    char coro_bytes[16];
+
+#if (configUSE_CORO_SCHEDULER == 1)
+    snprintf(coro_bytes, sizeof(coro_bytes), "%u", (unsigned) sizeof(Coro_t));
+#else
+    snprintf(coro_bytes, sizeof(coro_bytes), "null");
+#endif
+
+    snprintf(line, sizeof(line),
+             "{\n  \"suite\": \"kernel_bench\",\n  \"platform\": \"%s\",\n"
+             "  \"commit\": \"%s\",\n  \"counter_hz\": %llu,\n  \"cpu_hz\": %llu,\n"
+             "  \"config\": {\"tick_rate_hz\": %lu, \"preemption\": %d, \"time_slicing\": %d, "
+             "\"edf\": %d, \"time_partitioning\": %d, \"critical_profiler\": %d, "
+             "\"stack_overflow_check\": %d, \"heap\": \"%s\", \"heap_instrumentation\": %d, "
+             "\"trace_facility\": %d, \"run_time_stats\": %d},\n"
+             "  \"sizes\": {\"tcb_bytes\": %u, \"coro_bytes\": %s},\n  \"results\": [",
+             bench_platform_name, BENCH_GIT_COMMIT,
+             (unsigned long long) bench_counter_hz(), (unsigned long long) bench_cpu_hz(),
+             (unsigned long) configTICK_RATE_HZ, configUSE_PREEMPTION, configUSE_TIME_SLICING,
+             configUSE_EDF_SCHEDULING, configUSE_TIME_PARTITIONING, configUSE_CRITICAL_PROFILER,
+             configCHECK_FOR_STACK_OVERFLOW, BENCH_HEAP_NAME, configUSE_HEAP_INSTRUMENTATION,
+             configUSE_TRACE_FACILITY, configGENERATE_RUN_TIME_STATS,
+             (unsigned) sizeof(StaticTask_t), coro_bytes);
+    bench_write(line);
+}
+
+void kernel_bench_task(void *params) {
+    unsigned failures = 0;
+    bool first = true;
+
+    (void) params;
+    bench_runner = xTaskGetCurrentTaskHandle();
+
+    bench_write_header();
+
+    for (size_t i = 0; i < sizeof(bench_cases) / sizeof(bench_cases[0]); i++) {
+        failures += bench_run_case(&bench_cases[i], first) ? 0 : 1;
+        first = false;
+    }
+#if BENCH_CPP_COROUTINES
+    for (size_t i = 0; i < bench_cpp_case_count; i++) {
+        failures += bench_run_case(&bench_cpp_cases[i], first) ? 0 : 1;
+        first = false;
+    }
+#endif
+    for (size_t i = 0; i < bench_platform_case_count; i++) {
+        failures += bench_run_case(&bench_platform_cases[i], first) ? 0 : 1;
+        first = false;
+    }
+
+    bench_write("\n  ]\n}\n");
+    bench_finish(failures);
+
+    vTaskDelete(NULL);
+}
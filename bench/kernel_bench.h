@@ -0,0 +1,128 @@
+/**
+ * @file kernel_bench.h
+ * @brief Suíte de microbenchmarks das primitivas do kernel.
+ *
+ * A suíte (kernel_bench.c) usa apenas a API do FreeRTOS e roda igual no
+ * RP2040 (rp2040/bench_rp2040.c) e no host Linux com o port POSIX
+ * (posix/bench_posix.c). Cada plataforma fornece o contador de tempo, a
+ * frequência da CPU, a saída de texto e um meio de executar uma função em
+ * contexto de interrupção.
+ *
+ * Cada caso executa uma operação um número fixo de vezes entre duas leituras
+ * do contador, e repete isso BENCH_RUNS vezes. O tempo por operação é a média
+ * de cada repetição, o que dá resolução abaixo de um ciclo mesmo com o
+ * contador de 1 us do RP2040. O resultado é um documento JSON, com o mínimo,
+ * a mediana e o máximo das repetições em nanossegundos, a mediana em ciclos e
+ * em operações por segundo, para ser guardado e comparado commit a commit.
+ * Alguns casos acrescentam uma métrica própria, como a fragmentação do heap
+ * no padrão aleatório de alocações.
+ */
+
+#ifndef KERNEL_BENCH_H
+#define KERNEL_BENCH_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Repetições de cada caso; a mediana descarta interrupções ocasionais
+#define BENCH_RUNS 7
+
+// Operações por repetição nos casos que não dependem do tick
+#define BENCH_ITERATIONS 1000
+
+// Prioridade da tarefa que executa a suíte. As tarefas auxiliares usam a
+// mesma prioridade ou as imediatamente acima, todas abaixo da tarefa de
+// serviço dos temporizadores.
+#define BENCH_TASK_PRIORITY (tskIDLE_PRIORITY + 2)
+
+// Em palavras de pilha; expandida onde FreeRTOS.h já foi incluído
+#define BENCH_TASK_STACK_WORDS (configMINIMAL_STACK_SIZE * 4)
+
+// Valor devolvido por um caso que não pôde ser executado
+#define BENCH_FAILED UINT64_MAX
+
+/**
+ * @brief Um caso da suíte.
+ *
+ * run() executa a operação iterations vezes e devolve o tempo gasto, em
+ * unidades de bench_counter(). ops_per_iteration converte iterações em
+ * operações quando uma iteração mede mais de uma (por exemplo, duas trocas de
+ * contexto por volta de ping-pong).
+ */
+typedef struct {
+    const char *name;
+    uint64_t (*run)(uint32_t iterations, uint32_t param);
+    uint32_t iterations;
+    uint32_t param;
+    uint32_t ops_per_iteration;
+} bench_case_t;
+
+// --- Fornecido por cada plataforma ---
+
+// Nome da plataforma no JSON
+extern const char *const bench_platform_name;
+
+// Casos que só existem na plataforma (pode ser vazio)
+extern const bench_case_t bench_platform_cases[];
+extern const size_t bench_platform_case_count;
+
+/**
+ * @brief Contador monotônico de 64 bits.
+ */
+uint64_t bench_counter(void);
+
+/**
+ * @brief Frequência de bench_counter(), em Hz.
+ */
+uint64_t bench_counter_hz(void);
+
+/**
+ * @brief Frequência da CPU, em Hz, para converter tempo em ciclos.
+ *
+ * @return 0 se a plataforma não sabe; os ciclos saem então como null.
+ */
+uint64_t bench_cpu_hz(void);
+
+/**
+ * @brief Executa handler em contexto de interrupção e retorna depois dele.
+ *
+ * A função pode chamar as APIs FromISR e portYIELD_FROM_ISR(); a troca de
+ * contexto pedida acontece ao sair da interrupção.
+ */
+void bench_run_in_isr(void (*handler)(void));
+
+/**
+ * @brief Escreve uma parte do documento JSON.
+ */
+void bench_write(const char *text);
+
+/**
+ * @brief Chamada ao fim da suíte com o número de casos que falharam.
+ */
+void bench_finish(unsigned failures);
+
+// --- Fornecido por kernel_bench.c ---
+
+/**
+ * @brief Tarefa que executa a suíte inteira e chama bench_finish().
+ *
+ * Deve ser criada com prioridade BENCH_TASK_PRIORITY e pilha de
+ * BENCH_TASK_STACK_WORDS palavras.
+ */
+void kernel_bench_task(void *params);
+
+// --- Fornecido por coro_cpp_bench.cpp, com BENCH_CPP_COROUTINES em 1 ---
+
+// Casos das co-rotinas C++20 (src/rtos_coro.hpp)
+extern const bench_case_t bench_cpp_cases[];
+extern const size_t bench_cpp_case_count;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // KERNEL_BENCH_H
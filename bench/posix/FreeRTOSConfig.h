@@ -0,0 +1,122 @@
+/*
+ * Configuração do FreeRTOS para a suíte de microbenchmarks no host, com o
+ * port POSIX (GCC_POSIX). Segue o FreeRTOSConfig.h do firmware nas opções que
+ * mudam o custo das primitivas (extensões, preempção, fatia de tempo) e
+ * desliga o que depende do RP2040 ou de uma pilha real: a partição de tempo,
+ * o perfilador de seções críticas e a zona de guarda das pilhas, que no port
+ * POSIX são pilhas de pthreads. Como em bench/rp2040, a instrumentação do
+ * heap também fica desligada, para não entrar no custo de cada alocação, e a
+ * verificação de estouro de pilha só é ligada com BENCH_STACK_OVERFLOW_CHECK,
+ * opção do CMakeLists.txt.
+ */
+
+#ifndef FREERTOS_CONFIG_H
+#define FREERTOS_CONFIG_H
+
+/* Scheduler Related */
+#define configUSE_PREEMPTION                    1
+#define configUSE_TICKLESS_IDLE                 0
+#define configUSE_IDLE_HOOK                     0
+#define configUSE_TICK_HOOK                     0
+#define configTICK_RATE_HZ                      ( ( TickType_t ) 1000 )
+#define configMAX_PRIORITIES                    32
+#define configMINIMAL_STACK_SIZE                ( ( unsigned short ) 4096 )
+#define configUSE_16_BIT_TICKS                  0
+#define configIDLE_SHOULD_YIELD                 1
+#define configUSE_EDF_SCHEDULING                1
+#define configUSE_TIME_PARTITIONING             0
+
+/* Synchronization Related */
+#define configUSE_MUTEXES                       1
+#define configUSE_RECURSIVE_MUTEXES             1
+#define configUSE_TRANSITIVE_INHERITANCE        1
+#define configMAX_INHERITANCE_DEPTH             4
+#define configUSE_CEILING_MUTEXES               1
+#define configUSE_APPLICATION_TASK_TAG          0
+#define configUSE_COUNTING_SEMAPHORES           1
+#define configQUEUE_REGISTRY_SIZE               8
+#define configUSE_QUEUE_SETS                    1
+#define configUSE_QUEUE_ZERO_COPY               1
+#define configUSE_QUEUE_BATCH_TRANSFER          1
+#define configUSE_SPSC_RINGS                    1
+#define configUSE_FAST_MUTEXES                  1
+#define configUSE_RW_LOCKS                      1
+#define configUSE_STREAM_BUFFER_ZERO_COPY       1
+#define configUSE_STREAM_BUFFER_EXTERNAL_INDEX  1
+#define configUSE_STREAM_BUFFER_VECTORED_IO     1
+#define configUSE_SB_COMPLETED_CALLBACK         1
+#define configUSE_INDEXED_EVENT_GROUPS          1
+#define configUSE_DIRECT_EVENT_GROUPS           1
+#define configDIRECT_EVENT_GROUP_MAX_WAITERS    8
+#define configUSE_TIME_SLICING                  1
+#define configUSE_NEWLIB_REENTRANT              0
+#define configENABLE_BACKWARD_COMPATIBILITY     1
+#define configNUM_THREAD_LOCAL_STORAGE_POINTERS 5
+#define configTASK_NOTIFICATION_ARRAY_ENTRIES   2
+
+/* System */
+#define configSTACK_DEPTH_TYPE                  uint32_t
+#define configMESSAGE_BUFFER_LENGTH_TYPE        size_t
+
+/* Memory allocation related definitions. */
+#define configSUPPORT_STATIC_ALLOCATION         0
+#define configSUPPORT_DYNAMIC_ALLOCATION        1
+#define configTOTAL_HEAP_SIZE                   ( 4 * 1024 * 1024 )
+#define configAPPLICATION_ALLOCATED_HEAP        0
+#define configUSE_BLOCK_POOLS                   1
+#define configUSE_KERNEL_OBJECT_POOLS           0
+#define configUSE_HEAP_INSTRUMENTATION          0
+#define configHEAP_INSTRUMENTATION_TAGS         16
+#define configHEAP_INSTRUMENTATION_BLOCKS       64
+
+/* Hook function related definitions. */
+#ifndef BENCH_STACK_OVERFLOW_CHECK
+#define BENCH_STACK_OVERFLOW_CHECK              0
+#endif
+#define configCHECK_FOR_STACK_OVERFLOW          BENCH_STACK_OVERFLOW_CHECK
+#define configUSE_MALLOC_FAILED_HOOK            0
+#define configUSE_DAEMON_TASK_STARTUP_HOOK      0
+
+/* Run time and task stats gathering related definitions. */
+#define configGENERATE_RUN_TIME_STATS           0
+#define configUSE_TRACE_FACILITY                1
+#define configUSE_STATS_FORMATTING_FUNCTIONS    0
+
+/* Critical section profiling is RP2040 only (see the firmware config). */
+#define configUSE_CRITICAL_PROFILER             0
+
+/* Co-routine related definitions. */
+#define configUSE_CO_ROUTINES                   0
+#define configMAX_CO_ROUTINE_PRIORITIES         1
+#define configUSE_CORO_SCHEDULER                1
+
+/* Software timer related definitions. */
+#define configUSE_TIMERS                        1
+#define configTIMER_TASK_PRIORITY               ( configMAX_PRIORITIES - 1 )
+#define configTIMER_QUEUE_LENGTH                10
+#define configTIMER_TASK_STACK_DEPTH            configMINIMAL_STACK_SIZE
+
+#include <assert.h>
+/* Define to trap errors during development. */
+#define configASSERT(x)                         assert(x)
+
+/* Set the following definitions to 1 to include the API function, or zero
+to exclude the API function. */
+#define INCLUDE_vTaskPrioritySet                1
+#define INCLUDE_uxTaskPriorityGet               1
+#define INCLUDE_vTaskDelete                     1
+#define INCLUDE_vTaskSuspend                    1
+#define INCLUDE_vTaskDelayUntil                 1
+#define INCLUDE_vTaskDelay                      1
+#define INCLUDE_xTaskGetSchedulerState          1
+#define INCLUDE_xTaskGetCurrentTaskHandle       1
+#define INCLUDE_uxTaskGetStackHighWaterMark     1
+#define INCLUDE_xTaskGetIdleTaskHandle          1
+#define INCLUDE_eTaskGetState                   1
+#define INCLUDE_xTimerPendFunctionCall          1
+#define INCLUDE_xTaskAbortDelay                 1
+#define INCLUDE_xTaskGetHandle                  1
+#define INCLUDE_xTaskResumeFromISR              1
+#define INCLUDE_xQueueGetMutexHolder            1
+
+#endif /* FREERTOS_CONFIG_H */
@@ -0,0 +1,125 @@
+/**
+ * @file bench_posix.c
+ * @brief Plataforma host (Linux, port POSIX) da suíte de microbenchmarks.
+ *
+ * O contador é CLOCK_MONOTONIC, em nanossegundos. Os ciclos só são
+ * calculados em x86-64, com a frequência do TSC medida na partida; nas
+ * demais arquiteturas saem como null.
+ *
+ * O port POSIX não tem interrupções: cada tarefa é uma pthread e o tick é um
+ * sinal. bench_run_in_isr() chama a função direto da tarefa, e o
+ * portYIELD_FROM_ISR() dela vira um yield comum. Os casos FromISR medem então
+ * o caminho da API, sem a entrada e a saída de uma interrupção de verdade; só
+ * a comparação entre eles faz sentido, e não com os números do RP2040.
+ *
+ * Os números do host servem para acompanhar regressões commit a commit, já
+ * que o port POSIX troca de contexto por sinais e variáveis de condição e o
+ * escalonador do Linux interfere nas medidas.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#if defined(__x86_64__)
+#include <x86intrin.h>
+#endif
+#include "FreeRTOS.h"
+#include "task.h"
+#include "kernel_bench.h"
+
+const char *const bench_platform_name = "posix";
+
+// Sem casos próprios; o elemento existe só porque C não aceita vetor vazio
+const bench_case_t bench_platform_cases[1] = { { NULL, NULL, 0, 0, 0 } };
+const size_t bench_platform_case_count = 0;
+
+#if BENCH_HEAP_REGIONS
+static uint8_t bench_heap[configTOTAL_HEAP_SIZE];
+#endif
+
+static uint64_t bench_tsc_hz;
+
+uint64_t bench_counter(void) {
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (uint64_t) now.tv_sec * 1000000000u + (uint64_t) now.tv_nsec;
+}
+
+uint64_t bench_counter_hz(void) {
+    return 1000000000u;
+}
+
+uint64_t bench_cpu_hz(void) {
+    return bench_tsc_hz;
+}
+
+/**
+ * @brief Mede a frequência do TSC contra CLOCK_MONOTONIC durante 100 ms.
+ *
+ * Em processadores com TSC invariante, que é o caso comum, ela é a frequência
+ * nominal, e não a do turbo; os ciclos são uma conversão do tempo, como no
+ * RP2040.
+ */
+static void bench_calibrate_tsc(void) {
+#if defined(__x86_64__)
+    const struct timespec interval = { 0, 100000000 };
+    uint64_t start = bench_counter();
+    uint64_t tsc_start = __rdtsc();
+
+    nanosleep(&interval, NULL);
+
+    uint64_t elapsed = bench_counter() - start;
+    uint64_t tsc_elapsed = __rdtsc() - tsc_start;
+
+    bench_tsc_hz = (uint64_t) ((double) tsc_elapsed * 1e9 / (double) elapsed);
+#endif
+}
+
+void bench_run_in_isr(void (*handler)(void)) {
+    handler();
+}
+
+void bench_write(const char *text) {
+    fputs(text, stdout);
+}
+
+void bench_finish(unsigned failures) {
+    fprintf(stderr, "kernel_bench: %u caso(s) com falha\n", failures);
+    fflush(stdout);
+    exit(failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+
+/**
+ * @brief Chamada pelo FreeRTOS quando a verificação de pilha, ligada com
+ * BENCH_STACK_OVERFLOW_CHECK, encontra um estouro.
+ */
+void vApplicationStackOverflowHook(TaskHandle_t task, char *task_name) {
+    (void) task;
+
+    // O documento JSON fica incompleto; o motivo vai para stderr
+    fprintf(stderr, "kernel_bench: estouro de pilha em %s\n", task_name);
+    abort();
+}
+
+int main(void) {
+    bench_calibrate_tsc();
+
+#if BENCH_HEAP_REGIONS
+    const HeapRegion_t regions[] = {
+        { bench_heap, sizeof(bench_heap) },
+        { NULL, 0 }
+    };
+    vPortDefineHeapRegions(regions);
+#endif
+
+    xTaskCreate(kernel_bench_task, "kernel_bench", BENCH_TASK_STACK_WORDS, NULL,
+                BENCH_TASK_PRIORITY, NULL);
+
+    vTaskStartScheduler();
+
+    return EXIT_FAILURE;
+}
@@ -0,0 +1,31 @@
+/*
+ * Configuração do FreeRTOS para a suíte de microbenchmarks no RP2040. Parte
+ * do FreeRTOSConfig.h do firmware, para medir o mesmo kernel, e desliga o que
+ * só serve ao diagnóstico e soma custo às primitivas medidas: o perfilador de
+ * seções críticas, que cronometra cada seção crítica, a instrumentação do
+ * heap, que registra cada pvPortMalloc() e vPortFree(), e a verificação de
+ * estouro de pilha, feita a cada troca de contexto. O JSON lista as três.
+ *
+ * A verificação pode ser ligada com BENCH_STACK_OVERFLOW_CHECK, opção do
+ * CMakeLists.txt, para comparar o custo dos métodos na troca de contexto.
+ */
+
+#ifndef BENCH_FREERTOS_CONFIG_H
+#define BENCH_FREERTOS_CONFIG_H
+
+#include "../../FreeRTOSConfig.h"
+
+#undef configUSE_CRITICAL_PROFILER
+#define configUSE_CRITICAL_PROFILER             0
+
+#undef configUSE_HEAP_INSTRUMENTATION
+#define configUSE_HEAP_INSTRUMENTATION          0
+
+#ifndef BENCH_STACK_OVERFLOW_CHECK
+#define BENCH_STACK_OVERFLOW_CHECK              0
+#endif
+
+#undef configCHECK_FOR_STACK_OVERFLOW
+#define configCHECK_FOR_STACK_OVERFLOW          BENCH_STACK_OVERFLOW_CHECK
+
+#endif /* BENCH_FREERTOS_CONFIG_H */
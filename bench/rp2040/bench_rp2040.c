@@ -0,0 +1,191 @@
+/**
+ * @file bench_rp2040.c
+ * @brief Plataforma RP2040 da suíte de microbenchmarks.
+ *
+ * O contador é o temporizador de 64 bits de 1 MHz do RP2040 (time_us_64()).
+ * O Cortex-M0+ não tem contador de ciclos, então os ciclos são o tempo
+ * multiplicado por clk_sys; como cada caso mede centenas de operações entre
+ * duas leituras, a resolução por operação fica abaixo de um ciclo.
+ *
+ * As funções "em interrupção" rodam numa IRQ de usuário livre do RP2040,
+ * disparada por software, e as APIs FromISR são medidas no contexto real de
+ * uma interrupção.
+ *
+ * O executável é um projeto à parte (CMakeLists.txt deste diretório), com o
+ * FreeRTOSConfig.h do firmware menos o perfilador de seções críticas, a
+ * instrumentação do heap e a verificação de pilha (o JSON lista as opções).
+ * Os casos próprios desta plataforma calibram DELAY_US_WAKE_LATENCY_US de
+ * delay_us.h.
+ *
+ * O JSON sai pela USB depois que um terminal abre a porta serial.
+ */
+
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "pico/stdio_usb.h"
+#include "hardware/clocks.h"
+#include "hardware/irq.h"
+#include "hardware/sync.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "kernel_bench.h"
+#include "delay_us.h"
+
+const char *const bench_platform_name = "rp2040";
+
+// IRQ de usuário usada por bench_run_in_isr() e a função que ela executa
+static int bench_irq = -1;
+static void (*volatile bench_irq_function)(void);
+
+#if BENCH_HEAP_REGIONS
+// heap_banked.c e heap_5.c precisam que as regiões sejam definidas antes da
+// primeira alocação; aqui há uma só, na SRAM principal
+static uint8_t bench_heap[configTOTAL_HEAP_SIZE];
+#endif
+
+uint64_t bench_counter(void) {
+    return time_us_64();
+}
+
+uint64_t bench_counter_hz(void) {
+    return 1000000u;
+}
+
+uint64_t bench_cpu_hz(void) {
+    return clock_get_hz(clk_sys);
+}
+
+static void bench_irq_handler(void) {
+    void (*function)(void) = bench_irq_function;
+
+    bench_irq_function = NULL;
+    function();
+}
+
+void bench_run_in_isr(void (*handler)(void)) {
+    bench_irq_function = handler;
+    irq_set_pending((uint) bench_irq);
+
+    // A interrupção é tomada logo após a escrita no NVIC; a espera só cobre
+    // as poucas instruções até isso acontecer
+    while (bench_irq_function != NULL) {
+        tight_loop_contents();
+    }
+}
+
+void bench_write(const char *text) {
+    fputs(text, stdout);
+}
+
+void bench_finish(unsigned failures) {
+    printf("# kernel_bench: %u caso(s) com falha\n", failures);
+    fflush(stdout);
+}
+
+// ---------------------------------------------------------------------------
+// Casos desta plataforma
+// ---------------------------------------------------------------------------
+
+static TaskHandle_t bench_alarm_task;
+
+static int64_t bench_alarm_callback(alarm_id_t id, void *user_data) {
+    BaseType_t woken = pdFALSE;
+
+    (void) id;
+    (void) user_data;
+
+    vTaskNotifyGiveFromISR(bench_alarm_task, &woken);
+    portYIELD_FROM_ISR(woken);
+
+    return 0;
+}
+
+/**
+ * @brief Do instante programado de um alarme do SDK até a tarefa notificada
+ * por ele voltar a executar: o valor de DELAY_US_WAKE_LATENCY_US.
+ */
+static uint64_t bench_alarm_wake_latency(uint32_t iterations, uint32_t param) {
+    uint64_t total = 0;
+
+    bench_alarm_task = xTaskGetCurrentTaskHandle();
+
+    for (uint32_t i = 0; i < iterations; i++) {
+        absolute_time_t target = make_timeout_time_us(param);
+
+        if (add_alarm_at(target, bench_alarm_callback, NULL, false) < 0) {
+            return BENCH_FAILED;
+        }
+        (void) ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        total += time_us_64() - to_us_since_boot(target);
+    }
+
+    return total;
+}
+
+/**
+ * @brief Quanto task_delay_us(param) passa do tempo pedido.
+ */
+static uint64_t bench_delay_us_overshoot(uint32_t iterations, uint32_t param) {
+    uint64_t total = 0;
+
+    for (uint32_t i = 0; i < iterations; i++) {
+        uint64_t start = time_us_64();
+        task_delay_us(param);
+        total += time_us_64() - start - param;
+    }
+
+    return total;
+}
+
+const bench_case_t bench_platform_cases[] = {
+    { "alarm_wake_latency", bench_alarm_wake_latency, 100, 200, 1 },
+    { "delay_us_200_overshoot", bench_delay_us_overshoot, 100, 200, 1 },
+};
+
+const size_t bench_platform_case_count = sizeof(bench_platform_cases) / sizeof(bench_platform_cases[0]);
+
+/**
+ * @brief Chamada pelo FreeRTOS quando uma tarefa usa a zona de guarda da pilha.
+ */
+void vApplicationStackOverflowHook(TaskHandle_t task, char *task_name) {
+    (void) task;
+    (void) task_name;
+
+    // A saída USB depende de interrupções, então não há como relatar daqui;
+    // o documento JSON fica incompleto
+    taskDISABLE_INTERRUPTS();
+
+    while (1) {
+        // Parado para inspeção com o depurador.
+    }
+}
+
+int main() {
+    stdio_init_all();
+
+#if BENCH_HEAP_REGIONS
+    const HeapRegion_t regions[] = {
+        { bench_heap, sizeof(bench_heap) },
+        { NULL, 0 }
+    };
+    vPortDefineHeapRegions(regions);
+#endif
+
+    bench_irq = user_irq_claim_unused(true);
+    irq_set_exclusive_handler((uint) bench_irq, bench_irq_handler);
+    irq_set_enabled((uint) bench_irq, true);
+
+    // Espera um terminal na USB, para que o documento saia inteiro
+    while (!stdio_usb_connected()) {
+        sleep_ms(100);
+    }
+
+    xTaskCreate(kernel_bench_task, "kernel_bench", BENCH_TASK_STACK_WORDS, NULL,
+                BENCH_TASK_PRIORITY, NULL);
+
+    vTaskStartScheduler();
+
+    while (1) {
+        // Só alcançado se o escalonador não puder iniciar.
+    };
+}
@@ -0,0 +1,275 @@
+/**
+ * @file adc_dma.c
+ * @brief Implementação da aquisição contínua do ADC via DMA.
+ *
+ * O ADC opera em modo contínuo (500 mil amostras por segundo, 8 bits por
+ * amostra) e um canal de DMA copia cada amostra do FIFO do ADC para um anel
+ * alinhado, que é também a área de armazenamento de um stream buffer criado
+ * com xStreamBufferCreateExternallyIndexed(). A cada ADC_DMA_CHUNK_SIZE
+ * amostras a interrupção do DMA informa a nova posição de escrita com
+ * xStreamBufferSetHeadFromISR(), o que desbloqueia a tarefa consumidora.
+ * A tarefa lê as amostras no próprio anel com xStreamBufferPeek() e
+ * vStreamBufferConsume(), sem cópias.
+ *
+ * O DMA não pode ser contido pelo stream buffer: se a tarefa ficasse um anel
+ * inteiro para trás, ele sobrescreveria amostras ainda não lidas. Por isso a
+ * interrupção só rearma o canal quando o próximo bloco cabe no espaço livre;
+ * caso contrário conta um estouro e deixa o canal parado até a tarefa
+ * consumir o que falta, e as amostras perdidas são as que o ADC produz nesse
+ * intervalo, não as que já estavam no anel.
+ *
+ * A cada ADC_DMA_REPORT_PERIOD_MS a tarefa envia pela UART (uart_dma.h) a
+ * vazão obtida, o tempo de CPU gasto na interrupção e no processamento e o
+ * número de acessos à SRAM principal que esperaram pelo barramento porque
+ * outro mestre (a CPU ou o DMA) usava o mesmo banco, lido dos contadores de
+ * desempenho do barramento.
+ */
+
+#include "adc_dma.h"
+#include "uart_dma.h"
+#include "delay_us.h"
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "hardware/adc.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "hardware/structs/busctrl.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "stream_buffer.h"
+
+// Anel do DMA: o modo anel exige alinhamento igual ao tamanho
+static uint8_t adc_ring[ADC_DMA_RING_SIZE] __attribute__((aligned(ADC_DMA_RING_SIZE)));
+
+// Stream buffer cuja posição de escrita é avançada pelo DMA
+static StreamBufferHandle_t adc_buffer = NULL;
+
+// Canal de DMA usado na aquisição
+static int adc_channel = -1;
+
+// Estatísticas da interrupção, zeradas a cada relatório
+static volatile uint32_t adc_irq_count = 0;
+static volatile uint32_t adc_irq_us = 0;
+static volatile uint32_t adc_overruns = 0;
+
+// Canal parado pela interrupção por falta de espaço no anel
+static volatile bool adc_stalled = false;
+
+// Eventos dos quatro contadores de desempenho do barramento: acessos
+// contestados a cada banco da SRAM principal, onde fica o anel do DMA
+static const bus_ctrl_perf_event_t adc_bus_events[4] = {
+    arbiter_sram0_perf_event_access_contested,
+    arbiter_sram1_perf_event_access_contested,
+    arbiter_sram2_perf_event_access_contested,
+    arbiter_sram3_perf_event_access_contested,
+};
+
+/**
+ * @brief Seleciona os eventos dos contadores de desempenho e os zera.
+ */
+static void adc_bus_counters_init(void) {
+    for (int i = 0; i < 4; i++) {
+        busctrl_hw->counter[i].sel = adc_bus_events[i];
+        busctrl_hw->counter[i].value = 0;
+    }
+}
+
+/**
+ * @brief Lê e zera os contadores de desempenho.
+ * @return Acessos contestados à SRAM principal desde a última leitura.
+ */
+static uint32_t adc_bus_counters_take(void) {
+    uint32_t total = 0;
+
+    for (int i = 0; i < 4; i++) {
+        total += busctrl_hw->counter[i].value;
+        // Qualquer escrita zera o contador
+        busctrl_hw->counter[i].value = 0;
+    }
+
+    return total;
+}
+
+/**
+ * @brief Interrupção de fim de bloco do DMA do ADC.
+ *
+ * Rearma o canal para o próximo bloco, se ele couber no espaço livre, e
+ * informa ao stream buffer até onde o DMA escreveu. O FIFO do ADC absorve as
+ * amostras que chegam enquanto o canal é rearmado.
+ */
+static void adc_dma_irq_handler(void) {
+    BaseType_t higher_priority_task_woken = pdFALSE;
+    uint32_t start;
+    size_t head;
+
+    // A linha DMA_IRQ_0 é compartilhada com outros módulos
+    if (!dma_channel_get_irq0_status(adc_channel)) {
+        return;
+    }
+
+    start = time_us_32();
+    dma_channel_acknowledge_irq0(adc_channel);
+
+    // O espaço livre ainda não desconta o bloco que acabou de chegar: o
+    // próximo só cabe se sobrarem dois blocos. O endereço de escrita do DMA
+    // já está dentro do anel, e não muda se o canal ficar parado
+    if (xStreamBufferSpacesAvailable(adc_buffer) >= 2 * ADC_DMA_CHUNK_SIZE) {
+        dma_channel_set_trans_count(adc_channel, ADC_DMA_CHUNK_SIZE, true);
+    } else {
+        adc_stalled = true;
+        adc_overruns++;
+    }
+    head = (size_t) (dma_channel_hw_addr(adc_channel)->write_addr - (uintptr_t) adc_ring) &
+           (ADC_DMA_RING_SIZE - 1);
+
+    xStreamBufferSetHeadFromISR(adc_buffer, head, &higher_priority_task_woken);
+
+    adc_irq_count++;
+    adc_irq_us += time_us_32() - start;
+
+    portYIELD_FROM_ISR(higher_priority_task_woken);
+}
+
+/**
+ * @brief Configura o ADC, o canal de DMA e o stream buffer, e inicia a
+ * aquisição.
+ */
+static void adc_dma_init(void) {
+    adc_gpio_init(ADC_DMA_PIN);
+    adc_init();
+    adc_select_input(ADC_DMA_INPUT);
+
+    // FIFO habilitado, DREQ a cada amostra, 8 bits por amostra
+    adc_fifo_setup(true, true, 1, false, true);
+    // Divisor 0: conversões de 96 ciclos de 48 MHz (500 mil amostras/s)
+    adc_set_clkdiv(0);
+
+    // O tamanho do anel é o tamanho do stream buffer; o gatilho de um bloco
+    // faz a tarefa acordar uma vez por interrupção
+    adc_buffer = xStreamBufferCreateExternallyIndexed(ADC_DMA_RING_SIZE,
+                                                      ADC_DMA_CHUNK_SIZE,
+                                                      adc_ring, NULL, NULL);
+    configASSERT(adc_buffer != NULL);
+
+    // Canal de DMA: FIFO do ADC (fixo) -> anel (incrementando, com volta)
+    adc_channel = dma_claim_unused_channel(true);
+    dma_channel_config config = dma_channel_get_default_config(adc_channel);
+    channel_config_set_transfer_data_size(&config, DMA_SIZE_8);
+    channel_config_set_read_increment(&config, false);
+    channel_config_set_write_increment(&config, true);
+    channel_config_set_ring(&config, true, ADC_DMA_RING_BITS);
+    channel_config_set_dreq(&config, DREQ_ADC);
+    dma_channel_configure(adc_channel, &config, adc_ring, &adc_hw->fifo,
+                          ADC_DMA_CHUNK_SIZE, false);
+
+    dma_channel_set_irq0_enabled(adc_channel, true);
+    irq_add_shared_handler(DMA_IRQ_0, adc_dma_irq_handler,
+                           PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(DMA_IRQ_0, true);
+
+    adc_bus_counters_init();
+
+    // Aguarda a entrada selecionada se acomodar antes da primeira conversão,
+    // sem ocupar o processador e sem esperar um tick inteiro
+    task_delay_us(ADC_DMA_SETTLE_US);
+
+    dma_channel_start(adc_channel);
+    adc_run(true);
+}
+
+/**
+ * @brief Religa o canal parado pela interrupção, quando a tarefa já liberou
+ * espaço para um bloco.
+ */
+static void adc_dma_resume(void) {
+    if (!adc_stalled || xStreamBufferSpacesAvailable(adc_buffer) < ADC_DMA_CHUNK_SIZE) {
+        return;
+    }
+
+    taskENTER_CRITICAL();
+    // As amostras no FIFO são de antes da pausa; descartá-las deixa a falha
+    // inteira num ponto só do sinal
+    adc_fifo_drain();
+    adc_stalled = false;
+    dma_channel_set_trans_count(adc_channel, ADC_DMA_CHUNK_SIZE, true);
+    taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief Tarefa do ADC.
+ *
+ * Consome as amostras diretamente do anel, calcula a média do período e
+ * relata a vazão em bytes por segundo, a ocupação de CPU e a contenção no
+ * barramento da SRAM principal.
+ *
+ * @param pvParameters Parâmetros da tarefa (não utilizado).
+ */
+void adc_dma_task(void *pvParameters) {
+    char report[176];
+    TickType_t last_report;
+    uint32_t bytes = 0;
+    uint32_t sum = 0;
+    uint32_t task_us = 0;
+
+    adc_dma_init();
+    last_report = xTaskGetTickCount();
+
+    while (true) {
+        void *data;
+        size_t len = xStreamBufferPeek(adc_buffer, &data, pdMS_TO_TICKS(ADC_DMA_REPORT_PERIOD_MS));
+
+        if (len > 0) {
+            uint32_t start = time_us_32();
+            const uint8_t *samples = (const uint8_t *) data;
+
+            for (size_t i = 0; i < len; i++) {
+                sum += samples[i];
+            }
+
+            // Devolve a região ao DMA
+            vStreamBufferConsume(adc_buffer, len);
+            adc_dma_resume();
+            bytes += len;
+            task_us += time_us_32() - start;
+        }
+
+        TickType_t now = xTaskGetTickCount();
+        TickType_t elapsed = now - last_report;
+
+        if (elapsed >= pdMS_TO_TICKS(ADC_DMA_REPORT_PERIOD_MS)) {
+            uint32_t elapsed_us = (uint32_t) elapsed * (1000000u / configTICK_RATE_HZ);
+            uint32_t bytes_per_s = (uint32_t) (((uint64_t) bytes * 1000000u) / elapsed_us);
+            // Ocupação de CPU em centésimos de porcento
+            uint32_t cpu = (uint32_t) (((uint64_t) (adc_irq_us + task_us) * 10000u) / elapsed_us);
+            // Acessos contestados por segundo: cai quando as pilhas das
+            // tarefas estão nos bancos scratch (ver main.c)
+            uint32_t contested = (uint32_t) (((uint64_t) adc_bus_counters_take() * 1000000u) / elapsed_us);
+            int n = snprintf(report, sizeof(report),
+                             "ADC: %lu B/s (%lu.%03lu MB/s), %lu irq, %lu estouros, CPU %lu.%02lu%%, "
+                             "media %lu, SRAM contestada %lu/s\r\n",
+                             (unsigned long) bytes_per_s,
+                             (unsigned long) (bytes_per_s / 1000000u),
+                             (unsigned long) ((bytes_per_s / 1000u) % 1000u),
+                             (unsigned long) adc_irq_count,
+                             (unsigned long) adc_overruns,
+                             (unsigned long) (cpu / 100u), (unsigned long) (cpu % 100u),
+                             (unsigned long) (bytes ? sum / bytes : 0),
+                             (unsigned long) contested);
+
+            if (n > 0) {
+                uart_dma_write(report, (size_t) n, 0);
+            }
+
+            taskENTER_CRITICAL();
+            adc_irq_count = 0;
+            adc_irq_us = 0;
+            adc_overruns = 0;
+            taskEXIT_CRITICAL();
+
+            bytes = 0;
+            sum = 0;
+            task_us = 0;
+            last_report = now;
+        }
+    }
+}
\ No newline at end of file
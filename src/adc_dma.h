@@ -0,0 +1,40 @@
+/**
+ * @file adc_dma.h
+ * @brief Definições para a aquisição contínua do ADC via DMA.
+ *
+ * O DMA escreve as amostras do ADC diretamente, em modo anel, na memória de
+ * um stream buffer. O kernel é informado da nova posição de escrita apenas
+ * uma vez por bloco de amostras, a partir da interrupção do DMA.
+ */
+
+#ifndef ADC_DMA_H
+#define ADC_DMA_H
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+// Microfone da BitDogLab V6 (GPIO 28, entrada 2 do ADC)
+#define ADC_DMA_PIN 28
+#define ADC_DMA_INPUT 2
+
+// Tamanho do anel do DMA: potência de dois, até 32 KB (2^ADC_DMA_RING_BITS)
+#define ADC_DMA_RING_BITS 12
+#define ADC_DMA_RING_SIZE (1u << ADC_DMA_RING_BITS)
+
+// Amostras por transferência do DMA (uma interrupção por bloco)
+#define ADC_DMA_CHUNK_SIZE 512
+
+// Tempo de acomodação da entrada do ADC antes de iniciar a aquisição, em
+// microssegundos
+#define ADC_DMA_SETTLE_US 50
+
+// Intervalo entre os relatórios de vazão em milissegundos
+#define ADC_DMA_REPORT_PERIOD_MS 1000
+
+/**
+ * @brief Tarefa que consome as amostras do ADC e relata a vazão obtida.
+ * @param pvParameters Parâmetros da tarefa (não utilizado).
+ */
+void adc_dma_task(void *pvParameters);
+
+#endif // ADC_DMA_H
\ No newline at end of file
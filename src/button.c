@@ -3,7 +3,7 @@
  * @brief Implementação do controle dos botões.
  *
  * Este arquivo contém a implementação da tarefa que lê os botões A e B,
- * aplica um debounce de software e suspende/retoma as tarefas do
+ * aplica um debounce de software e pausa/retoma as co-rotinas do
  * LED e do buzzer.
  */
 
@@ -34,8 +34,9 @@ void button_init(void) {
  * @brief Tarefa de monitoramento dos botões.
  *
  * Verifica o estado dos botões periodicamente (polling). Quando um botão
- * é pressionado, aplica um debounce e então alterna o estado (suspenso/resumido)
- * da tarefa correspondente (LED para botão A, Buzzer para botão B).
+ * é pressionado, aplica um debounce e então notifica a co-rotina
+ * correspondente (LED para botão A, Buzzer para botão B), que alterna entre
+ * pausada e ativa.
  *
  * @param pvParameters Parâmetros da tarefa (não utilizado).
  */
@@ -51,15 +52,10 @@ void button_task(void *pvParameters) {
         if (!gpio_get(BUTTON_A_PIN) && !a_pressed) {
             a_pressed = true; // Marca o botão como pressionado para evitar repetição
 
-            // Verifica o estado atual da tarefa do LED
-            eTaskState led_state = eTaskGetState(led_rgb_task_handle);
+            // Alterna o estado da co-rotina do LED: se pausada, retoma;
+            // senão, pausa.
+            xCoroNotifyGive(&led_rgb_coro);
 
-            // Alterna o estado: se suspensa, resume; senão, suspende.
-            if (led_state == eSuspended) {
-                vTaskResume(led_rgb_task_handle);
-            } else {
-                vTaskSuspend(led_rgb_task_handle);
-            }
             // Debounce: aguarda um tempo para o usuário soltar o botão
             vTaskDelay(pdMS_TO_TICKS(DEBOUNCE_TIME_MS));
         } else if (gpio_get(BUTTON_A_PIN)) {
@@ -70,15 +66,9 @@ void button_task(void *pvParameters) {
         if (!gpio_get(BUTTON_B_PIN) && !b_pressed) {
             b_pressed = true;
 
-            // Verifica o estado atual da tarefa do buzzer
-            eTaskState buzzer_state = eTaskGetState(buzzer_task_handle);
+            // Alterna o estado da co-rotina do buzzer
+            xCoroNotifyGive(&buzzer_coro);
 
-            // Alterna o estado da tarefa do buzzer
-            if (buzzer_state == eSuspended) {
-                vTaskResume(buzzer_task_handle);
-            } else {
-                vTaskSuspend(buzzer_task_handle);
-            }
             // Debounce
             vTaskDelay(pdMS_TO_TICKS(DEBOUNCE_TIME_MS));
         } else if (gpio_get(BUTTON_B_PIN)) {
@@ -3,7 +3,7 @@
  * @brief Implementação do controle do buzzer.
  *
  * Este arquivo contém a implementação das funções para inicialização e controle
- * do buzzer, incluindo a tarefa que gera o sinal PWM para o buzzer.
+ * do buzzer, incluindo a co-rotina que gera o sinal PWM para o buzzer.
  */
 
 #include "buzzer.h"
@@ -12,8 +12,8 @@
 #include "FreeRTOS.h"
 #include "task.h"
 
-// Handle da tarefa, definido no main.c
-TaskHandle_t buzzer_task_handle = NULL;
+// Bloco de controle da co-rotina, adicionada ao grupo dos atuadores no main.c
+Coro_t buzzer_coro;
 
 /**
  * @brief Inicializa o pino do buzzer para operar com PWM.
@@ -32,31 +32,68 @@ void buzzer_init(void) {
 }
 
 /**
- * @brief Tarefa do buzzer.
+ * @brief Co-rotina do buzzer.
  *
  * Inicializa o buzzer e entra em um loop infinito para gerar um beep
- * de 200ms a cada 1 segundo.
+ * de 200ms a cada 1 segundo. Cada notificação da tarefa dos botões alterna
+ * entre pausada e ativa; a pausa começa antes do próximo beep.
  *
- * @param pvParameters Parâmetros da tarefa (não utilizado).
+ * @param coro Bloco de controle da co-rotina.
+ * @param pvParameters Parâmetros da co-rotina (não utilizado).
  */
-void buzzer_task(void *pvParameters) {
+void buzzer_coroutine(Coro_t *coro, void *pvParameters) {
+    // O estado fica em variáveis estáticas, pois as locais não sobrevivem às
+    // esperas da co-rotina
+    static uint slice_num;
+    static uint chan;
+
+    // Início da fase atual, referência para o próximo despertar.
+    static TickType_t last_wake;
+
+    BaseType_t delayed;
+    uint32_t presses;
+
+    coroSTART(coro);
+
     buzzer_init();
     
     // Obtém o "slice" e o "channel" do PWM para o pino do buzzer
-    uint slice_num = pwm_gpio_to_slice_num(BUZZER_PIN);
-    uint chan = pwm_gpio_to_channel(BUZZER_PIN);
+    slice_num = pwm_gpio_to_slice_num(BUZZER_PIN);
+    chan = pwm_gpio_to_channel(BUZZER_PIN);
 
     // Configura o PWM para uma frequência de ~2kHz
     pwm_set_wrap(slice_num, 4095);
     pwm_set_clkdiv(slice_num, 25);
 
+    last_wake = xTaskGetTickCount();
+
     while (true) {
+        // Um número ímpar de toques no botão B desde o último beep pausa o
+        // buzzer, já desligado, até o próximo número ímpar de toques.
+        coroNOTIFY_TAKE(coro, pdTRUE, 0, &presses);
+        if (presses % 2 != 0) {
+            do {
+                coroNOTIFY_TAKE(coro, pdTRUE, portMAX_DELAY, &presses);
+            } while (presses % 2 == 0);
+
+            last_wake = xTaskGetTickCount();
+        }
+
         // Ativa o buzzer com 50% de duty cycle para gerar o som
         pwm_set_chan_level(slice_num, chan, 2048);
-        vTaskDelay(pdMS_TO_TICKS(200));
+        coroDELAY_UNTIL(coro, &last_wake, pdMS_TO_TICKS(200), &delayed);
+        if (delayed == pdFALSE) {
+            // Fase perdida: recomeça a contagem.
+            last_wake = xTaskGetTickCount();
+        }
 
         // Desativa o buzzer
         pwm_set_chan_level(slice_num, chan, 0);
-        vTaskDelay(pdMS_TO_TICKS(800));
+        coroDELAY_UNTIL(coro, &last_wake, pdMS_TO_TICKS(800), &delayed);
+        if (delayed == pdFALSE) {
+            last_wake = xTaskGetTickCount();
+        }
     }
+
+    coroEND(coro);
 }
\ No newline at end of file
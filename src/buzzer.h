@@ -3,28 +3,29 @@
  * @brief Definições para o controle do buzzer.
  *
  * Este arquivo contém as definições para inicialização e controle do buzzer,
- * incluindo a tarefa que gera o som.
+ * incluindo a co-rotina que gera o som.
  */
 
 #ifndef BUZZER_H
 #define BUZZER_H
 
 #include "FreeRTOS.h"
-#include "task.h"
+#include "coro.h"
 
 // Pino do Buzzer conforme o esquemático da BitDogLab V6
 #define BUZZER_PIN 21
 
 /**
- * @brief Handle para a tarefa do buzzer.
- * Usado para controlar a tarefa (suspender/retomar) a partir de outras tarefas.
+ * @brief Bloco de controle da co-rotina do buzzer.
+ * Cada xCoroNotifyGive() com ele alterna a co-rotina entre pausada e ativa.
  */
-extern TaskHandle_t buzzer_task_handle;
+extern Coro_t buzzer_coro;
 
 /**
- * @brief Tarefa que controla o buzzer.
- * @param pvParameters Parâmetros da tarefa (não utilizado).
+ * @brief Co-rotina que controla o buzzer.
+ * @param coro Bloco de controle da co-rotina.
+ * @param pvParameters Parâmetros da co-rotina (não utilizado).
  */
-void buzzer_task(void *pvParameters);
+void buzzer_coroutine(Coro_t *coro, void *pvParameters);
 
 #endif // BUZZER_H
\ No newline at end of file
@@ -0,0 +1,95 @@
+/**
+ * @file delay_us.c
+ * @brief Implementação dos atrasos de tarefa com resolução de microssegundos.
+ *
+ * Cada atraso registra um alarme no pool de alarmes padrão do SDK, que usa um
+ * dos alarmes do temporizador de 1 MHz do RP2040 e aceita vários alarmes
+ * pendentes ao mesmo tempo. A interrupção do alarme notifica a tarefa com
+ * vTaskNotifyGiveIndexedFromISR(), e a tarefa espera em
+ * ulTaskNotifyTakeIndexed(), liberando o processador durante o atraso.
+ */
+
+#include "delay_us.h"
+#include "pico/stdlib.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if configTASK_NOTIFICATION_ARRAY_ENTRIES <= DELAY_US_NOTIFY_INDEX
+#error "configTASK_NOTIFICATION_ARRAY_ENTRIES deve ser maior que DELAY_US_NOTIFY_INDEX"
+#endif
+
+/**
+ * @brief Callback do alarme, executada na interrupção do temporizador.
+ *
+ * @param id Identificador do alarme (não utilizado).
+ * @param user_data Handle da tarefa a acordar.
+ * @return int64_t 0, para o alarme não ser repetido.
+ */
+static int64_t delay_us_alarm_callback(alarm_id_t id, void *user_data) {
+    BaseType_t higher_priority_task_woken = pdFALSE;
+
+    (void) id;
+    vTaskNotifyGiveIndexedFromISR((TaskHandle_t) user_data, DELAY_US_NOTIFY_INDEX,
+                                  &higher_priority_task_woken);
+
+    portYIELD_FROM_ISR(higher_priority_task_woken);
+
+    return 0;
+}
+
+/**
+ * @brief Espera até o instante indicado.
+ *
+ * @param target Instante em que a tarefa deve voltar a executar.
+ */
+static void delay_us_wait_until(absolute_time_t target) {
+    int64_t remaining_us = absolute_time_diff_us(get_absolute_time(), target);
+
+    if ((remaining_us > DELAY_US_WAKE_LATENCY_US) &&
+        (xTaskGetSchedulerState() == taskSCHEDULER_RUNNING)) {
+        absolute_time_t alarm_time =
+            from_us_since_boot(to_us_since_boot(target) - DELAY_US_WAKE_LATENCY_US);
+
+        // Descarta uma notificação deixada por um alarme de um atraso anterior
+        // que expirou pelo tempo limite abaixo.
+        (void) xTaskNotifyStateClearIndexed(NULL, DELAY_US_NOTIFY_INDEX);
+        (void) ulTaskNotifyValueClearIndexed(NULL, DELAY_US_NOTIFY_INDEX, UINT32_MAX);
+
+        alarm_id_t alarm = add_alarm_at(alarm_time, delay_us_alarm_callback,
+                                        xTaskGetCurrentTaskHandle(), false);
+
+        // alarm == 0: o instante já passou; alarm < 0: pool sem espaço. Nos
+        // dois casos o atraso é completado em espera ativa.
+        if (alarm > 0) {
+            // Tempo limite de segurança, dois ticks além do atraso, caso o
+            // alarme se perca; nunca é atingido em operação normal.
+            TickType_t timeout = pdMS_TO_TICKS((TickType_t) (remaining_us / 1000)) + 2;
+
+            if (ulTaskNotifyTakeIndexed(DELAY_US_NOTIFY_INDEX, pdTRUE, timeout) == 0) {
+                (void) cancel_alarm(alarm);
+            }
+        }
+    }
+
+    // Completa o atraso em espera ativa: no máximo DELAY_US_WAKE_LATENCY_US
+    // quando a tarefa foi bloqueada.
+    busy_wait_until(target);
+}
+
+void task_delay_us(uint32_t us) {
+    delay_us_wait_until(make_timeout_time_us(us));
+}
+
+bool task_delay_until_us(absolute_time_t *previous_wake, uint32_t increment_us) {
+    absolute_time_t target = delayed_by_us(*previous_wake, increment_us);
+
+    *previous_wake = target;
+
+    if (absolute_time_diff_us(get_absolute_time(), target) <= 0) {
+        return false;
+    }
+
+    delay_us_wait_until(target);
+
+    return true;
+}
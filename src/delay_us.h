@@ -0,0 +1,53 @@
+/**
+ * @file delay_us.h
+ * @brief Atrasos de tarefa com resolução de microssegundos.
+ *
+ * O menor atraso de vTaskDelay() é um tick (1 ms). Estas funções armam um
+ * alarme do temporizador de hardware no pool de alarmes do SDK e bloqueiam a
+ * tarefa em uma notificação até o alarme disparar, sem aumentar a frequência
+ * do tick. Os últimos microssegundos, que cobrem a latência de despertar da
+ * tarefa, são completados em espera ativa.
+ */
+
+#ifndef DELAY_US_H
+#define DELAY_US_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "pico/time.h"
+
+// Índice da notificação de tarefa usado pelos atrasos. O índice 0 fica livre
+// para a aplicação e para os stream buffers (configTASK_NOTIFICATION_ARRAY_ENTRIES
+// deve ser pelo menos 2).
+#define DELAY_US_NOTIFY_INDEX 1
+
+// Tempo estimado entre o disparo do alarme e a tarefa voltar a executar
+// (interrupção do alarme, notificação e troca de contexto). O alarme é armado
+// esse tempo antes do prazo e o restante é feito em espera ativa; atrasos
+// menores que este valor são feitos inteiramente em espera ativa.
+#define DELAY_US_WAKE_LATENCY_US 15
+
+/**
+ * @brief Bloqueia a tarefa chamadora por um número de microssegundos.
+ *
+ * Antes de o escalonador iniciar, faz espera ativa.
+ *
+ * @param us Duração do atraso em microssegundos.
+ */
+void task_delay_us(uint32_t us);
+
+/**
+ * @brief Bloqueia a tarefa até um instante fixo, para execução periódica.
+ *
+ * Equivalente a xTaskDelayUntil() em microssegundos: o instante de despertar
+ * é calculado a partir do anterior, e não do momento da chamada, de modo que
+ * o período não acumula desvio.
+ *
+ * @param previous_wake Instante do último despertar; atualizado pela função.
+ *        Deve ser inicializado com get_absolute_time() antes da primeira chamada.
+ * @param increment_us Período em microssegundos.
+ * @return true se a tarefa foi atrasada, false se o instante já havia passado.
+ */
+bool task_delay_until_us(absolute_time_t *previous_wake, uint32_t increment_us);
+
+#endif // DELAY_US_H
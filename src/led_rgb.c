@@ -2,32 +2,47 @@
  * @file led_rgb.c
  * @brief Implementação do controle do LED RGB.
  *
- * Este arquivo contém a implementação da tarefa que alterna as cores do LED RGB.
+ * Este arquivo contém a implementação da co-rotina que alterna as cores do LED RGB.
  */
 
 #include "led_rgb.h"      // Para protótipo da função e definições dos pinos
 #include "pico/stdlib.h"  // Para as funções gpio_...
 #include "FreeRTOS.h"     // Para os tipos do FreeRTOS
-#include "task.h"         // Para vTaskDelay, TaskHandle_t, etc.
+#include "task.h"         // Para xTaskGetTickCount
 
 // Array com os pinos do LED para facilitar o acesso.
 const uint8_t led_pins[] = {LED_R_PIN, LED_G_PIN, LED_B_PIN};
 
-// Handle da tarefa, usado pela tarefa dos botões para suspender/retomar esta.
-// A variável é declarada aqui, mas o main.c irá atribuir o valor a ela.
-TaskHandle_t led_rgb_task_handle = NULL;
+// Bloco de controle da co-rotina, usado pela tarefa dos botões para pausá-la
+// e retomá-la. O main.c a adiciona ao grupo dos atuadores.
+Coro_t led_rgb_coro;
 
 /**
- * @brief Tarefa que controla o LED RGB.
+ * @brief Co-rotina que controla o LED RGB.
  *
  * Inicializa os pinos do LED e entra em um loop infinito para
  * alternar ciclicamente entre as cores vermelho, verde e azul
- * a cada 500ms. Esta tarefa pode ser suspensa e retomada pela tarefa dos botões.
+ * a cada 500ms. Cada notificação da tarefa dos botões alterna entre pausada
+ * e ativa; a pausa começa quando a cor atual se apaga.
  *
- * @param pvParameters Parâmetros da tarefa (não utilizado).
+ * As variáveis locais não sobrevivem às esperas de uma co-rotina, por isso o
+ * estado fica em variáveis estáticas.
+ *
+ * @param coro Bloco de controle da co-rotina.
+ * @param pvParameters Parâmetros da co-rotina (não utilizado).
  */
-void led_rgb_task(void *pvParameters)
+void led_rgb_coroutine(Coro_t *coro, void *pvParameters)
 {
+    static int current_color_index;
+
+    // Início do período atual, referência para o próximo despertar.
+    static TickType_t last_wake;
+
+    BaseType_t delayed;
+    uint32_t presses;
+
+    coroSTART(coro);
+
     // Inicializa os 3 pinos do LED como saídas digitais.
     for (int i = 0; i < 3; i++)
     {
@@ -36,16 +51,37 @@ void led_rgb_task(void *pvParameters)
         gpio_put(led_pins[i], 0); // Garante que todos comecem apagados
     }
 
-    int current_color_index = 0;
+    current_color_index = 0;
+    last_wake = xTaskGetTickCount();
 
-    // Loop infinito da tarefa
+    // Loop infinito da co-rotina
     while (1)
     {
+        // Um número ímpar de toques no botão A desde a última cor pausa o
+        // LED, já apagado, até o próximo número ímpar de toques.
+        coroNOTIFY_TAKE(coro, pdTRUE, 0, &presses);
+        if (presses % 2 != 0)
+        {
+            do
+            {
+                coroNOTIFY_TAKE(coro, pdTRUE, portMAX_DELAY, &presses);
+            } while (presses % 2 == 0);
+
+            // Recomeça a contagem do período a partir de agora.
+            last_wake = xTaskGetTickCount();
+        }
+
         // Acende o LED da cor atual
         gpio_put(led_pins[current_color_index], 1);
 
-        // Aguarda 500ms. vTaskDelay libera o processador para outras tarefas.
-        vTaskDelay(pdMS_TO_TICKS(500));
+        // Aguarda o fim do período de 500ms, liberando o processador para
+        // as outras co-rotinas e tarefas.
+        coroDELAY_UNTIL(coro, &last_wake, pdMS_TO_TICKS(500), &delayed);
+        if (delayed == pdFALSE)
+        {
+            // O período já tinha passado: recomeça a contagem a partir de agora.
+            last_wake = xTaskGetTickCount();
+        }
 
         // Apaga o LED da cor atual antes de passar para a próxima
         gpio_put(led_pins[current_color_index], 0);
@@ -57,4 +93,6 @@ void led_rgb_task(void *pvParameters)
             current_color_index = 0;
         }
     }
+
+    coroEND(coro);
 }
@@ -3,14 +3,14 @@
  * @brief Definições para o controle do LED RGB.
  *
  * Este arquivo contém as definições para inicialização e controle do LED RGB,
- * incluindo suspensão e retomada da tarefa do LED.
+ * incluindo a pausa e a retomada da co-rotina do LED.
  */
 
 #ifndef LED_RGB_H
 #define LED_RGB_H
 
 #include "FreeRTOS.h"
-#include "task.h"
+#include "coro.h"
 
 // Pinos do LED RGB conforme o esquemático da BitDogLab V6
 #define LED_R_PIN 13
@@ -18,15 +18,16 @@
 #define LED_B_PIN 12
 
 /**
- * @brief Handle para a tarefa do LED RGB.
- * Usado para controlar a tarefa (suspender/retomar) a partir de outras tarefas.
+ * @brief Bloco de controle da co-rotina do LED RGB.
+ * Cada xCoroNotifyGive() com ele alterna a co-rotina entre pausada e ativa.
  */
-extern TaskHandle_t led_rgb_task_handle;
+extern Coro_t led_rgb_coro;
 
 /**
- * @brief Tarefa que controla o ciclo de cores do LED RGB.
- * @param pvParameters Parâmetros da tarefa (não utilizado).
+ * @brief Co-rotina que controla o ciclo de cores do LED RGB.
+ * @param coro Bloco de controle da co-rotina.
+ * @param pvParameters Parâmetros da co-rotina (não utilizado).
  */
-void led_rgb_task(void *pvParameters);
+void led_rgb_coroutine(Coro_t *coro, void *pvParameters);
 
 #endif // LED_RGB_H
\ No newline at end of file
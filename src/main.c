@@ -2,27 +2,210 @@
  * @file main.c
  * @brief Ponto de entrada principal do sistema multitarefa para a BitDogLab.
  *
- * Este arquivo inicializa o sistema, cria as tarefas para o LED RGB,
- * o buzzer e os botões, e inicia o escalonador do FreeRTOS.
+ * Este arquivo inicializa o sistema, cria as tarefas para os atuadores (LED
+ * RGB e buzzer) e os botões, e inicia o escalonador do FreeRTOS.
+ *
+ * O LED e o buzzer são co-rotinas sem pilha própria (coro.h), executadas em
+ * turnos por uma única tarefa, a dos atuadores. Cada comportamento desses
+ * ocupa só o seu Coro_t (40 bytes no RP2040), em vez de um TCB de 136 bytes e
+ * uma pilha de 1 KB; o grupo custa uma tarefa, um conjunto de filas e um
+ * semáforo. Outros comportamentos periódicos simples entram no mesmo grupo
+ * sem mais pilha.
+ *
+ * O heap do FreeRTOS (heap_banked.c) ocupa três regiões: a SRAM principal,
+ * cujos quatro bancos são entrelaçados e compartilhados com o DMA, e os dois
+ * bancos de 4 KB scratch_x e scratch_y. As pilhas das tarefas vão para os
+ * bancos scratch, de modo que os acessos da CPU à pilha não disputam o
+ * barramento com as escritas do DMA na SRAM principal.
+ *
+ * As últimas 8 palavras de cada pilha formam uma zona de guarda
+ * (configCHECK_FOR_STACK_OVERFLOW 3): a troca de contexto só compara o
+ * ponteiro de pilha salvo com o limite da zona, e a tarefa ociosa confere o
+ * conteúdo das zonas a cada 100 ms.
+ *
+ * As prioridades das tarefas seguem a ordem de prazo monotônico do modelo
+ * temporal de task_model: quanto menor o prazo, maior a prioridade. Na
+ * partida, a análise de tempo de resposta (sched_analysis.h) relata pela UART
+ * o pior tempo de resposta de cada tarefa, e um temporizador confere depois o
+ * tempo de CPU medido de cada uma com o WCET declarado.
+ *
+ * O tempo de CPU é dividido em quadros de 10 ms (configUSE_TIME_PARTITIONING).
+ * O primeiro milissegundo de cada quadro é a janela da partição de entrada, à
+ * qual só a tarefa dos botões pertence, e ela só executa nessa janela. As
+ * demais tarefas não têm partição e podem executar em qualquer janela,
+ * inclusive nessa: a janela garante apenas que nenhuma outra partição a use.
+ * Dentro dela, a tarefa do ADC, a de serviço dos temporizadores (ambas de
+ * prioridade maior) e as interrupções ainda tomam parte do tempo; o quanto,
+ * no pior caso, é o que a análise de task_model soma ao tempo de resposta
+ * dos botões.
  */
 
+#include <stdio.h>
 #include "pico/stdlib.h"
+#include "hardware/uart.h"
 #include "FreeRTOS.h"
 #include "task.h"
+#include "block_pool.h"
+#include "coro.h"
 
 // Inclui os cabeçalhos dos módulos de periféricos
 #include "led_rgb.h"
 #include "buzzer.h"
 #include "button.h"
+#include "uart_dma.h"
+#include "adc_dma.h"
+#include "sched_analysis.h"
+
+// Número de blocos de controle de tarefa (TCB) reservados: as três tarefas
+// da aplicação, a tarefa ociosa e a tarefa de serviço dos temporizadores.
+#define TCB_POOL_BLOCKS 5
+
+// Área estática do pool de TCBs e a estrutura que o descreve.
+static uint8_t tcb_pool_storage[blockpoolSTORAGE_SIZE(sizeof(StaticTask_t), TCB_POOL_BLOCKS)];
+static StaticBlockPool_t tcb_pool_buffer;
+
+// Regiões do heap. O índice de cada região na tabela passada a
+// vPortDefineHeapRegions() é a dica de posicionamento de xTaskCreateInRegion().
+#define HEAP_REGION_MAIN      0 // SRAM principal (bancos 0 a 3, entrelaçados)
+#define HEAP_REGION_SCRATCH_X 1 // Banco 4, livre enquanto o núcleo 1 não é usado
+#define HEAP_REGION_SCRATCH_Y 2 // Banco 5, dividido com a pilha das interrupções
+
+// Para medir o efeito do posicionamento, defina como 0: todas as pilhas
+// voltam para a SRAM principal e a contenção aparece no relatório do ADC.
+#define STACKS_IN_SCRATCH 1
+
+#if STACKS_IN_SCRATCH
+#define STACK_REGION_X HEAP_REGION_SCRATCH_X
+#define STACK_REGION_Y HEAP_REGION_SCRATCH_Y
+#else
+#define STACK_REGION_X HEAP_REGION_MAIN
+#define STACK_REGION_Y HEAP_REGION_MAIN
+#endif
+
+// Prioridades das tarefas, usadas na criação e no modelo temporal, em ordem
+// de prazo monotônico: ADC (1024 us), botões (50 ms) e atuadores (200 ms)
+#define PRIO_ACTUATORS 1
+#define PRIO_BUTTON    2
+#define PRIO_ADC       3
+
+// Custo estimado de uma troca de contexto em microssegundos
+#define CONTEXT_SWITCH_US 5
+
+// Partição da tarefa dos botões e quadro de 10 ms: 1 ms para a partição de
+// entrada e 9 ms só para as tarefas sem partição
+#define PARTITION_INPUT 0
+#define PARTITION_FRAME_US 10000u
+
+static const TaskPartitionWindow_t major_frame[] = {
+    { PARTITION_INPUT, pdMS_TO_TICKS(1) },
+    { tskNO_PARTITION, pdMS_TO_TICKS(9) },
+};
+
+// Intervalo entre as conferências do modelo com as medições
+#define SCHED_MONITOR_PERIOD_MS 5000
+
+// Modelo temporal para a análise de escalonabilidade: nome, período ou
+// separação mínima, prazo (0 para igual ao período), WCET, variação de
+// liberação e prioridade, em microssegundos. Os WCETs são estimativas; o
+// monitor aponta as tarefas cujo tempo de CPU medido passa do declarado.
+static const sched_task_t task_model[] = {
+    // Interrupções, acima de qualquer tarefa: o tick, as duas trocas de
+    // janela de cada quadro e o fim de cada bloco de 512 amostras do ADC a
+    // 500 kS/s
+    { "Tick_IRQ", 1000, 0, 5, 0, configMAX_PRIORITIES },
+    { "Partition_Switch", PARTITION_FRAME_US / 2u, 0, 10, 0, configMAX_PRIORITIES },
+    { "ADC_DMA_IRQ", 1024, 0, 10, 0, configMAX_PRIORITIES },
+    // Tarefa de serviço dos temporizadores, onde roda o monitor
+    { "Tmr Svc", SCHED_MONITOR_PERIOD_MS * 1000u, 0, 300, SCHED_TICK_JITTER_US,
+      configTIMER_TASK_PRIORITY },
+    // Acordada fora da sua janela, espera até a janela seguinte (9 ms)
+    { "Button_Task", 50000, 0, 50, SCHED_TICK_JITTER_US + 9000u, PRIO_BUTTON },
+    // Acordada pela interrupção do DMA. O anel comporta oito blocos, mas o
+    // prazo fica igual ao período porque a análise supõe D <= T; o relatório
+    // de vazão, uma vez por segundo, entra no WCET.
+    { "ADC_DMA_Task", 1024, 0, 200, 0, PRIO_ADC },
+    // Co-rotinas do LED e do buzzer. Separação mínima: a menor das duas
+    // esperas do ciclo do buzzer; o WCET soma o das duas co-rotinas, que
+    // podem acordar no mesmo tick.
+    { "Actuator_Task", 200000, 0, 70, SCHED_TICK_JITTER_US, PRIO_ACTUATORS },
+};
+
+#define TASK_MODEL_COUNT (sizeof(task_model) / sizeof(task_model[0]))
+
+// Grupo de co-rotinas dos atuadores (LED e buzzer)
+static CoroScheduler_t actuators;
+
+// Área do heap na SRAM principal
+static uint8_t main_heap[configTOTAL_HEAP_SIZE];
+
+// Limites definidos pelo linker script do SDK: o fim das seções de cada banco
+// scratch e o início da pilha de cada núcleo, que fica no topo do banco.
+extern uint8_t __scratch_x_end__[], __StackOneBottom[];
+extern uint8_t __scratch_y_end__[], __StackBottom[];
+
+/**
+ * @brief Entrega ao FreeRTOS as regiões do heap.
+ *
+ * Deve ser chamada antes de qualquer alocação dinâmica do kernel.
+ */
+static void heap_regions_init(void) {
+    const HeapRegion_t regions[] = {
+        { main_heap, sizeof(main_heap) },
+        { __scratch_x_end__, (size_t) (__StackOneBottom - __scratch_x_end__) },
+        { __scratch_y_end__, (size_t) (__StackBottom - __scratch_y_end__) },
+        { NULL, 0 }
+    };
+
+    vPortDefineHeapRegions(regions);
+}
+
+/**
+ * @brief Chamada pelo FreeRTOS quando uma tarefa usa a zona de guarda da pilha.
+ *
+ * Pode ser chamada na troca de contexto, onde o stream buffer do uart_dma não
+ * pode ser usado, por isso a mensagem é escrita diretamente no FIFO da UART.
+ * Informa o nome da tarefa e a profundidade alcançada na zona de guarda e
+ * para o sistema, já que a memória vizinha à pilha pode estar corrompida.
+ *
+ * @param task Tarefa que estourou a pilha.
+ * @param task_name Nome da tarefa.
+ */
+void vApplicationStackOverflowHook(TaskHandle_t task, char *task_name) {
+    char msg[96];
+    unsigned long depth = (unsigned long) uxTaskGetStackOverflowDepth(task);
+    int len;
+
+    taskDISABLE_INTERRUPTS();
+
+    // Profundidade acima do tamanho da zona de guarda indica que o ponteiro
+    // de pilha saiu do buffer da pilha.
+    len = snprintf(msg, sizeof(msg), "\r\nEstouro de pilha em %s: %lu de %u palavras da zona de guarda\r\n",
+                   task_name, depth, (unsigned) configSTACK_GUARD_WORDS);
+    if (len > (int) sizeof(msg) - 1) {
+        len = (int) sizeof(msg) - 1;
+    }
+    uart_write_blocking(UART_DMA_ID, (const uint8_t *) msg, (size_t) len);
+
+    while (1) {
+        // Sistema parado para inspeção com o depurador.
+    }
+}
 
 /**
  * @brief Ponto de entrada principal do programa.
  *
  * - Inicializa a E/S padrão (para depuração via USB).
+ * - Define as regiões do heap (SRAM principal e bancos scratch).
+ * - Inicializa a transmissão serial via DMA (uart_dma.h).
+ * - Relata a análise de escalonabilidade do modelo temporal.
+ * - Registra um pool de blocos fixos para os TCBs, para que a criação das
+ *   tarefas não fragmente o heap.
  * - Cria três tarefas concorrentes:
- * 1. led_rgb_task: Controla o LED RGB.
- * 2. buzzer_task: Controla o buzzer.
- * 3. button_task: Monitora os botões para controlar as outras duas tarefas.
+ * 1. Actuator_Task: Executa as co-rotinas do LED RGB (led_rgb_coroutine) e
+ *    do buzzer (buzzer_coroutine).
+ * 2. button_task: Monitora os botões para pausar e retomar as co-rotinas.
+ * 3. adc_dma_task: Consome as amostras do ADC capturadas via DMA.
+ * - Cria o temporizador que confere o modelo com as medições.
  * - Inicia o escalonador do FreeRTOS.
  *
  * @return int Nunca retorna, pois o controle é passado para o FreeRTOS.
@@ -31,24 +214,73 @@ int main() {
     // Inicializa a comunicação serial USB para depuração (opcional)
     stdio_init_all();
 
-    // Cria a tarefa para o LED RGB.
-    // Parâmetros:
-    // - led_rgb_task: A função da tarefa.
-    // - "LED_Task": Nome da tarefa (para depuração).
-    // - 256: Tamanho da pilha em palavras (256 * 4 bytes).
-    // - NULL: Parâmetros para a tarefa (nenhum).
-    // - 1: Prioridade da tarefa (prioridades mais baixas primeiro).
-    // - &led_rgb_task_handle: Handle para controlar a tarefa.
-    xTaskCreate(led_rgb_task, "LED_Task", 256, NULL, 1, &led_rgb_task_handle);
+    // Define as regiões do heap antes de qualquer objeto do kernel ser criado
+    heap_regions_init();
+
+    // Inicializa a UART com transmissão via DMA, usada pelos relatórios do ADC
+    uart_dma_init();
+
+    // Relata o pior tempo de resposta de cada tarefa antes de criá-las
+    sched_analysis_report(task_model, TASK_MODEL_COUNT, CONTEXT_SWITCH_US);
+
+    // Registra o pool de TCBs antes de criar qualquer tarefa: a partir daqui,
+    // xTaskCreate() toma o bloco de controle do pool em tempo constante e só
+    // a pilha continua vindo do heap.
+    xBlockPoolRegisterKernelObjectPool(
+        xBlockPoolCreateStatic(sizeof(StaticTask_t), TCB_POOL_BLOCKS,
+                               tcb_pool_storage, &tcb_pool_buffer));
 
-    // Cria a tarefa para o buzzer com os mesmos parâmetros.
-    xTaskCreate(buzzer_task, "Buzzer_Task", 256, NULL, 1, &buzzer_task_handle);
+    // Cria o grupo dos atuadores e as suas co-rotinas, do LED RGB e do
+    // buzzer. Elas não esperam em filas, então o conjunto de filas do grupo
+    // só precisa do lugar do semáforo das notificações (0). Sem memória para
+    // o grupo, os atuadores ficariam parados sem aviso. O resultado fica fora
+    // do configASSERT(), que some do build com NDEBUG.
+    BaseType_t actuators_created = xCoroSchedulerCreate(&actuators, 0);
+    configASSERT(actuators_created == pdPASS);
+    (void) actuators_created;
+    vCoroCreate(&actuators, &led_rgb_coro, led_rgb_coroutine, NULL);
+    vCoroCreate(&actuators, &buzzer_coro, buzzer_coroutine, NULL);
+
+    // Cria a tarefa que executa as co-rotinas dos atuadores.
+    // Parâmetros:
+    // - vCoroSchedulerTask: A função da tarefa, que executa o grupo.
+    // - "Actuator_Task": Nome da tarefa (para depuração).
+    // - 256: Tamanho da pilha em palavras (256 * 4 bytes), compartilhada
+    //   pelas co-rotinas.
+    // - &actuators: O grupo de co-rotinas a executar.
+    // - PRIO_ACTUATORS: Prioridade da tarefa (1; números maiores são mais prioritários).
+    // - NULL: O handle da tarefa não é necessário; os botões notificam as
+    //   co-rotinas diretamente.
+    // - STACK_REGION_X: Região do heap onde a pilha é alocada (dica; se não
+    //   houver espaço, a pilha vem de outra região).
+    xTaskCreateInRegion(vCoroSchedulerTask, "Actuator_Task", 256, &actuators, PRIO_ACTUATORS, NULL,
+                        STACK_REGION_X);
 
     // Cria a tarefa para os botões.
-    // Um handle não é necessário, pois esta tarefa não será controlada por outras.
-    // A prioridade é 2, maior que as outras, para garantir que os botões
-    // tenham resposta rápida.
-    xTaskCreate(button_task, "Button_Task", 256, NULL, 2, NULL);
+    // O handle serve para vincular a tarefa à partição de entrada, abaixo.
+    // A prioridade é 2, maior que a dos atuadores e menor que a do ADC, cujo
+    // prazo é mais curto.
+    // O scratch_x já guarda as pilhas dos atuadores e do ADC; esta vai para o
+    // scratch_y.
+    TaskHandle_t button_task_handle;
+    xTaskCreateInRegion(button_task, "Button_Task", 256, NULL, PRIO_BUTTON, &button_task_handle,
+                        STACK_REGION_Y);
+
+    // Cria a tarefa de aquisição do ADC via DMA.
+    // A prioridade é 3, a maior entre as tarefas da aplicação: o DMA captura
+    // as amostras sem depender da tarefa, mas ela tem o prazo mais curto, um
+    // bloco de 512 amostras.
+    // É a tarefa mais ativa enquanto o DMA escreve no anel, por isso a sua
+    // pilha fica fora dos bancos da SRAM principal.
+    xTaskCreateInRegion(adc_dma_task, "ADC_DMA_Task", 256, NULL, PRIO_ADC, NULL, STACK_REGION_X);
+
+    // Divide o tempo em janelas e vincula a tarefa dos botões à partição de
+    // entrada; a primeira janela começa com o escalonador
+    xTaskSetPartitionSchedule(major_frame, sizeof(major_frame) / sizeof(major_frame[0]));
+    vTaskSetPartition(button_task_handle, PARTITION_INPUT);
+
+    // Confere periodicamente o tempo de CPU medido com o modelo
+    sched_analysis_start_monitor(task_model, TASK_MODEL_COUNT, SCHED_MONITOR_PERIOD_MS);
 
     // Inicia o escalonador do FreeRTOS.
     // A partir deste ponto, o FreeRTOS assume o controle do processador
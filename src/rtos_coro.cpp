@@ -0,0 +1,104 @@
+/**
+ * @file rtos_coro.cpp
+ * @brief Implementação das co-rotinas C++20 sobre os grupos do kernel.
+ *
+ * Cada co-rotina C++ é um Coro_t comum do kernel cuja função, step(),
+ * retoma o quadro dela. As esperas preparam o Coro_t com as mesmas funções
+ * internas que as macros de coro.h usam, então o kernel acorda a co-rotina
+ * pela notificação, pela fila ou pelo prazo, como faria com uma co-rotina C.
+ */
+
+#include "rtos_coro.hpp"
+
+namespace rtos {
+
+namespace {
+
+// Pool dos quadros e o tamanho de cada bloco
+BlockPoolHandle_t frame_pool;
+std::size_t frame_block_size;
+
+}  // namespace
+
+void set_frame_pool(BlockPoolHandle_t pool) noexcept {
+    BlockPoolStats_t stats;
+
+    vBlockPoolGetStats(pool, &stats);
+    frame_block_size = stats.xBlockSize;
+    frame_pool = pool;
+}
+
+void *coro_task::promise_type::operator new(std::size_t size) noexcept {
+    configASSERT(frame_pool != NULL);
+
+    if (size > frame_block_size) {
+        return nullptr;
+    }
+    return pvBlockPoolAlloc(frame_pool);
+}
+
+void coro_task::promise_type::operator delete(void *frame) noexcept {
+    vBlockPoolFree(frame_pool, frame);
+}
+
+void coro_task::promise_type::step(Coro_t *coro, void *params) {
+    auto &promise = *static_cast<promise_type *>(params);
+    coro_group &group = *promise.group;
+
+    group.destroy_ended();
+
+    // Acordada sem o item ou a notificação (outra co-rotina levou o item):
+    // poll() já a pôs de novo em espera
+    if (promise.wait != nullptr) {
+        if (!promise.wait->poll(promise.wait, coro)) {
+            return;
+        }
+        promise.wait = nullptr;
+    }
+
+    auto handle = std::coroutine_handle<promise_type>::from_promise(promise);
+    handle.resume();
+
+    if (handle.done()) {
+        // O kernel ainda lê o Coro_t ao tirá-lo da lista, então o quadro só
+        // é liberado depois
+        coro->ucState = coroSTATE_ENDED;
+        promise.next_ended = group.ended_;
+        group.ended_ = &promise;
+    }
+}
+
+Coro_t *coro_group::spawn(coro_task task) noexcept {
+    if (!task) {
+        return NULL;
+    }
+
+    coro_task::promise_type &promise = task.handle_.promise();
+    task.handle_ = nullptr;
+
+    promise.group = this;
+    vCoroCreate(&scheduler_, &promise.coro, coro_task::promise_type::step, &promise);
+
+    return &promise.coro;
+}
+
+void coro_group::run() noexcept {
+    vCoroSchedulerRun(&scheduler_);
+    destroy_ended();
+}
+
+void coro_group::task_entry(void *params) {
+    static_cast<coro_group *>(params)->run();
+    vTaskDelete(NULL);
+}
+
+void coro_group::destroy_ended() noexcept {
+    while (ended_ != nullptr) {
+        auto &promise = static_cast<coro_task::promise_type &>(*ended_);
+
+        ended_ = promise.next_ended;
+        std::coroutine_handle<coro_task::promise_type>::from_promise(promise).destroy();
+    }
+}
+
+}  // namespace rtos
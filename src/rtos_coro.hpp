@@ -0,0 +1,462 @@
+/**
+ * @file rtos_coro.hpp
+ * @brief Co-rotinas C++20 sobre os grupos de co-rotinas do kernel (coro.h).
+ *
+ * Uma função que retorna rtos::coro_task é uma co-rotina C++20 e espera com
+ * co_await, sem bloquear a tarefa que a executa:
+ * - co_await rtos::delay(ticks), rtos::delay_ms(ms) ou rtos::yield();
+ * - co_await rtos::delay_until(prev, ticks), para execução periódica;
+ * - co_await fila.receive(), que devolve std::optional<T>;
+ * - co_await rtos::notification(), que devolve a contagem de notificações
+ *   dadas com xCoroNotifyGive() ou vCoroNotifyGiveFromISR().
+ *
+ * Um rtos::coro_group é um CoroScheduler_t do kernel: as suas co-rotinas
+ * rodam em turnos numa única tarefa, que dorme no conjunto de filas do grupo
+ * até a próxima notificação, item ou prazo. Cada co-rotina ocupa só o seu
+ * quadro, tirado do pool de blocos registrado com rtos::set_frame_pool(), em
+ * vez de um TCB e uma pilha; ao contrário das macros de coro.h, as variáveis
+ * locais e os parâmetros sobrevivem às esperas, porque ficam no quadro.
+ *
+ * As mesmas limitações de coro.h valem aqui: todas as co-rotinas de um grupo
+ * têm a prioridade da tarefa que o executa, uma co-rotina que não espera
+ * segura as outras, e uma chamada bloqueante do FreeRTOS dentro dela
+ * bloqueia o grupo inteiro (envie nas filas com tempo de espera 0). Uma
+ * rtos::coro_task não pode ser aguardada por outra; cada uma roda por conta
+ * própria no grupo. O código não usa exceções nem o heap, então serve com
+ * -fno-exceptions.
+ */
+
+#ifndef RTOS_CORO_HPP
+#define RTOS_CORO_HPP
+
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "block_pool.h"
+#include "coro.h"
+
+#if (configUSE_CORO_SCHEDULER != 1) || (configUSE_BLOCK_POOLS != 1)
+#error "rtos_coro.hpp precisa de configUSE_CORO_SCHEDULER e configUSE_BLOCK_POOLS em 1 no FreeRTOSConfig.h"
+#endif
+
+namespace rtos {
+
+class coro_group;
+
+/**
+ * @brief Espera de uma co-rotina que pode acordar sem estar concluída.
+ *
+ * Antes de retomar a co-rotina, o grupo chama poll(). Se outra co-rotina ou
+ * tarefa levou o item da fila, poll() devolve false e a co-rotina volta a
+ * esperar, como no laço das macros de coro.h.
+ */
+struct coro_wait {
+    bool (*poll)(coro_wait *wait, Coro_t *coro);
+};
+
+/**
+ * @brief Estado de uma co-rotina no grupo, guardado no quadro dela.
+ */
+struct coro_context {
+    Coro_t coro;
+    coro_group *group = nullptr;
+    coro_wait *wait = nullptr;
+    coro_context *next_ended = nullptr;
+};
+
+/**
+ * @brief Tipo de retorno das co-rotinas executadas por um rtos::coro_group.
+ *
+ * A co-rotina é criada suspensa e começa quando o grupo a recebe em
+ * coro_group::spawn(). Se o pool de quadros não tiver um bloco livre ou
+ * grande o suficiente, a coro_task sai vazia (false).
+ */
+class coro_task {
+public:
+    struct promise_type : coro_context {
+        static void *operator new(std::size_t size) noexcept;
+        static void operator delete(void *frame) noexcept;
+
+        static coro_task get_return_object_on_allocation_failure() noexcept {
+            return coro_task();
+        }
+
+        coro_task get_return_object() noexcept {
+            return coro_task(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        std::suspend_always initial_suspend() const noexcept {
+            return {};
+        }
+
+        // Fica suspensa no fim; o grupo destrói o quadro depois que o kernel
+        // tira o Coro_t da lista
+        std::suspend_always final_suspend() const noexcept {
+            return {};
+        }
+
+        void return_void() const noexcept {}
+
+        void unhandled_exception() const noexcept {
+            configASSERT(pdFALSE);
+        }
+
+        // As esperas só existem dentro de uma coro_task, que lhes dá o seu
+        // contexto
+        template <typename Awaiter>
+        Awaiter await_transform(Awaiter awaiter) noexcept {
+            awaiter.context = this;
+            return awaiter;
+        }
+
+        /**
+         * @brief CoroFunction_t do Coro_t: conclui a espera e retoma a co-rotina.
+         */
+        static void step(Coro_t *coro, void *params);
+    };
+
+    coro_task() noexcept = default;
+
+    coro_task(coro_task &&other) noexcept : handle_(std::exchange(other.handle_, nullptr)) {}
+
+    coro_task &operator=(coro_task &&other) noexcept {
+        if (this != &other) {
+            reset();
+            handle_ = std::exchange(other.handle_, nullptr);
+        }
+        return *this;
+    }
+
+    coro_task(const coro_task &) = delete;
+    coro_task &operator=(const coro_task &) = delete;
+
+    ~coro_task() {
+        reset();
+    }
+
+    explicit operator bool() const noexcept {
+        return static_cast<bool>(handle_);
+    }
+
+private:
+    friend class coro_group;
+
+    explicit coro_task(std::coroutine_handle<promise_type> handle) noexcept : handle_(handle) {}
+
+    // Destrói uma co-rotina que não chegou a ser entregue a um grupo
+    void reset() noexcept {
+        if (handle_) {
+            handle_.destroy();
+            handle_ = nullptr;
+        }
+    }
+
+    std::coroutine_handle<promise_type> handle_;
+};
+
+/**
+ * @brief Grupo de co-rotinas executado por uma única tarefa.
+ *
+ * Como CoroScheduler_t, deve ficar em memória estática ou durar mais que a
+ * tarefa que o executa. create() aloca o conjunto de filas e o semáforo do
+ * grupo, então deve ser chamada depois que o heap estiver pronto.
+ */
+class coro_group {
+public:
+    /**
+     * @brief Cria o conjunto de filas e o semáforo do grupo.
+     *
+     * @param queue_events Soma dos comprimentos das filas que serão
+     *        adicionadas com add_queue(), como em xCoroSchedulerCreate().
+     * @return true se houve memória.
+     */
+    bool create(UBaseType_t queue_events = 0) noexcept {
+        return xCoroSchedulerCreate(&scheduler_, queue_events) == pdPASS;
+    }
+
+    /**
+     * @brief Libera o conjunto de filas e o semáforo; o grupo deve ter
+     * terminado.
+     */
+    void destroy() noexcept {
+        vCoroSchedulerDelete(&scheduler_);
+    }
+
+    /**
+     * @brief Faz as co-rotinas do grupo acordarem com os itens da fila.
+     *
+     * A fila deve estar vazia, e só as co-rotinas do grupo podem receber dela.
+     */
+    bool add_queue(QueueHandle_t queue) noexcept {
+        return xCoroSchedulerAddQueue(&scheduler_, queue) == pdPASS;
+    }
+
+    /**
+     * @brief Entrega a co-rotina ao grupo; ela começa na próxima volta.
+     *
+     * @return O Coro_t da co-rotina, para xCoroNotifyGive() e
+     *         vCoroNotifyGiveFromISR(), ou NULL se a coro_task estava vazia.
+     *         Vale até a co-rotina terminar.
+     */
+    Coro_t *spawn(coro_task task) noexcept;
+
+    /**
+     * @brief Executa as co-rotinas até todas terminarem.
+     */
+    void run() noexcept;
+
+    /**
+     * @brief Função de tarefa que executa o grupo passado em params e apaga
+     * a tarefa quando ele termina.
+     */
+    static void task_entry(void *params);
+
+private:
+    friend struct coro_task::promise_type;
+
+    // Libera os quadros das co-rotinas que terminaram. Só é chamada quando
+    // o kernel já não usa os seus Coro_t, na volta seguinte ou no fim.
+    void destroy_ended() noexcept;
+
+    CoroScheduler_t scheduler_;
+    coro_context *ended_ = nullptr;
+};
+
+/**
+ * @brief Registra o pool de blocos de onde vêm os quadros das co-rotinas.
+ *
+ * O bloco deve comportar o maior quadro, que o compilador calcula a partir
+ * das variáveis locais, dos parâmetros e das esperas de cada co-rotina.
+ * Chamadas com o pool esgotado ou com um quadro maior que o bloco devolvem
+ * uma coro_task vazia.
+ */
+void set_frame_pool(BlockPoolHandle_t pool) noexcept;
+
+// ---------------------------------------------------------------------------
+// Esperas
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Espera de rtos::delay(), o equivalente a vTaskDelay().
+ */
+struct delay_awaiter {
+    TickType_t ticks;
+    coro_context *context = nullptr;
+
+    bool await_ready() const noexcept {
+        return false;
+    }
+
+    void await_suspend(std::coroutine_handle<>) const noexcept {
+        vCoroPrepareDelay(&context->coro, ticks);
+    }
+
+    void await_resume() const noexcept {}
+};
+
+/**
+ * @brief Espera de rtos::delay_until(), o equivalente a xTaskDelayUntil().
+ *
+ * co_await devolve true se a co-rotina esperou, false se o instante já havia
+ * passado.
+ */
+struct delay_until_awaiter {
+    TickType_t *previous_wake;
+    TickType_t increment;
+    coro_context *context = nullptr;
+    bool delayed = false;
+
+    bool await_ready() noexcept {
+        delayed = xCoroPrepareDelayUntil(&context->coro, previous_wake, increment) != pdFALSE;
+        return !delayed;
+    }
+
+    void await_suspend(std::coroutine_handle<>) const noexcept {}
+
+    bool await_resume() const noexcept {
+        return delayed;
+    }
+};
+
+/**
+ * @brief Espera de rtos::notification(), o equivalente a ulTaskNotifyTake().
+ *
+ * co_await devolve a contagem de notificações antes de ser zerada ou
+ * decrementada, ou 0 se o tempo acabou.
+ */
+struct notification_awaiter : coro_wait {
+    BaseType_t clear_on_exit;
+    TickType_t ticks;
+    coro_context *context = nullptr;
+    uint32_t value = 0;
+
+    notification_awaiter(BaseType_t clear, TickType_t ticks_to_wait) noexcept
+        : coro_wait{poll_notification}, clear_on_exit(clear), ticks(ticks_to_wait) {}
+
+    bool await_ready() noexcept {
+        vCoroSetTimeOut(&context->coro, ticks);
+        return poll_notification(this, &context->coro);
+    }
+
+    void await_suspend(std::coroutine_handle<>) noexcept {
+        context->wait = this;
+    }
+
+    uint32_t await_resume() const noexcept {
+        return value;
+    }
+
+private:
+    static bool poll_notification(coro_wait *wait, Coro_t *coro) {
+        auto *self = static_cast<notification_awaiter *>(wait);
+
+        self->value = ulCoroTakeNotification(coro, self->clear_on_exit);
+        return self->value != 0U ||
+               xCoroPrepareWait(coro, coroSTATE_WAITING_NOTIFICATION, NULL) == pdFALSE;
+    }
+};
+
+/**
+ * @brief Espera de rtos::queue<T>::receive(), o equivalente a xQueueReceive().
+ *
+ * co_await devolve o item, ou std::nullopt se o tempo acabou.
+ */
+template <typename T>
+struct receive_awaiter : coro_wait {
+    QueueHandle_t queue;
+    TickType_t ticks;
+    coro_context *context = nullptr;
+    std::optional<T> item;
+
+    receive_awaiter(QueueHandle_t from, TickType_t ticks_to_wait) noexcept
+        : coro_wait{poll_queue}, queue(from), ticks(ticks_to_wait) {}
+
+    bool await_ready() noexcept {
+        vCoroSetTimeOut(&context->coro, ticks);
+        return poll_queue(this, &context->coro);
+    }
+
+    void await_suspend(std::coroutine_handle<>) noexcept {
+        context->wait = this;
+    }
+
+    std::optional<T> await_resume() noexcept {
+        return std::move(item);
+    }
+
+private:
+    static bool poll_queue(coro_wait *wait, Coro_t *coro) {
+        auto *self = static_cast<receive_awaiter *>(wait);
+        T received;
+
+        if (xQueueReceive(self->queue, &received, 0) == pdPASS) {
+            self->item = received;
+            return true;
+        }
+        return xCoroPrepareWait(coro, coroSTATE_WAITING_QUEUE, self->queue) == pdFALSE;
+    }
+};
+
+/**
+ * @brief Espera um número de ticks; 0 é o mesmo que rtos::yield().
+ */
+inline delay_awaiter delay(TickType_t ticks) noexcept {
+    return delay_awaiter{ticks};
+}
+
+/**
+ * @brief Espera um número de milissegundos, arredondado para ticks.
+ */
+inline delay_awaiter delay_ms(uint32_t ms) noexcept {
+    return delay_awaiter{pdMS_TO_TICKS(ms)};
+}
+
+/**
+ * @brief Deixa as outras co-rotinas prontas do grupo rodarem antes desta.
+ */
+inline delay_awaiter yield() noexcept {
+    return delay_awaiter{0};
+}
+
+/**
+ * @brief Espera até previous_wake + increment e avança previous_wake.
+ *
+ * Como previous_wake pode ser uma variável local da co-rotina, basta
+ * inicializá-la com xTaskGetTickCount() antes do laço.
+ */
+inline delay_until_awaiter delay_until(TickType_t &previous_wake, TickType_t increment) noexcept {
+    return delay_until_awaiter{&previous_wake, increment};
+}
+
+/**
+ * @brief Espera uma notificação dada ao Coro_t devolvido por spawn().
+ *
+ * @param clear_on_exit pdTRUE para zerar a contagem, pdFALSE para decrementá-la.
+ * @param ticks Tempo máximo de espera, ou portMAX_DELAY.
+ */
+inline notification_awaiter notification(BaseType_t clear_on_exit = pdTRUE,
+                                          TickType_t ticks = portMAX_DELAY) noexcept {
+    return notification_awaiter(clear_on_exit, ticks);
+}
+
+/**
+ * @brief Fila do FreeRTOS com itens do tipo T, recebidos com co_await.
+ *
+ * As tarefas e as interrupções enviam como numa fila comum. Dentro de uma
+ * co-rotina, send() deve usar tempo de espera 0, para não bloquear o grupo.
+ */
+template <typename T>
+class queue {
+    static_assert(std::is_trivially_copyable_v<T>, "os itens são copiados byte a byte pela fila");
+
+public:
+    /**
+     * @brief Cria a fila, com espaço para length itens.
+     *
+     * @return true se houve memória.
+     */
+    bool create(UBaseType_t length) noexcept {
+        handle_ = xQueueCreate(length, sizeof(T));
+        return handle_ != NULL;
+    }
+
+    void destroy() noexcept {
+        vQueueDelete(handle_);
+        handle_ = NULL;
+    }
+
+    QueueHandle_t handle() const noexcept {
+        return handle_;
+    }
+
+    bool send(const T &item, TickType_t ticks = 0) noexcept {
+        return xQueueSend(handle_, &item, ticks) == pdPASS;
+    }
+
+    bool send_from_isr(const T &item, BaseType_t *higher_priority_task_woken) noexcept {
+        return xQueueSendFromISR(handle_, &item, higher_priority_task_woken) == pdPASS;
+    }
+
+    /**
+     * @brief Espera um item; a fila deve ter sido adicionada ao grupo com
+     * coro_group::add_queue().
+     *
+     * @param ticks Tempo máximo de espera, ou portMAX_DELAY.
+     */
+    receive_awaiter<T> receive(TickType_t ticks = portMAX_DELAY) const noexcept {
+        return receive_awaiter<T>(handle_, ticks);
+    }
+
+private:
+    QueueHandle_t handle_ = NULL;
+};
+
+}  // namespace rtos
+
+#endif  // RTOS_CORO_HPP
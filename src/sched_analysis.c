@@ -0,0 +1,341 @@
+/**
+ * @file sched_analysis.c
+ * @brief Implementação da análise de escalonabilidade e do monitor.
+ *
+ * A análise é feita em aritmética inteira de 64 bits, já que o RP2040 não tem
+ * unidade de ponto flutuante. O monitor roda na tarefa de serviço dos
+ * temporizadores e lê os contadores de tempo de execução do kernel, que
+ * contam microssegundos do temporizador de 64 bits do RP2040. Com
+ * configUSE_TIME_PARTITIONING, o monitor também relata o uso de cada partição
+ * e o custo medido das trocas de janela; com configUSE_CRITICAL_PROFILER, as
+ * seções críticas que mantêm as interrupções mascaradas por mais tempo.
+ */
+
+#include "sched_analysis.h"
+#include "uart_dma.h"
+#include <stdio.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+#if (configUSE_CRITICAL_PROFILER == 1)
+#include "critical_profiler.h"
+#endif
+
+// Nome da tarefa de serviço dos temporizadores, como em timers.c
+#ifndef configTIMER_SERVICE_TASK_NAME
+#define configTIMER_SERVICE_TASK_NAME "Tmr Svc"
+#endif
+
+// O relatório de partida é escrito sem esperar, antes que o DMA possa
+// esvaziar o buffer de transmissão, então precisa caber nele inteiro; um
+// byte do stream buffer nunca fica livre
+_Static_assert(UART_DMA_TX_BUFFER_SIZE - 1u >= SCHED_REPORT_MAX_BYTES,
+               "o buffer de transmissao da UART nao comporta o relatorio de partida");
+
+// Seções críticas relatadas a cada conferência do monitor
+#define SCHED_MONITOR_CRITICAL_SITES 3
+
+// Limite de Liu e Layland, n * (2^(1/n) - 1), em centésimos de porcento
+static const uint16_t liu_layland_bound[SCHED_ANALYSIS_MAX_TASKS] = {
+    10000, 8284, 7798, 7568, 7435, 7348, 7286, 7241
+};
+
+// Conjunto conferido pelo monitor
+static const sched_task_t *monitor_tasks;
+static size_t monitor_count;
+
+// Tempo de execução de cada tarefa e instante na conferência anterior
+static uint64_t monitor_prev_runtime[SCHED_ANALYSIS_MAX_TASKS];
+static uint64_t monitor_prev_time;
+static bool monitor_primed = false;
+
+/**
+ * @brief Prazo relativo efetivo da tarefa.
+ */
+static uint32_t sched_deadline(const sched_task_t *task) {
+    return task->deadline_us != 0 ? task->deadline_us : task->period_us;
+}
+
+/**
+ * @brief Indica se a prioridade da entrada pode ser escolhida pela aplicação.
+ *
+ * As interrupções ficam acima de qualquer tarefa, e a tarefa de serviço dos
+ * temporizadores fica na prioridade de configTIMER_TASK_PRIORITY, qualquer que
+ * seja o seu prazo; a ordem de prazo monotônico não se aplica a elas.
+ */
+static bool sched_priority_assignable(const sched_task_t *task) {
+    return task->priority < configMAX_PRIORITIES &&
+           strcmp(task->name, configTIMER_SERVICE_TASK_NAME) != 0;
+}
+
+/**
+ * @brief Envia uma linha do relatório sem bloquear.
+ *
+ * Se o buffer de transmissão estiver cheio, a linha é descartada: o monitor
+ * não pode atrasar a tarefa de serviço dos temporizadores.
+ */
+static void sched_write_line(const char *line, int len) {
+    // snprintf() devolve o tamanho que a linha teria sem o corte
+    if (len > SCHED_REPORT_LINE_MAX - 1) {
+        len = SCHED_REPORT_LINE_MAX - 1;
+    }
+
+    if (len > 0) {
+        uart_dma_write(line, (size_t) len, 0);
+    }
+}
+
+bool sched_analysis_run(const sched_task_t *tasks, size_t count,
+                        uint32_t switch_overhead_us, sched_result_t *results) {
+    bool all_schedulable = true;
+
+    for (size_t i = 0; i < count; i++) {
+        const uint64_t cost = (uint64_t) tasks[i].wcet_us + 2u * switch_overhead_us;
+        const uint64_t deadline = sched_deadline(&tasks[i]);
+        uint64_t w = cost;
+
+        // Iteração de ponto fixo: w só cresce, então para assim que repete
+        // ou que a resposta passa do prazo
+        while (true) {
+            uint64_t next = cost;
+
+            for (size_t j = 0; j < count; j++) {
+                if (j == i || tasks[j].priority < tasks[i].priority) {
+                    continue;
+                }
+
+                uint64_t period = tasks[j].period_us;
+                uint64_t jobs = (w + tasks[j].jitter_us + period - 1) / period;
+                next += jobs * ((uint64_t) tasks[j].wcet_us + 2u * switch_overhead_us);
+            }
+
+            if (next + tasks[i].jitter_us > deadline) {
+                w = UINT64_MAX;
+                break;
+            }
+
+            if (next == w) {
+                break;
+            }
+
+            w = next;
+        }
+
+        if (w == UINT64_MAX) {
+            results[i].response_us = SCHED_RESPONSE_UNBOUNDED;
+            results[i].schedulable = false;
+            all_schedulable = false;
+        } else {
+            results[i].response_us = (uint32_t) (w + tasks[i].jitter_us);
+            results[i].schedulable = true;
+        }
+    }
+
+    return all_schedulable;
+}
+
+bool sched_analysis_report(const sched_task_t *tasks, size_t count,
+                           uint32_t switch_overhead_us) {
+    sched_result_t results[SCHED_ANALYSIS_MAX_TASKS];
+    char line[SCHED_REPORT_LINE_MAX];
+    uint64_t utilization = 0;
+    bool schedulable;
+    int len;
+
+    configASSERT(count > 0 && count <= SCHED_ANALYSIS_MAX_TASKS);
+
+    schedulable = sched_analysis_run(tasks, count, switch_overhead_us, results);
+
+    for (size_t i = 0; i < count; i++) {
+        uint64_t cost = (uint64_t) tasks[i].wcet_us + 2u * switch_overhead_us;
+
+        // Utilização em centésimos de porcento
+        utilization += (cost * 10000u) / tasks[i].period_us;
+
+        if (results[i].schedulable) {
+            len = snprintf(line, sizeof(line),
+                           "RTA %s: prio %lu, T %lu us, D %lu us, C %lu us, R %lu us\r\n",
+                           tasks[i].name, (unsigned long) tasks[i].priority,
+                           (unsigned long) tasks[i].period_us,
+                           (unsigned long) sched_deadline(&tasks[i]),
+                           (unsigned long) tasks[i].wcet_us,
+                           (unsigned long) results[i].response_us);
+        } else {
+            len = snprintf(line, sizeof(line),
+                           "RTA %s: prio %lu, T %lu us, D %lu us, C %lu us, R > D (PRAZO PERDIDO)\r\n",
+                           tasks[i].name, (unsigned long) tasks[i].priority,
+                           (unsigned long) tasks[i].period_us,
+                           (unsigned long) sched_deadline(&tasks[i]),
+                           (unsigned long) tasks[i].wcet_us);
+        }
+        sched_write_line(line, len);
+    }
+
+    // O limite de Liu e Layland é suficiente para prioridades por taxa
+    // monotônica e prazos iguais aos períodos; acima dele, só a análise de
+    // tempo de resposta decide
+    len = snprintf(line, sizeof(line),
+                   "RTA: utilizacao %lu.%02lu%% (limite de Liu e Layland %u.%02u%%), %s\r\n",
+                   (unsigned long) (utilization / 100u), (unsigned long) (utilization % 100u),
+                   liu_layland_bound[count - 1] / 100u, liu_layland_bound[count - 1] % 100u,
+                   schedulable ? "escalonavel" : "NAO ESCALONAVEL");
+    sched_write_line(line, len);
+
+    // Com prazos menores ou iguais aos períodos, a ordem de prazo monotônico
+    // é ótima entre as atribuições de prioridade fixa
+    for (size_t i = 0; i < count; i++) {
+        if (!sched_priority_assignable(&tasks[i])) {
+            continue;
+        }
+
+        for (size_t j = 0; j < count; j++) {
+            if (sched_priority_assignable(&tasks[j]) &&
+                sched_deadline(&tasks[i]) < sched_deadline(&tasks[j]) &&
+                tasks[i].priority < tasks[j].priority) {
+                len = snprintf(line, sizeof(line),
+                               "RTA: %s (D %lu us) tem prioridade menor que %s (D %lu us), "
+                               "fora da ordem de prazo monotonico\r\n",
+                               tasks[i].name, (unsigned long) sched_deadline(&tasks[i]),
+                               tasks[j].name, (unsigned long) sched_deadline(&tasks[j]));
+                sched_write_line(line, len);
+
+                // Um aviso por tarefa basta e mantém o relatório limitado
+                break;
+            }
+        }
+    }
+
+    return schedulable;
+}
+
+/**
+ * @brief Callback do temporizador do monitor.
+ *
+ * Compara o tempo de CPU de cada tarefa desde a conferência anterior com o
+ * que o modelo permite no mesmo intervalo. A primeira chamada só registra os
+ * contadores.
+ */
+static void sched_monitor_callback(TimerHandle_t timer) {
+    // Estático para não ocupar a pilha da tarefa de serviço: as tarefas da
+    // aplicação, a tarefa ociosa e a de serviço dos temporizadores
+    static TaskStatus_t status[SCHED_ANALYSIS_MAX_TASKS + 2];
+    configRUN_TIME_COUNTER_TYPE total;
+    char line[SCHED_REPORT_LINE_MAX];
+    UBaseType_t found;
+    uint64_t now = time_us_64();
+    uint64_t elapsed = now - monitor_prev_time;
+
+    (void) timer;
+
+    found = uxTaskGetSystemState(status, SCHED_ANALYSIS_MAX_TASKS + 2, &total);
+
+    for (size_t i = 0; i < monitor_count; i++) {
+        const sched_task_t *task = &monitor_tasks[i];
+        const TaskStatus_t *match = NULL;
+
+        for (UBaseType_t k = 0; k < found; k++) {
+            if (strcmp(status[k].pcTaskName, task->name) == 0) {
+                match = &status[k];
+                break;
+            }
+        }
+
+        // Interrupções e tarefas ainda não criadas não têm contador
+        if (match == NULL) {
+            continue;
+        }
+
+        uint64_t runtime = match->ulRunTimeCounter - monitor_prev_runtime[i];
+        monitor_prev_runtime[i] = match->ulRunTimeCounter;
+
+        if (!monitor_primed || elapsed == 0) {
+            continue;
+        }
+
+        // Tempo de CPU por período, o que a análise supõe ser no máximo o WCET
+        uint64_t per_job = (runtime * task->period_us) / elapsed;
+        uint64_t cpu = (runtime * 10000u) / elapsed;
+        int len = snprintf(line, sizeof(line),
+                           "Medido %s: CPU %lu.%02lu%%, %lu us por periodo (WCET %lu us)%s\r\n",
+                           task->name, (unsigned long) (cpu / 100u), (unsigned long) (cpu % 100u),
+                           (unsigned long) per_job, (unsigned long) task->wcet_us,
+                           per_job > task->wcet_us ? ", WCET SUBESTIMADO" : "");
+        sched_write_line(line, len);
+    }
+
+#if (configUSE_TIME_PARTITIONING == 1)
+    for (UBaseType_t p = 0; p < configMAX_PARTITIONS; p++) {
+        TaskPartitionStatus_t partition;
+
+        // Partições sem janela no quadro não são usadas
+        if (xTaskGetPartitionStatus(p, &partition) != pdPASS || partition.xBudget == 0) {
+            continue;
+        }
+
+        // O custo da troca vem do contador de tempo de execução, em us
+        int len = snprintf(line, sizeof(line),
+                           "Particao %lu: orcamento %lu ticks por quadro, %lu janelas, %lu ticks usados, "
+                           "%lu estouros, troca %lu us (max %lu us)\r\n",
+                           (unsigned long) p, (unsigned long) partition.xBudget,
+                           (unsigned long) partition.ulWindows, (unsigned long) partition.ulUsedTicks,
+                           (unsigned long) partition.ulOverruns,
+                           (unsigned long) partition.ulLastSwitchOverhead,
+                           (unsigned long) partition.ulMaxSwitchOverhead);
+        sched_write_line(line, len);
+    }
+#endif
+
+#if (configUSE_CRITICAL_PROFILER == 1)
+    // Estático pelo mesmo motivo de status[]; cabe toda a tabela do kernel
+    static CriticalSiteStats_t sites[configCRITICAL_PROFILER_SITES + 1];
+    UBaseType_t site_count = uxCriticalProfilerGetSiteStats(sites, configCRITICAL_PROFILER_SITES + 1);
+
+    // Seleção parcial: leva as de maior duração máxima para o início
+    for (UBaseType_t i = 0; i < site_count && i < SCHED_MONITOR_CRITICAL_SITES; i++) {
+        for (UBaseType_t k = i + 1; k < site_count; k++) {
+            if (sites[k].ullMaxTime > sites[i].ullMaxTime) {
+                CriticalSiteStats_t swap = sites[i];
+                sites[i] = sites[k];
+                sites[k] = swap;
+            }
+        }
+
+        // O caminho completo do arquivo não ajuda e não cabe na linha
+        const char *file = sites[i].pcFile != NULL ? sites[i].pcFile : "(outros)";
+        const char *base = strrchr(file, '/');
+        file = base != NULL ? base + 1 : file;
+
+        // Seções de menos de 1 us aparecem com duração 0
+        int len = snprintf(line, sizeof(line),
+                           "Secao critica %s:%lu: %lu vezes, max %lu us, media %lu us\r\n",
+                           file, (unsigned long) sites[i].ulLine,
+                           (unsigned long) sites[i].ulCount,
+                           (unsigned long) sites[i].ullMaxTime,
+                           (unsigned long) (sites[i].ullTotalTime / sites[i].ulCount));
+        sched_write_line(line, len);
+    }
+#endif
+
+    monitor_prev_time = now;
+    monitor_primed = true;
+}
+
+void sched_analysis_start_monitor(const sched_task_t *tasks, size_t count,
+                                  uint32_t period_ms) {
+    TimerHandle_t timer;
+
+    configASSERT(count > 0 && count <= SCHED_ANALYSIS_MAX_TASKS);
+
+    monitor_tasks = tasks;
+    monitor_count = count;
+
+    timer = xTimerCreate("SchedMon", pdMS_TO_TICKS(period_ms), pdTRUE, NULL,
+                         sched_monitor_callback);
+    configASSERT(timer != NULL);
+
+    // A primeira conferência só registra os contadores; o intervalo começa aqui
+    monitor_prev_time = time_us_64();
+    xTimerStart(timer, 0);
+}
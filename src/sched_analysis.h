@@ -0,0 +1,114 @@
+/**
+ * @file sched_analysis.h
+ * @brief Análise de escalonabilidade do conjunto de tarefas declarado.
+ *
+ * Cada tarefa é declarada com período (ou separação mínima entre ativações),
+ * prazo relativo, tempo de execução no pior caso (WCET), variação de
+ * liberação e prioridade. A análise de tempo de resposta calcula o pior tempo
+ * de resposta de cada tarefa sob prioridade fixa e informa se o conjunto
+ * cumpre os prazos. O monitor compara em seguida o modelo com o tempo de CPU
+ * medido pelas estatísticas de execução do kernel.
+ */
+
+#ifndef SCHED_ANALYSIS_H
+#define SCHED_ANALYSIS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "FreeRTOS.h"
+
+// Tempo de resposta de uma tarefa cuja iteração não converge dentro do prazo
+#define SCHED_RESPONSE_UNBOUNDED UINT32_MAX
+
+// Variação de liberação de uma tarefa acordada pelo tick: a ativação pode
+// ocorrer até um período de tick depois do instante nominal
+#define SCHED_TICK_JITTER_US (1000000u / configTICK_RATE_HZ)
+
+// Maior número de tarefas aceito pelo monitor
+#define SCHED_ANALYSIS_MAX_TASKS 8
+
+// Maior linha do relatório e do monitor, em bytes; linhas maiores são cortadas
+#define SCHED_REPORT_LINE_MAX 128
+
+// Maior relatório de sched_analysis_report(): uma linha por tarefa, a da
+// utilização e no máximo um aviso de prioridade por tarefa
+#define SCHED_REPORT_MAX_BYTES ((2u * SCHED_ANALYSIS_MAX_TASKS + 1u) * SCHED_REPORT_LINE_MAX)
+
+/**
+ * @brief Modelo temporal de uma tarefa (ou de uma interrupção).
+ *
+ * Todos os tempos em microssegundos. Para uma interrupção, a prioridade deve
+ * ser maior que a de qualquer tarefa (por exemplo, configMAX_PRIORITIES) e o
+ * nome não corresponde a nenhuma tarefa, então o monitor não a confere.
+ */
+typedef struct {
+    const char *name;       // Nome da tarefa, igual ao passado a xTaskCreate()
+    uint32_t period_us;     // Período ou separação mínima entre ativações
+    uint32_t deadline_us;   // Prazo relativo (0 para prazo igual ao período)
+    uint32_t wcet_us;       // Tempo de execução no pior caso
+    uint32_t jitter_us;     // Variação de liberação
+    UBaseType_t priority;   // Prioridade (maior é mais prioritária)
+} sched_task_t;
+
+/**
+ * @brief Resultado da análise para uma tarefa.
+ */
+typedef struct {
+    uint32_t response_us;   // Pior tempo de resposta ou SCHED_RESPONSE_UNBOUNDED
+    bool schedulable;       // Pior tempo de resposta dentro do prazo
+} sched_result_t;
+
+/**
+ * @brief Calcula o pior tempo de resposta de cada tarefa.
+ *
+ * Usa a análise de tempo de resposta de prioridade fixa com variação de
+ * liberação: R = J + w, com w = C + soma de ceil((w + J_j) / T_j) * C_j sobre
+ * as tarefas de prioridade maior ou igual. As tarefas de mesma prioridade
+ * contam como interferência porque o kernel as alterna por fatia de tempo
+ * (ou por prazo, com configUSE_EDF_SCHEDULING), o que torna o resultado um
+ * limite superior para elas. A análise supõe prazos menores ou iguais aos
+ * períodos e não inclui bloqueio por recursos compartilhados.
+ *
+ * @param tasks Conjunto de tarefas.
+ * @param count Número de tarefas.
+ * @param switch_overhead_us Custo de uma troca de contexto; cada ativação
+ * soma duas trocas ao seu WCET.
+ * @param results Vetor com count posições que recebe os resultados.
+ * @return true se todas as tarefas cumprem os prazos.
+ */
+bool sched_analysis_run(const sched_task_t *tasks, size_t count,
+                        uint32_t switch_overhead_us, sched_result_t *results);
+
+/**
+ * @brief Executa a análise e envia o relatório pela UART (uart_dma.h).
+ *
+ * Além dos tempos de resposta, informa a utilização total comparada com o
+ * limite de Liu e Layland e as tarefas cujas prioridades não seguem a ordem
+ * de prazo monotônico. Essa ordem só é conferida entre as tarefas da
+ * aplicação: as interrupções e a tarefa de serviço dos temporizadores ficam
+ * de fora, e cada tarefa recebe no máximo um aviso. Pode ser chamada antes do
+ * escalonador iniciar: o relatório tem até SCHED_REPORT_MAX_BYTES e é escrito
+ * sem esperar, então cabe inteiro no buffer de transmissão da UART.
+ *
+ * @return true se o conjunto é escalonável.
+ */
+bool sched_analysis_report(const sched_task_t *tasks, size_t count,
+                           uint32_t switch_overhead_us);
+
+/**
+ * @brief Cria um temporizador que confere o modelo com as medições.
+ *
+ * A cada período, o tempo de CPU de cada tarefa (configGENERATE_RUN_TIME_STATS)
+ * é convertido em tempo médio por ativação e comparado com o WCET declarado.
+ * Uma média acima do WCET prova que a declaração está errada e que a análise
+ * não vale; uma média abaixo não prova o contrário, pois o pior caso pode não
+ * ter ocorrido.
+ *
+ * @param tasks Conjunto de tarefas; deve permanecer válido.
+ * @param count Número de tarefas (até SCHED_ANALYSIS_MAX_TASKS).
+ * @param period_ms Intervalo entre as conferências.
+ */
+void sched_analysis_start_monitor(const sched_task_t *tasks, size_t count,
+                                  uint32_t period_ms);
+
+#endif // SCHED_ANALYSIS_H
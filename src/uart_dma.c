@@ -0,0 +1,142 @@
+/**
+ * @file uart_dma.c
+ * @brief Implementação da transmissão serial via DMA.
+ *
+ * O stream buffer de transmissão é criado com
+ * xStreamBufferCreateExternallyIndexed() sobre o anel do DMA e com um callback
+ * de envio concluído (configUSE_SB_COMPLETED_CALLBACK). Quando uma tarefa
+ * escreve no buffer, o callback inicia uma transferência de DMA com todos os
+ * bytes pendentes; o canal lê em modo anel, então uma transferência passa do
+ * fim do anel para o início sem ser dividida. Ao fim da transferência, a
+ * interrupção do DMA informa ao stream buffer até onde o DMA leu com
+ * xStreamBufferSetTailFromISR(), o que desbloqueia uma tarefa que esteja
+ * esperando por espaço, e inicia a próxima transferência se houver mais dados.
+ */
+
+#include "uart_dma.h"
+#include "pico/stdlib.h"
+#include "hardware/uart.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "stream_buffer.h"
+
+// Anel do DMA: o modo anel exige alinhamento igual ao tamanho
+static uint8_t tx_ring[UART_DMA_TX_BUFFER_SIZE] __attribute__((aligned(UART_DMA_TX_BUFFER_SIZE)));
+
+// Stream buffer cuja posição de leitura é avançada pelo DMA
+static StreamBufferHandle_t tx_buffer = NULL;
+
+// Canal de DMA usado na transmissão
+static int tx_channel = -1;
+
+// Quantidade de bytes da transferência em andamento (0 se o DMA está livre)
+static volatile size_t tx_in_flight = 0;
+
+/**
+ * @brief Inicia uma transferência de DMA se o canal estiver livre e houver
+ * dados no buffer.
+ *
+ * Deve ser chamada com as interrupções mascaradas ou a partir da interrupção
+ * do DMA, para que duas transferências não sejam iniciadas ao mesmo tempo.
+ */
+static void uart_dma_start_next(void) {
+    size_t len;
+
+    if (tx_in_flight != 0) {
+        return;
+    }
+
+    // O endereço de leitura do DMA já está na posição de leitura do stream
+    // buffer, e o modo anel cuida da volta ao início
+    len = xStreamBufferBytesAvailable(tx_buffer);
+
+    if (len > 0) {
+        tx_in_flight = len;
+        dma_channel_set_trans_count(tx_channel, len, true);
+    }
+}
+
+/**
+ * @brief Callback chamado pelo stream buffer quando novos dados são escritos.
+ *
+ * @param stream_buffer Stream buffer que recebeu os dados.
+ * @param is_inside_isr pdTRUE se a escrita foi feita a partir de uma ISR.
+ * @param higher_priority_task_woken Não utilizado, pois nenhuma tarefa espera
+ * por dados neste buffer.
+ */
+static void uart_dma_send_completed(StreamBufferHandle_t stream_buffer,
+                                    BaseType_t is_inside_isr,
+                                    BaseType_t * const higher_priority_task_woken) {
+    (void) stream_buffer;
+    (void) higher_priority_task_woken;
+
+    if (is_inside_isr == pdFALSE) {
+        // Impede que a interrupção do DMA inicie a mesma transferência
+        taskENTER_CRITICAL();
+        uart_dma_start_next();
+        taskEXIT_CRITICAL();
+    } else {
+        UBaseType_t saved = taskENTER_CRITICAL_FROM_ISR();
+        uart_dma_start_next();
+        taskEXIT_CRITICAL_FROM_ISR(saved);
+    }
+}
+
+/**
+ * @brief Interrupção de fim de transferência do DMA de transmissão.
+ */
+static void uart_dma_irq_handler(void) {
+    BaseType_t higher_priority_task_woken = pdFALSE;
+    size_t tail;
+
+    // A linha DMA_IRQ_0 é compartilhada com outros módulos
+    if (!dma_channel_get_irq0_status(tx_channel)) {
+        return;
+    }
+
+    dma_channel_acknowledge_irq0(tx_channel);
+
+    // Libera os bytes transmitidos e desbloqueia quem espera por espaço
+    tail = (size_t) (dma_channel_hw_addr(tx_channel)->read_addr - (uintptr_t) tx_ring) &
+           (UART_DMA_TX_BUFFER_SIZE - 1);
+    tx_in_flight = 0;
+    xStreamBufferSetTailFromISR(tx_buffer, tail, &higher_priority_task_woken);
+
+    uart_dma_start_next();
+
+    portYIELD_FROM_ISR(higher_priority_task_woken);
+}
+
+void uart_dma_init(void) {
+    uart_init(UART_DMA_ID, UART_DMA_BAUDRATE);
+    gpio_set_function(UART_DMA_TX_PIN, GPIO_FUNC_UART);
+    gpio_set_function(UART_DMA_RX_PIN, GPIO_FUNC_UART);
+
+    // Nenhuma tarefa lê deste buffer: o DMA é o consumidor
+    tx_buffer = xStreamBufferCreateExternallyIndexed(UART_DMA_TX_BUFFER_SIZE, 1, tx_ring,
+                                                     uart_dma_send_completed, NULL);
+    configASSERT(tx_buffer != NULL);
+
+    // Canal de DMA: anel de 2^UART_DMA_TX_RING_BITS bytes (incrementando) ->
+    // FIFO da UART (fixo), 8 bits, cadenciado pelo DREQ de transmissão da UART
+    tx_channel = dma_claim_unused_channel(true);
+    dma_channel_config config = dma_channel_get_default_config(tx_channel);
+    channel_config_set_transfer_data_size(&config, DMA_SIZE_8);
+    channel_config_set_read_increment(&config, true);
+    channel_config_set_write_increment(&config, false);
+    channel_config_set_ring(&config, false, UART_DMA_TX_RING_BITS);
+    channel_config_set_dreq(&config, uart_get_dreq(UART_DMA_ID, true));
+    dma_channel_configure(tx_channel, &config, &uart_get_hw(UART_DMA_ID)->dr,
+                          tx_ring, 0, false);
+
+    dma_channel_set_irq0_enabled(tx_channel, true);
+    irq_add_shared_handler(DMA_IRQ_0, uart_dma_irq_handler,
+                           PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(DMA_IRQ_0, true);
+}
+
+size_t uart_dma_write(const void *data, size_t len, TickType_t ticks_to_wait) {
+    return xStreamBufferSend(tx_buffer, data, len, ticks_to_wait);
+}
\ No newline at end of file
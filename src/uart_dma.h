@@ -0,0 +1,47 @@
+/**
+ * @file uart_dma.h
+ * @brief Definições para a transmissão serial via DMA.
+ *
+ * Os dados a transmitir são escritos em um stream buffer indexado
+ * externamente, cuja memória é o anel de um canal de DMA. O DMA transmite
+ * diretamente do anel para a UART, sem cópias intermediárias e sem
+ * interrupção por byte.
+ */
+
+#ifndef UART_DMA_H
+#define UART_DMA_H
+
+#include "FreeRTOS.h"
+#include "stream_buffer.h"
+
+// UART0 nos pinos do conector de expansão da BitDogLab V6
+#define UART_DMA_ID uart0
+#define UART_DMA_TX_PIN 0
+#define UART_DMA_RX_PIN 1
+#define UART_DMA_BAUDRATE 115200
+
+// Anel de transmissão do DMA: 2^12 bytes (4 KB), dos quais o stream buffer
+// usa um a menos. Comporta o relatório da análise de escalonabilidade
+// (SCHED_REPORT_MAX_BYTES), escrito antes de o escalonador iniciar, quando
+// nada ainda esvazia o buffer
+#define UART_DMA_TX_RING_BITS 12
+#define UART_DMA_TX_BUFFER_SIZE (1u << UART_DMA_TX_RING_BITS)
+
+/**
+ * @brief Inicializa a UART, o canal de DMA e o stream buffer de transmissão.
+ *
+ * Deve ser chamada uma única vez, antes de qualquer chamada a uart_dma_write().
+ */
+void uart_dma_init(void);
+
+/**
+ * @brief Enfileira dados para transmissão pela UART.
+ *
+ * @param data Dados a transmitir.
+ * @param len Quantidade de bytes.
+ * @param ticks_to_wait Tempo máximo de espera por espaço no buffer.
+ * @return size_t Quantidade de bytes efetivamente enfileirados.
+ */
+size_t uart_dma_write(const void *data, size_t len, TickType_t ticks_to_wait);
+
+#endif // UART_DMA_H
\ No newline at end of file